@@ -0,0 +1,213 @@
+/**
+ * @file alloc.h
+ * @brief Arena and fixed-block pool allocators over the linker heap
+ *
+ * The linker scripts reserve .heap (__heap_start .. __heap_end, HEAP_SIZE
+ * bytes, set from CMake). heap_init(), called from platform_init(), splits
+ * it into NUM_HARTS line-aligned slices and gives each hart a bump arena
+ * over its slice:
+ *
+ *   - Arena: arena_alloc() bumps a pointer; memory is returned all at once
+ *     by arena_reset() (or back to an arena_mark() with arena_release())
+ *     when the region that used it ends. There is no per-object free.
+ *   - Pool: fixed-size blocks carved out of an arena once, then recycled
+ *     through an intrusive free list with pool_alloc() / pool_free().
+ *
+ * Every per-hart arena (heap_arena()) is only ever touched by its owning
+ * hart, so allocation takes no locks and no AMOs. Arenas and pools are not
+ * thread-safe: one owner each, and blocks must be freed by their owner.
+ *
+ * Alignments must be powers of two. ALLOC_ALIGN_LINE keeps objects off
+ * each other's cache lines; alloc_vec_align() additionally covers one
+ * vector register (VLENB) in RVV builds.
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include "smp.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Cache-line alignment for arena_alloc() / pool_init() */
+#define ALLOC_ALIGN_LINE SMP_CACHE_LINE
+
+/** Smallest alignment handed out (every block can hold a pool link) */
+#define ALLOC_ALIGN_MIN sizeof(void *)
+
+/* =============================================================================
+ * Arena (Bump) Allocator
+ * ============================================================================= */
+
+/**
+ * @brief Bump arena over [base, end)
+ */
+typedef struct {
+    uintptr_t base; /* First byte of the region */
+    uintptr_t end;  /* One past the last byte */
+    uintptr_t cur;  /* Next free byte */
+} arena_t;
+
+/** Saved arena position for arena_release() */
+typedef uintptr_t arena_mark_t;
+
+/**
+ * @brief Initialize an arena over a caller-provided region
+ *
+ * @param arena Arena to initialize
+ * @param base Start of the region
+ * @param size Region size in bytes
+ */
+void arena_init(arena_t *arena, void *base, size_t size);
+
+/**
+ * @brief Allocate size bytes aligned to align
+ *
+ * @param arena Arena to allocate from
+ * @param size Bytes to allocate (0 is allowed and returns a valid pointer)
+ * @param align Power-of-two alignment (raised to ALLOC_ALIGN_MIN)
+ * @return Pointer to uninitialized memory, or NULL if the arena is exhausted
+ */
+void *arena_alloc(arena_t *arena, size_t size, size_t align);
+
+/**
+ * @brief Return every allocation of the arena at once
+ */
+static inline void arena_reset(arena_t *arena)
+{
+    arena->cur = arena->base;
+}
+
+/**
+ * @brief Current arena position, for a later arena_release()
+ */
+static inline arena_mark_t arena_mark(const arena_t *arena)
+{
+    return arena->cur;
+}
+
+/**
+ * @brief Return every allocation made since mark was taken
+ */
+static inline void arena_release(arena_t *arena, arena_mark_t mark)
+{
+    arena->cur = mark;
+}
+
+/** Bytes allocated from the arena (including alignment padding) */
+static inline size_t arena_used(const arena_t *arena)
+{
+    return (size_t) (arena->cur - arena->base);
+}
+
+/** Bytes still available, before alignment padding */
+static inline size_t arena_remaining(const arena_t *arena)
+{
+    return (size_t) (arena->end - arena->cur);
+}
+
+/* =============================================================================
+ * Fixed-Block Pool
+ * ============================================================================= */
+
+/** Free-list link stored in the first word of every free block */
+typedef struct pool_block {
+    struct pool_block *next;
+} pool_block_t;
+
+/**
+ * @brief Pool of equally sized, equally aligned blocks
+ */
+typedef struct {
+    pool_block_t *free_list;
+    uintptr_t base;    /* First block */
+    size_t block_size; /* Stride between blocks (multiple of the alignment) */
+    uint32_t nblocks;
+    uint32_t nfree;
+} pool_t;
+
+/**
+ * @brief Carve nblocks blocks out of an arena and put them on the free list
+ *
+ * @param pool Pool to initialize
+ * @param arena Arena that provides the block storage
+ * @param block_size Usable bytes per block (rounded up to align)
+ * @param nblocks Number of blocks
+ * @param align Power-of-two block alignment (raised to ALLOC_ALIGN_MIN)
+ * @return false if the arena cannot hold the blocks (the pool is then empty)
+ */
+bool pool_init(pool_t *pool, arena_t *arena, size_t block_size, uint32_t nblocks, size_t align);
+
+/**
+ * @brief Take a block from the pool
+ * @return Block pointer, or NULL if every block is in use
+ */
+static inline void *pool_alloc(pool_t *pool)
+{
+    pool_block_t *blk = pool->free_list;
+
+    if (blk) {
+        pool->free_list = blk->next;
+        pool->nfree--;
+    }
+    return blk;
+}
+
+/**
+ * @brief Return a block obtained from pool_alloc() of the same pool
+ */
+static inline void pool_free(pool_t *pool, void *ptr)
+{
+    pool_block_t *blk = (pool_block_t *) ptr;
+
+    blk->next = pool->free_list;
+    pool->free_list = blk;
+    pool->nfree++;
+}
+
+/** True if ptr is the start of one of the pool's blocks */
+bool pool_owns(const pool_t *pool, const void *ptr);
+
+/* =============================================================================
+ * Heap
+ * ============================================================================= */
+
+/**
+ * @brief Split the linker heap into one arena per hart
+ *
+ * Called by hart 0 from platform_init(), before any hart allocates. Each
+ * slice is a whole number of cache lines.
+ */
+void heap_init(void);
+
+/** Size of the linker heap in bytes */
+size_t heap_size(void);
+
+/**
+ * @brief Arena of a given hart
+ * @param hart Hart ID (0 .. NUM_HARTS-1)
+ */
+arena_t *heap_hart_arena(uint32_t hart);
+
+/**
+ * @brief The calling hart's arena (found through tp, no locking needed)
+ */
+static inline arena_t *heap_arena(void)
+{
+    return heap_hart_arena(smp_hart_id());
+}
+
+/**
+ * @brief Alignment for buffers used by vector kernels
+ *
+ * Cache line, or VLENB when a vector register is larger (RVV builds).
+ */
+size_t alloc_vec_align(void);
+
+#endif /* ALLOC_H */
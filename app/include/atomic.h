@@ -1,13 +1,32 @@
 /**
  * @file atomic.h
- * @brief RISC-V atomic memory operations
+ * @brief RISC-V atomic memory operations with C11-style memory orders
  *
  * Provides atomic operations using RISC-V 'A' extension instructions:
- * - AMO (Atomic Memory Operations): amoadd, amoswap, amoor, amoand
+ * - AMO (Atomic Memory Operations): amoswap, amoadd, amoand, amoor, amoxor,
+ *   amomin[u], amomax[u], in 32-bit (.w) and 64-bit (.d) widths
  * - LR/SC (Load-Reserved / Store-Conditional) for CAS operations
+ * - Plain loads and stores bracketed by the fences of the RVWMO mapping
  *
- * All operations use .aqrl (acquire-release) ordering for sequential
- * consistency, which is safest for SMP correctness.
+ * Every operation has an _explicit variant taking an atomic_order_t,
+ * mapped as in the ISA manual's C11 table (RVWMO appendix):
+ *
+ *   order     AMO      LR/SC (CAS)     load                   store
+ *   relaxed   amo      lr / sc         l                      s
+ *   acquire   amo.aq   lr.aq / sc      l; fence r,rw          (release)
+ *   release   amo.rl   lr / sc.rl      (acquire)              fence rw,w; s
+ *   acq_rel   amo.aqrl lr.aq / sc.rl   (acquire)              (release)
+ *   seq_cst   amo.aqrl lr.aqrl / sc.rl fence rw,rw; l;        fence rw,w; s
+ *                                      fence r,rw
+ *
+ * An order that does not apply to an operation (release on a load, acquire
+ * on a store) is strengthened to the nearest one that does. The order is
+ * meant to be a constant: the switch folds to one instruction sequence
+ * once the function is inlined.
+ *
+ * The functions without a suffix keep their original ordering: the AMOs
+ * and CAS are seq_cst, atomic_load_*() is acquire and atomic_store_*() is
+ * release.
  */
 
 #ifndef ATOMIC_H
@@ -16,164 +35,236 @@
 #include <stdint.h>
 
 /* =============================================================================
- * 32-bit Atomic Operations (using AMO instructions)
+ * Memory Orders
  * ============================================================================= */
 
 /**
- * @brief Atomic add (32-bit)
- * @param ptr Pointer to the atomic variable
- * @param val Value to add
- * @return Previous value at *ptr (before addition)
+ * @brief Memory order of an atomic operation (C11 memory_order, minus consume)
  */
-static inline uint32_t atomic_add_u32(volatile uint32_t *ptr, uint32_t val)
-{
-    uint32_t result;
-    __asm__ __volatile__("amoadd.w.aqrl %0, %1, (%2)"
-                         : "=r"(result)
-                         : "r"(val), "r"(ptr)
-                         : "memory");
-    return result;
-}
+typedef enum {
+    ATOMIC_RELAXED, /**< Atomicity only, no ordering */
+    ATOMIC_ACQUIRE, /**< Later accesses stay after this one */
+    ATOMIC_RELEASE, /**< Earlier accesses stay before this one */
+    ATOMIC_ACQ_REL, /**< Both (read-modify-write operations) */
+    ATOMIC_SEQ_CST, /**< Both, plus a single total order with other seq_cst ops */
+} atomic_order_t;
 
 /**
- * @brief Atomic swap (32-bit)
- * @param ptr Pointer to the atomic variable
- * @param val Value to swap in
- * @return Previous value at *ptr
+ * @brief Memory fence (C11 atomic_thread_fence)
+ *
+ * acquire: fence r,rw. release: fence rw,w. acq_rel: fence.tso (r->rw
+ * and w->w). seq_cst: fence rw,rw. relaxed: compiler barrier only.
+ *
+ * @param order Memory order of the fence
  */
-static inline uint32_t atomic_swap_u32(volatile uint32_t *ptr, uint32_t val)
+static inline void atomic_thread_fence(atomic_order_t order)
 {
-    uint32_t result;
-    __asm__ __volatile__("amoswap.w.aqrl %0, %1, (%2)"
-                         : "=r"(result)
-                         : "r"(val), "r"(ptr)
-                         : "memory");
-    return result;
+    switch (order) {
+    case ATOMIC_RELAXED:
+        __asm__ __volatile__("" ::: "memory");
+        break;
+    case ATOMIC_ACQUIRE:
+        __asm__ __volatile__("fence r, rw" ::: "memory");
+        break;
+    case ATOMIC_RELEASE:
+        __asm__ __volatile__("fence rw, w" ::: "memory");
+        break;
+    case ATOMIC_ACQ_REL:
+        __asm__ __volatile__("fence.tso" ::: "memory");
+        break;
+    default:
+        __asm__ __volatile__("fence rw, rw" ::: "memory");
+        break;
+    }
 }
 
-/**
- * @brief Atomic OR (32-bit)
- * @param ptr Pointer to the atomic variable
- * @param val Value to OR
- * @return Previous value at *ptr
- */
-static inline uint32_t atomic_or_u32(volatile uint32_t *ptr, uint32_t val)
-{
-    uint32_t result;
-    __asm__ __volatile__("amoor.w.aqrl %0, %1, (%2)"
-                         : "=r"(result)
-                         : "r"(val), "r"(ptr)
-                         : "memory");
-    return result;
-}
+/* =============================================================================
+ * Read-Modify-Write Operations (AMO instructions)
+ * ============================================================================= */
 
-/**
- * @brief Atomic AND (32-bit)
- * @param ptr Pointer to the atomic variable
- * @param val Value to AND
- * @return Previous value at *ptr
- */
-static inline uint32_t atomic_and_u32(volatile uint32_t *ptr, uint32_t val)
-{
-    uint32_t result;
-    __asm__ __volatile__("amoand.w.aqrl %0, %1, (%2)"
-                         : "=r"(result)
-                         : "r"(val), "r"(ptr)
-                         : "memory");
-    return result;
-}
+/** One AMO with ordering suffix sfx ("", ".aq", ".rl" or ".aqrl") */
+#define ATOMIC_AMO_ASM(insn, sfx, result, ptr, val)                                               \
+    __asm__ __volatile__(insn sfx " %0, %1, (%2)" : "=r"(result) : "r"(val), "r"(ptr) : "memory")
 
 /**
- * @brief Atomic load (32-bit) with acquire semantics
- * @param ptr Pointer to the atomic variable
- * @return Current value at *ptr
+ * Defines name_explicit(ptr, val, order), returning the previous value at
+ * *ptr, and name(ptr, val), its seq_cst form.
  */
-static inline uint32_t atomic_load_u32(volatile uint32_t *ptr)
-{
-    uint32_t val;
-    __asm__ __volatile__("lw %0, 0(%1)\n\t"
-                         "fence r, rw"
-                         : "=r"(val)
-                         : "r"(ptr)
-                         : "memory");
-    return val;
-}
+#define ATOMIC_DEFINE_AMO(name, type, insn)                                                        \
+    static inline type name##_explicit(volatile type *ptr, type val, atomic_order_t order)        \
+    {                                                                                              \
+        type result;                                                                               \
+        switch (order) {                                                                           \
+        case ATOMIC_RELAXED:                                                                       \
+            ATOMIC_AMO_ASM(insn, "", result, ptr, val);                                            \
+            break;                                                                                 \
+        case ATOMIC_ACQUIRE:                                                                       \
+            ATOMIC_AMO_ASM(insn, ".aq", result, ptr, val);                                         \
+            break;                                                                                 \
+        case ATOMIC_RELEASE:                                                                       \
+            ATOMIC_AMO_ASM(insn, ".rl", result, ptr, val);                                         \
+            break;                                                                                 \
+        default:                                                                                   \
+            ATOMIC_AMO_ASM(insn, ".aqrl", result, ptr, val);                                       \
+            break;                                                                                 \
+        }                                                                                          \
+        return result;                                                                             \
+    }                                                                                              \
+    static inline type name(volatile type *ptr, type val)                                          \
+    {                                                                                              \
+        return name##_explicit(ptr, val, ATOMIC_SEQ_CST);                                          \
+    }
 
-/**
- * @brief Atomic store (32-bit) with release semantics
- * @param ptr Pointer to the atomic variable
- * @param val Value to store
+/*
+ * Each line defines atomic_<op>_<type>() and atomic_<op>_<type>_explicit().
+ * All return the previous value; min/max on _i32/_i64 compare signed,
+ * on _u32/_u64 unsigned.
  */
-static inline void atomic_store_u32(volatile uint32_t *ptr, uint32_t val)
-{
-    __asm__ __volatile__("fence rw, w\n\t"
-                         "sw %0, 0(%1)"
-                         :
-                         : "r"(val), "r"(ptr)
-                         : "memory");
-}
+
+/* 32-bit */
+ATOMIC_DEFINE_AMO(atomic_swap_u32, uint32_t, "amoswap.w")
+ATOMIC_DEFINE_AMO(atomic_add_u32, uint32_t, "amoadd.w")
+ATOMIC_DEFINE_AMO(atomic_and_u32, uint32_t, "amoand.w")
+ATOMIC_DEFINE_AMO(atomic_or_u32, uint32_t, "amoor.w")
+ATOMIC_DEFINE_AMO(atomic_xor_u32, uint32_t, "amoxor.w")
+ATOMIC_DEFINE_AMO(atomic_min_u32, uint32_t, "amominu.w")
+ATOMIC_DEFINE_AMO(atomic_max_u32, uint32_t, "amomaxu.w")
+ATOMIC_DEFINE_AMO(atomic_min_i32, int32_t, "amomin.w")
+ATOMIC_DEFINE_AMO(atomic_max_i32, int32_t, "amomax.w")
+
+/* 64-bit */
+ATOMIC_DEFINE_AMO(atomic_swap_u64, uint64_t, "amoswap.d")
+ATOMIC_DEFINE_AMO(atomic_add_u64, uint64_t, "amoadd.d")
+ATOMIC_DEFINE_AMO(atomic_and_u64, uint64_t, "amoand.d")
+ATOMIC_DEFINE_AMO(atomic_or_u64, uint64_t, "amoor.d")
+ATOMIC_DEFINE_AMO(atomic_xor_u64, uint64_t, "amoxor.d")
+ATOMIC_DEFINE_AMO(atomic_min_u64, uint64_t, "amominu.d")
+ATOMIC_DEFINE_AMO(atomic_max_u64, uint64_t, "amomaxu.d")
+ATOMIC_DEFINE_AMO(atomic_min_i64, int64_t, "amomin.d")
+ATOMIC_DEFINE_AMO(atomic_max_i64, int64_t, "amomax.d")
+
+/* =============================================================================
+ * Compare-and-Swap (LR/SC)
+ * ============================================================================= */
+
+/** One LR/SC compare-and-swap loop with suffixes lsfx / ssfx */
+#define ATOMIC_CAS_ASM(w, lsfx, ssfx, tmp, result, ptr, expected, desired)                        \
+    __asm__ __volatile__("1:\n\t"                                                                  \
+                         "lr." w lsfx " %0, (%2)\n\t"                                              \
+                         "bne       %0, %3, 2f\n\t"                                                \
+                         "sc." w ssfx " %1, %4, (%2)\n\t"                                          \
+                         "bnez      %1, 1b\n\t"                                                    \
+                         "li        %1, 1\n\t"                                                     \
+                         "j         3f\n\t"                                                        \
+                         "2:\n\t"                                                                  \
+                         "li        %1, 0\n\t"                                                     \
+                         "3:\n\t"                                                                  \
+                         : "=&r"(tmp), "=&r"(result)                                               \
+                         : "r"(ptr), "r"(expected), "r"(desired)                                   \
+                         : "memory")
 
 /**
- * @brief Compare-and-swap (32-bit) using LR/SC
- * @param ptr Pointer to the atomic variable
- * @param expected Expected current value
- * @param desired Value to store if current == expected
- * @return 1 if swap succeeded, 0 if it failed
+ * Defines name_explicit(ptr, expected, desired, order) and name(ptr,
+ * expected, desired), its seq_cst form. Both store desired only if
+ * *ptr == expected and return 1 if they did, 0 otherwise. A failed CAS
+ * has the acquire half of order (lr.aq), if any.
  */
-static inline int atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired)
-{
-    uint32_t tmp;
-    int result;
-    __asm__ __volatile__("1:\n\t"
-                         "lr.w.aqrl %0, (%2)\n\t"
-                         "bne       %0, %3, 2f\n\t"
-                         "sc.w.rl   %1, %4, (%2)\n\t"
-                         "bnez      %1, 1b\n\t"
-                         "li        %1, 1\n\t"
-                         "j         3f\n\t"
-                         "2:\n\t"
-                         "li        %1, 0\n\t"
-                         "3:\n\t"
-                         : "=&r"(tmp), "=&r"(result)
-                         : "r"(ptr), "r"(expected), "r"(desired)
-                         : "memory");
-    return result;
-}
+#define ATOMIC_DEFINE_CAS(name, type, w)                                                           \
+    static inline int name##_explicit(volatile type *ptr, type expected, type desired,            \
+                                      atomic_order_t order)                                        \
+    {                                                                                              \
+        type tmp;                                                                                  \
+        int result;                                                                                \
+        switch (order) {                                                                           \
+        case ATOMIC_RELAXED:                                                                       \
+            ATOMIC_CAS_ASM(w, "", "", tmp, result, ptr, expected, desired);                        \
+            break;                                                                                 \
+        case ATOMIC_ACQUIRE:                                                                       \
+            ATOMIC_CAS_ASM(w, ".aq", "", tmp, result, ptr, expected, desired);                     \
+            break;                                                                                 \
+        case ATOMIC_RELEASE:                                                                       \
+            ATOMIC_CAS_ASM(w, "", ".rl", tmp, result, ptr, expected, desired);                     \
+            break;                                                                                 \
+        case ATOMIC_ACQ_REL:                                                                       \
+            ATOMIC_CAS_ASM(w, ".aq", ".rl", tmp, result, ptr, expected, desired);                  \
+            break;                                                                                 \
+        default:                                                                                   \
+            ATOMIC_CAS_ASM(w, ".aqrl", ".rl", tmp, result, ptr, expected, desired);                \
+            break;                                                                                 \
+        }                                                                                          \
+        return result;                                                                             \
+    }                                                                                              \
+    static inline int name(volatile type *ptr, type expected, type desired)                        \
+    {                                                                                              \
+        return name##_explicit(ptr, expected, desired, ATOMIC_SEQ_CST);                            \
+    }
+
+ATOMIC_DEFINE_CAS(atomic_cas_u32, uint32_t, "w")
+ATOMIC_DEFINE_CAS(atomic_cas_u64, uint64_t, "d")
 
 /* =============================================================================
- * 64-bit Atomic Operations
+ * Loads and Stores
  * ============================================================================= */
 
 /**
- * @brief Atomic add (64-bit)
- * @param ptr Pointer to the atomic variable
- * @param val Value to add
- * @return Previous value at *ptr
+ * Defines name_explicit(ptr, order) and name(ptr), its acquire form.
+ * Release and acq_rel are strengthened to acquire.
  */
-static inline uint64_t atomic_add_u64(volatile uint64_t *ptr, uint64_t val)
-{
-    uint64_t result;
-    __asm__ __volatile__("amoadd.d.aqrl %0, %1, (%2)"
-                         : "=r"(result)
-                         : "r"(val), "r"(ptr)
-                         : "memory");
-    return result;
-}
+#define ATOMIC_DEFINE_LOAD(name, type, insn)                                                       \
+    static inline type name##_explicit(volatile type *ptr, atomic_order_t order)                 \
+    {                                                                                              \
+        type val;                                                                                  \
+        switch (order) {                                                                           \
+        case ATOMIC_RELAXED:                                                                       \
+            __asm__ __volatile__(insn " %0, 0(%1)" : "=r"(val) : "r"(ptr) : "memory");             \
+            break;                                                                                 \
+        case ATOMIC_SEQ_CST:                                                                       \
+            __asm__ __volatile__("fence rw, rw\n\t" insn " %0, 0(%1)\n\t"                          \
+                                 "fence r, rw"                                                     \
+                                 : "=r"(val)                                                       \
+                                 : "r"(ptr)                                                        \
+                                 : "memory");                                                      \
+            break;                                                                                 \
+        default:                                                                                   \
+            __asm__ __volatile__(insn " %0, 0(%1)\n\t"                                             \
+                                 "fence r, rw"                                                     \
+                                 : "=r"(val)                                                       \
+                                 : "r"(ptr)                                                        \
+                                 : "memory");                                                      \
+            break;                                                                                 \
+        }                                                                                          \
+        return val;                                                                                \
+    }                                                                                              \
+    static inline type name(volatile type *ptr)                                                    \
+    {                                                                                              \
+        return name##_explicit(ptr, ATOMIC_ACQUIRE);                                               \
+    }
 
 /**
- * @brief Atomic swap (64-bit)
- * @param ptr Pointer to the atomic variable
- * @param val Value to swap in
- * @return Previous value at *ptr
+ * Defines name_explicit(ptr, val, order) and name(ptr, val), its release
+ * form. Every order but relaxed is a release store (the seq_cst load
+ * carries the leading full fence).
  */
-static inline uint64_t atomic_swap_u64(volatile uint64_t *ptr, uint64_t val)
-{
-    uint64_t result;
-    __asm__ __volatile__("amoswap.d.aqrl %0, %1, (%2)"
-                         : "=r"(result)
-                         : "r"(val), "r"(ptr)
-                         : "memory");
-    return result;
-}
+#define ATOMIC_DEFINE_STORE(name, type, insn)                                                      \
+    static inline void name##_explicit(volatile type *ptr, type val, atomic_order_t order)        \
+    {                                                                                              \
+        if (order == ATOMIC_RELAXED) {                                                             \
+            __asm__ __volatile__(insn " %0, 0(%1)" : : "r"(val), "r"(ptr) : "memory");             \
+        } else {                                                                                   \
+            __asm__ __volatile__("fence rw, w\n\t" insn " %0, 0(%1)"                               \
+                                 :                                                                 \
+                                 : "r"(val), "r"(ptr)                                              \
+                                 : "memory");                                                      \
+        }                                                                                          \
+    }                                                                                              \
+    static inline void name(volatile type *ptr, type val)                                          \
+    {                                                                                              \
+        name##_explicit(ptr, val, ATOMIC_RELEASE);                                                 \
+    }
+
+ATOMIC_DEFINE_LOAD(atomic_load_u32, uint32_t, "lw")
+ATOMIC_DEFINE_LOAD(atomic_load_u64, uint64_t, "ld")
+ATOMIC_DEFINE_STORE(atomic_store_u32, uint32_t, "sw")
+ATOMIC_DEFINE_STORE(atomic_store_u64, uint64_t, "sd")
 
 #endif /* ATOMIC_H */
@@ -2,85 +2,104 @@
  * @file console.h
  * @brief Console abstraction layer
  *
- * Provides platform-independent console I/O macros.
- * Maps to UART for QEMU/gem5/Renode and HTIF for Spike.
+ * Platform-independent buffered console output. Each hart appends to its
+ * own line buffer; a complete line (or a full buffer) is handed to the
+ * platform backend in one bulk write:
+ *   - QEMU/gem5 FS/Renode: uart_write() (per-hart TX rings, see uart.h)
+ *   - Spike: htif_write() (one HTIF write syscall per line)
+ *   - gem5 SE: gem5_se_write() (one write(2) ecall per line)
+ *
+ * console_printf() formats straight into the line buffer: no heap, and
+ * stack use is bounded by one 24-byte digit buffer. Supported
+ * conversions: %d %i %u %x %X %c %s %p %%, with flags '-' and '0', a
+ * field width, and the length modifiers l, ll and z.
+ *
+ * Output that does not end in a newline stays buffered until
+ * console_flush(); platform_exit() flushes before stopping the simulator.
  */
 
 #ifndef CONSOLE_H
 #define CONSOLE_H
 
+#include <stdarg.h>
+#include <stddef.h>
 #include <stdint.h>
 
-/* Platform-specific console mapping */
-#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
-#include "gem5_se_io.h"
-#define console_puts gem5_se_puts
-#define console_putc gem5_se_putc
-#elif defined(PLATFORM_QEMU_VIRT) || defined(PLATFORM_GEM5) || defined(PLATFORM_RENODE)
-#include "uart.h"
-#define console_puts uart_puts
-#define console_putc uart_putc
-#elif defined(PLATFORM_SPIKE)
-#include "htif.h"
-#define console_puts htif_puts
-#define console_putc htif_putc
-#else
-#error "No platform defined for console output"
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Per-hart line buffer size in bytes */
+#ifndef CONSOLE_LINE_SIZE
+#define CONSOLE_LINE_SIZE 128
 #endif
 
+/*
+ * Harts may print concurrently without a lock when the backend keeps each
+ * line from a per-hart buffer intact (UART needs its TX rings for that).
+ */
+#if !(defined(PLATFORM_QEMU_VIRT) || defined(PLATFORM_GEM5) || defined(PLATFORM_RENODE)) ||       \
+    defined(GEM5_MODE_SE) || defined(UART_TX_RING)
+#define CONSOLE_LOCKFREE
+#endif
+
+/* =============================================================================
+ * Backend Interface
+ * ============================================================================= */
+
+/**
+ * @brief Console backend: the platform's bulk output entry points
+ *
+ * write() receives complete lines except when a line overflows
+ * CONSOLE_LINE_SIZE or on console_flush(). '\n' is passed through; the
+ * backend adds any line-ending translation the device needs.
+ */
+typedef struct {
+    const char *name;                           /**< Backend name for reports */
+    void (*write)(const char *buf, size_t len); /**< Bulk write */
+    void (*flush)(void);                        /**< Drain backend buffers, or NULL */
+} console_backend_t;
+
+/**
+ * @brief The backend selected for this platform at build time
+ */
+const console_backend_t *console_get_backend(void);
+
+/* =============================================================================
+ * Output
+ * ============================================================================= */
+
+/**
+ * @brief Write a single character
+ */
+void console_putc(char c);
+
+/**
+ * @brief Write a null-terminated string
+ */
+void console_puts(const char *s);
+
 /**
- * @brief Simple integer to string conversion (decimal)
- * @param value Value to convert
- * @param buf Output buffer
- * @param buf_size Size of output buffer
+ * @brief Write a buffer of len bytes
  */
-static inline void console_put_dec(uint64_t value, char *buf, int buf_size)
-{
-    int i = 0;
-    if (value == 0) {
-        buf[0] = '0';
-        buf[1] = '\0';
-        return;
-    }
-
-    /* Convert digits in reverse */
-    char temp[32];
-    while (value > 0 && i < 31) {
-        temp[i++] = '0' + (value % 10);
-        value /= 10;
-    }
-    temp[i] = '\0';
-
-    /* Reverse the string */
-    int len = i;
-    for (int j = 0; j < len && j < buf_size - 1; j++) {
-        buf[j] = temp[len - 1 - j];
-    }
-    buf[len < buf_size ? len : buf_size - 1] = '\0';
-}
+void console_write(const char *buf, size_t len);
 
 /**
- * @brief Print a uint64_t value in hex
- * @param value Value to print
+ * @brief Formatted output (subset of printf, see file comment)
+ */
+void console_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Formatted output from a va_list
+ */
+void console_vprintf(const char *fmt, va_list ap) __attribute__((format(printf, 1, 0)));
+
+/**
+ * @brief Send every hart's buffered output to the backend and drain it
+ *
+ * Called by platform_exit(). Call from hart 0 while other harts are not
+ * printing.
  */
-static inline void console_put_hex(uint64_t value)
-{
-    console_puts("0x");
-    char hex[17];
-    const char hexchars[] = "0123456789ABCDEF";
-
-    for (int i = 15; i >= 0; i--) {
-        hex[15 - i] = hexchars[(value >> (i * 4)) & 0xF];
-    }
-    hex[16] = '\0';
-
-    /* Skip leading zeros */
-    int start = 0;
-    while (start < 15 && hex[start] == '0') {
-        start++;
-    }
-
-    console_puts(&hex[start]);
-}
+void console_flush(void);
 
 #endif /* CONSOLE_H */
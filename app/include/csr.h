@@ -79,6 +79,10 @@
 #define CSR_MTVEC 0x305
 #define CSR_MCOUNTEREN 0x306
 
+/* Machine Counter Setup */
+#define CSR_MCOUNTINHIBIT 0x320
+#define CSR_MHPMEVENT3 0x323 /* mhpmevent3..31: 0x323..0x33F */
+
 /* Machine Trap Handling */
 #define CSR_MSCRATCH 0x340
 #define CSR_MEPC 0x341
@@ -89,6 +93,7 @@
 /* Machine Counter/Timers */
 #define CSR_MCYCLE 0xB00
 #define CSR_MINSTRET 0xB02
+#define CSR_MHPMCOUNTER3 0xB03 /* mhpmcounter3..31: 0xB03..0xB1F */
 #define CSR_MCYCLEH 0xB80
 #define CSR_MINSTRETH 0xB82
 
@@ -122,6 +127,12 @@
 #define MSTATUS_TSR (1UL << 22)  /* Trap SRET */
 #define MSTATUS_SD (1UL << 63)   /* State Dirty (RV64 only) */
 
+/* mstatus.FS states (mstatus.VS uses the same encoding, see rvv_detect.h) */
+#define MSTATUS_FS_OFF (0UL << 13)     /* FP unit disabled */
+#define MSTATUS_FS_INITIAL (1UL << 13) /* FP registers in their initial state */
+#define MSTATUS_FS_CLEAN (2UL << 13)   /* FP registers unchanged since last save/restore */
+#define MSTATUS_FS_DIRTY (3UL << 13)   /* FP registers written */
+
 /* Privilege modes */
 #define PRV_U 0UL /* User mode */
 #define PRV_S 1UL /* Supervisor mode */
@@ -210,6 +221,107 @@ static inline uint64_t csr_read_time(void)
     return read_csr(time);
 }
 
+/* =============================================================================
+ * Hardware Performance Monitor (Zihpm) Counters
+ * ============================================================================= */
+
+/** First and last programmable counter (mhpmcounter3 .. mhpmcounter31) */
+#define CSR_HPM_FIRST 3
+#define CSR_HPM_LAST 31
+
+/** Expand X(n) for every programmable counter number */
+#define CSR_HPM_FOREACH(X)                                                                         \
+    X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17) X(18) X(19) \
+        X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31)
+
+/*
+ * CSR numbers are instruction immediates, so counter n is selected with a
+ * switch; with a constant n the switch folds to a single csrr/csrw.
+ */
+
+/**
+ * @brief Read mhpmcounter<n>
+ * @param n Counter number (3..31); other values read as 0
+ */
+static inline uint64_t csr_read_mhpmcounter(unsigned n)
+{
+    switch (n) {
+#define CSR_HPM_READ_COUNTER(i)                                                                    \
+    case i:                                                                                        \
+        return read_csr(mhpmcounter##i);
+        CSR_HPM_FOREACH(CSR_HPM_READ_COUNTER)
+#undef CSR_HPM_READ_COUNTER
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Read mhpmevent<n>
+ * @param n Counter number (3..31); other values read as 0
+ */
+static inline uint64_t csr_read_mhpmevent(unsigned n)
+{
+    switch (n) {
+#define CSR_HPM_READ_EVENT(i)                                                                      \
+    case i:                                                                                        \
+        return read_csr(mhpmevent##i);
+        CSR_HPM_FOREACH(CSR_HPM_READ_EVENT)
+#undef CSR_HPM_READ_EVENT
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Write the event selector of counter n
+ * @param n Counter number (3..31); other values are ignored
+ * @param event Implementation-defined event selector (0 = no event)
+ */
+static inline void csr_write_mhpmevent(unsigned n, uint64_t event)
+{
+    switch (n) {
+#define CSR_HPM_WRITE_EVENT(i)                                                                     \
+    case i:                                                                                        \
+        write_csr(mhpmevent##i, event);                                                            \
+        break;
+        CSR_HPM_FOREACH(CSR_HPM_WRITE_EVENT)
+#undef CSR_HPM_WRITE_EVENT
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Write mhpmcounter<n>
+ * @param n Counter number (3..31); other values are ignored
+ */
+static inline void csr_write_mhpmcounter(unsigned n, uint64_t value)
+{
+    switch (n) {
+#define CSR_HPM_WRITE_COUNTER(i)                                                                   \
+    case i:                                                                                        \
+        write_csr(mhpmcounter##i, value);                                                          \
+        break;
+        CSR_HPM_FOREACH(CSR_HPM_WRITE_COUNTER)
+#undef CSR_HPM_WRITE_COUNTER
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Write mcountinhibit (bit n stops counter n; 0 lets all count)
+ * @param mask Counters to inhibit
+ *
+ * Uses the CSR number: older assemblers only know 0x320 by its
+ * privileged-1.9 name.
+ */
+static inline void csr_write_mcountinhibit(uint32_t mask)
+{
+    __asm__ __volatile__("csrw %0, %1" ::"i"(CSR_MCOUNTINHIBIT), "r"((unsigned long) mask));
+}
+
 /**
  * @brief Enable machine-mode interrupts
  */
@@ -0,0 +1,126 @@
+/**
+ * @file dataset.h
+ * @brief Host-provided input datasets, mapped zero-copy (gem5 SE)
+ *
+ * Benchmarks take their inputs from files on the host instead of static
+ * arrays in .bss, so input size no longer costs ELF size or boot time and
+ * a new input needs no rebuild. dataset_map() opens a file, mmaps all of
+ * it read-only and checks the header; the elements are then used in
+ * place. gem5 SE fills a file mapping from the host file when it is
+ * created, so the guest never copies the data.
+ *
+ * File format (little endian, written by scripts/gen-dataset.py):
+ *
+ *   offset 0   dataset_header_t (64 bytes)
+ *   offset 64  rows * cols elements, row-major, data_offset % 64 == 0
+ *
+ * A vector is a 1 x n dataset. Paths come from the command line, e.g.
+ *
+ *   gem5.opt se_config.py --cmd=app.elf --options="a.rvds b.rvds"
+ *
+ * Only gem5 SE has a host file system; elsewhere dataset_map() returns
+ * DATASET_ERR_UNSUPPORTED.
+ */
+
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * File Format
+ * ============================================================================= */
+
+/** "RVDS" read as a little-endian word */
+#define DATASET_MAGIC 0x53445652U
+#define DATASET_VERSION 1
+
+/** Element types */
+#define DATASET_DTYPE_F32 1
+
+typedef struct {
+    uint32_t magic;       /* DATASET_MAGIC */
+    uint32_t version;     /* DATASET_VERSION */
+    uint32_t dtype;       /* DATASET_DTYPE_* */
+    uint32_t elem_size;   /* Bytes per element */
+    uint64_t rows;        /* Matrix rows (1 for a vector) */
+    uint64_t cols;        /* Matrix columns (elements of a vector) */
+    uint64_t data_offset; /* Start of the elements, 64-byte aligned */
+    uint64_t data_bytes;  /* rows * cols * elem_size */
+    uint64_t reserved[2];
+} dataset_header_t;
+
+_Static_assert(sizeof(dataset_header_t) == 64, "dataset header is one 64-byte line");
+
+/* =============================================================================
+ * Mapped Dataset
+ * ============================================================================= */
+
+typedef enum {
+    DATASET_OK = 0,
+    DATASET_ERR_UNSUPPORTED, /**< No host file system on this platform */
+    DATASET_ERR_OPEN,        /**< openat() or lseek() failed */
+    DATASET_ERR_MAP,         /**< mmap() failed */
+    DATASET_ERR_FORMAT,      /**< Bad magic/version or sizes past the end of the file */
+} dataset_status_t;
+
+typedef struct {
+    const dataset_header_t *header; /* Start of the mapping */
+    const void *data;               /* First element */
+    uint64_t rows;
+    uint64_t cols;
+    uint32_t dtype;
+    size_t map_bytes; /* Length of the mapping (whole file) */
+} dataset_t;
+
+/**
+ * @brief Map the dataset file at @p path (relative to gem5's working directory)
+ * @param ds Filled in on success; left zeroed otherwise
+ */
+dataset_status_t dataset_map(dataset_t *ds, const char *path);
+
+/**
+ * @brief Unmap a dataset returned by dataset_map()
+ */
+void dataset_unmap(dataset_t *ds);
+
+/**
+ * @brief float32 elements of a DATASET_DTYPE_F32 dataset, NULL for other types
+ */
+static inline const float *dataset_f32(const dataset_t *ds)
+{
+    return ds->dtype == DATASET_DTYPE_F32 ? (const float *) ds->data : (const float *) 0;
+}
+
+/**
+ * @brief Number of elements (rows * cols)
+ */
+static inline uint64_t dataset_elems(const dataset_t *ds)
+{
+    return ds->rows * ds->cols;
+}
+
+/**
+ * @brief Short description of a status, for log lines
+ */
+const char *dataset_strerror(dataset_status_t status);
+
+/* =============================================================================
+ * Scratch Buffers
+ * ============================================================================= */
+
+/**
+ * @brief Zeroed read/write buffer of @p bytes from an anonymous mapping
+ *
+ * For outputs sized by a dataset (too big for the heap arenas).
+ * @return The buffer, or NULL if the mapping failed or is unsupported
+ */
+void *dataset_scratch(size_t bytes);
+
+/**
+ * @brief Release a buffer from dataset_scratch()
+ */
+void dataset_scratch_free(void *buf, size_t bytes);
+
+#endif /* DATASET_H */
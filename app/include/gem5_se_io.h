@@ -5,13 +5,41 @@
  * In gem5 SE mode (Process + SEWorkload), I/O uses Linux syscalls via ecall:
  * write(64) for output, exit_group(94) for shutdown. gem5 emulates them.
  *
- * This module is only active when GEM5_MODE_SE is defined.
+ * Input files use openat/read/lseek/close and mmap/munmap on the host's
+ * files (paths relative to gem5's working directory). The command line
+ * (se_config.py --options) is available through gem5_se_argc()/argv().
+ * Wrappers return the syscall result: >= 0 on success, -errno on failure.
+ *
+ * This module is only active when GEM5_MODE_SE is defined; elsewhere the
+ * file and mmap wrappers fail with -GEM5_SE_ENOSYS and argc is 0.
  */
 
 #ifndef GEM5_SE_IO_H
 #define GEM5_SE_IO_H
 
 #include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Linux ABI Constants (asm-generic, as used by RISC-V)
+ * ============================================================================= */
+
+#define GEM5_SE_AT_FDCWD (-100) /* openat(): path relative to the cwd */
+#define GEM5_SE_O_RDONLY 0
+#define GEM5_SE_SEEK_SET 0
+#define GEM5_SE_SEEK_END 2
+
+#define GEM5_SE_PROT_READ 0x1
+#define GEM5_SE_PROT_WRITE 0x2
+#define GEM5_SE_MAP_PRIVATE 0x02
+#define GEM5_SE_MAP_ANONYMOUS 0x20
+
+#define GEM5_SE_ENOENT 2
+#define GEM5_SE_ENOMEM 12
+#define GEM5_SE_ENOSYS 38
+
+/** mmap() failure: the result is -errno, i.e. in the top 4 KiB of the address space */
+#define GEM5_SE_MMAP_FAILED(p) ((uintptr_t) (p) > (uintptr_t) -4096)
 
 /**
  * @brief Initialize gem5 SE I/O (no-op, SE handles setup)
@@ -43,4 +71,63 @@ void gem5_se_write(const char *buf, size_t len);
  */
 void gem5_se_exit(int exit_code);
 
+/* =============================================================================
+ * Command Line
+ * ============================================================================= */
+
+/**
+ * @brief Number of arguments gem5 passed to the process (argv[0] included)
+ */
+int gem5_se_argc(void);
+
+/**
+ * @brief Argument @p i of the process command line
+ * @return The argument, or NULL when i is out of range
+ */
+const char *gem5_se_argv(int i);
+
+/* =============================================================================
+ * Files and Memory Mappings
+ * ============================================================================= */
+
+/**
+ * @brief openat(dirfd, path, flags, 0)
+ * @return File descriptor, or -errno
+ */
+long gem5_se_openat(int dirfd, const char *path, int flags);
+
+/**
+ * @brief read(fd, buf, len)
+ * @return Bytes read (0 at end of file), or -errno
+ */
+long gem5_se_read(int fd, void *buf, size_t len);
+
+/**
+ * @brief lseek(fd, offset, whence)
+ * @return New file offset, or -errno
+ */
+long gem5_se_lseek(int fd, long offset, int whence);
+
+/**
+ * @brief close(fd)
+ * @return 0, or -errno
+ */
+long gem5_se_close(int fd);
+
+/**
+ * @brief mmap(addr, len, prot, flags, fd, offset)
+ *
+ * gem5 backs the mapping with host pages: a file mapping is filled from the
+ * host file when it is created, so the guest reads it without copying.
+ *
+ * @return Mapping address; test with GEM5_SE_MMAP_FAILED()
+ */
+void *gem5_se_mmap(void *addr, size_t len, int prot, int flags, int fd, long offset);
+
+/**
+ * @brief munmap(addr, len)
+ * @return 0, or -errno
+ */
+long gem5_se_munmap(void *addr, size_t len);
+
 #endif /* GEM5_SE_IO_H */
@@ -0,0 +1,216 @@
+/**
+ * @file hpm.h
+ * @brief Hardware performance counter (Zicntr/Zihpm) profiling harness
+ *
+ * hpm_init() clears mcountinhibit, programs the selected events into
+ * mhpmevent3 onwards (one counter per event) and calibrates the cost of
+ * an empty measurement.
+ * hpm_begin()/hpm_end() then sample mcycle, minstret and those counters
+ * around one region and return the deltas with that fixed overhead
+ * subtracted, so short kernels (the 64-element tests) are not dominated
+ * by the counter reads themselves:
+ *
+ *   hpm_sample_t start, delta;
+ *   hpm_begin(&start);
+ *   rvv_saxpy(a, x, y, n);
+ *   hpm_end(&start, &delta);
+ *   hpm_report("rvv_saxpy", &delta, n);
+ *
+ * Event selectors are implementation-defined. The HPM_SEL_* defaults use
+ * the SiFive U7 encoding (event class in bits [7:0], event mask above);
+ * override them with -DHPM_SEL_...=<value> for other cores. hpm_init()
+ * reads each selector back: a counter whose mhpmevent is hardwired to
+ * zero is reported as "n/a" rather than as zero events. A selector that
+ * sticks but names an event the model does not count still reads 0.
+ *
+ * gem5 SE runs in U-mode, where only the cycle and instret CSRs are
+ * readable: every event is "n/a" there.
+ */
+
+#ifndef HPM_H
+#define HPM_H
+
+#include "csr.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Counters sampled by hpm_begin()/hpm_end() (mhpmcounter3 onwards) */
+#ifndef HPM_MAX_EVENTS
+#define HPM_MAX_EVENTS 4
+#endif
+
+#if HPM_MAX_EVENTS < 1 || HPM_MAX_EVENTS > (CSR_HPM_LAST - CSR_HPM_FIRST + 1)
+#error "HPM_MAX_EVENTS must be 1..29"
+#endif
+
+/** Empty measurements taken by hpm_init(); the minimum is the overhead */
+#ifndef HPM_CALIBRATE_RUNS
+#define HPM_CALIBRATE_RUNS 16
+#endif
+
+/* Event selectors (SiFive U7 encoding: class | mask << 8) */
+#ifndef HPM_SEL_L1D_MISS
+#define HPM_SEL_L1D_MISS ((1UL << 9) | 2) /* Data cache miss / MMIO access */
+#endif
+#ifndef HPM_SEL_L1I_MISS
+#define HPM_SEL_L1I_MISS ((1UL << 8) | 2) /* Instruction cache miss */
+#endif
+#ifndef HPM_SEL_BRANCH_MISS
+#define HPM_SEL_BRANCH_MISS ((1UL << 13) | 1) /* Branch direction mispredict */
+#endif
+#ifndef HPM_SEL_DTLB_MISS
+#define HPM_SEL_DTLB_MISS ((1UL << 12) | 2) /* Data TLB miss */
+#endif
+
+/* =============================================================================
+ * Events and Samples
+ * ============================================================================= */
+
+/**
+ * @brief Events the harness knows how to select
+ */
+typedef enum {
+    HPM_EVENT_NONE = 0,    /**< Slot unused */
+    HPM_EVENT_L1D_MISS,    /**< L1 data cache misses */
+    HPM_EVENT_L1I_MISS,    /**< L1 instruction cache misses */
+    HPM_EVENT_BRANCH_MISS, /**< Branch mispredictions */
+    HPM_EVENT_DTLB_MISS,   /**< Data TLB misses */
+    HPM_EVENT_COUNT
+} hpm_event_t;
+
+/**
+ * @brief Counter values (absolute in hpm_begin(), deltas from hpm_end())
+ */
+typedef struct {
+    uint64_t cycles;                 /**< mcycle */
+    uint64_t instret;                /**< minstret */
+    uint64_t events[HPM_MAX_EVENTS]; /**< mhpmcounter3 + slot */
+} hpm_sample_t;
+
+/* =============================================================================
+ * Setup
+ * ============================================================================= */
+
+/**
+ * @brief Program the event counters and calibrate the sampling overhead
+ *
+ * Slot i counts events[i] on mhpmcounter(3 + i); slots past count are
+ * cleared. Call from hart 0 before the first hpm_begin().
+ *
+ * @param events Events to count
+ * @param count Number of events (at most HPM_MAX_EVENTS)
+ */
+void hpm_init(const hpm_event_t *events, uint32_t count);
+
+/**
+ * @brief Number of programmed event slots
+ */
+uint32_t hpm_num_events(void);
+
+/**
+ * @brief Event counted by a slot
+ */
+hpm_event_t hpm_slot_event(uint32_t slot);
+
+/**
+ * @brief True if the slot's selector was accepted by the hardware
+ */
+bool hpm_slot_live(uint32_t slot);
+
+/**
+ * @brief Short event name for reports (e.g. "l1d_miss")
+ */
+const char *hpm_event_name(hpm_event_t event);
+
+/**
+ * @brief Overhead of an empty hpm_begin()/hpm_end() pair
+ */
+const hpm_sample_t *hpm_overhead(void);
+
+/* =============================================================================
+ * Sampling
+ * ============================================================================= */
+
+static inline uint64_t hpm_read_cycle(void)
+{
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+    return read_csr(cycle);
+#else
+    return read_csr(mcycle);
+#endif
+}
+
+static inline uint64_t hpm_read_instret(void)
+{
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+    return read_csr(instret);
+#else
+    return read_csr(minstret);
+#endif
+}
+
+static inline void hpm_read_events(uint64_t *events)
+{
+    /* Constant bound: the loop unrolls and each switch folds to one csrr */
+    for (unsigned i = 0; i < HPM_MAX_EVENTS; i++) {
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+        events[i] = 0;
+#else
+        events[i] = csr_read_mhpmcounter(CSR_HPM_FIRST + i);
+#endif
+    }
+}
+
+/**
+ * @brief Start a measurement
+ *
+ * Events are read first and mcycle last, so the cycle window is the
+ * innermost one.
+ */
+static inline void hpm_begin(hpm_sample_t *start)
+{
+    hpm_read_events(start->events);
+    start->instret = hpm_read_instret();
+    start->cycles = hpm_read_cycle();
+}
+
+/**
+ * @brief Subtract start and the calibrated overhead from end (clamped at 0)
+ */
+void hpm_delta(const hpm_sample_t *start, const hpm_sample_t *end, hpm_sample_t *delta);
+
+/**
+ * @brief Finish a measurement started with hpm_begin()
+ * @param start Sample from hpm_begin()
+ * @param delta Region counts with the sampling overhead removed
+ */
+static inline void hpm_end(const hpm_sample_t *start, hpm_sample_t *delta)
+{
+    hpm_sample_t end;
+
+    end.cycles = hpm_read_cycle();
+    end.instret = hpm_read_instret();
+    hpm_read_events(end.events);
+    hpm_delta(start, &end, delta);
+}
+
+/* =============================================================================
+ * Reporting
+ * ============================================================================= */
+
+/**
+ * @brief Print one "[HPM] <name> n=... cycles=... IPC=... <event>=..." line
+ *
+ * IPC, cycles per element and events per element (in parentheses) are
+ * printed with two decimals. elements may be 0 to omit the per-element
+ * figures.
+ */
+void hpm_report(const char *name, const hpm_sample_t *delta, size_t elements);
+
+#endif /* HPM_H */
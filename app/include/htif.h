@@ -3,7 +3,10 @@
  * @brief HTIF (Host-Target Interface) driver for Spike
  *
  * HTIF is Spike's I/O mechanism using tohost/fromhost registers.
- * This provides basic console output for Spike simulator.
+ * This provides console output for the Spike simulator. Output is
+ * buffered per hart and flushed on newline, when the buffer is full, or
+ * by htif_flush(); with HTIF_BATCHED_WRITE each flush is a single host
+ * write syscall.
  */
 
 #ifndef HTIF_H
@@ -35,6 +38,13 @@ void htif_puts(const char *s);
  */
 void htif_write(const char *buf, size_t len);
 
+/**
+ * @brief Send all buffered console output to the host
+ *
+ * Called by htif_poweroff() before exiting.
+ */
+void htif_flush(void);
+
 /**
  * @brief Shutdown simulator via HTIF
  * @param exit_code Exit code (0 = success)
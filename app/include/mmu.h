@@ -0,0 +1,113 @@
+/**
+ * @file mmu.h
+ * @brief Sv39 identity mapping of RAM with 4 KiB, 2 MiB or 1 GiB pages (ENABLE_MMU)
+ *
+ * Runs the benchmarks under virtual memory to see what translation costs
+ * them. Hart 0 builds one set of Sv39 page tables at boot (mmu_init(),
+ * from platform_init()): RAM_BASE..RAM_BASE + RAM_SIZE mapped VA == PA
+ * with leaves of the CMake MMU_PAGE_SIZE (4K, 2M or 1G), and the device
+ * space below RAM_BASE as two 1 GiB gigapages. Every hart then points
+ * satp at them (mmu_enable_hart(); secondaries from smp_secondary_entry()).
+ *
+ * The code stays in machine mode, so mtvec, mcycle, the HPM counters and
+ * the CLINT keep working: mstatus.MPRV = 1 with MPP = S makes every load,
+ * store, AMO and vector memory access an S-mode access translated through
+ * satp, with the TLB and the page walker of the hart in the loop.
+ * Instruction fetch stays physical (MPRV does not apply to it), which
+ * leaves the instruction TLB out; the kernels' code is a few pages.
+ *
+ * Traps: trap entry sets MPP = M, so the handler runs untranslated, and
+ * mret leaves MPP = U, so after the first trap accesses are translated as
+ * U-mode ones. The leaves are therefore U pages and mstatus.SUM is set,
+ * which makes the two privileges see the same mapping. PMP entry 0 grants
+ * S/U-mode access to all of memory (reset PMP denies it).
+ *
+ * Page table memory is static: the root and (2M/4K) one 4 KiB L1 table,
+ * plus for 4K pages one L0 table per 2 MiB of RAM (RAM_SIZE / 512 bytes;
+ * 256 KiB for 128 MiB), all in .bss.
+ *
+ * On gem5, per-region data TLB misses come from the stats dumps:
+ *   parse-gem5-stats.py --roi --roi-log gem5.log m5out/stats.txt
+ * Without ENABLE_MMU every call compiles to nothing. Not available in
+ * gem5 SE mode (no machine mode; gem5 runs the process on its own page
+ * tables).
+ */
+
+#ifndef MMU_H
+#define MMU_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Sv39 Definitions
+ * ============================================================================= */
+
+#define SATP_MODE_SV39 (8UL << 60)
+
+/** mstatus.MPP = S: with MPRV, loads and stores use S-mode translation */
+#define MSTATUS_MPP_S (1UL << 11)
+
+#define PTE_V (1UL << 0) /* Valid */
+#define PTE_R (1UL << 1) /* Readable */
+#define PTE_W (1UL << 2) /* Writable */
+#define PTE_X (1UL << 3) /* Executable */
+#define PTE_U (1UL << 4) /* User (see Traps above) */
+#define PTE_G (1UL << 5) /* Global */
+#define PTE_A (1UL << 6) /* Accessed (preset: no A/D update faults or walker writes) */
+#define PTE_D (1UL << 7) /* Dirty */
+#define PTE_PPN_SHIFT 10
+
+#define MMU_PT_ENTRIES 512
+#define MMU_PAGE_4K (1UL << 12)
+#define MMU_PAGE_2M (1UL << 21)
+#define MMU_PAGE_1G (1UL << 30)
+
+/** Leaf size for RAM (CMake MMU_PAGE_SIZE) */
+#if defined(MMU_PAGE_SIZE_1G)
+#define MMU_PAGE_SIZE MMU_PAGE_1G
+#define MMU_PAGE_NAME "1 GiB"
+#elif defined(MMU_PAGE_SIZE_2M)
+#define MMU_PAGE_SIZE MMU_PAGE_2M
+#define MMU_PAGE_NAME "2 MiB"
+#else
+#define MMU_PAGE_SIZE MMU_PAGE_4K
+#define MMU_PAGE_NAME "4 KiB"
+#endif
+
+/** PMP: entry 0 NAPOT over the whole address space, RWX */
+#define PMP_R 0x01
+#define PMP_W 0x02
+#define PMP_X 0x04
+#define PMP_NAPOT 0x18
+
+/* =============================================================================
+ * API
+ * ============================================================================= */
+
+#if defined(ENABLE_MMU)
+
+/**
+ * @brief Build the page tables and enable translation on the calling hart (hart 0)
+ *
+ * Call once, before any secondary hart is released.
+ */
+void mmu_init(void);
+
+/**
+ * @brief Enable translation on the calling hart: PMP, satp, sfence.vma, MPRV
+ */
+void mmu_enable_hart(void);
+
+/** Print the mapping ("[MMU] ..." line) */
+void mmu_report(void);
+
+#else
+
+static inline void mmu_init(void) {}
+static inline void mmu_enable_hart(void) {}
+static inline void mmu_report(void) {}
+
+#endif /* ENABLE_MMU */
+
+#endif /* MMU_H */
@@ -0,0 +1,210 @@
+/**
+ * @file msgq.h
+ * @brief Bounded lock-free inter-hart message queues with IPI doorbells
+ *
+ * Two ring queues of 64-bit messages (a value or a pointer into shared
+ * memory), for producer/consumer pipelines between harts:
+ *
+ *   - spsc_queue_t: one producer hart, one consumer hart. Plain loads and
+ *     stores plus acquire/release fences; each side keeps a cached copy
+ *     of the other side's index, so the shared lines move only when the
+ *     cached view says full (or empty).
+ *   - mpmc_queue_t: any number of producers and consumers (Vyukov's
+ *     bounded queue). Every cell carries a sequence number; producers and
+ *     consumers claim positions with an LR/SC CAS on their index.
+ *
+ * The head (consumer) index, the tail (producer) index and the doorbell
+ * each sit on their own cache line, away from the read-only ring
+ * descriptor, so producers and consumers only share the slots they hand
+ * over.
+ *
+ * Doorbells: spsc_pop_wait() / mpmc_pop_wait() sleep in wfi while the
+ * queue is empty. The consumer sets its bit in the queue's sleeper mask
+ * and re-checks the queue before wfi; a successful push fences, reads the
+ * mask and, if a consumer is asleep, claims its bit and writes that
+ * hart's CLINT MSIP (smp_send_ipi()). mstatus.MIE is held clear around
+ * the sleep, as in sched_park(), so the wakeup is never consumed by a
+ * trap. gem5 SE mode has no CLINT: the waits spin instead.
+ *
+ * Capacities are powers of two; the caller provides the slot storage
+ * (static or from an alloc.h arena, ideally line aligned). Indices are
+ * free-running 32-bit counters, so a queue holds at most 2^31 messages.
+ * Hart IDs must be below 32 (one sleeper bit each).
+ */
+
+#ifndef MSGQ_H
+#define MSGQ_H
+
+#include "atomic.h"
+#include "platform.h"
+#include "smp.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Doorbell
+ * ============================================================================= */
+
+/** Bitmask of consumer harts asleep (or about to sleep) on a queue */
+typedef struct {
+    volatile uint32_t sleepers;
+} __attribute__((aligned(SMP_CACHE_LINE))) msgq_bell_t;
+
+/** Claim one sleeping consumer's bit and send it an IPI */
+void msgq_bell_wake(msgq_bell_t *bell);
+
+/** After publishing a message: wake a sleeping consumer, if any */
+static inline void msgq_bell_ring(msgq_bell_t *bell)
+{
+    mb(); /* Message published before reading the sleeper mask */
+    if (bell->sleepers != 0) {
+        msgq_bell_wake(bell);
+    }
+}
+
+/* =============================================================================
+ * SPSC Queue
+ * ============================================================================= */
+
+typedef struct {
+    /* Producer line */
+    struct {
+        volatile uint32_t tail; /* Next position to write */
+        uint32_t head_cache;    /* Producer's last view of head */
+    } __attribute__((aligned(SMP_CACHE_LINE))) prod;
+
+    /* Consumer line */
+    struct {
+        volatile uint32_t head; /* Next position to read */
+        uint32_t tail_cache;    /* Consumer's last view of tail */
+    } __attribute__((aligned(SMP_CACHE_LINE))) cons;
+
+    msgq_bell_t bell;
+
+    /* Read-only after spsc_init() */
+    struct {
+        uint64_t *slots;
+        uint32_t mask; /* capacity - 1 */
+    } __attribute__((aligned(SMP_CACHE_LINE))) ring;
+} spsc_queue_t;
+
+/**
+ * @brief Initialize an empty SPSC queue over caller-provided slots
+ *
+ * @param q Queue
+ * @param slots Storage for capacity messages
+ * @param capacity Power of two, at least 2
+ * @return false if capacity is not a power of two >= 2
+ */
+bool spsc_init(spsc_queue_t *q, uint64_t *slots, uint32_t capacity);
+
+/**
+ * @brief Append a message (producer hart only)
+ * @return false if the queue is full
+ */
+static inline bool spsc_push(spsc_queue_t *q, uint64_t msg)
+{
+    uint32_t tail = q->prod.tail;
+
+    if (tail - q->prod.head_cache > q->ring.mask) {
+        q->prod.head_cache = atomic_load_u32(&q->cons.head); /* Slot reads done */
+        if (tail - q->prod.head_cache > q->ring.mask) {
+            return false;
+        }
+    }
+    q->ring.slots[tail & q->ring.mask] = msg;
+    atomic_store_u32(&q->prod.tail, tail + 1); /* Release the slot */
+    msgq_bell_ring(&q->bell);
+    return true;
+}
+
+/**
+ * @brief Take the oldest message (consumer hart only)
+ * @return false if the queue is empty
+ */
+static inline bool spsc_pop(spsc_queue_t *q, uint64_t *msg)
+{
+    uint32_t head = q->cons.head;
+
+    if (head == q->cons.tail_cache) {
+        q->cons.tail_cache = atomic_load_u32(&q->prod.tail); /* Acquire the slots */
+        if (head == q->cons.tail_cache) {
+            return false;
+        }
+    }
+    *msg = q->ring.slots[head & q->ring.mask];
+    atomic_store_u32(&q->cons.head, head + 1); /* Slot free once read */
+    return true;
+}
+
+/** Messages in the queue (exact only on the producer or consumer hart) */
+static inline uint32_t spsc_count(const spsc_queue_t *q)
+{
+    return q->prod.tail - q->cons.head;
+}
+
+/** Push, spinning while the queue is full (producer hart only) */
+void spsc_push_wait(spsc_queue_t *q, uint64_t msg);
+
+/** Pop, sleeping in wfi until the producer rings (consumer hart only) */
+uint64_t spsc_pop_wait(spsc_queue_t *q);
+
+/* =============================================================================
+ * MPMC Queue
+ * ============================================================================= */
+
+/** One ring cell: seq == position when free, position + 1 when full */
+typedef struct {
+    volatile uint32_t seq;
+    uint32_t pad;
+    uint64_t msg;
+} mpmc_cell_t;
+
+typedef struct {
+    struct {
+        volatile uint32_t pos; /* Next position to claim for writing */
+    } __attribute__((aligned(SMP_CACHE_LINE))) enq;
+
+    struct {
+        volatile uint32_t pos; /* Next position to claim for reading */
+    } __attribute__((aligned(SMP_CACHE_LINE))) deq;
+
+    msgq_bell_t bell;
+
+    /* Read-only after mpmc_init() */
+    struct {
+        mpmc_cell_t *cells;
+        uint32_t mask;
+    } __attribute__((aligned(SMP_CACHE_LINE))) ring;
+} mpmc_queue_t;
+
+/**
+ * @brief Initialize an empty MPMC queue over caller-provided cells
+ *
+ * @param q Queue
+ * @param cells Storage for capacity cells
+ * @param capacity Power of two, at least 2
+ * @return false if capacity is not a power of two >= 2
+ */
+bool mpmc_init(mpmc_queue_t *q, mpmc_cell_t *cells, uint32_t capacity);
+
+/**
+ * @brief Append a message (any hart)
+ * @return false if the queue is full
+ */
+bool mpmc_push(mpmc_queue_t *q, uint64_t msg);
+
+/**
+ * @brief Take the oldest message (any hart)
+ * @return false if the queue is empty
+ */
+bool mpmc_pop(mpmc_queue_t *q, uint64_t *msg);
+
+/** Push, spinning while the queue is full */
+void mpmc_push_wait(mpmc_queue_t *q, uint64_t msg);
+
+/** Pop, sleeping in wfi until a producer rings */
+uint64_t mpmc_pop_wait(mpmc_queue_t *q);
+
+#endif /* MSGQ_H */
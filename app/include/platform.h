@@ -73,21 +73,32 @@
  * gem5 recognizes special instruction encodings as "m5ops" which control
  * the simulator (exit, dump stats, reset stats, etc.).
  *
- * For RISC-V, m5ops use a custom instruction encoding format:
- *   .insn r CUSTOM_0, func3, func7, rd, rs1, rs2
+ * For RISC-V, m5ops use the CUSTOM_3 opcode with the m5op number in
+ * funct7 and all register fields zero (as in gem5's util/m5 m5op.S);
+ * arguments are passed in a0/a1 per the calling convention:
+ *   .insn r CUSTOM_3, 0, func7, zero, zero, zero
  *
- * CUSTOM_0 opcode = 0x0b (bits [6:0])
+ * CUSTOM_3 opcode = 0x7b (bits [6:0])
  * func3 = 0x0
  * func7 encodes the m5op type:
  *   0x21 = m5_exit
- *   0x31 = m5_dump_stats
- *   0x32 = m5_reset_stats
+ *   0x40 = m5_reset_stats
+ *   0x41 = m5_dump_stats
+ *   0x43 = m5_checkpoint
+ *   0x52 = m5_switch_cpu
+ *   0x5a = m5_work_begin
+ *   0x5b = m5_work_end
  */
 
-/* m5op function codes (func7 field) */
+/* m5op opcode and function codes (func7 field) */
+#define M5OP_OPCODE 0x7b
 #define M5OP_EXIT 0x21
-#define M5OP_DUMP_STATS 0x31
-#define M5OP_RESET_STATS 0x32
+#define M5OP_RESET_STATS 0x40
+#define M5OP_DUMP_STATS 0x41
+#define M5OP_CHECKPOINT 0x43
+#define M5OP_SWITCH_CPU 0x52
+#define M5OP_WORK_BEGIN 0x5a
+#define M5OP_WORK_END 0x5b
 
 /**
  * @brief Trigger gem5 simulation exit via m5ops pseudo-instruction
@@ -96,8 +107,7 @@
 static inline void gem5_m5_exit(uint64_t delay)
 {
     register uint64_t a0 __asm__("a0") = delay;
-    register uint64_t a1 __asm__("a1") = 0;
-    __asm__ __volatile__(".insn r 0x0b, 0x0, 0x21, zero, %0, %1" : : "r"(a0), "r"(a1) : "memory");
+    __asm__ __volatile__(".insn r 0x7b, 0x0, 0x21, zero, zero, zero" : : "r"(a0) : "memory");
 }
 
 /**
@@ -109,7 +119,10 @@ static inline void gem5_m5_dump_stats(uint64_t delay, uint64_t period)
 {
     register uint64_t a0 __asm__("a0") = delay;
     register uint64_t a1 __asm__("a1") = period;
-    __asm__ __volatile__(".insn r 0x0b, 0x0, 0x31, zero, %0, %1" : : "r"(a0), "r"(a1) : "memory");
+    __asm__ __volatile__(".insn r 0x7b, 0x0, 0x41, zero, zero, zero"
+                         :
+                         : "r"(a0), "r"(a1)
+                         : "memory");
 }
 
 /**
@@ -121,7 +134,67 @@ static inline void gem5_m5_reset_stats(uint64_t delay, uint64_t period)
 {
     register uint64_t a0 __asm__("a0") = delay;
     register uint64_t a1 __asm__("a1") = period;
-    __asm__ __volatile__(".insn r 0x0b, 0x0, 0x32, zero, %0, %1" : : "r"(a0), "r"(a1) : "memory");
+    __asm__ __volatile__(".insn r 0x7b, 0x0, 0x40, zero, zero, zero"
+                         :
+                         : "r"(a0), "r"(a1)
+                         : "memory");
+}
+
+/**
+ * @brief Ask gem5 for a checkpoint (exit event "checkpoint")
+ * @param delay Delay (in ticks) before the checkpoint; 0 = immediate
+ * @param period Period (in ticks) for repeated checkpoints; 0 = once
+ */
+static inline void gem5_m5_checkpoint(uint64_t delay, uint64_t period)
+{
+    register uint64_t a0 __asm__("a0") = delay;
+    register uint64_t a1 __asm__("a1") = period;
+    __asm__ __volatile__(".insn r 0x7b, 0x0, 0x43, zero, zero, zero"
+                         :
+                         : "r"(a0), "r"(a1)
+                         : "memory");
+}
+
+/**
+ * @brief Ask gem5 to switch CPU models (exit event "switchcpu")
+ *
+ * The simulation script decides what happens; the configs in
+ * platforms/gem5/configs switch from the fast-forward CPU to the
+ * detailed one (--fast-forward) and otherwise carry on.
+ */
+static inline void gem5_m5_switch_cpu(void)
+{
+    __asm__ __volatile__(".insn r 0x7b, 0x0, 0x52, zero, zero, zero" : : : "memory");
+}
+
+/**
+ * @brief Mark the start of a gem5 work item (per-work-item stats)
+ * @param workid Work item ID
+ * @param threadid Thread (hart) ID
+ */
+static inline void gem5_m5_work_begin(uint64_t workid, uint64_t threadid)
+{
+    register uint64_t a0 __asm__("a0") = workid;
+    register uint64_t a1 __asm__("a1") = threadid;
+    __asm__ __volatile__(".insn r 0x7b, 0x0, 0x5a, zero, zero, zero"
+                         :
+                         : "r"(a0), "r"(a1)
+                         : "memory");
+}
+
+/**
+ * @brief Mark the end of a gem5 work item
+ * @param workid Work item ID
+ * @param threadid Thread (hart) ID
+ */
+static inline void gem5_m5_work_end(uint64_t workid, uint64_t threadid)
+{
+    register uint64_t a0 __asm__("a0") = workid;
+    register uint64_t a1 __asm__("a1") = threadid;
+    __asm__ __volatile__(".insn r 0x7b, 0x0, 0x5b, zero, zero, zero"
+                         :
+                         : "r"(a0), "r"(a1)
+                         : "memory");
 }
 
 #endif /* PLATFORM_GEM5 */
@@ -132,6 +205,11 @@ static inline void gem5_m5_reset_stats(uint64_t delay, uint64_t period)
 #define CLINT_MTIMECMP (CLINT_BASE + 0x4000) /* Machine Time Compare */
 #define CLINT_MTIME (CLINT_BASE + 0xBFF8)    /* Machine Time */
 
+/** CLINT mtime tick rate (QEMU virt and Spike: 10 MHz) */
+#ifndef CLINT_TIMEBASE_HZ
+#define CLINT_TIMEBASE_HZ 10000000UL
+#endif
+
 /* PLIC (Platform-Level Interrupt Controller) */
 #define PLIC_BASE 0x0C000000UL
 
@@ -174,6 +252,34 @@ void platform_exit(int exit_code);
  */
 const char *platform_get_name(void);
 
+/* =============================================================================
+ * Boot Timing
+ * ============================================================================= */
+
+/*
+ * mcycle stamps taken by hart 0 in startup.S (the user-level cycle CSR in
+ * gem5 SE mode, where reset is the start of the process). startup.S stores
+ * them at fixed offsets: keep the indices in sync.
+ */
+#define BOOT_STAMP_START 0 /* _start entered: cycles since reset */
+#define BOOT_STAMP_BSS 1   /* BSS cleared by every hart (boot barrier passed) */
+#define BOOT_STAMP_MAIN 2  /* platform_init() returned, entering main() */
+#define BOOT_STAMP_COUNT 3
+
+extern uint64_t platform_boot_cycles[BOOT_STAMP_COUNT];
+
+/** 1 if hart 0 cleared its BSS slice with rvv_memset, 0 for the sd loop (startup.S) */
+extern uint32_t platform_boot_bss_rvv;
+
+/**
+ * @brief Print the reset-to-main() cycle breakdown ("[BOOT] ..." line)
+ *
+ * Stages: reset to _start (boot ROM / simulator reset vector), BSS clear
+ * (split across NUM_HARTS harts, with the method hart 0 actually used), and
+ * platform_init() (console, FPU/vector enable, heap).
+ */
+void platform_boot_report(void);
+
 /* =============================================================================
  * Utility Macros
  * ============================================================================= */
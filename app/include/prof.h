@@ -0,0 +1,86 @@
+/**
+ * @file prof.h
+ * @brief PC-sampling profiler on the machine timer interrupt (ENABLE_PROFILER)
+ *
+ * Each profiled hart programs its CLINT mtimecmp to fire every
+ * PROF_PERIOD_US microseconds of mtime. The timer handler (trap.h) adds
+ * the interrupted PC, mepc, to the hart's histogram and re-arms. At exit,
+ * platform_exit() stops sampling and prof_dump() prints the histograms:
+ *
+ *   [PROF] hart=<h> pc=0x<addr> samples=<n>     one line per distinct PC
+ *   [PROF] hart=<h> samples=<n> pcs=<n> dropped=<n>
+ *
+ * scripts/prof-symbolize.py turns a saved console log into a flat profile
+ * per function and object file using the build's app.dump and app.map:
+ *
+ *   prof-symbolize.py --log run.log --dump build/app/app.dump --map build/app/app.map
+ *
+ * Hart 0 starts sampling at the top of main() and every secondary when it
+ * is released (smp_secondary_entry()). Samples are taken where interrupts
+ * are enabled: time spent with mstatus.MIE clear (trap entry, the wfi
+ * window in sched_park()) is charged to the instruction that re-enables
+ * them. mtime is wall-clock time on QEMU and follows retired instructions
+ * on Spike, so the profile is of host time and instructions respectively.
+ * The handler itself costs a few dozen instructions per sample, which
+ * also shows up in cycle counts measured while profiling.
+ *
+ * Without ENABLE_PROFILER every call compiles to nothing. Not available
+ * in gem5 SE mode (no machine mode, no CLINT).
+ */
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Sample period in microseconds of mtime (CMake PROF_PERIOD_US) */
+#ifndef PROF_PERIOD_US
+#define PROF_PERIOD_US 100
+#endif
+
+/** Distinct PCs remembered per hart (power of two); further PCs are counted as dropped */
+#ifndef PROF_SLOTS
+#define PROF_SLOTS 512
+#endif
+
+/** Linear-probe limit before a sample is dropped */
+#define PROF_MAX_PROBES 16
+
+/* =============================================================================
+ * API
+ * ============================================================================= */
+
+#if defined(ENABLE_PROFILER)
+
+/**
+ * @brief Start sampling on the calling hart
+ *
+ * Installs the timer handler, arms the hart's mtimecmp and enables
+ * mie.MTIE and mstatus.MIE. Does nothing once prof_stop() was called.
+ */
+void prof_start(void);
+
+/**
+ * @brief Stop sampling on every hart
+ *
+ * The calling hart disarms its timer at once; the others disarm on their
+ * next tick without recording it.
+ */
+void prof_stop(void);
+
+/** Print every hart's histogram ("[PROF] ..." lines); call after prof_stop() */
+void prof_dump(void);
+
+#else
+
+static inline void prof_start(void) {}
+static inline void prof_stop(void) {}
+static inline void prof_dump(void) {}
+
+#endif /* ENABLE_PROFILER */
+
+#endif /* PROF_H */
@@ -0,0 +1,134 @@
+/**
+ * @file roi.h
+ * @brief Region-of-interest (ROI) brackets for benchmark kernels
+ *
+ * roi_begin()/roi_end() bracket one kernel run. On gem5 (SE and FS) the
+ * bracket resets the simulator statistics at begin and dumps them at end,
+ * so stats.txt holds one dump per region followed by the final dump at
+ * exit; each region is also a gem5 work item. On every platform the
+ * region's length is measured with the cycle counter, which is all the
+ * bracket costs outside gem5.
+ *
+ * Regions are numbered in the order they begin. roi_report() prints one
+ * "[ROI] <index> <name> cycles=<n>" line per region; pass that output to
+ * scripts/parse-gem5-stats.py --roi-log to name the dumps:
+ *
+ *   parse-gem5-stats.py --roi --roi-log gem5.log m5out/stats.txt
+ *
+ * Regions do not nest and are opened from hart 0 only. Do not print
+ * inside a region: console output would land in the kernel's stats.
+ *
+ * Fast-forward mark (gem5): the first roi_begin() also issues the m5op
+ * selected by CMake GEM5_ROI_MARK, switchcpu (default) or checkpoint,
+ * before resetting the stats. se_config.py/fs_config.py run boot, BSS
+ * clearing and set-up on AtomicSimpleCPU up to that point and switch to
+ * the detailed --cpu-type there (--fast-forward), or write a checkpoint
+ * (--checkpoint-dir) that --restore-from resumes in the detailed CPU.
+ */
+
+#ifndef ROI_H
+#define ROI_H
+
+#include "platform.h"
+
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Regions remembered for roi_report(); later regions are timed but not listed */
+#ifndef ROI_MAX_REGIONS
+#define ROI_MAX_REGIONS 256
+#endif
+
+/* =============================================================================
+ * Internal State
+ * ============================================================================= */
+
+/** Cycle counter at the start of the open region */
+extern uint64_t roi_start_cycle;
+
+/** Record the name of a region about to open; returns its index */
+uint32_t roi_open(const char *name);
+
+/** Record the cycles of the region that just closed */
+void roi_close(uint64_t cycles);
+
+/** Number of regions opened so far */
+uint32_t roi_count(void);
+
+static inline uint64_t roi_read_cycle(void)
+{
+    uint64_t cycles;
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+    /* gem5 SE runs in U-mode: use the user-level cycle CSR */
+    __asm__ __volatile__("csrr %0, cycle" : "=r"(cycles));
+#else
+    __asm__ __volatile__("csrr %0, mcycle" : "=r"(cycles));
+#endif
+    return cycles;
+}
+
+/** End of the fast-forward phase: the first region is about to open */
+static inline void roi_fast_forward_mark(void)
+{
+#if defined(GEM5_ROI_MARK_CHECKPOINT)
+    gem5_m5_checkpoint(0, 0);
+#elif defined(GEM5_ROI_MARK_SWITCH_CPU)
+    gem5_m5_switch_cpu();
+#endif
+}
+
+/* =============================================================================
+ * Region API
+ * ============================================================================= */
+
+/**
+ * @brief Open a region: reset gem5 stats, start the cycle count
+ * @param name Region name (string literal; kept for roi_report())
+ */
+static inline void roi_begin(const char *name)
+{
+    uint32_t index = roi_open(name);
+
+#if defined(PLATFORM_GEM5)
+    if (index == 0) {
+        roi_fast_forward_mark();
+    }
+    gem5_m5_work_begin(index, 0);
+    gem5_m5_reset_stats(0, 0);
+#else
+    (void) index;
+#endif
+
+    roi_start_cycle = roi_read_cycle();
+}
+
+/**
+ * @brief Close the open region: stop the cycle count, dump gem5 stats
+ * @return Cycles spent in the region
+ */
+static inline uint64_t roi_end(void)
+{
+    uint64_t cycles = roi_read_cycle() - roi_start_cycle;
+
+#if defined(PLATFORM_GEM5)
+    gem5_m5_dump_stats(0, 0);
+    gem5_m5_work_end(roi_count() - 1, 0);
+#endif
+
+    roi_close(cycles);
+    return cycles;
+}
+
+/* =============================================================================
+ * Reporting
+ * ============================================================================= */
+
+/**
+ * @brief Print "[ROI] <index> <name> cycles=<n>" for every region
+ */
+void roi_report(void);
+
+#endif /* ROI_H */
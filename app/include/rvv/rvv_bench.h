@@ -0,0 +1,124 @@
+/**
+ * @file rvv_bench.h
+ * @brief Table-driven RVV micro-benchmark runner
+ *
+ * Each registered benchmark pairs a scalar reference with an RVV kernel
+ * and a list of problem sizes. For every size the runner:
+ *   1. fills the inputs and runs both kernels once to check the result
+ *   2. runs each kernel RVV_BENCH_WARMUP times untimed (I-cache, TLB and
+ *      branch predictor warm-up)
+ *   3. times RVV_BENCH_REPS runs and reduces them to min/median/max/
+ *      mean/stddev cycles plus the median retired instruction count
+ *
+ * Results are emitted as one machine-readable console line per kernel,
+ * implementation and size, so CI can grep them out of the simulator log:
+ *
+ *   [BENCH-CSV] platform,vlen,kernel,impl,n,reps,min,median,max,mean,stddev,instret,passed,backend
+ *   [BENCH-JSON] {"platform":"qemu","vlen":128,"kernel":"saxpy","impl":"rvv",...}
+ *
+ * backend is RVV_BACKEND_NAME ("asm" or "intrinsics"), so runs of the two
+ * kernel backends can be told apart and compared line by line.
+ *
+ * The CSV header is printed once by rvv_bench_run_all(). Select the
+ * formats with RVV_BENCH_FORMAT_CSV and/or RVV_BENCH_FORMAT_JSON (CMake
+ * -DRVV_BENCH_FORMAT=csv|json|both); with neither defined both are used.
+ */
+
+#ifndef RVV_BENCH_H
+#define RVV_BENCH_H
+
+#include "rvv/rvv_common.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Untimed runs before measuring */
+#ifndef RVV_BENCH_WARMUP
+#define RVV_BENCH_WARMUP 2
+#endif
+
+/** Timed runs per kernel and size */
+#ifndef RVV_BENCH_REPS
+#define RVV_BENCH_REPS 7
+#endif
+
+#if RVV_BENCH_REPS < 1 || RVV_BENCH_REPS > 64
+#error "RVV_BENCH_REPS must be 1..64"
+#endif
+
+#if !defined(RVV_BENCH_FORMAT_CSV) && !defined(RVV_BENCH_FORMAT_JSON)
+#define RVV_BENCH_FORMAT_CSV
+#define RVV_BENCH_FORMAT_JSON
+#endif
+
+/** Largest element count in the size sweep (buffers are sized for it) */
+#ifdef RVV_BENCH_SWEEP
+#define RVV_BENCH_MAX_LEN (64 * 1024)
+#else
+#define RVV_BENCH_MAX_LEN 4096
+#endif
+
+/* =============================================================================
+ * Benchmark Registry
+ * ============================================================================= */
+
+/**
+ * @brief One registered benchmark
+ *
+ * scalar() writes the reference outputs and vector() the RVV outputs, so
+ * check() can compare them after one run of each. n is the problem size
+ * in the benchmark's own unit (elements, or the matrix dimension).
+ */
+typedef struct {
+    const char *name;         /**< Kernel name in the output lines */
+    void (*setup)(size_t n);  /**< Fill inputs and reset outputs */
+    void (*scalar)(size_t n); /**< Scalar reference (NULL: vector only) */
+    void (*vector)(size_t n); /**< RVV kernel */
+    bool (*check)(size_t n);  /**< Compare outputs (NULL: not checked) */
+    const size_t *sizes;      /**< Problem sizes to sweep */
+    size_t num_sizes;         /**< Entries in sizes */
+} rvv_bench_case_t;
+
+/**
+ * @brief Built-in benchmark table
+ * @param count Receives the number of entries
+ */
+const rvv_bench_case_t *rvv_bench_registry(size_t *count);
+
+/* =============================================================================
+ * Measurement
+ * ============================================================================= */
+
+/**
+ * @brief Time fn(n): warm-up runs, then RVV_BENCH_REPS timed runs
+ * @param stats Receives the cycle statistics
+ * @param instret Receives the median retired instructions (may be NULL)
+ */
+void rvv_bench_measure(void (*fn)(size_t n), size_t n, rvv_bench_stats_t *stats,
+                       uint64_t *instret);
+
+/**
+ * @brief Check and time one benchmark at one size
+ *
+ * Fills result->scalar/vector with the statistics and scalar_cycles/
+ * vector_cycles with the medians.
+ */
+void rvv_bench_run(const rvv_bench_case_t *bench, size_t n, rvv_bench_result_t *result);
+
+/**
+ * @brief Emit the CSV/JSON lines for one result (one per implementation)
+ */
+void rvv_bench_emit(const rvv_bench_result_t *result);
+
+/**
+ * @brief Run every registered benchmark at every size and emit the results
+ * @return Number of (benchmark, size) pairs whose check failed
+ */
+uint32_t rvv_bench_run_all(void);
+
+#endif /* RVV_BENCH_H */
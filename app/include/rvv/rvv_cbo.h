@@ -0,0 +1,149 @@
+/**
+ * @file rvv_cbo.h
+ * @brief Cache-block managed streaming kernels (Zicbop prefetch, Zicboz cbo.zero)
+ *
+ * The plain streaming kernels are demand-fetched: every input line
+ * misses when the loop reaches it, and every output line is first read
+ * for ownership and then overwritten. The *_cbo variants here run the
+ * same dispatched kernel (rvv_dispatch.h) over RVV_CBO_CHUNK_BYTES of
+ * output at a time and, around each chunk:
+ *
+ *   - prefetch.r the inputs rvv_cbo.prefetch_dist bytes ahead of the
+ *     chunk (prefetch.w for an output that is also read, SAXPY's y)
+ *   - cbo.zero every cache block of the chunk's output that the kernel
+ *     will overwrite completely, so the line is allocated without a
+ *     memory read (rvv_cbo.zero_dst; partial head/tail blocks are left
+ *     to the demand path)
+ *
+ * Chunks start on output cache-block boundaries, so a block is never
+ * zeroed after part of it was written. Zeroing is skipped when the
+ * output overlaps an input.
+ *
+ * Both instructions are emitted as raw encodings, like the ntl.all hint
+ * in vec_memcpy.c, so the toolchain needs no Zicbop/Zicboz support.
+ * prefetch.* are HINTs (ori x0, rs1, imm) and execute as no-ops on
+ * harts without Zicbop. cbo.zero traps on harts without Zicboz, so
+ * neither extension can be probed safely: they are build-time choices
+ * (CMake RVV_ZICBOP / RVV_ZICBOZ, rvv_get_extensions()) and the
+ * simulators are started with them. The block size is measured with one
+ * cbo.zero before the first zeroing (rvv_get_cbo_block_size()).
+ */
+
+#ifndef RVV_CBO_H
+#define RVV_CBO_H
+
+#include "rvv/rvv_common.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Cache-block size without Zicboz, or when the Zicboz probe fails */
+#ifndef RVV_CBO_BLOCK_BYTES
+#define RVV_CBO_BLOCK_BYTES 64
+#endif
+
+/** Largest cache-block size rvv_get_cbo_block_size() can measure */
+#define RVV_CBO_BLOCK_MAX 512
+
+/** Default prefetch distance in bytes (CMake RVV_CBO_PREFETCH_DIST) */
+#ifndef RVV_CBO_PREFETCH_DIST
+#define RVV_CBO_PREFETCH_DIST 1024
+#endif
+
+/** Output bytes per kernel call; a power of two (raised to the block size if smaller) */
+#define RVV_CBO_CHUNK_BYTES 1024
+
+/** Elements per array in the cache-block streaming benchmark (L2 is 256 KiB on gem5) */
+#ifdef RVV_BENCH_SWEEP
+#define RVV_CBO_BENCH_LEN (1024 * 1024)
+#else
+#define RVV_CBO_BENCH_LEN (64 * 1024)
+#endif
+
+/**
+ * @brief Cache-management settings of the *_cbo kernels
+ *
+ * Read on every call; change the fields between calls to tune the
+ * prefetch distance or compare with and without zeroing.
+ */
+typedef struct {
+    size_t block;         /**< Cache-block size in bytes (power of two); 0 until measured */
+    size_t prefetch_dist; /**< Bytes ahead of each input to prefetch; 0 disables */
+    bool zero_dst;        /**< cbo.zero output blocks the kernel overwrites (Zicboz) */
+} rvv_cbo_config_t;
+
+/**
+ * Current settings. Defaults come from the build: prefetching at
+ * RVV_CBO_PREFETCH_DIST with RVV_HAVE_ZICBOP, zeroing with RVV_HAVE_ZICBOZ;
+ * the block size is measured on first use.
+ */
+extern rvv_cbo_config_t rvv_cbo;
+
+/* =============================================================================
+ * Cache-Block Instructions
+ * ============================================================================= */
+
+/** prefetch.r 0(p): the block holding p will be read (ori x0, p, 1) */
+static inline void rvv_prefetch_r(const void *p)
+{
+    __asm__ __volatile__("ori     x0, %0, 1" : : "r"(p));
+}
+
+/** prefetch.w 0(p): the block holding p will be written (ori x0, p, 3) */
+static inline void rvv_prefetch_w(const void *p)
+{
+    __asm__ __volatile__("ori     x0, %0, 3" : : "r"(p));
+}
+
+/** cbo.zero (p): zero the whole cache block holding p; traps without Zicboz */
+static inline void rvv_cbo_zero(void *p)
+{
+    __asm__ __volatile__(".insn i 0x0f, 2, x0, %0, 4" : : "r"(p) : "memory");
+}
+
+/* =============================================================================
+ * Streaming Kernels
+ * ============================================================================= */
+
+/**
+ * @brief Set rvv_cbo.block from rvv_get_cbo_block_size()
+ *
+ * Call after rvv_enable(). Optional: the first *_cbo call runs it while
+ * rvv_cbo.block is still 0, so cbo.zero never uses an assumed size. The
+ * result is kept; if the probe returns 0 or a size that is not a power
+ * of two, the block falls back to RVV_CBO_BLOCK_BYTES and zero_dst is
+ * cleared.
+ */
+void rvv_cbo_init(void);
+
+/**
+ * @brief SAXPY with input prefetch: y[i] = a * x[i] + y[i]
+ *
+ * x is prefetched with prefetch.r and y with prefetch.w; y is read, so
+ * it is never zeroed. Same results as rvv_saxpy().
+ */
+void rvv_saxpy_cbo(float a, const float *x, float *y, size_t n);
+
+/**
+ * @brief Vector add (int32) with input prefetch and output zeroing
+ */
+void rvv_vec_add_i32_cbo(const int32_t *a, const int32_t *b, int32_t *c, size_t n);
+
+/**
+ * @brief Vector add (float32) with input prefetch and output zeroing
+ */
+void rvv_vec_add_f32_cbo(const float *a, const float *b, float *c, size_t n);
+
+/**
+ * @brief Memory copy with source prefetch and destination zeroing
+ *
+ * Copies each chunk with rvv_memcpy(). Regions must not overlap.
+ */
+void rvv_memcpy_cbo(void *dst, const void *src, size_t n);
+
+#endif /* RVV_CBO_H */
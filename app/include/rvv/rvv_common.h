@@ -12,6 +12,22 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/* =============================================================================
+ * Kernel Backend
+ * ============================================================================= */
+
+/**
+ * Implementation behind the rvv_* kernels, selected with CMake
+ * -DRVV_BACKEND=asm|intrinsics: hand-written inline assembly (default) or
+ * riscv_vector.h intrinsics. Both provide this whole API, including the
+ * rvv_dispatch.h variant tables; the scalar references are shared.
+ */
+#if defined(RVV_BACKEND_INTRINSICS)
+#define RVV_BACKEND_NAME "intrinsics"
+#else
+#define RVV_BACKEND_NAME "asm"
+#endif
+
 /* =============================================================================
  * Test Data Sizes
  * ============================================================================= */
@@ -22,23 +38,105 @@
 /** Small array size for quick tests */
 #define RVV_TEST_SIZE_SMALL 16
 
+/** Larger array size for the HPM profile (exceeds a 32 KiB L1D across three arrays) */
+#define RVV_HPM_LARGE_SIZE 4096
+
 /** Matrix dimensions for matmul test */
 #define RVV_MATRIX_DIM 8
 
+/**
+ * Largest square GEMM in the blocked-GEMM sweep. The full 64..512 sweep
+ * is opt-in (-DRVV_BENCH_SWEEP=ON) because the reference kernel alone takes
+ * minutes at 512x512 on Spike and gem5 O3.
+ */
+#ifdef RVV_BENCH_SWEEP
+#define RVV_GEMM_MAX_DIM 512
+#else
+#define RVV_GEMM_MAX_DIM 64
+#endif
+
+/** Copies/fills shorter than this use a scalar byte loop */
+#define RVV_MEM_SMALL_BYTES 8
+
+/**
+ * Copies/fills of at least this many bytes use ntl.all (non-temporal)
+ * hints on the bulk path; 0 disables automatic streaming.
+ */
+#ifndef RVV_MEM_STREAM_BYTES
+#define RVV_MEM_STREAM_BYTES (1024 * 1024)
+#endif
+
+/** Largest buffer in the memcpy/memset bytes-per-cycle sweep (1 B .. 16 MiB) */
+#ifdef RVV_BENCH_SWEEP
+#define RVV_MEM_MAX_LEN (16 * 1024 * 1024)
+#else
+#define RVV_MEM_MAX_LEN (64 * 1024)
+#endif
+
+/** Guard bytes around each memcpy/memset test region (catches overruns) */
+#define RVV_MEM_GUARD 64
+
+/** Longest copy in the memcpy/memset alignment check (odd, > 4 KiB) */
+#define RVV_MEM_CHECK_LEN 4099
+
+/** Largest array in the dot-product mode sweep (64 .. 1M elements) */
+#ifdef RVV_BENCH_SWEEP
+#define RVV_DOT_MAX_LEN (1024 * 1024)
+#else
+#define RVV_DOT_MAX_LEN (16 * 1024)
+#endif
+
+/**
+ * Core clock used to convert cycles to GFLOP/s (gem5 configs run at 1GHz).
+ * Override with -DRVV_BENCH_CPU_MHZ=<mhz>.
+ */
+#ifndef RVV_BENCH_CPU_MHZ
+#define RVV_BENCH_CPU_MHZ 1000
+#endif
+
 /* =============================================================================
  * Benchmark Result Type
  * ============================================================================= */
 
+/**
+ * @brief Cycle statistics over repeated timed runs
+ */
+typedef struct {
+    uint64_t min;    /**< Fastest run */
+    uint64_t median; /**< Median run */
+    uint64_t max;    /**< Slowest run */
+    uint64_t mean;   /**< Arithmetic mean */
+    uint64_t stddev; /**< Population standard deviation */
+} rvv_bench_stats_t;
+
 /**
  * @brief Result structure for RVV benchmark comparison
  */
 typedef struct {
-    const char *name;       /**< Workload name */
-    uint64_t scalar_cycles; /**< Cycles for scalar implementation */
-    uint64_t vector_cycles; /**< Cycles for vector implementation */
-    int passed;             /**< Correctness check result (1=pass, 0=fail) */
+    const char *name;         /**< Workload name */
+    uint64_t scalar_cycles;   /**< Cycles for scalar implementation (median) */
+    uint64_t vector_cycles;   /**< Cycles for vector implementation (median) */
+    int passed;               /**< Correctness check result (1=pass, 0=fail) */
+    size_t n;                 /**< Problem size */
+    int has_scalar;           /**< scalar and scalar_instret are valid */
+    rvv_bench_stats_t scalar; /**< Scalar cycle statistics */
+    rvv_bench_stats_t vector; /**< Vector cycle statistics */
+    uint64_t scalar_instret;  /**< Scalar retired instructions (median) */
+    uint64_t vector_instret;  /**< Vector retired instructions (median) */
 } rvv_bench_result_t;
 
+/* =============================================================================
+ * Reduction Modes
+ * ============================================================================= */
+
+/**
+ * @brief Floating-point reduction mode for reducing kernels
+ */
+typedef enum {
+    RVV_REDUCE_ORDERED, /**< Element-order sum; bit-identical to the scalar reference */
+    RVV_REDUCE_FAST,    /**< Per-lane partial sums, one unordered reduction at the end */
+} rvv_reduce_mode_t;
+
 /* =============================================================================
  * Cycle Counter Helpers
  * ============================================================================= */
@@ -54,6 +152,18 @@ static inline uint64_t rvv_read_mcycle(void)
     return cycles;
 }
 
+/* =============================================================================
+ * Inline Assembly Helpers
+ * ============================================================================= */
+
+/**
+ * Clobber list for kernels that use whole register groups up to v23
+ * (three LMUL=8 groups, or six LMUL=4 groups in the unrolled variants).
+ */
+#define RVV_CLOBBER_V0_V23                                                                         \
+    "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8", "v9", "v10", "v11", "v12", "v13", "v14", \
+        "v15", "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23"
+
 /* =============================================================================
  * Float Comparison Helper
  * ============================================================================= */
@@ -73,6 +183,129 @@ static inline int rvv_float_eq(float a, float b, float epsilon)
     return diff <= epsilon;
 }
 
+/* =============================================================================
+ * Half-Precision Helpers
+ * ============================================================================= */
+
+/**
+ * fp16 (IEEE binary16) and bf16 values are passed around as raw 16-bit
+ * patterns so the scalar references and the test data do not depend on
+ * compiler support for _Float16/__bf16; only the Zvfh/Zvfbfwma kernels
+ * interpret them.
+ */
+typedef uint16_t rvv_f16_t;
+typedef uint16_t rvv_bf16_t;
+
+/** @brief Reinterpret float bits as uint32_t */
+static inline uint32_t rvv_f32_bits(float f)
+{
+    union {
+        float f;
+        uint32_t u;
+    } v = {.f = f};
+    return v.u;
+}
+
+/** @brief Reinterpret uint32_t bits as float */
+static inline float rvv_f32_from_bits(uint32_t u)
+{
+    union {
+        uint32_t u;
+        float f;
+    } v = {.u = u};
+    return v.f;
+}
+
+/**
+ * @brief Widen fp16 to float32 (exact, including subnormals, inf and NaN)
+ */
+static inline float rvv_f16_to_f32(rvv_f16_t h)
+{
+    uint32_t sign = (uint32_t) (h & 0x8000) << 16;
+    int32_t exp = (h >> 10) & 0x1f;
+    uint32_t man = h & 0x3ff;
+
+    if (exp == 0x1f) {
+        return rvv_f32_from_bits(sign | 0x7f800000 | (man << 13));
+    }
+    if (exp == 0) {
+        if (man == 0) {
+            return rvv_f32_from_bits(sign);
+        }
+        /* Subnormal: normalize into the float32 exponent range */
+        exp = 1;
+        while ((man & 0x400) == 0) {
+            man <<= 1;
+            exp--;
+        }
+        man &= 0x3ff;
+    }
+    return rvv_f32_from_bits(sign | ((uint32_t) (exp + 112) << 23) | (man << 13));
+}
+
+/**
+ * @brief Narrow float32 to fp16, round to nearest even (overflow -> inf)
+ */
+static inline rvv_f16_t rvv_f32_to_f16(float f)
+{
+    uint32_t bits = rvv_f32_bits(f);
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t abs = bits & 0x7fffffff;
+
+    if (abs >= 0x7f800000) {
+        return (rvv_f16_t) (sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0));
+    }
+    if (abs >= 0x477ff000) { /* >= 65520: rounds past the largest fp16 */
+        return (rvv_f16_t) (sign | 0x7c00);
+    }
+    if (abs <= 0x33000000) { /* <= 2^-25: rounds to zero */
+        return (rvv_f16_t) sign;
+    }
+
+    uint32_t h;
+    uint32_t rem;
+    uint32_t half;
+
+    if (abs < 0x38800000) {
+        /* fp16 subnormal: value / 2^-24, shifted out of the float32 significand */
+        uint32_t shift = 126 - (abs >> 23);
+        uint32_t man = (abs & 0x7fffff) | 0x800000;
+        h = man >> shift;
+        rem = man & ((1U << shift) - 1);
+        half = 1U << (shift - 1);
+    } else {
+        h = (abs >> 13) - (112U << 10);
+        rem = abs & 0x1fff;
+        half = 0x1000;
+    }
+    if (rem > half || (rem == half && (h & 1))) {
+        h++; /* a carry out of the significand bumps the exponent */
+    }
+    return (rvv_f16_t) (sign | h);
+}
+
+/**
+ * @brief Widen bf16 to float32 (exact)
+ */
+static inline float rvv_bf16_to_f32(rvv_bf16_t h)
+{
+    return rvv_f32_from_bits((uint32_t) h << 16);
+}
+
+/**
+ * @brief Narrow float32 to bf16, round to nearest even (NaN stays quiet NaN)
+ */
+static inline rvv_bf16_t rvv_f32_to_bf16(float f)
+{
+    uint32_t bits = rvv_f32_bits(f);
+
+    if ((bits & 0x7fffffff) > 0x7f800000) {
+        return (rvv_bf16_t) ((bits >> 16) | 0x40);
+    }
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return (rvv_bf16_t) (bits >> 16);
+}
+
 /* =============================================================================
  * RVV Workload Function Declarations
  * ============================================================================= */
@@ -92,14 +325,109 @@ void scalar_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n
 
 /**
  * @brief Vectorized memory copy using RVV
+ *
+ * Size-adaptive: scalar below RVV_MEM_SMALL_BYTES, a single strip up to
+ * one LMUL=8 group, otherwise an e64 bulk copy when dst and src share
+ * 8-byte alignment. Safe for n == 0. Regions must not overlap.
  */
 void rvv_memcpy(void *dst, const void *src, size_t n);
 
+/**
+ * @brief Vectorized memory copy with non-temporal (ntl.all) hints
+ *
+ * Same as rvv_memcpy() but always streams the bulk path, for large copies
+ * whose destination will not be read back soon.
+ */
+void rvv_memcpy_stream(void *dst, const void *src, size_t n);
+
 /**
  * @brief Scalar reference: memory copy
  */
 void scalar_memcpy(void *dst, const void *src, size_t n);
 
+/**
+ * @brief Vectorized memory set using RVV: dst[0..n-1] = (uint8_t) c
+ *
+ * Same size/alignment strategy as rvv_memcpy(). Safe for n == 0.
+ */
+void rvv_memset(void *dst, int c, size_t n);
+
+/**
+ * @brief Scalar reference: memory set
+ */
+void scalar_memset(void *dst, int c, size_t n);
+
+/**
+ * @brief Vectorized memory compare using RVV
+ * @return 0 if the first n bytes are equal, otherwise a[i] - b[i] for the
+ *         first differing byte i (compared as unsigned char)
+ */
+int rvv_memcmp(const void *a, const void *b, size_t n);
+
+/**
+ * @brief Scalar reference: memory compare
+ */
+int scalar_memcmp(const void *a, const void *b, size_t n);
+
+/**
+ * @brief Vectorized string length using RVV fault-only-first loads
+ *
+ * Uses vle8ff.v so a strip that runs past the terminator into an unmapped
+ * page is cut short instead of trapping; s only has to be readable up to
+ * and including its NUL byte.
+ */
+size_t rvv_strlen(const char *s);
+
+/**
+ * @brief Scalar reference: string length
+ */
+size_t scalar_strlen(const char *s);
+
+/**
+ * @brief Strided gather (float32): dst[i] = src[i * stride]
+ * @param stride Element stride; may be zero or negative
+ */
+void rvv_gather_strided_f32(float *dst, const float *src, ptrdiff_t stride, size_t n);
+
+/**
+ * @brief Scalar reference: strided gather
+ */
+void scalar_gather_strided_f32(float *dst, const float *src, ptrdiff_t stride, size_t n);
+
+/**
+ * @brief Strided scatter (float32): dst[i * stride] = src[i]
+ * @param stride Element stride; may be negative, must not be zero
+ */
+void rvv_scatter_strided_f32(float *dst, ptrdiff_t stride, const float *src, size_t n);
+
+/**
+ * @brief Scalar reference: strided scatter
+ */
+void scalar_scatter_strided_f32(float *dst, ptrdiff_t stride, const float *src, size_t n);
+
+/**
+ * @brief Indexed gather (float32): dst[i] = src[idx[i]]
+ * @param idx Element indices, each < 2^30 (scaled to 32-bit byte offsets)
+ */
+void rvv_gather_f32(float *dst, const float *src, const uint32_t *idx, size_t n);
+
+/**
+ * @brief Scalar reference: indexed gather
+ */
+void scalar_gather_f32(float *dst, const float *src, const uint32_t *idx, size_t n);
+
+/**
+ * @brief Indexed scatter (float32): dst[idx[i]] = src[i]
+ * @param idx Distinct element indices, each < 2^30; the stores are
+ *            unordered, so which of several duplicates wins is unspecified
+ */
+void rvv_scatter_f32(float *dst, const uint32_t *idx, const float *src, size_t n);
+
+/**
+ * @brief Scalar reference: indexed scatter
+ */
+void scalar_scatter_f32(float *dst, const uint32_t *idx, const float *src, size_t n);
+
 /* Level 2: Floating-Point Vector Operations */
 
 /**
@@ -117,6 +445,13 @@ void scalar_vec_add_f32(const float *a, const float *b, float *c, size_t n);
  */
 float rvv_dot_product_f32(const float *a, const float *b, size_t n);
 
+/**
+ * @brief Vector dot product (float32) with an explicit reduction mode
+ * @param mode RVV_REDUCE_ORDERED for bit-reproducible results,
+ *             RVV_REDUCE_FAST to reduce once after the loop
+ */
+float rvv_dot_product_f32_mode(const float *a, const float *b, size_t n, rvv_reduce_mode_t mode);
+
 /**
  * @brief Scalar reference: dot product (float32)
  */
@@ -132,6 +467,110 @@ void rvv_saxpy(float a, const float *x, float *y, size_t n);
  */
 void scalar_saxpy(float a, const float *x, float *y, size_t n);
 
+/* Level 2: Reductions and Scans */
+
+/**
+ * @brief Sum (int32), accumulated in 64 bits so it cannot overflow
+ */
+int64_t rvv_reduce_sum_i32(const int32_t *x, size_t n);
+
+/**
+ * @brief Scalar reference: sum (int32)
+ */
+int64_t scalar_reduce_sum_i32(const int32_t *x, size_t n);
+
+/**
+ * @brief Minimum (int32); INT32_MAX for n == 0
+ */
+int32_t rvv_reduce_min_i32(const int32_t *x, size_t n);
+
+/**
+ * @brief Scalar reference: minimum (int32)
+ */
+int32_t scalar_reduce_min_i32(const int32_t *x, size_t n);
+
+/**
+ * @brief Maximum (int32); INT32_MIN for n == 0
+ */
+int32_t rvv_reduce_max_i32(const int32_t *x, size_t n);
+
+/**
+ * @brief Scalar reference: maximum (int32)
+ */
+int32_t scalar_reduce_max_i32(const int32_t *x, size_t n);
+
+/**
+ * @brief Sum (float32) in element order; bit-identical to the scalar reference
+ */
+float rvv_reduce_sum_f32(const float *x, size_t n);
+
+/**
+ * @brief Scalar reference: sum (float32)
+ */
+float scalar_reduce_sum_f32(const float *x, size_t n);
+
+/**
+ * @brief Minimum (float32); +inf for n == 0, NaN elements are ignored
+ */
+float rvv_reduce_min_f32(const float *x, size_t n);
+
+/**
+ * @brief Scalar reference: minimum (float32)
+ */
+float scalar_reduce_min_f32(const float *x, size_t n);
+
+/**
+ * @brief Maximum (float32); -inf for n == 0, NaN elements are ignored
+ */
+float rvv_reduce_max_f32(const float *x, size_t n);
+
+/**
+ * @brief Scalar reference: maximum (float32)
+ */
+float scalar_reduce_max_f32(const float *x, size_t n);
+
+/**
+ * @brief Inclusive prefix sum (int32, wrapping): y[i] = x[0] + ... + x[i]
+ *
+ * x and y may be the same array.
+ */
+void rvv_prefix_sum_i32(const int32_t *x, int32_t *y, size_t n);
+
+/**
+ * @brief Scalar reference: inclusive prefix sum (int32)
+ */
+void scalar_prefix_sum_i32(const int32_t *x, int32_t *y, size_t n);
+
+/* Level 2: Fused Element-Wise Chains */
+
+/**
+ * @brief Clamp (float32): y[i] = min(max(x[i], lo), hi)
+ *
+ * NaN inputs become lo. x and y may be the same array.
+ */
+void rvv_clamp_f32(const float *x, float lo, float hi, float *y, size_t n);
+
+/**
+ * @brief Scalar reference: clamp (float32)
+ */
+void scalar_clamp_f32(const float *x, float lo, float hi, float *y, size_t n);
+
+/**
+ * @brief Fused AXPBY + clamp: y[i] = clamp(a * x[i] + b * z[i], lo, hi)
+ *
+ * One pass over x, z and y with the intermediate kept in registers; the
+ * unfused equivalent (scale, rvv_saxpy, rvv_clamp_f32) streams y three
+ * times. y may alias x or z.
+ */
+void rvv_axpbz_clamp_f32(float a, const float *x, float b, const float *z, float lo, float hi,
+                         float *y, size_t n);
+
+/**
+ * @brief Scalar reference: AXPBY + clamp
+ */
+void scalar_axpbz_clamp_f32(float a, const float *x, float b, const float *z, float lo, float hi,
+                            float *y, size_t n);
+
 /* Level 3: Advanced Operations */
 
 /**
@@ -151,4 +590,117 @@ void rvv_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32
 void scalar_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n,
                        uint32_t k);
 
+/**
+ * @brief Register-blocked GEMM microkernel selection
+ */
+typedef enum {
+    RVV_GEMM_UK_8X_M2, /**< 8 rows x (2*VLEN/32) columns, LMUL=2 */
+    RVV_GEMM_UK_4X_M4, /**< 4 rows x (4*VLEN/32) columns, LMUL=4 */
+} rvv_gemm_ukernel_t;
+
+/**
+ * @brief Blocked matrix multiply (float32): C = A * B
+ *
+ * Packs A/B into cache-contiguous panels and keeps an MR x NR tile of C
+ * in vector registers across the k-loop. Same layout and contract as
+ * rvv_matmul_f32(); uses the 8 x m2 microkernel.
+ */
+void rvv_gemm_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n, uint32_t k);
+
+/**
+ * @brief Blocked matrix multiply with an explicit microkernel
+ * @param uk Microkernel to use for all full and edge tiles
+ */
+void rvv_gemm_f32_uk(const float *A, const float *B, float *C, uint32_t m, uint32_t n, uint32_t k,
+                     rvv_gemm_ukernel_t uk);
+
+/* Mixed Precision: int8, fp16 and bf16 */
+
+/**
+ * @brief Dot product (int8 -> int32): result = sum(a[i] * b[i])
+ *
+ * Sign-extends to int16 and accumulates with vwmacc into per-lane int32
+ * sums. Wraps modulo 2^32; exact for n < 131072 (|a[i] * b[i]| <= 2^14).
+ */
+int32_t rvv_dot_product_i8(const int8_t *a, const int8_t *b, size_t n);
+
+/**
+ * @brief Scalar reference: dot product (int8 -> int32, wrapping)
+ */
+int32_t scalar_dot_product_i8(const int8_t *a, const int8_t *b, size_t n);
+
+/**
+ * @brief Matrix multiply (int8 -> int32): C = A * B
+ *
+ * Same layout as rvv_matmul_f32(); C is int32 and wraps like
+ * rvv_dot_product_i8().
+ */
+void rvv_matmul_i8(const int8_t *A, const int8_t *B, int32_t *C, uint32_t m, uint32_t n,
+                   uint32_t k);
+
+/**
+ * @brief Scalar reference: matrix multiply (int8 -> int32)
+ */
+void scalar_matmul_i8(const int8_t *A, const int8_t *B, int32_t *C, uint32_t m, uint32_t n,
+                      uint32_t k);
+
+/**
+ * @brief Scalar reference: dot product (fp16 inputs, float32 sum in element order)
+ */
+float scalar_dot_product_f16(const rvv_f16_t *a, const rvv_f16_t *b, size_t n);
+
+/**
+ * @brief Scalar reference: matrix multiply (fp16 inputs, float32 C)
+ */
+void scalar_matmul_f16(const rvv_f16_t *A, const rvv_f16_t *B, float *C, uint32_t m, uint32_t n,
+                       uint32_t k);
+
+/**
+ * @brief Scalar reference: dot product (bf16 inputs, float32 sum in element order)
+ */
+float scalar_dot_product_bf16(const rvv_bf16_t *a, const rvv_bf16_t *b, size_t n);
+
+/**
+ * @brief Scalar reference: matrix multiply (bf16 inputs, float32 C)
+ */
+void scalar_matmul_bf16(const rvv_bf16_t *A, const rvv_bf16_t *B, float *C, uint32_t m,
+                        uint32_t n, uint32_t k);
+
+#ifdef RVV_HAVE_ZVFH
+/**
+ * @brief Dot product (fp16 inputs, float32 sum): needs Zvfh
+ *
+ * Products are widened with vfwmul (exact in float32) and summed in
+ * element order, so the result is bit-identical to the scalar reference.
+ */
+float rvv_dot_product_f16(const rvv_f16_t *a, const rvv_f16_t *b, size_t n);
+
+/**
+ * @brief Matrix multiply (fp16 inputs, float32 C) with vfwmacc: needs Zvfh
+ *
+ * Same layout as rvv_matmul_f32(); bit-identical to the scalar reference.
+ */
+void rvv_matmul_f16(const rvv_f16_t *A, const rvv_f16_t *B, float *C, uint32_t m, uint32_t n,
+                    uint32_t k);
+#endif
+
+#ifdef RVV_HAVE_ZVFBFWMA
+/**
+ * @brief Dot product (bf16 inputs, float32 sum) with vfwmaccbf16: needs Zvfbfwma
+ *
+ * Each strip's products are formed exactly by vfwmaccbf16 into a zeroed
+ * accumulator and summed in element order: bit-identical to the scalar
+ * reference.
+ */
+float rvv_dot_product_bf16(const rvv_bf16_t *a, const rvv_bf16_t *b, size_t n);
+
+/**
+ * @brief Matrix multiply (bf16 inputs, float32 C) with vfwmaccbf16: needs Zvfbfwma
+ *
+ * Same layout as rvv_matmul_f32(); bit-identical to the scalar reference.
+ */
+void rvv_matmul_bf16(const rvv_bf16_t *A, const rvv_bf16_t *B, float *C, uint32_t m, uint32_t n,
+                     uint32_t k);
+#endif
+
 #endif /* RVV_COMMON_H */
@@ -4,7 +4,8 @@
  *
  * Provides functions to detect RVV availability, query hardware
  * parameters (VLEN, VLENB, ELEN), and enable the vector unit
- * in mstatus.VS.
+ * in mstatus.VS. Also reports the cache-block extensions used by the
+ * streaming kernels of rvv_cbo.h and the cache-block size.
  */
 
 #ifndef RVV_DETECT_H
@@ -13,6 +14,7 @@
 #include "csr.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /* =============================================================================
@@ -30,18 +32,58 @@
 /** misa bit for V extension */
 #define MISA_V_BIT (1UL << ('V' - 'A'))
 
+/** misa bits for the scalar F and D extensions (Zve*f / Zve64d need them) */
+#define MISA_F_BIT (1UL << ('F' - 'A'))
+#define MISA_D_BIT (1UL << ('D' - 'A'))
+
+/* =============================================================================
+ * Vector Sub-Extensions
+ * ============================================================================= */
+
+/** Sub-extension bits returned by rvv_get_extensions() */
+#define RVV_EXT_ZVE32X (1U << 0)   /* Integer vectors, ELEN >= 32 */
+#define RVV_EXT_ZVE32F (1U << 1)   /* + float32 vectors */
+#define RVV_EXT_ZVE64X (1U << 2)   /* Integer vectors, ELEN >= 64 */
+#define RVV_EXT_ZVE64F (1U << 3)   /* + float32 vectors with ELEN 64 */
+#define RVV_EXT_ZVE64D (1U << 4)   /* + float64 vectors */
+#define RVV_EXT_ZVFH (1U << 5)     /* fp16 vector arithmetic (build-time) */
+#define RVV_EXT_ZVFBFWMA (1U << 6) /* bf16 widening multiply-add (build-time) */
+#define RVV_EXT_ZICBOP (1U << 7)   /* Cache-block prefetch hints (build-time) */
+#define RVV_EXT_ZICBOZ (1U << 8)   /* Cache-block zero, cbo.zero (build-time) */
+
 /* =============================================================================
  * RVV Detection Functions
  * ============================================================================= */
 
+/**
+ * @brief Read misa, or build it from -march in gem5 SE (user mode, no misa)
+ */
+static inline uint64_t rvv_read_misa(void)
+{
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+    uint64_t misa = 0;
+#if defined(__riscv_vector)
+    misa |= MISA_V_BIT;
+#endif
+#if defined(__riscv_flen) && __riscv_flen >= 32
+    misa |= MISA_F_BIT;
+#endif
+#if defined(__riscv_flen) && __riscv_flen >= 64
+    misa |= MISA_D_BIT;
+#endif
+    return misa;
+#else
+    return read_csr(misa);
+#endif
+}
+
 /**
  * @brief Check if RVV is available by reading misa
  * @return true if V extension bit is set in misa
  */
 static inline bool rvv_available(void)
 {
-    uint64_t misa = read_csr(misa);
-    return (misa & MISA_V_BIT) != 0;
+    return (rvv_read_misa() & MISA_V_BIT) != 0;
 }
 
 /**
@@ -52,11 +94,15 @@ static inline bool rvv_available(void)
  */
 static inline void rvv_enable(void)
 {
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+    /* User mode: no mstatus access; gem5 SE starts the process with VS on */
+#else
     /* Clear VS field, then set to Initial (01) */
     unsigned long mstatus = read_csr(mstatus);
     mstatus &= ~MSTATUS_VS_MASK;
     mstatus |= MSTATUS_VS_INITIAL;
     write_csr(mstatus, mstatus);
+#endif
 }
 
 /**
@@ -79,10 +125,56 @@ static inline uint64_t rvv_get_vlen(void)
     return rvv_get_vlenb() * 8;
 }
 
+/**
+ * @brief Get ELEN (widest supported element width in bits)
+ *
+ * Requests SEW=64 with vsetvli: an unsupported vtype sets vtype.vill
+ * (the sign bit) instead of trapping, so this is safe on Zve32* harts.
+ * Clobbers vl/vtype.
+ *
+ * @return 64 or 32
+ */
+static inline uint64_t rvv_get_elen(void)
+{
+    unsigned long vl;
+    long vtype;
+    __asm__ __volatile__("vsetvli %0, zero, e64, m1, ta, ma\n\t"
+                         "csrr    %1, vtype"
+                         : "=r"(vl), "=r"(vtype));
+    (void) vl;
+    return vtype < 0 ? 32 : 64;
+}
+
+/**
+ * @brief Report the vector sub-extensions of this hart
+ *
+ * The Zve* bits are probed at runtime (ELEN via vtype.vill, F/D via
+ * misa). Zvfh and Zvfbfwma add no CSR state and only show up as an
+ * illegal-instruction trap when missing, so they are reported when the
+ * image was built for them (-DRVV_ZVFH / -DRVV_ZVFBFWMA) and the
+ * simulator is started with them. The same holds for Zicbop (its
+ * prefetches are HINTs that no-op without it) and Zicboz (cbo.zero traps
+ * without it): -DRVV_ZICBOP / -DRVV_ZICBOZ.
+ *
+ * @return Mask of RVV_EXT_* bits (0 if misa.V is clear)
+ */
+uint32_t rvv_get_extensions(void);
+
+/**
+ * @brief Cache-block size in bytes
+ *
+ * With Zicboz, measured: one cbo.zero on a RVV_CBO_BLOCK_MAX-aligned
+ * buffer of 0xff bytes zeroes exactly one block. Without it, the block
+ * size the build assumes (RVV_CBO_BLOCK_BYTES). Blocks larger than
+ * RVV_CBO_BLOCK_MAX are not supported.
+ */
+size_t rvv_get_cbo_block_size(void);
+
 /**
  * @brief Print RVV hardware information to console
  *
- * Prints VLEN, VLENB, and VL for various SEW/LMUL configurations.
+ * Prints VLEN, VLENB, ELEN, the sub-extensions, the cache-block size,
+ * and VL for various SEW/LMUL configurations.
  */
 void rvv_print_info(void);
 
@@ -0,0 +1,161 @@
+/**
+ * @file rvv_dispatch.h
+ * @brief VLEN/LMUL-specialized kernel variants and startup dispatch
+ *
+ * The streaming kernels (vec_add i32/f32, SAXPY, ordered dot product) are
+ * compiled in several variants: LMUL 1/2/4/8, plus LMUL 2/4 with the
+ * strip loop unrolled twice (one branch per two strips). The public
+ * rvv_* entry points call through the rvv_dispatch table, which starts
+ * out on the m1 variants and is filled in once by rvv_dispatch_init():
+ *
+ *   - Heuristic: pick the smallest LMUL whose register group holds at
+ *     least RVV_DISPATCH_STRIP_BITS bits (VLEN 128 -> m8, 256 -> m4,
+ *     512 -> m2, 1024+ -> m1), so each strip moves the same amount of
+ *     data and loop overhead stays flat across VLENs.
+ *   - Autotune (RVV_AUTOTUNE, CMake -DRVV_AUTOTUNE=ON): time every
+ *     variant on the target and keep the fastest one that matches the
+ *     scalar reference.
+ *
+ * The same binary therefore runs m8 loops on QEMU vlen=128 and m2 loops on
+ * gem5 vlen=512. Call rvv_dispatch_init() on hart 0 after rvv_enable()
+ * and before other harts run kernels; the table is read-only afterwards.
+ */
+
+#ifndef RVV_DISPATCH_H
+#define RVV_DISPATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Bits per strip the heuristic aims for (VLEN * LMUL) */
+#ifndef RVV_DISPATCH_STRIP_BITS
+#define RVV_DISPATCH_STRIP_BITS 1024
+#endif
+
+/** Elements per autotune run */
+#ifndef RVV_AUTOTUNE_LEN
+#define RVV_AUTOTUNE_LEN 1024
+#endif
+
+/** Timed runs per variant during autotune (the minimum is kept) */
+#ifndef RVV_AUTOTUNE_REPS
+#define RVV_AUTOTUNE_REPS 5
+#endif
+
+/* =============================================================================
+ * Kernels and Variants
+ * ============================================================================= */
+
+/**
+ * @brief Dispatched kernels
+ */
+typedef enum {
+    RVV_KERNEL_VEC_ADD_I32, /**< rvv_vec_add_i32() */
+    RVV_KERNEL_VEC_ADD_F32, /**< rvv_vec_add_f32() */
+    RVV_KERNEL_SAXPY,       /**< rvv_saxpy() */
+    RVV_KERNEL_DOT_F32,     /**< rvv_dot_product_f32() (ordered reduction) */
+    RVV_KERNEL_COUNT
+} rvv_kernel_t;
+
+/**
+ * @brief Compiled variants of each kernel
+ */
+typedef enum {
+    RVV_VARIANT_M1,    /**< LMUL=1 */
+    RVV_VARIANT_M2,    /**< LMUL=2 */
+    RVV_VARIANT_M4,    /**< LMUL=4 */
+    RVV_VARIANT_M8,    /**< LMUL=8 */
+    RVV_VARIANT_M2_X2, /**< LMUL=2, two strips per loop iteration */
+    RVV_VARIANT_M4_X2, /**< LMUL=4, two strips per loop iteration */
+    RVV_VARIANT_COUNT
+} rvv_variant_t;
+
+typedef void (*rvv_vec_add_i32_fn)(const int32_t *a, const int32_t *b, int32_t *c, size_t n);
+typedef void (*rvv_vec_add_f32_fn)(const float *a, const float *b, float *c, size_t n);
+typedef void (*rvv_saxpy_fn)(float a, const float *x, float *y, size_t n);
+typedef float (*rvv_dot_f32_fn)(const float *a, const float *b, size_t n);
+
+/**
+ * Variant tables, indexed by rvv_variant_t. A NULL entry means the kernel
+ * has no such variant (the ordered dot product is not unrolled: its
+ * reduction chain is serial either way).
+ */
+extern const rvv_vec_add_i32_fn rvv_vec_add_i32_variants[RVV_VARIANT_COUNT];
+extern const rvv_vec_add_f32_fn rvv_vec_add_f32_variants[RVV_VARIANT_COUNT];
+extern const rvv_saxpy_fn rvv_saxpy_variants[RVV_VARIANT_COUNT];
+extern const rvv_dot_f32_fn rvv_dot_f32_variants[RVV_VARIANT_COUNT];
+
+/* m1 variants: the dispatch table's initial entries */
+void rvv_vec_add_i32_m1(const int32_t *a, const int32_t *b, int32_t *c, size_t n);
+void rvv_vec_add_f32_m1(const float *a, const float *b, float *c, size_t n);
+void rvv_saxpy_m1(float a, const float *x, float *y, size_t n);
+float rvv_dot_product_f32_m1(const float *a, const float *b, size_t n);
+
+/* =============================================================================
+ * Dispatch Table
+ * ============================================================================= */
+
+/**
+ * @brief Active kernel implementations
+ */
+typedef struct {
+    rvv_vec_add_i32_fn vec_add_i32;
+    rvv_vec_add_f32_fn vec_add_f32;
+    rvv_saxpy_fn saxpy;
+    rvv_dot_f32_fn dot_f32;
+    rvv_variant_t selected[RVV_KERNEL_COUNT]; /**< Variant behind each entry */
+    bool tuned;                               /**< Chosen by autotune, not the heuristic */
+} rvv_dispatch_t;
+
+extern rvv_dispatch_t rvv_dispatch;
+
+/**
+ * @brief Fill the dispatch table (heuristic, then autotune if enabled)
+ */
+void rvv_dispatch_init(void);
+
+/**
+ * @brief Variant the VLEN heuristic picks
+ */
+rvv_variant_t rvv_dispatch_heuristic(uint64_t vlen);
+
+/**
+ * @brief Time every variant and select the fastest correct one
+ *
+ * Runs each variant RVV_AUTOTUNE_REPS times on RVV_AUTOTUNE_LEN elements.
+ * Also usable at runtime without RVV_AUTOTUNE.
+ */
+void rvv_dispatch_autotune(void);
+
+/**
+ * @brief Select a variant for one kernel
+ * @return false if the kernel has no such variant (table unchanged)
+ */
+bool rvv_dispatch_select(rvv_kernel_t kernel, rvv_variant_t variant);
+
+/**
+ * @brief True if the kernel was compiled in this variant
+ */
+bool rvv_variant_available(rvv_kernel_t kernel, rvv_variant_t variant);
+
+/**
+ * @brief Variant name ("m1", "m4x2", ...)
+ */
+const char *rvv_variant_name(rvv_variant_t variant);
+
+/**
+ * @brief Kernel name ("vec_add_i32", ...)
+ */
+const char *rvv_kernel_name(rvv_kernel_t kernel);
+
+/**
+ * @brief Print "[RVV] dispatch <kernel>: <variant> (<how>)" per kernel
+ */
+void rvv_dispatch_print(void);
+
+#endif /* RVV_DISPATCH_H */
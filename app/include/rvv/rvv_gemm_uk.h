@@ -0,0 +1,40 @@
+/**
+ * @file rvv_gemm_uk.h
+ * @brief GEMM microkernels shared by the blocked driver (vec_gemm.c)
+ *
+ * The packing and blocking driver is backend-independent; only the
+ * microkernels are implemented per RVV_BACKEND (vec_gemm_uk.c in inline
+ * assembly, intrinsics/vec_gemm_uk.c with riscv_vector.h intrinsics).
+ */
+
+#ifndef RVV_GEMM_UK_H
+#define RVV_GEMM_UK_H
+
+#include <stddef.h>
+
+/**
+ * @brief 8 x NR microkernel, LMUL=2
+ *
+ * C[0..7][0..vl-1] (+)= sum_p Ap[p][0..7] * Bp[p][0..vl-1]
+ *
+ * @param ap Packed A micro-panel (kc x 8, row values contiguous per p)
+ * @param bp Packed B micro-panel (kc x vl, contiguous per p)
+ * @param kc Depth (>= 1)
+ * @param c Top-left of the C tile
+ * @param ldc Row stride of C in bytes
+ * @param vl Number of columns in this tile (<= VLMAX for e32,m2)
+ * @param acc Non-zero to accumulate into C, zero to overwrite
+ */
+void rvv_gemm_ukernel_8x_m2(const float *ap, const float *bp, size_t kc, float *c, size_t ldc,
+                            size_t vl, size_t acc);
+
+/**
+ * @brief 4 x NR microkernel, LMUL=4
+ *
+ * Same contract as rvv_gemm_ukernel_8x_m2() with 4 rows per tile and
+ * vl <= VLMAX for e32,m4.
+ */
+void rvv_gemm_ukernel_4x_m4(const float *ap, const float *bp, size_t kc, float *c, size_t ldc,
+                            size_t vl, size_t acc);
+
+#endif /* RVV_GEMM_UK_H */
@@ -0,0 +1,105 @@
+/**
+ * @file rvv_parallel.h
+ * @brief Multi-hart work-partitioned RVV kernels (SMP + Vector)
+ *
+ * Each kernel splits its index space into contiguous, cache-line aligned
+ * chunks, one per hart, and runs the single-hart RVV kernel on every
+ * chunk through smp_parallel_run(). Reductions (dot product) combine the
+ * per-hart partial sums with a binary tree: at level l, hart h with bit l
+ * set hands its partial to hart h - 2^l, so hart 0 holds the total after
+ * ceil(log2(nharts)) steps. The combine order depends only on nharts, so
+ * results are reproducible for a given hart count.
+ *
+ * All functions must be called from hart 0 (see smp_parallel_run()).
+ * With nharts == 1 they run inline on hart 0.
+ */
+
+#ifndef RVV_PARALLEL_H
+#define RVV_PARALLEL_H
+
+#include "rvv/rvv_common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Scaling Benchmark Sizes
+ * ============================================================================= */
+
+/** Elements per chunk boundary (16 x 4 bytes = one 64-byte cache line) */
+#define RVV_PAR_CHUNK_ALIGN 16
+
+/**
+ * Strong scaling: fixed total problem size.
+ * Weak scaling: fixed per-hart size, total = per-hart * harts.
+ */
+#ifdef RVV_BENCH_SWEEP
+#define RVV_PAR_STRONG_LEN (1024 * 1024)
+#define RVV_PAR_WEAK_LEN (128 * 1024)
+#define RVV_PAR_MATRIX_DIM 256
+#else
+#define RVV_PAR_STRONG_LEN (16 * 1024)
+#define RVV_PAR_WEAK_LEN (4 * 1024)
+#define RVV_PAR_MATRIX_DIM 32
+#endif
+
+/** Rows of C per hart in the weak-scaling matmul */
+#define RVV_PAR_WEAK_ROWS 8
+
+/** Vector buffer length covering both scaling modes */
+#define RVV_PAR_MAX_LEN                                                                            \
+    (RVV_PAR_STRONG_LEN > RVV_PAR_WEAK_LEN * NUM_HARTS ? RVV_PAR_STRONG_LEN                       \
+                                                       : RVV_PAR_WEAK_LEN * NUM_HARTS)
+
+/** Matrix rows covering both scaling modes (columns/depth = RVV_PAR_MATRIX_DIM) */
+#define RVV_PAR_MAX_ROWS                                                                           \
+    (RVV_PAR_MATRIX_DIM > RVV_PAR_WEAK_ROWS * NUM_HARTS ? RVV_PAR_MATRIX_DIM                      \
+                                                        : RVV_PAR_WEAK_ROWS * NUM_HARTS)
+
+/* =============================================================================
+ * Partitioning
+ * ============================================================================= */
+
+/**
+ * @brief Compute hart's share [*lo, *hi) of n elements
+ *
+ * Chunks are multiples of RVV_PAR_CHUNK_ALIGN elements so no two harts
+ * write the same cache line; trailing harts may get an empty range.
+ */
+void rvv_par_range(size_t n, uint32_t hart, uint32_t nharts, size_t *lo, size_t *hi);
+
+/* =============================================================================
+ * Parallel Kernels
+ * ============================================================================= */
+
+/**
+ * @brief Parallel SAXPY: y[i] = a * x[i] + y[i]
+ */
+void rvv_par_saxpy(float a, const float *x, float *y, size_t n, uint32_t nharts);
+
+/**
+ * @brief Parallel vector add (int32): c[i] = a[i] + b[i]
+ */
+void rvv_par_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n,
+                         uint32_t nharts);
+
+/**
+ * @brief Parallel vector add (float32): c[i] = a[i] + b[i]
+ */
+void rvv_par_vec_add_f32(const float *a, const float *b, float *c, size_t n, uint32_t nharts);
+
+/**
+ * @brief Parallel dot product (float32) with tree reduction of partials
+ */
+float rvv_par_dot_product_f32(const float *a, const float *b, size_t n, uint32_t nharts);
+
+/**
+ * @brief Parallel matrix multiply (float32): rows of C split across harts
+ *
+ * Same layout as rvv_matmul_f32(); each hart runs rvv_matmul_f32() on its
+ * block of rows of A and C against the shared B.
+ */
+void rvv_par_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n,
+                        uint32_t k, uint32_t nharts);
+
+#endif /* RVV_PARALLEL_H */
@@ -0,0 +1,131 @@
+/**
+ * @file sched.h
+ * @brief Work-stealing task scheduler for SMP configurations
+ *
+ * Small bare-metal runtime: every hart owns a Chase-Lev work-stealing
+ * deque. sched_spawn() pushes a task onto the calling hart's deque; a hart
+ * pops its own deque from the bottom (LIFO, cache-warm) and, when empty,
+ * steals from the top of other harts' deques (FIFO, oldest and usually
+ * largest tasks first). Tasks may spawn further tasks, so irregular and
+ * recursive workloads balance themselves across harts.
+ *
+ * Idle secondary harts park in wfi with the machine software interrupt
+ * enabled in mie and mstatus.MIE clear while parked, so the wakeup is not
+ * taken as a trap (harts that run the profiler enable MIE otherwise). A
+ * spawn that finds a parked hart wakes it with a CLINT MSIP IPI.
+ *
+ * Hart 0 drives the runtime: it spawns root tasks and calls sched_wait(),
+ * which runs and steals tasks until every spawned task has completed.
+ * sched_broadcast() runs one function on a fixed set of harts at once
+ * (fork-join), which backs smp_parallel_run().
+ *
+ * Deque operations use LR/SC CAS and AMOs from atomic.h plus explicit
+ * fences; no locks are taken on the task path.
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "smp.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Per-hart deque capacity in tasks (power of two) */
+#ifndef SCHED_DEQUE_SIZE
+#define SCHED_DEQUE_SIZE 256
+#endif
+
+#if (SCHED_DEQUE_SIZE & (SCHED_DEQUE_SIZE - 1)) != 0
+#error "SCHED_DEQUE_SIZE must be a power of two"
+#endif
+
+/* =============================================================================
+ * Tasks
+ * ============================================================================= */
+
+/**
+ * @brief Task function
+ *
+ * @param arg Shared argument given to sched_spawn()
+ * @param lo First payload word (typically start of an index range)
+ * @param hi Second payload word (typically end of an index range)
+ */
+typedef void (*sched_task_fn_t)(void *arg, size_t lo, size_t hi);
+
+/**
+ * @brief Per-hart scheduler statistics
+ */
+typedef struct {
+    uint32_t executed; /**< Tasks run by this hart */
+    uint32_t stolen;   /**< Tasks taken from another hart's deque */
+    uint32_t inlined;  /**< Spawns run inline because the deque was full */
+    uint32_t parks;    /**< Times the hart parked in wfi */
+} sched_stats_t;
+
+/**
+ * @brief Initialize deques, counters and statistics
+ *
+ * Called by smp_init() on hart 0 before secondaries are released.
+ */
+void sched_init(void);
+
+/**
+ * @brief Spawn a task on the calling hart's deque
+ *
+ * May be called from hart 0 or from inside a running task on any hart.
+ * If the deque is full the task runs inline before returning. Wakes one
+ * parked hart if there is one.
+ *
+ * @param fn Task function
+ * @param arg Argument passed to fn
+ * @param lo First payload word
+ * @param hi Second payload word
+ */
+void sched_spawn(sched_task_fn_t fn, void *arg, size_t lo, size_t hi);
+
+/**
+ * @brief Run and steal tasks until all spawned tasks have completed
+ *
+ * Must be called by hart 0, outside any task.
+ */
+void sched_wait(void);
+
+/**
+ * @brief Run fn(hart, nharts, arg) on harts 0 .. nharts-1 concurrently
+ *
+ * Must be called by hart 0 with no tasks outstanding. Wakes every parked
+ * hart by IPI and returns once all harts have acknowledged the job. Harts
+ * >= nharts acknowledge without running fn.
+ *
+ * @param fn Work function
+ * @param arg Argument passed to every invocation of fn
+ * @param nharts Number of harts to use (2 .. NUM_HARTS)
+ */
+void sched_broadcast(smp_job_fn_t fn, void *arg, uint32_t nharts);
+
+/**
+ * @brief Secondary hart main loop (never returns)
+ *
+ * Serves broadcasts, runs and steals tasks, and parks in wfi when there
+ * is nothing to do.
+ *
+ * @param hart Calling hart ID (1 .. NUM_HARTS-1)
+ */
+void sched_worker_loop(uint32_t hart);
+
+/**
+ * @brief Copy out a hart's statistics
+ */
+void sched_get_stats(uint32_t hart, sched_stats_t *stats);
+
+/**
+ * @brief Zero all harts' statistics (hart 0, no tasks outstanding)
+ */
+void sched_reset_stats(void);
+
+#endif /* SCHED_H */
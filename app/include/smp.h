@@ -13,15 +13,21 @@
  *   5. Secondary harts call smp_secondary_entry(hartid)
  *
  * Synchronization:
- *   - Spinlocks using LR/SC (Load-Reserved / Store-Conditional)
- *   - Barriers using centralized counting with generation
+ *   - Spinlocks: LR/SC, TTAS with backoff, ticket or MCS queue lock,
+ *     chosen at build time (SMP_LOCK_*)
+ *   - Barriers: centralized, sense-reversing, combining tree or
+ *     dissemination, chosen at build time (SMP_BARRIER_*)
  *   - Atomic operations via AMO instructions (see atomic.h)
+ *   - CLINT MSIP inter-processor interrupts to wake parked harts
+ *
+ * Work dispatch: see sched.h (work-stealing tasks and fork-join jobs).
  */
 
 #ifndef SMP_H
 #define SMP_H
 
 #include "atomic.h"
+#include "csr.h"
 #include "platform.h"
 
 #include <stdbool.h>
@@ -37,27 +43,327 @@
 
 #define MAX_HARTS 8
 
+/* =============================================================================
+ * Cache-Line Layout
+ * ============================================================================= */
+
+/** Coherence granule assumed for padding (QEMU, Spike and gem5 all use 64) */
+#define SMP_CACHE_LINE 64
+
+/**
+ * Place a shared object on its own cache line(s) in .bss.smp_shared.
+ *
+ * The linker scripts gather this input section at the start of .bss
+ * between __smp_shared_start and __smp_shared_end, both line aligned, and
+ * every object in it starts on a line boundary. So a hart spinning on one
+ * of these objects never shares a line with another one, or with ordinary
+ * .bss data. The section is zeroed by the startup BSS clear.
+ */
+#define __smp_shared __attribute__((section(".bss.smp_shared"), aligned(SMP_CACHE_LINE)))
+
+/* =============================================================================
+ * Per-Hart Data
+ * ============================================================================= */
+
+/**
+ * @brief Hart-local data area, one cache line per hart
+ *
+ * startup.S points tp (and mscratch, in M-mode builds, for trap handlers)
+ * at smp_hart_local[hartid] before any C code runs, and stores hartid
+ * once BSS is clear. Only the owning hart writes its entry, so nothing
+ * here is ever falsely shared. startup.S indexes the array with a shift
+ * by 6, so the size must stay SMP_CACHE_LINE.
+ */
+typedef struct {
+    uint32_t hartid;          /* mhartid (0 in gem5 SE mode) */
+    volatile uint32_t online; /* Set to 1 when a secondary hart has booted */
+    uint8_t pad[SMP_CACHE_LINE - 2 * sizeof(uint32_t)];
+} smp_hart_local_t;
+
+_Static_assert(sizeof(smp_hart_local_t) == SMP_CACHE_LINE, "startup.S assumes 64-byte entries");
+
+extern smp_hart_local_t smp_hart_local[MAX_HARTS];
+
+/**
+ * @brief The calling hart's local data area (read from tp)
+ */
+static inline smp_hart_local_t *smp_this_hart(void)
+{
+    smp_hart_local_t *self;
+    __asm__ __volatile__("mv %0, tp" : "=r"(self));
+    return self;
+}
+
+/**
+ * @brief The calling hart's ID without a CSR access (usable in gem5 SE mode)
+ */
+static inline uint32_t smp_hart_id(void)
+{
+    return smp_this_hart()->hartid;
+}
+
+/**
+ * @brief Per-hart counter: one padded slot per hart, merged on read
+ *
+ * Each hart only adds to its own slot with a plain load/store, so
+ * increments never contend; smp_counter_read() sums the slots. The sum
+ * is exact once the writers have synchronized with the reader (e.g. at
+ * the end of smp_parallel_run()); read concurrently it is a snapshot.
+ */
+typedef struct {
+    struct {
+        volatile uint64_t value;
+        uint8_t pad[SMP_CACHE_LINE - sizeof(uint64_t)];
+    } slot[MAX_HARTS] __attribute__((aligned(SMP_CACHE_LINE)));
+} smp_counter_t;
+
+/**
+ * @brief Add to the calling hart's slot of a per-hart counter
+ */
+static inline void smp_counter_add(smp_counter_t *c, uint64_t n)
+{
+    c->slot[smp_hart_id()].value += n;
+}
+
+/**
+ * @brief Zero every slot of a per-hart counter (no writer may be active)
+ */
+void smp_counter_reset(smp_counter_t *c);
+
+/**
+ * @brief Sum of all slots of a per-hart counter
+ */
+uint64_t smp_counter_read(const smp_counter_t *c);
+
 /* =============================================================================
  * Spinlock
  * ============================================================================= */
 
+/*
+ * Lock algorithm, selected at build time (CMake SMP_LOCK); all share the
+ * spinlock_t / SPINLOCK_INIT / spin_lock() / spin_unlock() / spin_trylock()
+ * API:
+ *
+ *   SMP_LOCK_LRSC    LR/SC test-and-set (default). Unfair, no backoff.
+ *   SMP_LOCK_TTAS    test-and-test-and-set: spin on a plain load until the
+ *                    lock looks free, then amoswap.w.aq; exponential
+ *                    backoff after each failed attempt.
+ *   SMP_LOCK_TICKET  ticket lock: amoadd.w.aq takes a ticket, waiters spin
+ *                    on now_serving. FIFO-fair.
+ *   SMP_LOCK_MCS     MCS queue lock: each waiter spins on its own per-hart
+ *                    node (one cache line per hart, embedded in the lock),
+ *                    so a handoff touches only the successor's line. FIFO.
+ *
+ * Every release is a single .rl AMO (no separate full fence), and every
+ * acquire ends in .aq ordering.
+ */
+#if !defined(SMP_LOCK_LRSC) && !defined(SMP_LOCK_TTAS) && !defined(SMP_LOCK_TICKET) &&           \
+    !defined(SMP_LOCK_MCS)
+#define SMP_LOCK_LRSC
+#endif
+
+#if defined(SMP_LOCK_TTAS)
+#define SMP_LOCK_NAME "ttas"
+#elif defined(SMP_LOCK_TICKET)
+#define SMP_LOCK_NAME "ticket"
+#elif defined(SMP_LOCK_MCS)
+#define SMP_LOCK_NAME "mcs"
+#else
+#define SMP_LOCK_NAME "lrsc"
+#endif
+
+/** TTAS backoff bounds, in delay-loop iterations */
+#ifndef SMP_LOCK_BACKOFF_MIN
+#define SMP_LOCK_BACKOFF_MIN 4
+#endif
+#ifndef SMP_LOCK_BACKOFF_MAX
+#define SMP_LOCK_BACKOFF_MAX 1024
+#endif
+
+/**
+ * @brief Release-ordered 32-bit store as an AMO (amoswap.w.rl)
+ */
+static inline void spin_store_release(volatile uint32_t *ptr, uint32_t val)
+{
+    (void) atomic_swap_u32_explicit(ptr, val, ATOMIC_RELEASE);
+}
+
+#if defined(SMP_LOCK_TICKET)
+
+/**
+ * @brief Ticket lock: next ticket to hand out, ticket being served
+ */
+typedef struct {
+    volatile uint32_t next;
+    volatile uint32_t owner;
+} spinlock_t;
+
+#elif defined(SMP_LOCK_MCS)
+
+/**
+ * @brief MCS queue node, one per hart per lock
+ *
+ * next holds the successor's hart ID + 1 (0 = none), so the queue can be
+ * linked with 32-bit AMOs.
+ */
+typedef struct {
+    volatile uint32_t next;
+    volatile uint32_t locked;
+    uint8_t pad[56];
+} mcs_node_t;
+
+/**
+ * @brief MCS lock: queue tail (hart ID + 1 of the last waiter, 0 = free)
+ */
+typedef struct {
+    volatile uint32_t tail;
+    mcs_node_t node[MAX_HARTS] __attribute__((aligned(64)));
+} spinlock_t;
+
+#else
+
 /**
- * @brief Spinlock type using LR/SC for mutual exclusion
+ * @brief Spinlock type using LR/SC (or TTAS AMO swap) for mutual exclusion
  */
 typedef struct {
     volatile uint32_t lock;
 } spinlock_t;
 
-/** Static initializer for spinlock */
+#endif /* SMP_LOCK_* */
+
+/** Static initializer for spinlock (all variants: all-zero is unlocked) */
 #define SPINLOCK_INIT                                                                              \
     {                                                                                              \
         0                                                                                          \
     }
 
+#if defined(SMP_LOCK_TTAS)
+
+/** Busy-wait for roughly n iterations (TTAS backoff) */
+static inline void spin_delay(uint32_t n)
+{
+    for (volatile uint32_t i = 0; i < n; i++) {
+        /* Delay */
+    }
+}
+
+/** amoswap.w.aq 1 into the lock word; returns the previous value */
+static inline uint32_t spin_swap_acquire(volatile uint32_t *ptr)
+{
+    return atomic_swap_u32_explicit(ptr, 1, ATOMIC_ACQUIRE);
+}
+
+static inline void spin_lock(spinlock_t *lock)
+{
+    uint32_t backoff = SMP_LOCK_BACKOFF_MIN;
+
+    while (1) {
+        /* Test: read-shared spin, no coherence traffic while held */
+        while (lock->lock != 0) {
+            /* Spin */
+        }
+        /* Test-and-set */
+        if (spin_swap_acquire(&lock->lock) == 0) {
+            return;
+        }
+        spin_delay(backoff);
+        if (backoff < SMP_LOCK_BACKOFF_MAX) {
+            backoff <<= 1;
+        }
+    }
+}
+
+static inline void spin_unlock(spinlock_t *lock)
+{
+    spin_store_release(&lock->lock, 0);
+}
+
+static inline bool spin_trylock(spinlock_t *lock)
+{
+    return lock->lock == 0 && spin_swap_acquire(&lock->lock) == 0;
+}
+
+#elif defined(SMP_LOCK_TICKET)
+
+static inline void spin_lock(spinlock_t *lock)
+{
+    uint32_t ticket = atomic_add_u32_explicit(&lock->next, 1, ATOMIC_ACQUIRE);
+
+    while (lock->owner != ticket) {
+        /* Spin */
+    }
+    atomic_thread_fence(ATOMIC_ACQUIRE);
+}
+
+static inline void spin_unlock(spinlock_t *lock)
+{
+    /* Only the holder writes owner */
+    (void) atomic_add_u32_explicit(&lock->owner, 1, ATOMIC_RELEASE);
+}
+
+static inline bool spin_trylock(spinlock_t *lock)
+{
+    uint32_t owner = lock->owner;
+
+    /* Take ticket 'owner' only if nobody holds or waits for the lock */
+    return atomic_cas_u32_explicit(&lock->next, owner, owner + 1, ATOMIC_ACQUIRE) != 0;
+}
+
+#elif defined(SMP_LOCK_MCS)
+
+static inline void spin_lock(spinlock_t *lock)
+{
+    uint32_t me = (uint32_t) csr_read_hartid();
+    mcs_node_t *node = &lock->node[me];
+
+    node->next = 0;
+    node->locked = 1;
+
+    /* acq_rel: our node's reset before a successor can link behind it */
+    uint32_t pred = atomic_swap_u32_explicit(&lock->tail, me + 1, ATOMIC_ACQ_REL);
+    if (pred != 0) {
+        /* Link behind the predecessor, then spin on our own line */
+        spin_store_release(&lock->node[pred - 1].next, me + 1);
+        while (node->locked) {
+            /* Spin */
+        }
+    }
+    atomic_thread_fence(ATOMIC_ACQUIRE);
+}
+
+static inline void spin_unlock(spinlock_t *lock)
+{
+    uint32_t me = (uint32_t) csr_read_hartid();
+    mcs_node_t *node = &lock->node[me];
+
+    if (node->next == 0) {
+        /* No known successor: try to swing tail back to free */
+        if (atomic_cas_u32_explicit(&lock->tail, me + 1, 0, ATOMIC_RELEASE)) {
+            return;
+        }
+        /* A successor swapped tail but has not linked yet */
+        while (node->next == 0) {
+            /* Spin */
+        }
+    }
+    spin_store_release(&lock->node[node->next - 1].locked, 0);
+}
+
+static inline bool spin_trylock(spinlock_t *lock)
+{
+    uint32_t me = (uint32_t) csr_read_hartid();
+
+    lock->node[me].next = 0;
+    lock->node[me].locked = 1;
+    return atomic_cas_u32_explicit(&lock->tail, 0, me + 1, ATOMIC_ACQ_REL) != 0;
+}
+
+#else /* SMP_LOCK_LRSC */
+
 /**
  * @brief Acquire a spinlock (blocking)
  *
- * Uses LR/SC loop with acquire-release ordering.
+ * Uses an LR/SC loop; lr.w.aq gives acquire ordering.
  * Spins until the lock is acquired.
  *
  * @param lock Pointer to the spinlock
@@ -66,12 +372,11 @@ static inline void spin_lock(spinlock_t *lock)
 {
     uint32_t tmp;
     __asm__ __volatile__("1:\n\t"
-                         "lr.w   %0, (%1)\n\t"
-                         "bnez   %0, 1b\n\t"
-                         "li     %0, 1\n\t"
-                         "sc.w   %0, %0, (%1)\n\t"
-                         "bnez   %0, 1b\n\t"
-                         "fence  rw, rw\n\t"
+                         "lr.w.aq %0, (%1)\n\t"
+                         "bnez    %0, 1b\n\t"
+                         "li      %0, 1\n\t"
+                         "sc.w    %0, %0, (%1)\n\t"
+                         "bnez    %0, 1b\n\t"
                          : "=&r"(tmp)
                          : "r"(&lock->lock)
                          : "memory");
@@ -80,14 +385,13 @@ static inline void spin_lock(spinlock_t *lock)
 /**
  * @brief Release a spinlock
  *
- * Uses release fence before store.
+ * amoswap.w.rl orders all prior accesses before the release.
  *
  * @param lock Pointer to the spinlock
  */
 static inline void spin_unlock(spinlock_t *lock)
 {
-    __asm__ __volatile__("fence rw, rw" ::: "memory");
-    lock->lock = 0;
+    spin_store_release(&lock->lock, 0);
 }
 
 /**
@@ -100,16 +404,15 @@ static inline bool spin_trylock(spinlock_t *lock)
 {
     uint32_t tmp;
     uint32_t result;
-    __asm__ __volatile__("lr.w   %0, (%2)\n\t"
-                         "bnez   %0, 1f\n\t"
-                         "li     %0, 1\n\t"
-                         "sc.w   %1, %0, (%2)\n\t"
-                         "bnez   %1, 1f\n\t"
-                         "fence  rw, rw\n\t"
-                         "li     %1, 1\n\t"
-                         "j      2f\n\t"
+    __asm__ __volatile__("lr.w.aq %0, (%2)\n\t"
+                         "bnez    %0, 1f\n\t"
+                         "li      %0, 1\n\t"
+                         "sc.w    %1, %0, (%2)\n\t"
+                         "bnez    %1, 1f\n\t"
+                         "li      %1, 1\n\t"
+                         "j       2f\n\t"
                          "1:\n\t"
-                         "li     %1, 0\n\t"
+                         "li      %1, 0\n\t"
                          "2:\n\t"
                          : "=&r"(tmp), "=&r"(result)
                          : "r"(&lock->lock)
@@ -117,10 +420,94 @@ static inline bool spin_trylock(spinlock_t *lock)
     return result != 0;
 }
 
+#endif /* SMP_LOCK_* */
+
 /* =============================================================================
  * Barrier
  * ============================================================================= */
 
+/*
+ * Barrier algorithm, selected at build time (CMake SMP_BARRIER):
+ *
+ *   SMP_BARRIER_CENTRAL        counter + generation under a spinlock
+ *                              (default; arrivals serialize on the lock)
+ *   SMP_BARRIER_SENSE          sense-reversing: one amoadd per arrival,
+ *                              waiters spin on a sense word kept on its
+ *                              own cache line
+ *   SMP_BARRIER_TREE           4-ary combining tree: each hart waits for
+ *                              its children, reports to its parent, then
+ *                              is released by its parent; every flag is
+ *                              on the owning hart's cache line
+ *   SMP_BARRIER_DISSEMINATION  ceil(log2(n)) rounds; in round r hart h
+ *                              signals hart (h + 2^r) mod n and waits for
+ *                              hart (h - 2^r) mod n
+ *
+ * Tree and dissemination use mhartid as the participant index, so the
+ * participants of a barrier initialized with total = n must be harts
+ * 0 .. n-1 (true for smp_test_barrier and smp_parallel_run() jobs).
+ */
+#if !defined(SMP_BARRIER_CENTRAL) && !defined(SMP_BARRIER_SENSE) && !defined(SMP_BARRIER_TREE) && \
+    !defined(SMP_BARRIER_DISSEMINATION)
+#define SMP_BARRIER_CENTRAL
+#endif
+
+#if defined(SMP_BARRIER_SENSE)
+#define SMP_BARRIER_NAME "sense"
+#elif defined(SMP_BARRIER_TREE)
+#define SMP_BARRIER_NAME "tree"
+#elif defined(SMP_BARRIER_DISSEMINATION)
+#define SMP_BARRIER_NAME "dissemination"
+#else
+#define SMP_BARRIER_NAME "central"
+#endif
+
+/** Children per node in the combining tree barrier */
+#define SMP_BARRIER_TREE_ARITY 4
+
+/** Dissemination rounds needed for MAX_HARTS (ceil(log2(8))) */
+#define SMP_BARRIER_MAX_ROUNDS 3
+
+#if defined(SMP_BARRIER_SENSE)
+
+/**
+ * @brief Sense-reversing barrier
+ *
+ * count and sense sit on separate cache lines: arrivals only touch the
+ * count line (amoadd), waiters only read the sense line, which is
+ * written once per episode.
+ */
+typedef struct {
+    volatile uint32_t count __attribute__((aligned(64)));
+    uint32_t total;
+    volatile uint32_t sense __attribute__((aligned(64)));
+} barrier_t;
+
+#elif defined(SMP_BARRIER_TREE) || defined(SMP_BARRIER_DISSEMINATION)
+
+/**
+ * @brief Per-hart barrier flags, one cache line per hart
+ *
+ * Flags hold episode numbers rather than booleans and are compared with
+ * >=, so no reset is needed between episodes. epoch is private to the
+ * owning hart (its current episode).
+ */
+typedef struct {
+    volatile uint32_t flag[SMP_BARRIER_MAX_ROUNDS]; /**< tree: [0] = arrived */
+    volatile uint32_t release;                  /**< tree: set by parent */
+    uint32_t epoch;
+    uint8_t pad[64 - (SMP_BARRIER_MAX_ROUNDS + 2) * sizeof(uint32_t)];
+} barrier_slot_t;
+
+/**
+ * @brief Tree / dissemination barrier with per-hart padded flags
+ */
+typedef struct {
+    barrier_slot_t slot[MAX_HARTS] __attribute__((aligned(64)));
+    uint32_t total;
+} barrier_t;
+
+#else
+
 /**
  * @brief Centralized barrier for synchronizing all harts
  *
@@ -134,6 +521,8 @@ typedef struct {
     spinlock_t lock;
 } barrier_t;
 
+#endif /* SMP_BARRIER_* */
+
 /**
  * @brief Initialize a barrier
  *
@@ -145,8 +534,11 @@ void barrier_init(barrier_t *bar, uint32_t total);
 /**
  * @brief Wait at a barrier until all harts arrive
  *
- * The last hart to arrive resets the counter and advances the
- * generation, releasing all waiting harts.
+ * Central: the last hart to arrive resets the counter and advances the
+ * generation, releasing all waiting harts. See SMP_BARRIER_* above for
+ * the other algorithms. Every access a hart makes before the barrier
+ * happens before every access any hart makes after it: each variant
+ * releases on arrival and acquires on departure, with no full fence.
  *
  * @param bar Pointer to barrier
  */
@@ -190,6 +582,50 @@ uint32_t smp_get_harts_online(void);
  */
 uint32_t smp_get_num_harts(void);
 
+/* =============================================================================
+ * Inter-Processor Interrupts (CLINT MSIP)
+ * ============================================================================= */
+
+/**
+ * Each hart has a 32-bit MSIP register at CLINT_MSIP + 4 * hartid; writing
+ * 1 raises that hart's machine software interrupt, writing 0 clears it.
+ * With mie.MSIE set, a pending MSIP wakes the hart from wfi even when
+ * mstatus.MIE is clear (no trap is taken). gem5 SE mode has no CLINT.
+ */
+#if !(defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE))
+#define SMP_HAVE_IPI 1
+#endif
+
+#define SMP_MSIP_REG(hart) (*(volatile uint32_t *) (CLINT_MSIP + 4UL * (hart)))
+
+/**
+ * @brief Raise a machine software interrupt on a hart
+ * @param hart Target hart ID
+ */
+static inline void smp_send_ipi(uint32_t hart)
+{
+#if defined(SMP_HAVE_IPI)
+    mb(); /* Publish prior stores before the wakeup */
+    SMP_MSIP_REG(hart) = 1;
+#else
+    (void) hart;
+#endif
+}
+
+/**
+ * @brief Acknowledge (clear) the calling hart's software interrupt
+ * @param hart Calling hart ID
+ */
+static inline void smp_clear_ipi(uint32_t hart)
+{
+#if defined(SMP_HAVE_IPI)
+    SMP_MSIP_REG(hart) = 0;
+    mb(); /* Clear before re-checking for work */
+#else
+    (void) hart;
+#endif
+}
+
 /* =============================================================================
  * SMP Test Coordination
  * ============================================================================= */
@@ -197,7 +633,8 @@ uint32_t smp_get_num_harts(void);
 /**
  * @brief Global print lock for serialized console output
  *
- * Must be held when printing from any hart to avoid interleaved output.
+ * Must be held when printing from any hart to avoid interleaved output,
+ * unless console.h defines CONSOLE_LOCKFREE (per-hart UART/HTIF buffers).
  */
 extern spinlock_t smp_print_lock;
 
@@ -223,11 +660,40 @@ extern spinlock_t smp_test_lock;
  */
 extern volatile uint32_t smp_atomic_counter;
 
+/* =============================================================================
+ * Fork-Join Work Dispatch
+ * ============================================================================= */
+
+/**
+ * @brief Work function run on each participating hart
+ *
+ * @param hart Index of the calling hart (0 .. nharts-1)
+ * @param nharts Number of harts participating in this job
+ * @param arg Caller-provided argument (shared by all harts)
+ */
+typedef void (*smp_job_fn_t)(uint32_t hart, uint32_t nharts, void *arg);
+
+/**
+ * @brief Run a job on harts 0 .. nharts-1 and wait for all to finish
+ *
+ * Must be called by hart 0 after the secondary harts are online, with no
+ * scheduler tasks outstanding. Implemented by sched_broadcast(): parked
+ * harts are woken by IPI. Hart 0 runs its own share of the job. Harts
+ * >= nharts stay idle for this job. With nharts <= 1 the job runs inline
+ * on hart 0 without touching the other harts.
+ *
+ * @param fn Work function
+ * @param arg Argument passed to every invocation of fn
+ * @param nharts Number of harts to use (clamped to 1 .. NUM_HARTS)
+ */
+void smp_parallel_run(smp_job_fn_t fn, void *arg, uint32_t nharts);
+
 /**
  * @brief Entry point for secondary harts (called from startup.S)
  *
- * Secondary harts call this after being released. It coordinates
- * with hart 0 to participate in SMP tests.
+ * Secondary harts call this after being released. After announcing
+ * themselves they enter the scheduler loop (sched_worker_loop()) and
+ * run whatever hart 0 dispatches until the system exits.
  *
  * @param hartid The hart ID of the calling hart
  */
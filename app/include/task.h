@@ -0,0 +1,121 @@
+/**
+ * @file task.h
+ * @brief Preemptive round-robin tasks on the machine timer (ENABLE_PREEMPT)
+ *
+ * task_create() sets up to TASK_MAX tasks, each on its own stack;
+ * task_run() then time-slices them on the calling hart every
+ * TASK_SLICE_US microseconds of mtime until all have returned. The
+ * switch happens in the timer handler (trap.h): the outgoing task's
+ * integer registers are already in the trap frame on its stack, and the
+ * handler hands the trap exit the incoming task's frame instead.
+ *
+ * FP and vector registers are switched lazily from mstatus.FS / .VS:
+ *
+ *   - switch-out: the register file is saved only if the field reads
+ *     Dirty (the task wrote it since it was last saved or restored)
+ *   - switch-in: the incoming task's registers are restored only if it
+ *     has saved state and the register file does not hold it already
+ *     (the hart tracks whose state it holds)
+ *   - then the field is set to Clean, so the next write marks it Dirty
+ *
+ * The vector state is v0-v31 plus vl, vtype, vstart and vcsr; the FP state
+ * f0-f31 plus fcsr. A task that never touches FP or vector registers never
+ * pays for them. TASK_SAVE_EAGER saves and restores both on every switch
+ * instead, as a baseline for the same workload.
+ *
+ * One hart runs task_run() at a time; the caller's own context (including
+ * its FP/vector registers) is saved on the first switch and comes back
+ * when the last task returns. ENABLE_PREEMPT owns the machine timer
+ * interrupt, so it cannot be combined with ENABLE_PROFILER. Not available
+ * in gem5 SE mode (no machine mode, no CLINT).
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include <stdint.h>
+
+/* =============================================================================
+ * Configuration
+ * ============================================================================= */
+
+/** Time slice in microseconds of mtime (CMake TASK_SLICE_US) */
+#ifndef TASK_SLICE_US
+#define TASK_SLICE_US 200
+#endif
+
+/** Tasks per task_run() */
+#ifndef TASK_MAX
+#define TASK_MAX 4
+#endif
+
+/** Stack per task, in bytes */
+#ifndef TASK_STACK_SIZE
+#define TASK_STACK_SIZE 8192
+#endif
+
+/** Largest VLEN in bits the vector save areas hold; task_run() fails above it */
+#ifndef TASK_VLEN_MAX
+#define TASK_VLEN_MAX 1024
+#endif
+
+/* =============================================================================
+ * Types
+ * ============================================================================= */
+
+/** Task body; the task ends when it returns */
+typedef void (*task_fn_t)(void *arg);
+
+/** FP/vector context switch policy */
+typedef enum {
+    TASK_SAVE_LAZY,  /**< Save on Dirty, restore on owner change (mstatus.FS/VS) */
+    TASK_SAVE_EAGER, /**< Save and restore FP and vector state on every switch */
+} task_save_mode_t;
+
+/**
+ * @brief Context switch counters of one task_run()
+ *
+ * switch_cycles covers the C part of each switching tick, from handler
+ * entry to the frame hand-over; the integer save/restore in startup.S is
+ * the same for both modes and not included.
+ */
+typedef struct {
+    uint64_t switches;      /**< Ticks that changed the running context */
+    uint64_t switch_cycles; /**< Sum of the cycles of those ticks */
+    uint64_t f_saves;       /**< FP register file stores */
+    uint64_t f_restores;    /**< FP register file loads */
+    uint64_t v_saves;       /**< Vector register file stores */
+    uint64_t v_restores;    /**< Vector register file loads */
+    uint64_t bytes;         /**< Bytes moved by those stores and loads */
+} task_stats_t;
+
+/* =============================================================================
+ * API
+ * ============================================================================= */
+
+#if defined(ENABLE_PREEMPT)
+
+/**
+ * @brief Add a task for the next task_run()
+ * @param fn Task body
+ * @param arg Argument passed to fn
+ * @return Task index, or -1 if TASK_MAX tasks are already waiting
+ */
+int task_create(task_fn_t fn, void *arg);
+
+/**
+ * @brief Run the created tasks round-robin until all have returned
+ *
+ * The caller idles in wfi with the timer armed. Tasks run with mstatus.MIE
+ * set and must not disable interrupts for long: a slice only ends on a
+ * timer interrupt or when the task returns.
+ *
+ * @param mode FP/vector save policy
+ * @param stats Filled with this run's switch counters (may be NULL)
+ * @return 0 on success, -1 without tasks or if VLEN exceeds TASK_VLEN_MAX
+ */
+int task_run(task_save_mode_t mode, task_stats_t *stats);
+
+#endif /* ENABLE_PREEMPT */
+
+#endif /* TASK_H */
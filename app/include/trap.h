@@ -0,0 +1,97 @@
+/**
+ * @file trap.h
+ * @brief Machine-mode trap entry and interrupt handler registration
+ *
+ * startup.S installs _trap_vector in mtvec in vectored mode (MODE = 1):
+ * exceptions enter at the base, interrupt cause N at base + 4 * N. Each
+ * path saves x1-x31 and mepc/mcause/mtval into a trap_frame_t on the
+ * current stack (everything runs in M-mode, so there is no stack switch)
+ * and calls the C dispatcher below:
+ *
+ *   - Interrupts: the handler registered for the cause with
+ *     trap_set_handler() runs, then every register (and mepc, which the
+ *     handler may change) is restored and mret resumes the hart. A handler
+ *     may instead name another saved frame with trap_switch_frame(): the
+ *     exit path then restores that one, on its own stack (task.h).
+ *   - Exceptions: the cause and faulting PC are printed ("[TRAP] ..."),
+ *     and the hart parks in wfi. Nothing here recovers from a fault.
+ *
+ * Only the integer registers are saved: interrupt handlers must not touch
+ * the FP or vector registers (trap.c and prof.c are built with
+ * -fno-tree-vectorize for that reason).
+ *
+ * Unhandled interrupts are quietened rather than ignored: a machine
+ * software interrupt clears the hart's MSIP (it only has to wake wfi, see
+ * smp_send_ipi()), a timer interrupt pushes the hart's mtimecmp to the
+ * maximum, and anything else is masked in mie.
+ *
+ * Not available in gem5 SE mode, which runs in user mode.
+ */
+
+#ifndef TRAP_H
+#define TRAP_H
+
+#include <stdint.h>
+
+/* =============================================================================
+ * Trap Frame
+ * ============================================================================= */
+
+/** Interrupt causes with a handler slot (mcause without the interrupt bit) */
+#define TRAP_MAX_IRQ 16
+
+/**
+ * @brief Registers saved by the trap entry in startup.S
+ *
+ * regs[n] holds xn (regs[0] is unused, regs[2] is sp before the trap).
+ * startup.S stores at fixed offsets: keep the layout in sync.
+ */
+typedef struct {
+    uint64_t regs[32];
+    uint64_t mepc;   /* Resume PC (interrupts) or faulting PC (exceptions) */
+    uint64_t mcause; /* Interrupt bit + cause code */
+    uint64_t mtval;  /* Faulting address or instruction, if any */
+    uint64_t pad;    /* Keeps the frame a multiple of 16 bytes */
+} trap_frame_t;
+
+_Static_assert(sizeof(trap_frame_t) == 288, "startup.S TRAP_FRAME_SIZE");
+
+/** Interrupt handler; may update frame->mepc to resume elsewhere */
+typedef void (*trap_handler_fn_t)(trap_frame_t *frame);
+
+/* =============================================================================
+ * API
+ * ============================================================================= */
+
+/**
+ * @brief Install (or with NULL, remove) the handler for an interrupt cause
+ *
+ * Handlers are shared by all harts. Enable the source in mie and set
+ * mstatus.MIE on each hart that should take it.
+ *
+ * @param irq Interrupt cause (IRQ_M_SOFT, IRQ_M_TIMER, IRQ_M_EXT, ...)
+ * @param fn Handler, run with interrupts disabled
+ */
+void trap_set_handler(uint32_t irq, trap_handler_fn_t fn);
+
+/**
+ * @brief Resume a different frame when the current interrupt returns
+ *
+ * Only valid inside an interrupt handler. next must be a complete frame
+ * at the top of the stack it resumes on (sp after the switch is next + 1),
+ * e.g. one pushed by an earlier trap or built by hand for a new context.
+ *
+ * @param next Frame to restore instead of the interrupted one
+ */
+void trap_switch_frame(trap_frame_t *next);
+
+/**
+ * @brief Interrupt dispatcher, called from the startup.S vector table
+ * @return Frame to restore: frame itself, or the one passed to trap_switch_frame()
+ */
+trap_frame_t *trap_handle_interrupt(trap_frame_t *frame);
+
+/** Exception reporter, called from the startup.S vector table; does not return */
+void trap_handle_exception(trap_frame_t *frame);
+
+#endif /* TRAP_H */
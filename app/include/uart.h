@@ -2,8 +2,10 @@
  * @file uart.h
  * @brief UART driver for NS16550A (QEMU virt, gem5, Renode)
  *
- * Simple polled UART driver for bare-metal applications.
- * No interrupts, no buffering - direct register access.
+ * Polled UART driver for bare-metal applications. No interrupts.
+ * With UART_TX_RING (CMake option, default ON), writes go to a per-hart
+ * lock-free ring and are drained to the TX FIFO in batches; call
+ * uart_flush() to force everything out.
  */
 
 #ifndef UART_H
@@ -35,12 +37,19 @@ void uart_putc(char c);
 void uart_puts(const char *s);
 
 /**
- * @brief Write a buffer to UART
+ * @brief Write a buffer to UART ('\n' is sent as "\r\n", as in uart_puts())
  * @param buf Buffer to write
  * @param len Length of buffer
  */
 void uart_write(const char *buf, size_t len);
 
+/**
+ * @brief Drain all buffered output to the UART (blocking)
+ *
+ * No-op without UART_TX_RING.
+ */
+void uart_flush(void);
+
 /**
  * @brief Read a single character from UART (blocking)
  * @return Character read
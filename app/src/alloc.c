@@ -0,0 +1,153 @@
+/**
+ * @file alloc.c
+ * @brief Arena and fixed-block pool allocators over the linker heap
+ *
+ * See alloc.h. All state is per hart or per object; nothing here takes a
+ * lock. The per-hart arena descriptors live in .bss.smp_shared, one cache
+ * line each, so a hart bumping its arena never touches another hart's
+ * line.
+ */
+
+#include "alloc.h"
+
+#include "platform.h"
+#include "smp.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ENABLE_RVV)
+#include "rvv/rvv_detect.h"
+#endif
+
+/* =============================================================================
+ * Per-Hart Arenas
+ * ============================================================================= */
+
+/** One arena per hart, padded to a cache line */
+typedef struct {
+    arena_t arena;
+    uint8_t pad[SMP_CACHE_LINE - sizeof(arena_t)];
+} heap_slot_t;
+
+static heap_slot_t heap_slots[MAX_HARTS] __smp_shared;
+
+/* =============================================================================
+ * Helpers
+ * ============================================================================= */
+
+static inline uintptr_t align_up(uintptr_t x, size_t align)
+{
+    return (x + align - 1) & ~(uintptr_t) (align - 1);
+}
+
+static inline size_t clamp_align(size_t align)
+{
+    return align < ALLOC_ALIGN_MIN ? ALLOC_ALIGN_MIN : align;
+}
+
+/* =============================================================================
+ * Arena
+ * ============================================================================= */
+
+void arena_init(arena_t *arena, void *base, size_t size)
+{
+    arena->base = (uintptr_t) base;
+    arena->end = arena->base + size;
+    arena->cur = arena->base;
+}
+
+void *arena_alloc(arena_t *arena, size_t size, size_t align)
+{
+    uintptr_t p = align_up(arena->cur, clamp_align(align));
+
+    /* p < cur: the round-up wrapped around */
+    if (p < arena->cur || p > arena->end || size > arena->end - p) {
+        return NULL;
+    }
+    arena->cur = p + size;
+    return (void *) p;
+}
+
+/* =============================================================================
+ * Pool
+ * ============================================================================= */
+
+bool pool_init(pool_t *pool, arena_t *arena, size_t block_size, uint32_t nblocks, size_t align)
+{
+    align = clamp_align(align);
+    block_size = (size_t) align_up(block_size ? block_size : 1, align);
+
+    pool->free_list = NULL;
+    pool->block_size = block_size;
+    pool->nblocks = 0;
+    pool->nfree = 0;
+    pool->base = 0;
+
+    if (nblocks != 0 && block_size > SIZE_MAX / nblocks) {
+        return false;
+    }
+    uint8_t *mem = (uint8_t *) arena_alloc(arena, block_size * nblocks, align);
+    if (!mem) {
+        return false;
+    }
+
+    /* Link back to front so pool_alloc() hands out ascending addresses */
+    for (uint32_t i = nblocks; i > 0; i--) {
+        pool_free(pool, mem + (size_t) (i - 1) * block_size);
+    }
+    pool->base = (uintptr_t) mem;
+    pool->nblocks = nblocks;
+    return true;
+}
+
+bool pool_owns(const pool_t *pool, const void *ptr)
+{
+    uintptr_t p = (uintptr_t) ptr;
+
+    if (p < pool->base || p >= pool->base + (uintptr_t) pool->block_size * pool->nblocks) {
+        return false;
+    }
+    return (p - pool->base) % pool->block_size == 0;
+}
+
+/* =============================================================================
+ * Heap
+ * ============================================================================= */
+
+void heap_init(void)
+{
+    uintptr_t start = align_up((uintptr_t) __heap_start, SMP_CACHE_LINE);
+    uintptr_t end = (uintptr_t) __heap_end & ~(uintptr_t) (SMP_CACHE_LINE - 1);
+    size_t slice = 0;
+
+    if (end > start) {
+        slice = ((end - start) / NUM_HARTS) & ~(size_t) (SMP_CACHE_LINE - 1);
+    }
+
+    for (uint32_t h = 0; h < MAX_HARTS; h++) {
+        size_t size = h < NUM_HARTS ? slice : 0;
+        arena_init(&heap_slots[h].arena, (void *) (start + (uintptr_t) h * slice), size);
+    }
+}
+
+size_t heap_size(void)
+{
+    return (size_t) (__heap_end - __heap_start);
+}
+
+arena_t *heap_hart_arena(uint32_t hart)
+{
+    return &heap_slots[hart].arena;
+}
+
+size_t alloc_vec_align(void)
+{
+#if defined(ENABLE_RVV)
+    size_t vlenb = rvv_available() ? (size_t) rvv_get_vlenb() : 0;
+    return vlenb > ALLOC_ALIGN_LINE ? vlenb : ALLOC_ALIGN_LINE;
+#else
+    return ALLOC_ALIGN_LINE;
+#endif
+}
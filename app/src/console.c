@@ -0,0 +1,311 @@
+/**
+ * @file console.c
+ * @brief Buffered console and printf-style formatting
+ *
+ * Characters accumulate in the calling hart's line buffer and reach the
+ * backend once per line, so a report line such as
+ * "[RVV] vec_add: scalar=... vec=... cycles" costs one UART ring append,
+ * one HTIF request or one gem5 SE write ecall instead of one per string
+ * or per digit.
+ */
+
+#include "console.h"
+
+#include "csr.h"
+#include "platform.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+#include "gem5_se_io.h"
+#elif defined(PLATFORM_QEMU_VIRT) || defined(PLATFORM_GEM5) || defined(PLATFORM_RENODE)
+#include "uart.h"
+#elif defined(PLATFORM_SPIKE)
+#include "htif.h"
+#else
+#error "No platform defined for console output"
+#endif
+
+/* =============================================================================
+ * Backend Selection
+ * ============================================================================= */
+
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+static const console_backend_t console_backend = {"gem5-se", gem5_se_write, NULL};
+#elif defined(PLATFORM_QEMU_VIRT) || defined(PLATFORM_GEM5) || defined(PLATFORM_RENODE)
+static const console_backend_t console_backend = {"uart", uart_write, uart_flush};
+#elif defined(PLATFORM_SPIKE)
+static const console_backend_t console_backend = {"htif", htif_write, htif_flush};
+#endif
+
+const console_backend_t *console_get_backend(void)
+{
+    return &console_backend;
+}
+
+/* =============================================================================
+ * Line Buffers
+ * ============================================================================= */
+
+/** Per-hart line buffer, written only by its hart */
+typedef struct {
+    char buf[CONSOLE_LINE_SIZE];
+    size_t len;
+} __attribute__((aligned(64))) console_line_t;
+
+static console_line_t console_lines[NUM_HARTS];
+
+static inline console_line_t *console_line(void)
+{
+#if NUM_HARTS > 1
+    return &console_lines[csr_read_hartid()];
+#else
+    /* gem5 SE runs in U-mode, where mhartid is not readable */
+    return &console_lines[0];
+#endif
+}
+
+static void console_line_flush(console_line_t *line)
+{
+    if (line->len != 0) {
+        console_backend.write(line->buf, line->len);
+        line->len = 0;
+    }
+}
+
+static inline void console_emit(console_line_t *line, char c)
+{
+    line->buf[line->len++] = c;
+    if (c == '\n' || line->len == CONSOLE_LINE_SIZE) {
+        console_line_flush(line);
+    }
+}
+
+static void console_emit_n(console_line_t *line, const char *s, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        console_emit(line, s[i]);
+    }
+}
+
+/* =============================================================================
+ * Output
+ * ============================================================================= */
+
+void console_putc(char c)
+{
+    console_emit(console_line(), c);
+}
+
+void console_puts(const char *s)
+{
+    if (s == NULL) {
+        return;
+    }
+
+    console_line_t *line = console_line();
+    while (*s) {
+        console_emit(line, *s++);
+    }
+}
+
+void console_write(const char *buf, size_t len)
+{
+    if (buf == NULL) {
+        return;
+    }
+
+    console_emit_n(console_line(), buf, len);
+}
+
+void console_flush(void)
+{
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        console_line_flush(&console_lines[h]);
+    }
+    if (console_backend.flush != NULL) {
+        console_backend.flush();
+    }
+}
+
+/* =============================================================================
+ * Formatting
+ * ============================================================================= */
+
+/** Digits of a 64-bit value in any base >= 8, plus sign */
+#define CONSOLE_DIGITS_MAX 24
+
+/** Emit value in base with sign, padding and alignment */
+static void console_emit_number(console_line_t *line, uint64_t value, unsigned base, bool upper,
+                                bool negative, unsigned width, bool zero_pad, bool left)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[CONSOLE_DIGITS_MAX];
+    unsigned n = 0;
+
+    /* Digits fill tmp from the end, so no reverse pass is needed */
+    do {
+        tmp[CONSOLE_DIGITS_MAX - 1 - n++] = digits[value % base];
+        value /= base;
+    } while (value != 0);
+
+    unsigned len = n + (negative ? 1U : 0U);
+    unsigned pad = width > len ? width - len : 0;
+
+    if (!left && !zero_pad) {
+        for (; pad > 0; pad--) {
+            console_emit(line, ' ');
+        }
+    }
+    if (negative) {
+        console_emit(line, '-');
+    }
+    if (!left) {
+        for (; pad > 0; pad--) {
+            console_emit(line, '0');
+        }
+    }
+    console_emit_n(line, &tmp[CONSOLE_DIGITS_MAX - n], n);
+    for (; pad > 0; pad--) {
+        console_emit(line, ' ');
+    }
+}
+
+void console_vprintf(const char *fmt, va_list ap)
+{
+    console_line_t *line = console_line();
+
+    if (fmt == NULL) {
+        return;
+    }
+
+    while (*fmt) {
+        if (*fmt != '%') {
+            console_emit(line, *fmt++);
+            continue;
+        }
+
+        const char *spec = fmt++;
+        bool left = false;
+        bool zero_pad = false;
+        unsigned width = 0;
+        int longs = 0;
+        bool size = false;
+
+        /* Flags */
+        for (;; fmt++) {
+            if (*fmt == '-') {
+                left = true;
+            } else if (*fmt == '0') {
+                zero_pad = true;
+            } else {
+                break;
+            }
+        }
+
+        /* Width */
+        while (*fmt >= '0' && *fmt <= '9') {
+            width = width * 10 + (unsigned) (*fmt++ - '0');
+        }
+
+        /* Length */
+        while (*fmt == 'l') {
+            longs++;
+            fmt++;
+        }
+        if (*fmt == 'z') {
+            size = true;
+            fmt++;
+        }
+
+        char conv = *fmt;
+        if (conv == '\0') {
+            /* Truncated specifier: print it as text */
+            console_emit_n(line, spec, (size_t) (fmt - spec));
+            break;
+        }
+        fmt++;
+
+        switch (conv) {
+        case 'd':
+        case 'i': {
+            int64_t v;
+            if (size) {
+                v = (int64_t) va_arg(ap, long);
+            } else if (longs >= 2) {
+                v = (int64_t) va_arg(ap, long long);
+            } else if (longs == 1) {
+                v = (int64_t) va_arg(ap, long);
+            } else {
+                v = (int64_t) va_arg(ap, int);
+            }
+            uint64_t mag = v < 0 ? (uint64_t) 0 - (uint64_t) v : (uint64_t) v;
+            console_emit_number(line, mag, 10, false, v < 0, width, zero_pad, left);
+            break;
+        }
+        case 'u':
+        case 'x':
+        case 'X': {
+            uint64_t v;
+            if (size) {
+                v = (uint64_t) va_arg(ap, size_t);
+            } else if (longs >= 2) {
+                v = (uint64_t) va_arg(ap, unsigned long long);
+            } else if (longs == 1) {
+                v = (uint64_t) va_arg(ap, unsigned long);
+            } else {
+                v = (uint64_t) va_arg(ap, unsigned int);
+            }
+            console_emit_number(line, v, conv == 'u' ? 10 : 16, conv == 'X', false, width, zero_pad,
+                                left);
+            break;
+        }
+        case 'p':
+            console_emit_n(line, "0x", 2);
+            console_emit_number(line, (uint64_t) (uintptr_t) va_arg(ap, void *), 16, false, false,
+                                width, zero_pad, left);
+            break;
+        case 'c':
+            console_emit(line, (char) va_arg(ap, int));
+            break;
+        case 's': {
+            const char *s = va_arg(ap, const char *);
+            size_t len = 0;
+            if (s == NULL) {
+                s = "(null)";
+            }
+            while (s[len]) {
+                len++;
+            }
+            unsigned pad = width > len ? width - (unsigned) len : 0;
+            if (!left) {
+                for (; pad > 0; pad--) {
+                    console_emit(line, ' ');
+                }
+            }
+            console_emit_n(line, s, len);
+            for (; pad > 0; pad--) {
+                console_emit(line, ' ');
+            }
+            break;
+        }
+        case '%':
+            console_emit(line, '%');
+            break;
+        default:
+            /* Unsupported conversion: print the specifier verbatim */
+            console_emit_n(line, spec, (size_t) (fmt - spec));
+            break;
+        }
+    }
+}
+
+void console_printf(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    console_vprintf(fmt, ap);
+    va_end(ap);
+}
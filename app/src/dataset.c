@@ -0,0 +1,104 @@
+/**
+ * @file dataset.c
+ * @brief Host-provided input datasets, mapped zero-copy (gem5 SE)
+ *
+ * dataset_map() finds the file size with lseek(SEEK_END), maps the whole
+ * file PROT_READ/MAP_PRIVATE and closes the descriptor (the mapping stays
+ * valid). The header is checked against the mapped length before any
+ * element is handed out.
+ */
+
+#include "dataset.h"
+
+#include "gem5_se_io.h"
+
+#include <stdbool.h>
+
+dataset_status_t dataset_map(dataset_t *ds, const char *path)
+{
+    *ds = (dataset_t) {0};
+
+#if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+    long fd = gem5_se_openat(GEM5_SE_AT_FDCWD, path, GEM5_SE_O_RDONLY);
+    if (fd < 0) {
+        return DATASET_ERR_OPEN;
+    }
+
+    long size = gem5_se_lseek((int) fd, 0, GEM5_SE_SEEK_END);
+    if (size < (long) sizeof(dataset_header_t)) {
+        gem5_se_close((int) fd);
+        return size < 0 ? DATASET_ERR_OPEN : DATASET_ERR_FORMAT;
+    }
+
+    void *map = gem5_se_mmap((void *) 0, (size_t) size, GEM5_SE_PROT_READ, GEM5_SE_MAP_PRIVATE,
+                             (int) fd, 0);
+    gem5_se_close((int) fd);
+    if (GEM5_SE_MMAP_FAILED(map)) {
+        return DATASET_ERR_MAP;
+    }
+
+    const dataset_header_t *h = (const dataset_header_t *) map;
+    uint64_t bytes = (uint64_t) size;
+    bool ok = h->magic == DATASET_MAGIC && h->version == DATASET_VERSION &&
+              h->dtype == DATASET_DTYPE_F32 && h->elem_size == sizeof(float) &&
+              h->data_offset >= sizeof(*h) && (h->data_offset & 63) == 0 &&
+              h->data_offset <= bytes && h->cols != 0 &&
+              h->rows <= h->data_bytes / h->elem_size / h->cols &&
+              h->rows * h->cols * h->elem_size == h->data_bytes &&
+              h->data_bytes <= bytes - h->data_offset;
+    if (!ok) {
+        gem5_se_munmap(map, (size_t) size);
+        return DATASET_ERR_FORMAT;
+    }
+
+    ds->header = h;
+    ds->data = (const uint8_t *) map + h->data_offset;
+    ds->rows = h->rows;
+    ds->cols = h->cols;
+    ds->dtype = h->dtype;
+    ds->map_bytes = (size_t) size;
+    return DATASET_OK;
+#else
+    (void) path;
+    return DATASET_ERR_UNSUPPORTED;
+#endif
+}
+
+void dataset_unmap(dataset_t *ds)
+{
+    if (ds->header != (const dataset_header_t *) 0) {
+        gem5_se_munmap((void *) ds->header, ds->map_bytes);
+    }
+    *ds = (dataset_t) {0};
+}
+
+const char *dataset_strerror(dataset_status_t status)
+{
+    switch (status) {
+    case DATASET_OK:
+        return "ok";
+    case DATASET_ERR_UNSUPPORTED:
+        return "no host file system (gem5 SE only)";
+    case DATASET_ERR_OPEN:
+        return "cannot open";
+    case DATASET_ERR_MAP:
+        return "mmap failed";
+    case DATASET_ERR_FORMAT:
+        return "not a float32 RVDS dataset";
+    }
+    return "unknown";
+}
+
+void *dataset_scratch(size_t bytes)
+{
+    void *buf = gem5_se_mmap((void *) 0, bytes, GEM5_SE_PROT_READ | GEM5_SE_PROT_WRITE,
+                             GEM5_SE_MAP_PRIVATE | GEM5_SE_MAP_ANONYMOUS, -1, 0);
+    return GEM5_SE_MMAP_FAILED(buf) ? (void *) 0 : buf;
+}
+
+void dataset_scratch_free(void *buf, size_t bytes)
+{
+    if (buf != (void *) 0) {
+        gem5_se_munmap(buf, bytes);
+    }
+}
@@ -6,8 +6,14 @@
  * gem5 SE mode (Process + SEWorkload) intercepts ecall and emulates them.
  *
  * Syscall numbers (RISC-V Linux ABI):
- *   - write(fd, buf, len):  a7 = 64
- *   - exit_group(code):    a7 = 94
+ *   - openat(dirfd, path, flags, mode):           a7 = 56
+ *   - close(fd):                                  a7 = 57
+ *   - lseek(fd, offset, whence):                  a7 = 62
+ *   - read(fd, buf, len):                         a7 = 63
+ *   - write(fd, buf, len):                        a7 = 64
+ *   - exit_group(code):                           a7 = 94
+ *   - munmap(addr, len):                          a7 = 215
+ *   - mmap(addr, len, prot, flags, fd, offset):   a7 = 222
  *
  * This is only compiled when PLATFORM_GEM5 and GEM5_MODE_SE are defined.
  */
@@ -24,8 +30,14 @@
  * RISC-V Linux Syscall Numbers
  * ============================================================================= */
 
+#define SYS_openat 56
+#define SYS_close 57
+#define SYS_lseek 62
+#define SYS_read 63
 #define SYS_write 64
 #define SYS_exit_group 94
+#define SYS_munmap 215
+#define SYS_mmap 222
 
 #define STDOUT_FD 1
 
@@ -33,6 +45,29 @@
  * Syscall Interface
  * ============================================================================= */
 
+static inline long syscall6(long number, long arg0, long arg1, long arg2, long arg3, long arg4,
+                            long arg5)
+{
+    register long a7 __asm__("a7") = number;
+    register long a0 __asm__("a0") = arg0;
+    register long a1 __asm__("a1") = arg1;
+    register long a2 __asm__("a2") = arg2;
+    register long a3 __asm__("a3") = arg3;
+    register long a4 __asm__("a4") = arg4;
+    register long a5 __asm__("a5") = arg5;
+
+    __asm__ __volatile__("ecall"
+                         : "+r"(a0)
+                         : "r"(a7), "r"(a1), "r"(a2), "r"(a3), "r"(a4), "r"(a5)
+                         : "memory");
+    return a0;
+}
+
+static inline long syscall4(long number, long arg0, long arg1, long arg2, long arg3)
+{
+    return syscall6(number, arg0, arg1, arg2, arg3, 0, 0);
+}
+
 static inline long syscall3(long number, long arg0, long arg1, long arg2)
 {
     register long a7 __asm__("a7") = number;
@@ -98,6 +133,60 @@ void gem5_se_exit(int exit_code)
     }
 }
 
+/* =============================================================================
+ * Command Line
+ * ============================================================================= */
+
+/** Initial sp saved by startup.S: argc, then argv[0..argc-1], then NULL */
+extern const long *gem5_se_entry_sp;
+
+int gem5_se_argc(void)
+{
+    return gem5_se_entry_sp ? (int) gem5_se_entry_sp[0] : 0;
+}
+
+const char *gem5_se_argv(int i)
+{
+    if (i < 0 || i >= gem5_se_argc()) {
+        return (const char *) 0;
+    }
+    return (const char *) gem5_se_entry_sp[1 + i];
+}
+
+/* =============================================================================
+ * Files and Memory Mappings
+ * ============================================================================= */
+
+long gem5_se_openat(int dirfd, const char *path, int flags)
+{
+    return syscall4(SYS_openat, dirfd, (long) path, flags, 0);
+}
+
+long gem5_se_read(int fd, void *buf, size_t len)
+{
+    return syscall3(SYS_read, fd, (long) buf, (long) len);
+}
+
+long gem5_se_lseek(int fd, long offset, int whence)
+{
+    return syscall3(SYS_lseek, fd, offset, whence);
+}
+
+long gem5_se_close(int fd)
+{
+    return syscall1(SYS_close, fd);
+}
+
+void *gem5_se_mmap(void *addr, size_t len, int prot, int flags, int fd, long offset)
+{
+    return (void *) syscall6(SYS_mmap, (long) addr, (long) len, prot, flags, fd, offset);
+}
+
+long gem5_se_munmap(void *addr, size_t len)
+{
+    return syscall3(SYS_munmap, (long) addr, (long) len, 0);
+}
+
 #else /* Not gem5 SE mode */
 
 /* Stub implementations for non-SE builds */
@@ -121,5 +210,56 @@ void gem5_se_exit(int exit_code)
 {
     (void) exit_code;
 }
+int gem5_se_argc(void)
+{
+    return 0;
+}
+const char *gem5_se_argv(int i)
+{
+    (void) i;
+    return (const char *) 0;
+}
+long gem5_se_openat(int dirfd, const char *path, int flags)
+{
+    (void) dirfd;
+    (void) path;
+    (void) flags;
+    return -GEM5_SE_ENOSYS;
+}
+long gem5_se_read(int fd, void *buf, size_t len)
+{
+    (void) fd;
+    (void) buf;
+    (void) len;
+    return -GEM5_SE_ENOSYS;
+}
+long gem5_se_lseek(int fd, long offset, int whence)
+{
+    (void) fd;
+    (void) offset;
+    (void) whence;
+    return -GEM5_SE_ENOSYS;
+}
+long gem5_se_close(int fd)
+{
+    (void) fd;
+    return -GEM5_SE_ENOSYS;
+}
+void *gem5_se_mmap(void *addr, size_t len, int prot, int flags, int fd, long offset)
+{
+    (void) addr;
+    (void) len;
+    (void) prot;
+    (void) flags;
+    (void) fd;
+    (void) offset;
+    return (void *) (long) -GEM5_SE_ENOSYS;
+}
+long gem5_se_munmap(void *addr, size_t len)
+{
+    (void) addr;
+    (void) len;
+    return -GEM5_SE_ENOSYS;
+}
 
 #endif /* PLATFORM_GEM5 && GEM5_MODE_SE */
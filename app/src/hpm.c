@@ -0,0 +1,203 @@
+/**
+ * @file hpm.c
+ * @brief Performance counter programming, calibration and report
+ */
+
+#include "hpm.h"
+
+#include "console.h"
+#include "csr.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Event Table
+ * ============================================================================= */
+
+typedef struct {
+    const char *name;
+    uint64_t selector;
+} hpm_event_info_t;
+
+static const hpm_event_info_t hpm_events[HPM_EVENT_COUNT] = {
+    [HPM_EVENT_NONE] = {"none", 0},
+    [HPM_EVENT_L1D_MISS] = {"l1d_miss", HPM_SEL_L1D_MISS},
+    [HPM_EVENT_L1I_MISS] = {"l1i_miss", HPM_SEL_L1I_MISS},
+    [HPM_EVENT_BRANCH_MISS] = {"br_miss", HPM_SEL_BRANCH_MISS},
+    [HPM_EVENT_DTLB_MISS] = {"dtlb_miss", HPM_SEL_DTLB_MISS},
+};
+
+/* =============================================================================
+ * Harness State
+ * ============================================================================= */
+
+static hpm_event_t hpm_slots[HPM_MAX_EVENTS];
+static bool hpm_live[HPM_MAX_EVENTS];
+static uint32_t hpm_nslots;
+
+/** Counts of an empty measurement; zero until calibrated */
+static hpm_sample_t hpm_cost;
+
+/* =============================================================================
+ * Setup
+ * ============================================================================= */
+
+static void hpm_program(uint32_t slot, hpm_event_t event)
+{
+    hpm_slots[slot] = event;
+    hpm_live[slot] = false;
+
+#if !(defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE))
+    unsigned counter = CSR_HPM_FIRST + slot;
+    uint64_t selector = hpm_events[event].selector;
+
+    csr_write_mhpmevent(counter, selector);
+    csr_write_mhpmcounter(counter, 0);
+
+    /* WARL: an unimplemented counter reads its selector back as zero */
+    hpm_live[slot] = selector != 0 && csr_read_mhpmevent(counter) == selector;
+#endif
+}
+
+static void hpm_calibrate(void)
+{
+    hpm_sample_t start, delta, best;
+
+    hpm_cost = (hpm_sample_t) {0};
+
+    for (uint32_t run = 0; run < HPM_CALIBRATE_RUNS; run++) {
+        hpm_begin(&start);
+        hpm_end(&start, &delta);
+
+        if (run == 0) {
+            best = delta;
+            continue;
+        }
+        if (delta.cycles < best.cycles) {
+            best.cycles = delta.cycles;
+        }
+        if (delta.instret < best.instret) {
+            best.instret = delta.instret;
+        }
+        for (uint32_t i = 0; i < HPM_MAX_EVENTS; i++) {
+            if (delta.events[i] < best.events[i]) {
+                best.events[i] = delta.events[i];
+            }
+        }
+    }
+
+    hpm_cost = best;
+}
+
+void hpm_init(const hpm_event_t *events, uint32_t count)
+{
+    if (count > HPM_MAX_EVENTS) {
+        count = HPM_MAX_EVENTS;
+    }
+
+#if !(defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE))
+    /* Firmware or a previous run may have inhibited counters: let them all count */
+    csr_write_mcountinhibit(0);
+#endif
+
+    for (uint32_t slot = 0; slot < HPM_MAX_EVENTS; slot++) {
+        hpm_event_t event = HPM_EVENT_NONE;
+        if (slot < count && events[slot] < HPM_EVENT_COUNT) {
+            event = events[slot];
+        }
+        hpm_program(slot, event);
+    }
+    hpm_nslots = count;
+
+    hpm_calibrate();
+}
+
+uint32_t hpm_num_events(void)
+{
+    return hpm_nslots;
+}
+
+hpm_event_t hpm_slot_event(uint32_t slot)
+{
+    return slot < HPM_MAX_EVENTS ? hpm_slots[slot] : HPM_EVENT_NONE;
+}
+
+bool hpm_slot_live(uint32_t slot)
+{
+    return slot < HPM_MAX_EVENTS && hpm_live[slot];
+}
+
+const char *hpm_event_name(hpm_event_t event)
+{
+    return event < HPM_EVENT_COUNT ? hpm_events[event].name : "unknown";
+}
+
+const hpm_sample_t *hpm_overhead(void)
+{
+    return &hpm_cost;
+}
+
+/* =============================================================================
+ * Sampling
+ * ============================================================================= */
+
+static inline uint64_t hpm_sub(uint64_t end, uint64_t start, uint64_t cost)
+{
+    uint64_t d = end - start;
+    return d > cost ? d - cost : 0;
+}
+
+void hpm_delta(const hpm_sample_t *start, const hpm_sample_t *end, hpm_sample_t *delta)
+{
+    delta->cycles = hpm_sub(end->cycles, start->cycles, hpm_cost.cycles);
+    delta->instret = hpm_sub(end->instret, start->instret, hpm_cost.instret);
+    for (uint32_t i = 0; i < HPM_MAX_EVENTS; i++) {
+        delta->events[i] = hpm_sub(end->events[i], start->events[i], hpm_cost.events[i]);
+    }
+}
+
+/* =============================================================================
+ * Reporting
+ * ============================================================================= */
+
+/** Print num/den as "N.NN", or "n/a" when den is 0 */
+static void hpm_print_ratio(uint64_t num, uint64_t den)
+{
+    if (den == 0) {
+        console_puts("n/a");
+        return;
+    }
+
+    uint64_t x100 = num * 100 / den;
+    console_printf("%lu.%02lu", x100 / 100, x100 % 100);
+}
+
+void hpm_report(const char *name, const hpm_sample_t *delta, size_t elements)
+{
+    console_printf("[HPM] %s n=%zu cycles=%lu instret=%lu", name, elements, delta->cycles,
+                   delta->instret);
+    console_puts(" IPC=");
+    hpm_print_ratio(delta->instret, delta->cycles);
+    if (elements != 0) {
+        console_puts(" cyc/elem=");
+        hpm_print_ratio(delta->cycles, elements);
+    }
+
+    for (uint32_t i = 0; i < hpm_nslots; i++) {
+        const char *ev = hpm_event_name(hpm_slots[i]);
+
+        if (!hpm_live[i]) {
+            console_printf(" %s=n/a", ev);
+            continue;
+        }
+        console_printf(" %s=%lu", ev, delta->events[i]);
+        if (elements != 0) {
+            console_putc('(');
+            hpm_print_ratio(delta->events[i], elements);
+            console_puts("/elem)");
+        }
+    }
+    console_puts("\n");
+}
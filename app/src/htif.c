@@ -5,11 +5,19 @@
  * Spike uses HTIF for host-target communication instead of MMIO UART.
  * HTIF uses two special memory locations: tohost and fromhost.
  *
- * For console output, we use the syscall emulation interface.
+ * Console output is buffered per hart and sent a whole buffer at a time
+ * through the syscall device (HTIF_DEV_SYSCALL): tohost points at a
+ * magic_mem frame {SYS_write, fd, buf, len}, which the host front end
+ * executes before acknowledging through fromhost. A buffer is flushed on
+ * newline, when full, and on htif_poweroff(). One round trip per line
+ * replaces one tohost/fromhost handshake per byte. HTIF_BATCHED_WRITE=OFF
+ * restores the per-byte console device (HTIF_DEV_CONSOLE).
  */
 
 #include "htif.h"
 
+#include "atomic.h"
+#include "csr.h"
 #include "platform.h"
 
 #include <stdbool.h>
@@ -33,6 +41,11 @@
 #define HTIF_CMD(dev, cmd, data)                                                                   \
     (((uint64_t) (dev) << 56) | ((uint64_t) (cmd) << 48) | ((data) & 0xFFFFFFFFFFFFULL))
 
+/* Host syscall numbers (RISC-V Linux ABI, as used by the Spike front end) */
+#define HTIF_SYS_WRITE 64
+
+#define HTIF_FD_STDOUT 1
+
 /*
  * HTIF tohost/fromhost registers.
  * These symbols are defined in the Spike linker script (spike.ld).
@@ -41,6 +54,127 @@
 extern volatile uint64_t tohost;
 extern volatile uint64_t fromhost;
 
+/* =============================================================================
+ * Host Requests
+ * ============================================================================= */
+
+/** Serializes tohost/fromhost use across harts */
+static volatile uint32_t htif_busy;
+
+static inline void htif_lock(void)
+{
+    while (atomic_swap_u32(&htif_busy, 1) != 0) {
+        /* Spin */
+    }
+}
+
+static inline void htif_unlock(void)
+{
+    atomic_store_u32(&htif_busy, 0);
+}
+
+#if defined(HTIF_BATCHED_WRITE)
+
+/** Syscall frame: {num, a0, a1, a2, ...}; the host writes the result to [0] */
+static volatile uint64_t htif_magic_mem[8] __attribute__((aligned(64)));
+
+/** Send one syscall frame and wait for the host to complete it */
+static uint64_t htif_syscall(uint64_t num, uint64_t a0, uint64_t a1, uint64_t a2)
+{
+    htif_magic_mem[0] = num;
+    htif_magic_mem[1] = a0;
+    htif_magic_mem[2] = a1;
+    htif_magic_mem[3] = a2;
+    mb(); /* Frame and syscall buffer in memory before the host reads them */
+
+    /* Even payload = pointer to frame (odd payloads are exit codes) */
+    tohost = HTIF_CMD(HTIF_DEV_SYSCALL, 0, (uint64_t) (uintptr_t) htif_magic_mem);
+
+    while (fromhost == 0) {
+        /* Wait for the host to run the syscall */
+    }
+    fromhost = 0;
+    mb();
+
+    return htif_magic_mem[0];
+}
+
+#endif /* HTIF_BATCHED_WRITE */
+
+/** Send buf to the host console (caller holds htif_busy) */
+static void htif_send(const char *buf, size_t len)
+{
+    if (len == 0) {
+        return;
+    }
+
+#if defined(HTIF_BATCHED_WRITE)
+    htif_syscall(HTIF_SYS_WRITE, HTIF_FD_STDOUT, (uint64_t) (uintptr_t) buf, len);
+#else
+    for (size_t i = 0; i < len; i++) {
+        /* Wait for previous command to complete */
+        while (tohost != 0) {
+            fromhost = 0;
+        }
+
+        /* Write character using console device */
+        tohost = HTIF_CMD(HTIF_DEV_CONSOLE, HTIF_CMD_WRITE, (uint8_t) buf[i]);
+
+        /* Wait for completion */
+        while (tohost != 0) {
+            fromhost = 0;
+        }
+    }
+#endif
+}
+
+/* =============================================================================
+ * Buffered Console
+ * ============================================================================= */
+
+#ifndef HTIF_CONSOLE_BUF_SIZE
+#define HTIF_CONSOLE_BUF_SIZE 256
+#endif
+
+/** Per-hart line buffer, written only by its hart */
+typedef struct {
+    char buf[HTIF_CONSOLE_BUF_SIZE];
+    size_t len;
+} __attribute__((aligned(64))) htif_console_t;
+
+static htif_console_t htif_console[NUM_HARTS];
+
+static void htif_console_flush(htif_console_t *con)
+{
+    if (con->len == 0) {
+        return;
+    }
+
+    htif_lock();
+    htif_send(con->buf, con->len);
+    htif_unlock();
+    con->len = 0;
+}
+
+/** Append to the calling hart's buffer; flush on newline or when full */
+static void htif_console_write(const char *buf, size_t len)
+{
+    htif_console_t *con = &htif_console[csr_read_hartid()];
+    bool newline = false;
+
+    for (size_t i = 0; i < len; i++) {
+        if (con->len == HTIF_CONSOLE_BUF_SIZE) {
+            htif_console_flush(con);
+        }
+        con->buf[con->len++] = buf[i];
+        newline |= (buf[i] == '\n');
+    }
+
+    if (newline) {
+        htif_console_flush(con);
+    }
+}
+
 /* =============================================================================
  * HTIF Implementation
  * ============================================================================= */
@@ -54,18 +188,7 @@ void htif_init(void)
 
 void htif_putc(char c)
 {
-    /* Wait for previous command to complete */
-    while (tohost != 0) {
-        fromhost = 0;
-    }
-
-    /* Write character using console device */
-    tohost = HTIF_CMD(HTIF_DEV_CONSOLE, HTIF_CMD_WRITE, (uint8_t) c);
-
-    /* Wait for completion */
-    while (tohost != 0) {
-        fromhost = 0;
-    }
+    htif_console_write(&c, 1);
 }
 
 void htif_puts(const char *s)
@@ -74,9 +197,11 @@ void htif_puts(const char *s)
         return;
     }
 
-    while (*s) {
-        htif_putc(*s++);
+    size_t len = 0;
+    while (s[len]) {
+        len++;
     }
+    htif_console_write(s, len);
 }
 
 void htif_write(const char *buf, size_t len)
@@ -85,13 +210,21 @@ void htif_write(const char *buf, size_t len)
         return;
     }
 
-    for (size_t i = 0; i < len; i++) {
-        htif_putc(buf[i]);
+    htif_console_write(buf, len);
+}
+
+void htif_flush(void)
+{
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        htif_console_flush(&htif_console[h]);
     }
 }
 
 void htif_poweroff(int exit_code)
 {
+    /* Partial lines must reach the host before it exits */
+    htif_flush();
+
     /* Exit command: dev=0 (syscall), cmd=0, data=(code << 1) | 1 */
     tohost = HTIF_CMD(0, 0, (exit_code << 1) | 1);
 
@@ -120,6 +253,9 @@ void htif_write(const char *buf, size_t len)
     (void) buf;
     (void) len;
 }
+void htif_flush(void)
+{
+}
 void htif_poweroff(int exit_code)
 {
     (void) exit_code;
@@ -9,7 +9,17 @@
  *   - SMP boot verification (all harts online)
  *   - Spinlock correctness
  *   - Atomic operations
- *   - Barrier synchronization
+ *   - Barrier synchronization and latency (build-time SMP_BARRIER choice)
+ *   - Lock contention: throughput and fairness (build-time SMP_LOCK choice)
+ *   - Work-stealing scheduler (irregular Collatz workload)
+ *   - IPI wakeup of harts parked in wfi
+ *   - SPSC/MPMC message queues: throughput and round-trip latency
+ *   Secondary harts run only what hart 0 dispatches (see sched.h).
+ *
+ * Phase 4 + RVV (NUM_HARTS > 1, ENABLE_RVV): work-partitioned RVV kernels
+ *   - SAXPY, vector add (int32, float32), dot product (tree reduction),
+ *     matrix multiply split across harts
+ *   - Strong and weak scaling from 1 to NUM_HARTS harts
  *
  * Phase 5 (NUM_HARTS == 1, ENABLE_RVV): RISC-V Vector Extension tests
  *   - RVV detection (misa V-bit, VLEN/VLENB)
@@ -18,25 +28,49 @@
  *   - Vector dot product
  *   - SAXPY (y = a*x + y)
  *   - Matrix multiply
+ *   - memcmp/strlen, int/float reductions, prefix sum, gather/scatter
+ *   - Fused AXPBY + clamp vs the unfused kernel chain
+ *   - int8/fp16/bf16 dot product and matmul vs float32 (elements and bytes per cycle)
+ *   - gem5 SE: matmul and dot product on host datasets given on the command line
+ *   - Zicbop prefetch / Zicboz cbo.zero streaming kernels vs demand fetch (per-ROI)
  *   - Scalar vs vector performance comparison
  *
  * Designed to pass Phase 2, Phase 4, and Phase 5 CTest test cases.
  */
 
+#include "alloc.h"
 #include "console.h"
 #include "csr.h"
+#include "hpm.h"
+#include "mmu.h"
 #include "platform.h"
+#include "prof.h"
+#include "roi.h"
+#include "task.h"
 
 #include <stdbool.h>
 #include <stdint.h>
 
 #if NUM_HARTS > 1
+#include "msgq.h"
+#include "sched.h"
 #include "smp.h"
 #endif
 
+#if defined(ENABLE_RVV) && NUM_HARTS > 1
+#include "rvv/rvv_common.h"
+#include "rvv/rvv_dispatch.h"
+#include "rvv/rvv_parallel.h"
+#endif
+
 #if defined(ENABLE_RVV) && NUM_HARTS <= 1
+#include "dataset.h"
+#include "gem5_se_io.h"
+#include "rvv/rvv_bench.h"
+#include "rvv/rvv_cbo.h"
 #include "rvv/rvv_common.h"
 #include "rvv/rvv_detect.h"
+#include "rvv/rvv_dispatch.h"
 #endif
 
 /* =============================================================================
@@ -53,24 +87,6 @@ static int tests_total;
  * Helper Functions
  * ============================================================================= */
 
-/**
- * @brief Simple integer to string conversion
- */
-static void int_to_str(uint64_t value, char *buf, int buf_size)
-{
-    console_put_dec(value, buf, buf_size);
-}
-
-#if NUM_HARTS <= 1 && !defined(ENABLE_RVV)
-/**
- * @brief Print a uint64_t value in hex (used in Phase 2 CSR test)
- */
-static void print_hex(uint64_t value)
-{
-    console_put_hex(value);
-}
-#endif
-
 /**
  * @brief Record test result
  */
@@ -79,14 +95,8 @@ static void record_test(const char *name, bool passed)
     tests_total++;
     if (passed) {
         tests_passed++;
-        console_puts("[TEST] ");
-        console_puts(name);
-        console_puts(": PASS\n");
-    } else {
-        console_puts("[TEST] ");
-        console_puts(name);
-        console_puts(": FAIL\n");
     }
+    console_printf("[TEST] %s: %s\n", name, passed ? "PASS" : "FAIL");
 }
 
 /**
@@ -94,30 +104,13 @@ static void record_test(const char *name, bool passed)
  */
 static void print_summary(int phase)
 {
-    char buf[32];
-
     console_puts("=================================================================\n");
-    console_puts("[RESULT] Phase ");
-    int_to_str((uint64_t) phase, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" tests: ");
-    int_to_str((uint64_t) tests_passed, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("/");
-    int_to_str((uint64_t) tests_total, buf, sizeof(buf));
-    console_puts(buf);
-    if (tests_passed == tests_total) {
-        console_puts(" PASS\n");
-    } else {
-        console_puts(" FAIL\n");
-    }
+    console_printf("[RESULT] Phase %d tests: %d/%d %s\n", phase, tests_passed, tests_total,
+                   tests_passed == tests_total ? "PASS" : "FAIL");
     console_puts("=================================================================\n");
     console_puts("\n");
 
-    console_puts("[INFO] Phase ");
-    int_to_str((uint64_t) phase, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" complete. System halted.\n");
+    console_printf("[INFO] Phase %d complete. System halted.\n", phase);
 }
 
 /* =============================================================================
@@ -137,15 +130,8 @@ static void test_csr(void)
     uint64_t mstatus_val = read_csr(mstatus);
 #endif
 
-    console_puts("[CSR] Hart ID: ");
-    char buf[32];
-    int_to_str(hartid, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("\n");
-
-    console_puts("[CSR] mstatus: ");
-    print_hex(mstatus_val);
-    console_puts("\n");
+    console_printf("[CSR] Hart ID: %lu\n", hartid);
+    console_printf("[CSR] mstatus: 0x%lX\n", mstatus_val);
 
     record_test("CSR Hart ID", hartid == 0);
 #if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
@@ -211,6 +197,80 @@ static void test_function_calls(void)
     record_test("Function calls", passed);
 }
 
+/** Pool geometry in the heap test: block size is rounded up to a line */
+#define HEAP_TEST_POOL_BLOCKS 8
+#define HEAP_TEST_POOL_BYTES 24
+
+static bool heap_ptr_ok(const void *p, size_t align)
+{
+    uintptr_t a = (uintptr_t) p;
+    return p && (a & (align - 1)) == 0 && a >= (uintptr_t) __heap_start &&
+           a < (uintptr_t) __heap_end;
+}
+
+/**
+ * @brief Heap arena and pool allocators
+ *
+ * Bump-allocates from this hart's arena, checks alignment, exhaustion
+ * and mark/release, then runs a fixed-block pool empty and refills it.
+ */
+static void test_heap_alloc(void)
+{
+    arena_t *arena = heap_arena();
+    arena_mark_t mark = arena_mark(arena);
+    bool passed = true;
+
+    uint8_t *a = (uint8_t *) arena_alloc(arena, 100, ALLOC_ALIGN_LINE);
+    uint8_t *b = (uint8_t *) arena_alloc(arena, 1, ALLOC_ALIGN_MIN);
+    if (!heap_ptr_ok(a, ALLOC_ALIGN_LINE) || !heap_ptr_ok(b, ALLOC_ALIGN_MIN) || b < a + 100) {
+        passed = false;
+    } else {
+        for (int i = 0; i < 100; i++) {
+            a[i] = (uint8_t) i;
+        }
+        *b = 0xA5;
+        for (int i = 0; i < 100; i++) {
+            if (a[i] != (uint8_t) i) {
+                passed = false;
+            }
+        }
+    }
+    if (arena_alloc(arena, heap_size() + 1, ALLOC_ALIGN_MIN) != NULL) {
+        passed = false; /* Must fail without moving the bump pointer */
+    }
+
+    pool_t pool;
+    void *blocks[HEAP_TEST_POOL_BLOCKS];
+    if (!pool_init(&pool, arena, HEAP_TEST_POOL_BYTES, HEAP_TEST_POOL_BLOCKS, ALLOC_ALIGN_LINE)) {
+        passed = false;
+    } else {
+        for (int i = 0; i < HEAP_TEST_POOL_BLOCKS; i++) {
+            blocks[i] = pool_alloc(&pool);
+            if (!heap_ptr_ok(blocks[i], ALLOC_ALIGN_LINE) || !pool_owns(&pool, blocks[i]) ||
+                (i > 0 && blocks[i] == blocks[i - 1])) {
+                passed = false;
+            }
+        }
+        if (pool_alloc(&pool) != NULL || pool.nfree != 0) {
+            passed = false;
+        }
+        pool_free(&pool, blocks[3]);
+        if (pool_alloc(&pool) != blocks[3]) {
+            passed = false;
+        }
+    }
+
+    size_t used = arena_used(arena);
+    arena_release(arena, mark);
+    if (arena_mark(arena) != mark) {
+        passed = false;
+    }
+
+    console_printf("[HEAP] heap=%zu bytes, arena used=%zu, pool %ux%zu-byte blocks\n", heap_size(),
+                   used, (unsigned) HEAP_TEST_POOL_BLOCKS, pool.block_size);
+    record_test("Heap allocators", passed);
+}
+
 static void run_phase2_tests(void)
 {
     console_puts("[INFO] Running Phase 2 tests...\n");
@@ -227,6 +287,9 @@ static void run_phase2_tests(void)
 
     test_function_calls();
     console_puts("\n");
+
+    test_heap_alloc();
+    console_puts("\n");
 }
 
 #endif /* NUM_HARTS <= 1 && !ENABLE_RVV */
@@ -242,8 +305,6 @@ static void run_phase2_tests(void)
  */
 static void test_smp_boot(void)
 {
-    char buf[32];
-
     /* Initialize SMP subsystem */
     smp_init();
 
@@ -257,16 +318,25 @@ static void test_smp_boot(void)
     while (smp_get_harts_online() < (uint32_t) (NUM_HARTS - 1)) {
         /* Spin - secondary harts are incrementing the counter */
     }
-    mb(); /* Ensure we see all their writes */
+    /* smp_get_harts_online() ends in an acquire fence */
 
-    console_puts("[SMP] All ");
-    int_to_str(NUM_HARTS, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" harts online\n");
+    console_printf("[SMP] All %d harts online\n", NUM_HARTS);
 
     record_test("SMP boot", true);
 }
 
+/** smp_parallel_run() job: one locked increment per hart */
+static void smp_spinlock_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    (void) hart;
+    (void) nharts;
+    (void) arg;
+
+    spin_lock(&smp_test_lock);
+    smp_lock_counter++;
+    spin_unlock(&smp_test_lock);
+}
+
 /**
  * @brief Test 2: Spinlock correctness
  *
@@ -279,409 +349,2870 @@ static void test_smp_spinlock(void)
     smp_lock_counter = 0;
     wmb();
 
-    /* === Barrier 2: Signal spinlock test start === */
-    barrier_wait(&smp_test_barrier);
-
-    /* Hart 0 participates in spinlock test */
-    spin_lock(&smp_test_lock);
-    smp_lock_counter++;
-    spin_unlock(&smp_test_lock);
-
-    /* === Barrier 3: Wait for all harts to complete === */
-    barrier_wait(&smp_test_barrier);
+    /* Every hart (including hart 0) runs the job once */
+    smp_parallel_run(smp_spinlock_job, NULL, NUM_HARTS);
 
     bool passed = (smp_lock_counter == (uint32_t) NUM_HARTS);
-    console_puts("[SMP] Spinlock counter: ");
-    char buf[32];
-    int_to_str(smp_lock_counter, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("/");
-    int_to_str(NUM_HARTS, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("\n");
+    console_printf("[SMP] Spinlock counter: %u/%d\n", smp_lock_counter, NUM_HARTS);
 
     record_test("Spinlock", passed);
 }
 
+/** Shared targets of the explicit-order operations in the atomic test */
+static volatile uint64_t smp_atomic_sum64;
+static volatile uint64_t smp_atomic_mask64;
+static volatile uint64_t smp_atomic_cas64;
+static volatile uint32_t smp_atomic_xor32;
+static volatile uint32_t smp_atomic_max32;
+static volatile int64_t smp_atomic_min64;
+
+/** smp_parallel_run() job: one amoadd per hart, then one of each other op */
+static void smp_atomic_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    (void) nharts;
+    (void) arg;
+
+    atomic_add_u32(&smp_atomic_counter, 1);
+
+    /* Each order once; the results only depend on atomicity */
+    atomic_add_u64_explicit(&smp_atomic_sum64, (1ULL << 32) + hart, ATOMIC_RELAXED);
+    atomic_or_u64_explicit(&smp_atomic_mask64, 1ULL << (32 + hart), ATOMIC_RELAXED);
+    atomic_xor_u32_explicit(&smp_atomic_xor32, 1U << hart, ATOMIC_ACQ_REL);
+    atomic_max_u32_explicit(&smp_atomic_max32, hart, ATOMIC_RELEASE);
+    atomic_min_i64_explicit(&smp_atomic_min64, -(int64_t) hart, ATOMIC_ACQUIRE);
+
+    uint64_t old;
+    do {
+        old = atomic_load_u64_explicit(&smp_atomic_cas64, ATOMIC_RELAXED);
+    } while (!atomic_cas_u64_explicit(&smp_atomic_cas64, old, old + 2, ATOMIC_ACQ_REL));
+}
+
+/** Uncontended operations timed per memory order in the atomic test */
+#define SMP_ATOMIC_COST_ITERS 1000
+
+/** Mean cycles of one amoadd.w / load / store at a given order */
+typedef struct {
+    uint64_t amo;
+    uint64_t load;
+    uint64_t store;
+} smp_atomic_cost_t;
+
+/* The order is a constant at each call site, so each loop times exactly
+ * the instruction sequence of that order */
+#define SMP_ATOMIC_COST(var, order, cost)                                                          \
+    do {                                                                                           \
+        uint64_t t0 = csr_read_cycle();                                                            \
+        for (uint32_t i = 0; i < SMP_ATOMIC_COST_ITERS; i++) {                                     \
+            atomic_add_u32_explicit(&(var), 1, order);                                             \
+        }                                                                                          \
+        uint64_t t1 = csr_read_cycle();                                                            \
+        for (uint32_t i = 0; i < SMP_ATOMIC_COST_ITERS; i++) {                                     \
+            (void) atomic_load_u32_explicit(&(var), order);                                        \
+        }                                                                                          \
+        uint64_t t2 = csr_read_cycle();                                                            \
+        for (uint32_t i = 0; i < SMP_ATOMIC_COST_ITERS; i++) {                                     \
+            atomic_store_u32_explicit(&(var), i, order);                                           \
+        }                                                                                          \
+        uint64_t t3 = csr_read_cycle();                                                            \
+        (cost).amo = (t1 - t0) / SMP_ATOMIC_COST_ITERS;                                            \
+        (cost).load = (t2 - t1) / SMP_ATOMIC_COST_ITERS;                                           \
+        (cost).store = (t3 - t2) / SMP_ATOMIC_COST_ITERS;                                          \
+    } while (0)
+
 /**
  * @brief Test 3: Atomic operations
  *
  * All harts atomically increment a shared counter using amoadd.
- * If atomic ops work correctly, final count == NUM_HARTS.
+ * If atomic ops work correctly, final count == NUM_HARTS. Every hart
+ * also applies one 64-bit add/or, xor, unsigned max, signed 64-bit min
+ * and CAS, each at a different memory order. Hart 0 then reports the
+ * uncontended cost of amoadd.w, load and store at each order.
  */
 static void test_smp_atomic(void)
 {
-    /* Reset counter */
+    /* Reset counters */
     smp_atomic_counter = 0;
+    smp_atomic_sum64 = 0;
+    smp_atomic_mask64 = 0;
+    smp_atomic_cas64 = 0;
+    smp_atomic_xor32 = 0;
+    smp_atomic_max32 = 0;
+    smp_atomic_min64 = 0;
     wmb();
 
-    /* === Barrier 4: Signal atomic test start === */
-    barrier_wait(&smp_test_barrier);
-
-    /* Hart 0 participates in atomic test */
-    atomic_add_u32(&smp_atomic_counter, 1);
-
-    /* === Barrier 5: Wait for all harts to complete === */
-    barrier_wait(&smp_test_barrier);
+    smp_parallel_run(smp_atomic_job, NULL, NUM_HARTS);
 
+    const uint64_t n = NUM_HARTS;
     bool passed = (smp_atomic_counter == (uint32_t) NUM_HARTS);
-    console_puts("[SMP] Atomic counter: ");
-    char buf[32];
-    int_to_str(smp_atomic_counter, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("/");
-    int_to_str(NUM_HARTS, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("\n");
+    console_printf("[SMP] Atomic counter: %u/%d\n", smp_atomic_counter, NUM_HARTS);
+
+    bool ops_ok = smp_atomic_sum64 == (n << 32) + n * (n - 1) / 2 &&
+                  smp_atomic_mask64 == (((1ULL << n) - 1) << 32) &&
+                  smp_atomic_xor32 == (uint32_t) ((1ULL << n) - 1) &&
+                  smp_atomic_max32 == (uint32_t) (n - 1) &&
+                  smp_atomic_min64 == -(int64_t) (n - 1) && smp_atomic_cas64 == 2 * n;
+    console_printf("[SMP] Atomic 64-bit/min/max/xor/cas: %s\n", ops_ok ? "ok" : "mismatch");
+    passed = passed && ops_ok;
+
+    static volatile uint32_t cost_word;
+    smp_atomic_cost_t cost[5];
+    static const char *const order_names[5] = {"relaxed", "acquire", "release", "acq_rel",
+                                               "seq_cst"};
+
+    SMP_ATOMIC_COST(cost_word, ATOMIC_RELAXED, cost[0]);
+    SMP_ATOMIC_COST(cost_word, ATOMIC_ACQUIRE, cost[1]);
+    SMP_ATOMIC_COST(cost_word, ATOMIC_RELEASE, cost[2]);
+    SMP_ATOMIC_COST(cost_word, ATOMIC_ACQ_REL, cost[3]);
+    SMP_ATOMIC_COST(cost_word, ATOMIC_SEQ_CST, cost[4]);
+    for (uint32_t o = 0; o < 5; o++) {
+        console_printf("[ATOMIC] %-7s amoadd.w %lu load %lu store %lu cycles/op\n",
+                       order_names[o], cost[o].amo, cost[o].load, cost[o].store);
+    }
 
     record_test("Atomic operations", passed);
 }
 
+/** Barrier rounds in the barrier test */
+#define SMP_BARRIER_ROUNDS 4
+
+static volatile uint32_t smp_barrier_arrivals;
+static volatile uint32_t smp_barrier_errors;
+
+/**
+ * smp_parallel_run() job: each round every hart checks in, waits at the
+ * barrier, and verifies that all harts checked in before anyone left.
+ */
+static void smp_barrier_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    (void) hart;
+    (void) arg;
+
+    for (uint32_t round = 1; round <= SMP_BARRIER_ROUNDS; round++) {
+        atomic_add_u32(&smp_barrier_arrivals, 1);
+        barrier_wait(&smp_test_barrier);
+
+        if (atomic_load_u32(&smp_barrier_arrivals) < round * nharts) {
+            atomic_add_u32(&smp_barrier_errors, 1);
+        }
+        barrier_wait(&smp_test_barrier);
+    }
+}
+
 /**
  * @brief Test 4: Barrier synchronization
  *
- * If all previous barriers succeeded (which they must have for us
- * to reach here), barrier synchronization is working correctly.
- * Do one final barrier to confirm.
+ * All harts run SMP_BARRIER_ROUNDS rounds of arrive / barrier / check.
+ * A hart that leaves the barrier early sees fewer arrivals than expected.
  */
 static void test_smp_barrier(void)
 {
-    /* === Barrier 6: Final barrier (all harts must reach this) === */
-    barrier_wait(&smp_test_barrier);
+    smp_barrier_arrivals = 0;
+    smp_barrier_errors = 0;
+    wmb();
+
+    smp_parallel_run(smp_barrier_job, NULL, NUM_HARTS);
 
-    /* If we got here, all 6 barriers worked correctly */
-    record_test("Barrier synchronization", true);
+    bool passed = (smp_barrier_errors == 0) &&
+                  (smp_barrier_arrivals == (uint32_t) (SMP_BARRIER_ROUNDS * NUM_HARTS));
+    record_test("Barrier synchronization", passed);
 }
 
-static void run_phase4_tests(void)
+/** Timed barrier episodes per hart count in the latency benchmark */
+#define SMP_BARRIER_BENCH_ITERS 1000
+
+static barrier_t smp_bench_barrier;
+
+/** smp_parallel_run() job: align, then time ITERS barriers on hart 0 */
+static void smp_barrier_bench_job(uint32_t hart, uint32_t nharts, void *arg)
 {
-    char buf[32];
+    (void) nharts;
 
-    console_puts("[INFO] Running Phase 4 SMP tests with ");
-    int_to_str(NUM_HARTS, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" harts...\n");
-    console_puts("\n");
+    barrier_wait(&smp_bench_barrier); /* All harts inside the job */
 
-    /* Test 1: SMP Boot */
-    test_smp_boot();
-    console_puts("\n");
+    uint64_t start = csr_read_cycle();
+    for (uint32_t i = 0; i < SMP_BARRIER_BENCH_ITERS; i++) {
+        barrier_wait(&smp_bench_barrier);
+    }
+    uint64_t cycles = csr_read_cycle() - start;
 
-    /* === Barrier 1: Boot complete (synchronize all harts) === */
-    barrier_wait(&smp_test_barrier);
+    if (hart == 0) {
+        *(uint64_t *) arg = cycles;
+    }
+}
 
-    /* Test 2: Spinlock */
-    test_smp_spinlock();
-    console_puts("\n");
+/**
+ * @brief Test 5: Barrier latency at 2, 4, 8 ... NUM_HARTS harts
+ *
+ * Reports mean cycles per barrier episode for the SMP_BARRIER algorithm
+ * selected at build time.
+ */
+static void test_smp_barrier_latency(void)
+{
+    bool passed = true;
 
-    /* Test 3: Atomic operations */
-    test_smp_atomic();
-    console_puts("\n");
+    for (uint32_t h = 2; h <= NUM_HARTS; h *= 2) {
+        uint64_t cycles = 0;
 
-    /* Test 4: Barrier synchronization */
-    test_smp_barrier();
-    console_puts("\n");
+        barrier_init(&smp_bench_barrier, h);
+        wmb();
+        smp_parallel_run(smp_barrier_bench_job, &cycles, h);
+
+        if (cycles == 0) {
+            passed = false;
+        }
+
+        console_printf("[BARRIER] %s harts=%u: %lu cycles/barrier\n", SMP_BARRIER_NAME, h,
+                       cycles / SMP_BARRIER_BENCH_ITERS);
+    }
+
+    record_test("Barrier latency", passed);
 }
 
-#endif /* NUM_HARTS > 1 */
+/** Lock benchmark window per hart count, in CLINT mtime ticks (10 ms) */
+#define SMP_LOCK_BENCH_TICKS (CLINT_TIMEBASE_HZ / 100)
 
-/* =============================================================================
- * Phase 5: RVV Tests
- * ============================================================================= */
+/** Per-hart acquisition counts, one cache line each */
+typedef struct {
+    volatile uint64_t count;
+    uint8_t pad[56];
+} smp_lock_count_t;
 
-#if defined(ENABLE_RVV) && NUM_HARTS <= 1
+static spinlock_t smp_bench_lock;
+static smp_lock_count_t smp_lock_counts[NUM_HARTS] __attribute__((aligned(64)));
+static volatile uint64_t smp_lock_shared;
+static volatile uint32_t smp_lock_stop;
 
-/**
- * @brief Test 1: RVV Detection - check misa V-bit, print VLEN/VLENB
- */
-static void test_rvv_detect(void)
+static inline uint64_t smp_read_mtime(void)
 {
-    bool available = rvv_available();
-    record_test("RVV detection", available);
+    return *(volatile uint64_t *) CLINT_MTIME;
+}
 
-    if (available) {
-        rvv_print_info();
+/** smp_parallel_run() job: acquire/release until hart 0 calls time */
+static void smp_lock_bench_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    uint64_t *ticks = (uint64_t *) arg;
+    uint64_t start = smp_read_mtime();
+
+    (void) nharts;
+
+    while (!smp_lock_stop) {
+        spin_lock(&smp_bench_lock);
+        smp_lock_shared++; /* Shared line written inside the lock */
+        spin_unlock(&smp_bench_lock);
+        smp_lock_counts[hart].count++;
+
+        if (hart == 0 && smp_read_mtime() - start >= SMP_LOCK_BENCH_TICKS) {
+            *ticks = smp_read_mtime() - start;
+            atomic_store_u32(&smp_lock_stop, 1);
+        }
     }
 }
 
 /**
- * @brief Test 2: Integer vector add correctness
+ * @brief Test 6: Lock contention at 2, 4, 8 ... NUM_HARTS harts
+ *
+ * All harts hammer one lock for SMP_LOCK_BENCH_TICKS. Reports total
+ * acquisitions per second, per-hart min/max, and Jain's fairness index
+ * (sum^2 / (n * sum of squares); 100% = perfectly even). Fails if the
+ * protected counter disagrees with the per-hart totals (lost update) or
+ * spin_trylock() misbehaves.
  */
-static void test_rvv_vec_add_i32(void)
+static void test_smp_lock_contention(void)
 {
-    static int32_t a[RVV_TEST_SIZE];
-    static int32_t b[RVV_TEST_SIZE];
-    static int32_t c_scalar[RVV_TEST_SIZE];
-    static int32_t c_vector[RVV_TEST_SIZE];
-    char buf[32];
+    bool passed = true;
 
-    /* Initialize test data */
-    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
-        a[i] = (int32_t) (i + 1);
-        b[i] = (int32_t) (i * 2);
+    /* spin_trylock() on a free and on a held lock */
+    smp_bench_lock = (spinlock_t) SPINLOCK_INIT;
+    if (!spin_trylock(&smp_bench_lock)) {
+        passed = false;
+    } else {
+        if (spin_trylock(&smp_bench_lock)) {
+            passed = false;
+        }
+        spin_unlock(&smp_bench_lock);
     }
 
-    /* Scalar reference */
-    uint64_t start = rvv_read_mcycle();
-    scalar_vec_add_i32(a, b, c_scalar, RVV_TEST_SIZE);
-    uint64_t scalar_cycles = rvv_read_mcycle() - start;
-
-    /* RVV implementation */
-    start = rvv_read_mcycle();
-    rvv_vec_add_i32(a, b, c_vector, RVV_TEST_SIZE);
-    uint64_t vector_cycles = rvv_read_mcycle() - start;
+    for (uint32_t h = 2; h <= NUM_HARTS; h *= 2) {
+        uint64_t ticks = 0;
 
-    /* Verify correctness */
-    bool passed = true;
-    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
-        if (c_scalar[i] != c_vector[i]) {
+        smp_bench_lock = (spinlock_t) SPINLOCK_INIT;
+        for (uint32_t i = 0; i < NUM_HARTS; i++) {
+            smp_lock_counts[i].count = 0;
+        }
+        smp_lock_shared = 0;
+        smp_lock_stop = 0;
+        wmb();
+
+        smp_parallel_run(smp_lock_bench_job, &ticks, h);
+
+        uint64_t sum = 0;
+        uint64_t sum_sq = 0;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+        for (uint32_t i = 0; i < h; i++) {
+            uint64_t c = smp_lock_counts[i].count;
+            sum += c;
+            sum_sq += c * c;
+            min = c < min ? c : min;
+            max = c > max ? c : max;
+        }
+        if (sum != smp_lock_shared || ticks == 0) {
             passed = false;
-            break;
         }
+        uint64_t fairness = sum_sq ? sum * sum * 100 / (h * sum_sq) : 0;
+        uint64_t per_sec = ticks ? sum * CLINT_TIMEBASE_HZ / ticks : 0;
+
+        console_printf("[LOCK] %s harts=%u: acq=%lu acq/s=%lu min=%lu max=%lu fairness=%lu%%\n",
+                       SMP_LOCK_NAME, h, sum, per_sec, min, max, fairness);
     }
 
-    record_test("Vec add (int32)", passed);
+    record_test("Lock contention", passed);
+}
 
-    /* Print cycle comparison */
-    console_puts("[RVV] vec_add_i32: scalar=");
-    int_to_str(scalar_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" vec=");
-    int_to_str(vector_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" cycles\n");
+/* -----------------------------------------------------------------------------
+ * Work-stealing scheduler
+ *
+ * Irregular workload: total Collatz stopping time over [1, SCHED_TEST_N).
+ * Per-element cost varies widely, so static partitioning balances poorly;
+ * tasks split their range in half, spawn the upper half and keep the
+ * lower, letting idle harts steal the large upper halves.
+ * ----------------------------------------------------------------------------- */
+
+#define SCHED_TEST_N (16 * 1024)
+#define SCHED_TEST_GRAIN 64
+
+static uint64_t collatz_steps(uint64_t x)
+{
+    uint64_t steps = 0;
+
+    while (x > 1) {
+        x = (x & 1) ? 3 * x + 1 : x >> 1;
+        steps++;
+    }
+    return steps;
+}
+
+static void collatz_task(void *arg, size_t lo, size_t hi)
+{
+    while (hi - lo > SCHED_TEST_GRAIN) {
+        size_t mid = lo + (hi - lo) / 2;
+        sched_spawn(collatz_task, arg, mid, hi);
+        hi = mid;
+    }
+
+    uint64_t sum = 0;
+    for (size_t i = lo; i < hi; i++) {
+        sum += collatz_steps(i);
+    }
+    atomic_add_u64((volatile uint64_t *) arg, sum);
 }
 
 /**
- * @brief Test 3: Vector memcpy correctness
+ * @brief Test 7: Work-stealing scheduler
+ *
+ * Runs the Collatz workload serially on hart 0, then through the
+ * scheduler on all harts, and compares results and cycle counts.
  */
-static void test_rvv_memcpy(void)
+static void test_smp_sched(void)
 {
-    static uint8_t src[RVV_TEST_SIZE * 4];
-    static uint8_t dst_scalar[RVV_TEST_SIZE * 4];
-    static uint8_t dst_vector[RVV_TEST_SIZE * 4];
-    char buf[32];
-    size_t nbytes = RVV_TEST_SIZE * 4;
+    static volatile uint64_t total;
 
-    /* Initialize source data */
-    for (uint32_t i = 0; i < nbytes; i++) {
-        src[i] = (uint8_t) (i & 0xFF);
-        dst_scalar[i] = 0;
-        dst_vector[i] = 0;
+    uint64_t start = csr_read_cycle();
+    uint64_t expected = 0;
+    for (size_t i = 1; i < SCHED_TEST_N; i++) {
+        expected += collatz_steps(i);
     }
+    uint64_t serial_cycles = csr_read_cycle() - start;
 
-    /* Scalar reference */
-    uint64_t start = rvv_read_mcycle();
-    scalar_memcpy(dst_scalar, src, nbytes);
-    uint64_t scalar_cycles = rvv_read_mcycle() - start;
+    total = 0;
+    sched_reset_stats();
 
-    /* RVV implementation */
-    start = rvv_read_mcycle();
-    rvv_memcpy(dst_vector, src, nbytes);
-    uint64_t vector_cycles = rvv_read_mcycle() - start;
+    start = csr_read_cycle();
+    sched_spawn(collatz_task, (void *) &total, 1, SCHED_TEST_N);
+    sched_wait();
+    uint64_t par_cycles = csr_read_cycle() - start;
 
-    /* Verify correctness */
-    bool passed = true;
-    for (uint32_t i = 0; i < nbytes; i++) {
-        if (dst_scalar[i] != dst_vector[i]) {
-            passed = false;
-            break;
-        }
+    uint32_t executed = 0;
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        sched_stats_t st;
+        sched_get_stats(h, &st);
+        executed += st.executed;
+
+        console_printf("[SCHED] Hart %u: tasks=%u stolen=%u parks=%u\n", h, st.executed, st.stolen,
+                       st.parks);
     }
 
-    record_test("Vec memcpy", passed);
+    uint64_t speedup_x100 = serial_cycles * 100 / (par_cycles ? par_cycles : 1);
+    console_printf("[SCHED] Collatz n=%d: serial=%lu sched=%lu cycles, speedup=%lu.%02lu\n",
+                   SCHED_TEST_N, serial_cycles, par_cycles, speedup_x100 / 100, speedup_x100 % 100);
 
-    console_puts("[RVV] vec_memcpy: scalar=");
-    int_to_str(scalar_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" vec=");
-    int_to_str(vector_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" cycles\n");
+    record_test("Work-stealing scheduler", total == expected && executed > 0);
+}
+
+static volatile uint32_t smp_woken[NUM_HARTS];
+
+static void smp_wake_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    (void) nharts;
+    (void) arg;
+
+    smp_woken[hart] = 1;
 }
 
 /**
- * @brief Test 4: Float32 vector add correctness
+ * @brief Test 8: IPI wakeup
+ *
+ * Waits (bounded) until every secondary hart has parked in wfi, then
+ * broadcasts a job; each hart can only run it after an MSIP wakeup.
  */
-static void test_rvv_vec_add_f32(void)
+static void test_smp_ipi_wakeup(void)
 {
-    static float a[RVV_TEST_SIZE];
-    static float b[RVV_TEST_SIZE];
-    static float c_scalar[RVV_TEST_SIZE];
-    static float c_vector[RVV_TEST_SIZE];
-    char buf[32];
-
-    /* Initialize test data */
-    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
-        a[i] = (float) (i + 1) * 1.0f;
-        b[i] = (float) (i) * 0.5f;
+    bool all_parked = false;
+
+    sched_reset_stats();
+    for (uint32_t spin = 0; spin < 10000000 && !all_parked; spin++) {
+        all_parked = true;
+        for (uint32_t h = 1; h < NUM_HARTS; h++) {
+            sched_stats_t st;
+            sched_get_stats(h, &st);
+            if (st.parks == 0) {
+                all_parked = false;
+            }
+        }
     }
 
-    /* Scalar reference */
-    uint64_t start = rvv_read_mcycle();
-    scalar_vec_add_f32(a, b, c_scalar, RVV_TEST_SIZE);
-    uint64_t scalar_cycles = rvv_read_mcycle() - start;
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        smp_woken[h] = 0;
+    }
+    wmb();
 
-    /* RVV implementation */
-    start = rvv_read_mcycle();
-    rvv_vec_add_f32(a, b, c_vector, RVV_TEST_SIZE);
-    uint64_t vector_cycles = rvv_read_mcycle() - start;
+    smp_parallel_run(smp_wake_job, NULL, NUM_HARTS);
 
-    /* Verify correctness (with floating-point tolerance) */
-    bool passed = true;
-    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
-        if (!rvv_float_eq(c_scalar[i], c_vector[i], 0.001f)) {
+    bool passed = all_parked;
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        if (!smp_woken[h]) {
             passed = false;
-            break;
         }
     }
 
-    record_test("Vec add (float32)", passed);
-
-    console_puts("[RVV] vec_add_f32: scalar=");
-    int_to_str(scalar_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" vec=");
-    int_to_str(vector_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" cycles\n");
+    console_puts(all_parked ? "[SCHED] All secondary harts parked in wfi, woken by IPI\n"
+                            : "[SCHED] Secondary harts did not park\n");
+    record_test("IPI wakeup", passed);
 }
 
-/**
- * @brief Test 5: Dot product correctness
- */
-static void test_rvv_dot_product(void)
-{
-    static float a[RVV_TEST_SIZE];
-    static float b[RVV_TEST_SIZE];
-    char buf[32];
+/* -----------------------------------------------------------------------------
+ * False sharing: per-hart counters packed into one line vs one line each
+ * ----------------------------------------------------------------------------- */
 
-    /* Initialize test data: a[i] = i+1, b[i] = 1.0 */
-    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
-        a[i] = (float) (i + 1);
-        b[i] = 1.0f;
-    }
+/** Increments per hart per layout in the false-sharing benchmark */
+#define SMP_FS_ITERS 20000
 
-    /* Scalar reference: sum(1..64) = 64*65/2 = 2080 */
-    uint64_t start = rvv_read_mcycle();
-    float scalar_result = scalar_dot_product_f32(a, b, RVV_TEST_SIZE);
-    uint64_t scalar_cycles = rvv_read_mcycle() - start;
+/** One counter per hart, all in a single cache line */
+static volatile uint64_t smp_fs_packed[MAX_HARTS] __smp_shared;
+/** One counter per hart, each on its own line */
+static smp_counter_t smp_fs_padded __smp_shared;
+static barrier_t smp_fs_barrier;
+static volatile uint32_t smp_fs_tp_errors;
+
+typedef struct {
+    bool padded;
+    uint64_t cycles;
+} smp_fs_run_t;
+
+/** smp_parallel_run() job: align, then ITERS increments of the hart's own counter */
+static void smp_false_sharing_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    smp_fs_run_t *run = (smp_fs_run_t *) arg;
+
+    (void) nharts;
+
+    if (smp_this_hart() != &smp_hart_local[hart] || smp_hart_id() != hart) {
+        atomic_add_u32(&smp_fs_tp_errors, 1);
+    }
+
+    barrier_wait(&smp_fs_barrier); /* All harts inside the job */
+
+    uint64_t start = csr_read_cycle();
+    if (run->padded) {
+        for (uint32_t i = 0; i < SMP_FS_ITERS; i++) {
+            smp_counter_add(&smp_fs_padded, 1);
+        }
+    } else {
+        for (uint32_t i = 0; i < SMP_FS_ITERS; i++) {
+            smp_fs_packed[hart]++;
+        }
+    }
+    barrier_wait(&smp_fs_barrier);
+
+    if (hart == 0) {
+        run->cycles = csr_read_cycle() - start;
+    }
+}
+
+/**
+ * @brief Test 9: False sharing at 2, 4, 8 ... NUM_HARTS harts
+ *
+ * Every hart increments its own counter SMP_FS_ITERS times, first with all
+ * counters packed into one cache line, then with smp_counter_t (one line
+ * per hart, merged on read). The speedup is packed / padded cycles; it
+ * only shows on a model with coherent caches (gem5 Timing/O3 with L1s),
+ * QEMU and Spike report ~1x. Fails if either layout loses an increment or
+ * a hart's tp does not point at its own smp_hart_local[] entry.
+ */
+static void test_smp_false_sharing(void)
+{
+    bool passed = true;
+
+    smp_fs_tp_errors = 0;
+    for (uint32_t h = 2; h <= NUM_HARTS; h *= 2) {
+        smp_fs_run_t packed = {.padded = false, .cycles = 0};
+        smp_fs_run_t padded = {.padded = true, .cycles = 0};
+
+        for (uint32_t i = 0; i < MAX_HARTS; i++) {
+            smp_fs_packed[i] = 0;
+        }
+        smp_counter_reset(&smp_fs_padded);
+        barrier_init(&smp_fs_barrier, h);
+        wmb();
+
+        smp_parallel_run(smp_false_sharing_job, &packed, h);
+        smp_parallel_run(smp_false_sharing_job, &padded, h);
+
+        uint64_t packed_sum = 0;
+        for (uint32_t i = 0; i < h; i++) {
+            packed_sum += smp_fs_packed[i];
+        }
+        uint64_t expected = (uint64_t) h * SMP_FS_ITERS;
+        if (packed_sum != expected || smp_counter_read(&smp_fs_padded) != expected ||
+            packed.cycles == 0 || padded.cycles == 0) {
+            passed = false;
+        }
+        uint64_t speedup_x100 = packed.cycles * 100 / (padded.cycles ? padded.cycles : 1);
+
+        console_printf("[SMP] False sharing harts=%u: packed=%lu padded=%lu cycles "
+                       "speedup=%lu.%02lux\n",
+                       h, packed.cycles, padded.cycles, speedup_x100 / 100, speedup_x100 % 100);
+    }
+    if (smp_fs_tp_errors != 0) {
+        passed = false;
+    }
+
+    record_test("False sharing", passed);
+}
+
+/* -----------------------------------------------------------------------------
+ * Hart-local arenas: concurrent allocation without shared state
+ * ----------------------------------------------------------------------------- */
+
+/** Scratch bytes each hart allocates in the arena test */
+#define SMP_ARENA_BYTES 1024
+
+static uint8_t *smp_arena_bufs[NUM_HARTS];
+static arena_mark_t smp_arena_marks[NUM_HARTS];
+
+/** smp_parallel_run() job: allocate and fill scratch from the own arena */
+static void smp_arena_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    arena_t *arena = heap_arena();
+    size_t align = *(const size_t *) arg;
+
+    (void) nharts;
+
+    smp_arena_marks[hart] = arena_mark(arena);
+    uint8_t *buf = (uint8_t *) arena_alloc(arena, SMP_ARENA_BYTES, align);
+    if (buf) {
+        for (uint32_t i = 0; i < SMP_ARENA_BYTES; i++) {
+            buf[i] = (uint8_t) (hart + i);
+        }
+    }
+    smp_arena_bufs[hart] = buf;
+}
+
+/**
+ * @brief Test 10: Hart-local arenas
+ *
+ * Every hart allocates vector-aligned scratch from its own arena at the
+ * same time. Each buffer must lie inside its hart's slice of the heap
+ * and hold exactly what its hart wrote. Hart 0 then rewinds the arenas
+ * (the owners are idle between jobs).
+ */
+static void test_smp_hart_arenas(void)
+{
+    size_t align = alloc_vec_align();
+    bool passed = true;
+
+    smp_parallel_run(smp_arena_job, &align, NUM_HARTS);
+
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        const arena_t *arena = heap_hart_arena(h);
+        uintptr_t p = (uintptr_t) smp_arena_bufs[h];
+
+        if (!p || (p & (align - 1)) != 0 || p < arena->base ||
+            p + SMP_ARENA_BYTES > arena->end) {
+            passed = false;
+            continue;
+        }
+        for (uint32_t i = 0; i < SMP_ARENA_BYTES; i++) {
+            if (smp_arena_bufs[h][i] != (uint8_t) (h + i)) {
+                passed = false;
+                break;
+            }
+        }
+    }
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        arena_release(heap_hart_arena(h), smp_arena_marks[h]);
+    }
+
+    console_printf("[HEAP] %d hart arenas of %zu bytes, %u-byte scratch aligned to %zu\n",
+                   NUM_HARTS, arena_remaining(heap_hart_arena(0)), (unsigned) SMP_ARENA_BYTES,
+                   align);
+    record_test("Hart-local arenas", passed);
+}
+
+/* -----------------------------------------------------------------------------
+ * Message queues: SPSC/MPMC throughput and round-trip latency
+ * ----------------------------------------------------------------------------- */
+
+/** Messages streamed per throughput run */
+#define MSGQ_BENCH_MSGS 20000
+/** Round trips per latency run */
+#define MSGQ_BENCH_PINGS 200
+/** Ring capacity of every benchmark queue */
+#define MSGQ_BENCH_CAPACITY 256
+
+static spsc_queue_t msgq_fwd __smp_shared;  /* Hart 0 -> hart 1 */
+static spsc_queue_t msgq_back __smp_shared; /* Hart 1 -> hart 0 */
+static mpmc_queue_t msgq_mpmc __smp_shared;
+static uint64_t msgq_fwd_slots[MSGQ_BENCH_CAPACITY] __attribute__((aligned(64)));
+static uint64_t msgq_back_slots[MSGQ_BENCH_CAPACITY] __attribute__((aligned(64)));
+static mpmc_cell_t msgq_mpmc_cells[MSGQ_BENCH_CAPACITY] __attribute__((aligned(64)));
+static smp_counter_t msgq_sum __smp_shared;
+static barrier_t msgq_barrier;
+static volatile uint32_t msgq_errors;
+
+typedef enum {
+    MSGQ_RUN_STREAM,   /* Hart 0 streams MSGQ_BENCH_MSGS to hart 1 */
+    MSGQ_RUN_PING,     /* Round trips, both sides spinning */
+    MSGQ_RUN_PING_WFI, /* Round trips, both sides asleep on the doorbell */
+    MSGQ_RUN_MPMC      /* nharts / 2 producers, the rest consumers */
+} msgq_mode_t;
+
+typedef struct {
+    msgq_mode_t mode;
+    uint32_t msgs; /* MPMC: messages in total */
+    uint64_t cycles;
+    uint64_t ticks;
+} msgq_run_t;
+
+/** Hart 1 side of the two-hart runs */
+static void msgq_peer(msgq_mode_t mode)
+{
+    switch (mode) {
+    case MSGQ_RUN_STREAM: {
+        uint64_t sum = 0;
+        for (uint32_t i = 1; i <= MSGQ_BENCH_MSGS; i++) {
+            uint64_t msg = spsc_pop_wait(&msgq_fwd);
+            if (msg != i) {
+                atomic_add_u32(&msgq_errors, 1);
+            }
+            sum += msg;
+        }
+        spsc_push_wait(&msgq_back, sum); /* Done: hand the checksum back */
+        break;
+    }
+    case MSGQ_RUN_PING:
+        for (uint32_t i = 0; i < MSGQ_BENCH_PINGS; i++) {
+            uint64_t msg;
+            while (!spsc_pop(&msgq_fwd, &msg)) {
+                /* Spin */
+            }
+            spsc_push_wait(&msgq_back, msg + 1);
+        }
+        break;
+    case MSGQ_RUN_PING_WFI:
+        for (uint32_t i = 0; i < MSGQ_BENCH_PINGS; i++) {
+            spsc_push_wait(&msgq_back, spsc_pop_wait(&msgq_fwd) + 1);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/** Hart 0 side of the two-hart runs; returns the cycles of the whole run */
+static uint64_t msgq_driver(msgq_mode_t mode)
+{
+    uint64_t start = csr_read_cycle();
+
+    switch (mode) {
+    case MSGQ_RUN_STREAM: {
+        for (uint32_t i = 1; i <= MSGQ_BENCH_MSGS; i++) {
+            spsc_push_wait(&msgq_fwd, i);
+        }
+        uint64_t expected = (uint64_t) MSGQ_BENCH_MSGS * (MSGQ_BENCH_MSGS + 1) / 2;
+        if (spsc_pop_wait(&msgq_back) != expected) {
+            atomic_add_u32(&msgq_errors, 1);
+        }
+        break;
+    }
+    case MSGQ_RUN_PING:
+        for (uint32_t i = 0; i < MSGQ_BENCH_PINGS; i++) {
+            uint64_t msg;
+            spsc_push_wait(&msgq_fwd, i);
+            while (!spsc_pop(&msgq_back, &msg)) {
+                /* Spin */
+            }
+            if (msg != (uint64_t) i + 1) {
+                atomic_add_u32(&msgq_errors, 1);
+            }
+        }
+        break;
+    case MSGQ_RUN_PING_WFI:
+        for (uint32_t i = 0; i < MSGQ_BENCH_PINGS; i++) {
+            spsc_push_wait(&msgq_fwd, i);
+            if (spsc_pop_wait(&msgq_back) != (uint64_t) i + 1) {
+                atomic_add_u32(&msgq_errors, 1);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return csr_read_cycle() - start;
+}
+
+/**
+ * MPMC run: producer p sends (p << 32) | seq for seq = 1 .. msgs / nprod;
+ * every consumer takes msgs / ncons messages and checks that each
+ * producer's sequence numbers arrive in increasing order.
+ */
+static void msgq_mpmc_job(uint32_t hart, uint32_t nharts, msgq_run_t *run)
+{
+    uint32_t nprod = nharts / 2;
+    uint32_t ncons = nharts - nprod;
+
+    if (hart < nprod) {
+        for (uint32_t seq = 1; seq <= run->msgs / nprod; seq++) {
+            mpmc_push_wait(&msgq_mpmc, ((uint64_t) hart << 32) | seq);
+        }
+    } else {
+        uint32_t last[MAX_HARTS] = {0};
+        uint64_t sum = 0;
+
+        for (uint32_t i = 0; i < run->msgs / ncons; i++) {
+            uint64_t msg = mpmc_pop_wait(&msgq_mpmc);
+            uint32_t prod = (uint32_t) (msg >> 32);
+            uint32_t seq = (uint32_t) msg;
+
+            if (prod >= nprod || seq <= last[prod]) {
+                atomic_add_u32(&msgq_errors, 1);
+            } else {
+                last[prod] = seq;
+            }
+            sum += seq;
+        }
+        smp_counter_add(&msgq_sum, sum);
+    }
+}
+
+/** smp_parallel_run() job: one benchmark run, timed on hart 0 between barriers */
+static void msgq_bench_job(uint32_t hart, uint32_t nharts, void *arg)
+{
+    msgq_run_t *run = (msgq_run_t *) arg;
+
+    barrier_wait(&msgq_barrier);
+    uint64_t t0 = smp_read_mtime();
+    uint64_t c0 = csr_read_cycle();
+
+    if (run->mode == MSGQ_RUN_MPMC) {
+        msgq_mpmc_job(hart, nharts, run);
+    } else if (hart == 0) {
+        msgq_driver(run->mode);
+    } else {
+        msgq_peer(run->mode);
+    }
+
+    barrier_wait(&msgq_barrier);
+    if (hart == 0) {
+        run->cycles = csr_read_cycle() - c0;
+        run->ticks = smp_read_mtime() - t0;
+    }
+}
+
+static msgq_run_t msgq_bench_run(msgq_mode_t mode, uint32_t nharts, uint32_t msgs)
+{
+    msgq_run_t run = {.mode = mode, .msgs = msgs, .cycles = 0, .ticks = 0};
+
+    spsc_init(&msgq_fwd, msgq_fwd_slots, MSGQ_BENCH_CAPACITY);
+    spsc_init(&msgq_back, msgq_back_slots, MSGQ_BENCH_CAPACITY);
+    mpmc_init(&msgq_mpmc, msgq_mpmc_cells, MSGQ_BENCH_CAPACITY);
+    smp_counter_reset(&msgq_sum);
+    barrier_init(&msgq_barrier, nharts);
+    wmb();
+
+    smp_parallel_run(msgq_bench_job, &run, nharts);
+    return run;
+}
+
+/** Messages per second of mtime, 0 if the run was too short to measure */
+static uint64_t msgq_rate(uint64_t msgs, uint64_t ticks)
+{
+    return ticks ? msgs * CLINT_TIMEBASE_HZ / ticks : 0;
+}
+
+/**
+ * @brief Test 11: Message queues
+ *
+ * Between harts 0 and 1: SPSC streaming throughput, then round-trip
+ * latency over a pair of SPSC queues with both sides spinning and with
+ * both sides asleep in wfi until the doorbell IPI. Then MPMC throughput
+ * with NUM_HARTS / 2 producer and the remaining consumer harts. Fails if
+ * any message is lost, duplicated or reordered within its producer.
+ */
+static void test_smp_msgq(void)
+{
+    msgq_errors = 0;
+
+    msgq_run_t stream = msgq_bench_run(MSGQ_RUN_STREAM, 2, MSGQ_BENCH_MSGS);
+    console_printf("[MSGQ] SPSC stream: %u msgs in %lu cycles (%lu.%02lu cycles/msg), "
+                   "%lu msgs/s\n",
+                   (unsigned) MSGQ_BENCH_MSGS, stream.cycles, stream.cycles / MSGQ_BENCH_MSGS,
+                   stream.cycles * 100 / MSGQ_BENCH_MSGS % 100,
+                   msgq_rate(MSGQ_BENCH_MSGS, stream.ticks));
+
+    msgq_run_t ping = msgq_bench_run(MSGQ_RUN_PING, 2, 0);
+    msgq_run_t ping_wfi = msgq_bench_run(MSGQ_RUN_PING_WFI, 2, 0);
+    console_printf("[MSGQ] SPSC round trip (hart 0 <-> 1, %u pings): spin=%lu "
+                   "doorbell=%lu cycles\n",
+                   (unsigned) MSGQ_BENCH_PINGS, ping.cycles / MSGQ_BENCH_PINGS,
+                   ping_wfi.cycles / MSGQ_BENCH_PINGS);
+
+    uint32_t nprod = NUM_HARTS / 2;
+    uint32_t ncons = NUM_HARTS - nprod;
+    uint32_t msgs = MSGQ_BENCH_MSGS / (nprod * ncons) * (nprod * ncons);
+    msgq_run_t mpmc = msgq_bench_run(MSGQ_RUN_MPMC, NUM_HARTS, msgs);
+    uint64_t per_prod = msgs / nprod;
+    uint64_t expected = nprod * (per_prod * (per_prod + 1) / 2);
+    console_printf("[MSGQ] MPMC %u producers -> %u consumers: %u msgs in %lu cycles, "
+                   "%lu msgs/s\n",
+                   nprod, ncons, msgs, mpmc.cycles, msgq_rate(msgs, mpmc.ticks));
+
+    bool passed = msgq_errors == 0 && smp_counter_read(&msgq_sum) == expected &&
+                  stream.cycles != 0 && ping.cycles != 0 && ping_wfi.cycles != 0;
+    record_test("Message queues", passed);
+}
+
+#if defined(ENABLE_RVV)
+
+/* -----------------------------------------------------------------------------
+ * Phase 4 + RVV: work-partitioned kernels with strong/weak scaling
+ *
+ * Inputs are small integers so every result (including the tree-reduced
+ * dot product) is exact in float32 and can be checked with ==.
+ * ----------------------------------------------------------------------------- */
+
+static float par_x[RVV_PAR_MAX_LEN];
+static float par_z[RVV_PAR_MAX_LEN];
+static float par_y[RVV_PAR_MAX_LEN];
+static int32_t par_ia[RVV_PAR_MAX_LEN];
+static int32_t par_ib[RVV_PAR_MAX_LEN];
+static int32_t par_ic[RVV_PAR_MAX_LEN];
+
+static float par_A[RVV_PAR_MAX_ROWS * RVV_PAR_MATRIX_DIM];
+static float par_B[RVV_PAR_MATRIX_DIM * RVV_PAR_MATRIX_DIM];
+static float par_C[RVV_PAR_MAX_ROWS * RVV_PAR_MATRIX_DIM];
+static float par_C_ref[RVV_PAR_MAX_ROWS * RVV_PAR_MATRIX_DIM];
+
+/** One scaling run: n elements (or matrix rows) on nharts; returns cycles */
+typedef uint64_t (*par_bench_fn_t)(size_t n, uint32_t nharts, bool *ok);
+
+static uint64_t par_bench_saxpy(size_t n, uint32_t nharts, bool *ok)
+{
+    rvv_memcpy(par_y, par_z, n * sizeof(float));
+
+    roi_begin("rvv_par_saxpy");
+    rvv_par_saxpy(2.0f, par_x, par_y, n, nharts);
+    uint64_t cycles = roi_end();
+
+    for (size_t i = 0; i < n; i++) {
+        if (par_y[i] != 2.0f * par_x[i] + par_z[i]) {
+            *ok = false;
+            break;
+        }
+    }
+    return cycles;
+}
+
+static uint64_t par_bench_add_i32(size_t n, uint32_t nharts, bool *ok)
+{
+    roi_begin("rvv_par_vec_add_i32");
+    rvv_par_vec_add_i32(par_ia, par_ib, par_ic, n, nharts);
+    uint64_t cycles = roi_end();
+
+    for (size_t i = 0; i < n; i++) {
+        if (par_ic[i] != par_ia[i] + par_ib[i]) {
+            *ok = false;
+            break;
+        }
+    }
+    return cycles;
+}
+
+static uint64_t par_bench_add_f32(size_t n, uint32_t nharts, bool *ok)
+{
+    roi_begin("rvv_par_vec_add_f32");
+    rvv_par_vec_add_f32(par_x, par_z, par_y, n, nharts);
+    uint64_t cycles = roi_end();
+
+    for (size_t i = 0; i < n; i++) {
+        if (par_y[i] != par_x[i] + par_z[i]) {
+            *ok = false;
+            break;
+        }
+    }
+    return cycles;
+}
+
+static uint64_t par_bench_dot(size_t n, uint32_t nharts, bool *ok)
+{
+    uint64_t expected = 0;
+    for (size_t i = 0; i < n; i++) {
+        expected += (uint64_t) (i % 5) * (i % 3);
+    }
+
+    roi_begin("rvv_par_dot_product_f32");
+    float result = rvv_par_dot_product_f32(par_x, par_z, n, nharts);
+    uint64_t cycles = roi_end();
+
+    if (result != (float) expected) {
+        *ok = false;
+    }
+    return cycles;
+}
+
+static uint64_t par_bench_matmul(size_t rows, uint32_t nharts, bool *ok)
+{
+    uint32_t dim = RVV_PAR_MATRIX_DIM;
+
+    roi_begin("rvv_par_matmul_f32");
+    rvv_par_matmul_f32(par_A, par_B, par_C, (uint32_t) rows, dim, dim, nharts);
+    uint64_t cycles = roi_end();
+
+    for (size_t i = 0; i < rows * dim; i++) {
+        if (par_C[i] != par_C_ref[i]) {
+            *ok = false;
+            break;
+        }
+    }
+    return cycles;
+}
+
+/**
+ * @brief Print one scaling line
+ *
+ * speedup = base_cycles * work / cycles, where work is 1 for strong
+ * scaling and nharts for weak scaling (scaled speedup); efficiency is
+ * speedup / nharts.
+ */
+static void print_par_scaling(const char *name, const char *mode, size_t n, uint32_t nharts,
+                              uint64_t cycles, uint64_t base_cycles, uint32_t work)
+{
+    uint64_t speedup_x100 = base_cycles * work * 100 / (cycles ? cycles : 1);
+
+    console_printf("[SMP-RVV] %s %s n=%zu harts=%u: cycles=%lu speedup=%lu.%02lu eff=%lu%%\n", name,
+                   mode, n, nharts, cycles, speedup_x100 / 100, speedup_x100 % 100,
+                   speedup_x100 / nharts);
+}
+
+/**
+ * @brief Run strong and weak scaling for one kernel, 1 .. NUM_HARTS harts
+ */
+static void test_smp_rvv_kernel(const char *name, const char *test_name, par_bench_fn_t bench,
+                                size_t strong_n, size_t weak_n)
+{
+    bool passed = true;
+
+    uint64_t base = bench(strong_n, 1, &passed);
+    print_par_scaling(name, "strong", strong_n, 1, base, base, 1);
+    for (uint32_t h = 2; h <= NUM_HARTS; h++) {
+        uint64_t cycles = bench(strong_n, h, &passed);
+        print_par_scaling(name, "strong", strong_n, h, cycles, base, 1);
+    }
+
+    base = bench(weak_n, 1, &passed);
+    print_par_scaling(name, "weak", weak_n, 1, base, base, 1);
+    for (uint32_t h = 2; h <= NUM_HARTS; h++) {
+        uint64_t cycles = bench(weak_n * h, h, &passed);
+        print_par_scaling(name, "weak", weak_n * h, h, cycles, base, h);
+    }
+
+    record_test(test_name, passed);
+}
+
+static void run_phase4_rvv_tests(void)
+{
+    console_puts("[INFO] Running Phase 4 SMP+RVV scaling tests...\n");
+
+    /* Select kernel variants before any worker hart runs a kernel */
+    rvv_dispatch_init();
+    rvv_dispatch_print();
+    console_puts("\n");
+
+    for (uint32_t i = 0; i < RVV_PAR_MAX_LEN; i++) {
+        par_x[i] = (float) (i % 5);
+        par_z[i] = (float) (i % 3);
+        par_ia[i] = (int32_t) (i % 1000) - 500;
+        par_ib[i] = (int32_t) (i * 7);
+    }
+    for (uint32_t i = 0; i < RVV_PAR_MAX_ROWS * RVV_PAR_MATRIX_DIM; i++) {
+        par_A[i] = (float) ((i % 3) + 1);
+    }
+    for (uint32_t i = 0; i < RVV_PAR_MATRIX_DIM * RVV_PAR_MATRIX_DIM; i++) {
+        par_B[i] = (float) ((i % 5) + 1);
+    }
+    scalar_matmul_f32(par_A, par_B, par_C_ref, RVV_PAR_MAX_ROWS, RVV_PAR_MATRIX_DIM,
+                      RVV_PAR_MATRIX_DIM);
+
+    test_smp_rvv_kernel("saxpy", "SMP RVV saxpy", par_bench_saxpy, RVV_PAR_STRONG_LEN,
+                        RVV_PAR_WEAK_LEN);
+    console_puts("\n");
+
+    test_smp_rvv_kernel("vec_add_i32", "SMP RVV vec add (int32)", par_bench_add_i32,
+                        RVV_PAR_STRONG_LEN, RVV_PAR_WEAK_LEN);
+    console_puts("\n");
+
+    test_smp_rvv_kernel("vec_add_f32", "SMP RVV vec add (float32)", par_bench_add_f32,
+                        RVV_PAR_STRONG_LEN, RVV_PAR_WEAK_LEN);
+    console_puts("\n");
+
+    test_smp_rvv_kernel("dot_product", "SMP RVV dot product", par_bench_dot, RVV_PAR_STRONG_LEN,
+                        RVV_PAR_WEAK_LEN);
+    console_puts("\n");
+
+    test_smp_rvv_kernel("matmul", "SMP RVV matmul", par_bench_matmul, RVV_PAR_MATRIX_DIM,
+                        RVV_PAR_WEAK_ROWS);
+    console_puts("\n");
+}
+
+#endif /* ENABLE_RVV */
+
+static void run_phase4_tests(void)
+{
+    console_printf("[INFO] Running Phase 4 SMP tests with %d harts...\n", NUM_HARTS);
+    console_puts("\n");
+
+    /* Test 1: SMP Boot (secondaries then park in the scheduler loop) */
+    test_smp_boot();
+    console_puts("\n");
+
+    /* Test 2: Spinlock */
+    test_smp_spinlock();
+    console_puts("\n");
+
+    /* Test 3: Atomic operations */
+    test_smp_atomic();
+    console_puts("\n");
+
+    /* Test 4: Barrier synchronization */
+    test_smp_barrier();
+    console_puts("\n");
+
+    /* Test 5: Barrier latency (SMP_BARRIER algorithm) */
+    test_smp_barrier_latency();
+    console_puts("\n");
+
+    /* Test 6: Lock contention (SMP_LOCK algorithm) */
+    test_smp_lock_contention();
+    console_puts("\n");
+
+    /* Test 7: Work-stealing scheduler */
+    test_smp_sched();
+    console_puts("\n");
+
+    /* Test 8: IPI wakeup of parked harts */
+    test_smp_ipi_wakeup();
+    console_puts("\n");
+
+    /* Test 9: False sharing (packed vs per-hart padded counters) */
+    test_smp_false_sharing();
+    console_puts("\n");
+
+    /* Test 10: Hart-local heap arenas */
+    test_smp_hart_arenas();
+    console_puts("\n");
+
+    /* Test 11: Inter-hart message queues */
+    test_smp_msgq();
+    console_puts("\n");
+
+#if defined(ENABLE_RVV)
+    /* Tests 12-16: Work-partitioned RVV kernels */
+    run_phase4_rvv_tests();
+#endif
+}
+
+#endif /* NUM_HARTS > 1 */
+
+/* =============================================================================
+ * Phase 5: RVV Tests
+ * ============================================================================= */
+
+#if defined(ENABLE_RVV) && NUM_HARTS <= 1
+
+/**
+ * @brief Test 1: RVV Detection - check misa V-bit, print VLEN/VLENB
+ */
+static void test_rvv_detect(void)
+{
+    bool available = rvv_available();
+    record_test("RVV detection", available);
+
+    if (available) {
+        rvv_print_info();
+
+        /* Pick the LMUL variants for this VLEN before the kernel tests */
+        rvv_dispatch_init();
+        rvv_dispatch_print();
+    }
+}
+
+/**
+ * @brief Test 2: Integer vector add correctness
+ */
+static void test_rvv_vec_add_i32(void)
+{
+    static int32_t a[RVV_TEST_SIZE];
+    static int32_t b[RVV_TEST_SIZE];
+    static int32_t c_scalar[RVV_TEST_SIZE];
+    static int32_t c_vector[RVV_TEST_SIZE];
+
+    /* Initialize test data */
+    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
+        a[i] = (int32_t) (i + 1);
+        b[i] = (int32_t) (i * 2);
+    }
+
+    /* Scalar reference */
+    roi_begin("scalar_vec_add_i32");
+    scalar_vec_add_i32(a, b, c_scalar, RVV_TEST_SIZE);
+    uint64_t scalar_cycles = roi_end();
+
+    /* RVV implementation */
+    roi_begin("rvv_vec_add_i32");
+    rvv_vec_add_i32(a, b, c_vector, RVV_TEST_SIZE);
+    uint64_t vector_cycles = roi_end();
+
+    /* Verify correctness */
+    bool passed = true;
+    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
+        if (c_scalar[i] != c_vector[i]) {
+            passed = false;
+            break;
+        }
+    }
+
+    record_test("Vec add (int32)", passed);
+
+    /* Print cycle comparison */
+    console_printf("[RVV] vec_add_i32: scalar=%lu vec=%lu cycles\n", scalar_cycles, vector_cycles);
+}
+
+/**
+ * @brief Test 3: Vector memcpy correctness
+ */
+static void test_rvv_memcpy(void)
+{
+    static uint8_t src[RVV_TEST_SIZE * 4];
+    static uint8_t dst_scalar[RVV_TEST_SIZE * 4];
+    static uint8_t dst_vector[RVV_TEST_SIZE * 4];
+    size_t nbytes = RVV_TEST_SIZE * 4;
+
+    /* Initialize source data */
+    for (uint32_t i = 0; i < nbytes; i++) {
+        src[i] = (uint8_t) (i & 0xFF);
+    }
+    rvv_memset(dst_scalar, 0, nbytes);
+    rvv_memset(dst_vector, 0, nbytes);
+
+    /* Scalar reference */
+    roi_begin("scalar_memcpy");
+    scalar_memcpy(dst_scalar, src, nbytes);
+    uint64_t scalar_cycles = roi_end();
+
+    /* RVV implementation */
+    roi_begin("rvv_memcpy");
+    rvv_memcpy(dst_vector, src, nbytes);
+    uint64_t vector_cycles = roi_end();
+
+    /* Verify correctness */
+    bool passed = true;
+    for (uint32_t i = 0; i < nbytes; i++) {
+        if (dst_scalar[i] != dst_vector[i]) {
+            passed = false;
+            break;
+        }
+    }
+
+    record_test("Vec memcpy", passed);
+
+    console_printf("[RVV] vec_memcpy: scalar=%lu vec=%lu cycles\n", scalar_cycles, vector_cycles);
+}
+
+/**
+ * @brief Test 4: Float32 vector add correctness
+ */
+static void test_rvv_vec_add_f32(void)
+{
+    static float a[RVV_TEST_SIZE];
+    static float b[RVV_TEST_SIZE];
+    static float c_scalar[RVV_TEST_SIZE];
+    static float c_vector[RVV_TEST_SIZE];
+
+    /* Initialize test data */
+    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
+        a[i] = (float) (i + 1) * 1.0f;
+        b[i] = (float) (i) * 0.5f;
+    }
+
+    /* Scalar reference */
+    roi_begin("scalar_vec_add_f32");
+    scalar_vec_add_f32(a, b, c_scalar, RVV_TEST_SIZE);
+    uint64_t scalar_cycles = roi_end();
+
+    /* RVV implementation */
+    roi_begin("rvv_vec_add_f32");
+    rvv_vec_add_f32(a, b, c_vector, RVV_TEST_SIZE);
+    uint64_t vector_cycles = roi_end();
+
+    /* Verify correctness (with floating-point tolerance) */
+    bool passed = true;
+    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
+        if (!rvv_float_eq(c_scalar[i], c_vector[i], 0.001f)) {
+            passed = false;
+            break;
+        }
+    }
+
+    record_test("Vec add (float32)", passed);
+
+    console_printf("[RVV] vec_add_f32: scalar=%lu vec=%lu cycles\n", scalar_cycles, vector_cycles);
+}
+
+/**
+ * @brief Test 5: Dot product correctness
+ */
+static void test_rvv_dot_product(void)
+{
+    static float a[RVV_TEST_SIZE];
+    static float b[RVV_TEST_SIZE];
+
+    /* Initialize test data: a[i] = i+1, b[i] = 1.0 */
+    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
+        a[i] = (float) (i + 1);
+        b[i] = 1.0f;
+    }
+
+    /* Scalar reference: sum(1..64) = 64*65/2 = 2080 */
+    roi_begin("scalar_dot_product_f32");
+    float scalar_result = scalar_dot_product_f32(a, b, RVV_TEST_SIZE);
+    uint64_t scalar_cycles = roi_end();
+
+    /* RVV implementation */
+    roi_begin("rvv_dot_product_f32");
+    float vector_result = rvv_dot_product_f32(a, b, RVV_TEST_SIZE);
+    uint64_t vector_cycles = roi_end();
+
+    /* Verify correctness */
+    bool passed = rvv_float_eq(scalar_result, vector_result, 0.01f);
+
+    record_test("Dot product (float32)", passed);
+
+    console_printf("[RVV] dot_product: scalar=%lu vec=%lu cycles\n", scalar_cycles, vector_cycles);
+}
+
+/**
+ * @brief Test 6: SAXPY correctness
+ */
+static void test_rvv_saxpy(void)
+{
+    static float x[RVV_TEST_SIZE];
+    static float y_scalar[RVV_TEST_SIZE];
+    static float y_vector[RVV_TEST_SIZE];
+    float a = 2.0f;
+
+    /* Initialize test data */
+    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
+        x[i] = (float) (i + 1);
+        y_scalar[i] = (float) i * 0.5f;
+    }
+    rvv_memcpy(y_vector, y_scalar, sizeof(y_vector));
+
+    /* Scalar reference */
+    roi_begin("scalar_saxpy");
+    scalar_saxpy(a, x, y_scalar, RVV_TEST_SIZE);
+    uint64_t scalar_cycles = roi_end();
 
     /* RVV implementation */
-    start = rvv_read_mcycle();
-    float vector_result = rvv_dot_product_f32(a, b, RVV_TEST_SIZE);
-    uint64_t vector_cycles = rvv_read_mcycle() - start;
+    roi_begin("rvv_saxpy");
+    rvv_saxpy(a, x, y_vector, RVV_TEST_SIZE);
+    uint64_t vector_cycles = roi_end();
+
+    /* Verify correctness */
+    bool passed = true;
+    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
+        if (!rvv_float_eq(y_scalar[i], y_vector[i], 0.01f)) {
+            passed = false;
+            break;
+        }
+    }
+
+    record_test("SAXPY (float32)", passed);
+
+    console_printf("[RVV] saxpy: scalar=%lu vec=%lu cycles\n", scalar_cycles, vector_cycles);
+}
+
+/**
+ * @brief Test 7: Matrix multiply correctness
+ */
+static void test_rvv_matmul(void)
+{
+    static float A[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
+    static float B[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
+    static float C_scalar[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
+    static float C_vector[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
+    uint32_t dim = RVV_MATRIX_DIM;
+
+    /* Initialize test matrices */
+    for (uint32_t i = 0; i < dim * dim; i++) {
+        A[i] = (float) ((i % dim) + 1);
+        B[i] = (float) ((i / dim) + 1);
+    }
+
+    /* Scalar reference */
+    roi_begin("scalar_matmul_f32");
+    scalar_matmul_f32(A, B, C_scalar, dim, dim, dim);
+    uint64_t scalar_cycles = roi_end();
+
+    /* RVV implementation */
+    roi_begin("rvv_matmul_f32");
+    rvv_matmul_f32(A, B, C_vector, dim, dim, dim);
+    uint64_t vector_cycles = roi_end();
+
+    /* Verify correctness */
+    bool passed = true;
+    for (uint32_t i = 0; i < dim * dim; i++) {
+        if (!rvv_float_eq(C_scalar[i], C_vector[i], 0.1f)) {
+            passed = false;
+            break;
+        }
+    }
+
+    record_test("Matrix multiply (float32)", passed);
+
+    console_printf("[RVV] matmul: scalar=%lu vec=%lu cycles\n", scalar_cycles, vector_cycles);
+}
+
+/**
+ * @brief Print a x100 fixed-point value as "N.NN"
+ */
+static void print_fixed2(uint64_t value_x100)
+{
+    console_printf("%lu.%02lu", value_x100 / 100, value_x100 % 100);
+}
+
+/**
+ * @brief Print one GEMM timing line: cycles, flop/cycle and GFLOP/s
+ */
+static void print_gemm_result(const char *kernel, uint32_t dim, uint64_t cycles)
+{
+    uint64_t flops = 2ULL * dim * dim * dim;
+
+    if (cycles == 0) {
+        cycles = 1;
+    }
+
+    console_printf("[RVV] gemm %ux%u %s: cycles=%lu flop/cycle=", dim, dim, kernel, cycles);
+    print_fixed2(flops * 100 / cycles);
+    console_printf(" GFLOP/s@%uMHz=", (unsigned) RVV_BENCH_CPU_MHZ);
+    print_fixed2(flops * RVV_BENCH_CPU_MHZ / (cycles * 10));
+    console_puts("\n");
+}
+
+/**
+ * @brief Test 8: Blocked GEMM correctness and GFLOP/s sweep
+ *
+ * Compares the row-at-a-time rvv_matmul_f32() against both blocked
+ * microkernels. Inputs are small integers, so every partial sum is exact
+ * in float32 and the results must match bit-for-bit regardless of the
+ * summation order. The 13x13 case exercises row and column edge tiles.
+ */
+static void test_rvv_gemm(void)
+{
+    static float A[RVV_GEMM_MAX_DIM * RVV_GEMM_MAX_DIM];
+    static float B[RVV_GEMM_MAX_DIM * RVV_GEMM_MAX_DIM];
+    static float C_row[RVV_GEMM_MAX_DIM * RVV_GEMM_MAX_DIM];
+    static float C_blk[RVV_GEMM_MAX_DIM * RVV_GEMM_MAX_DIM];
+#ifdef RVV_BENCH_SWEEP
+    static const uint32_t dims[] = {13, 64, 128, 256, 512};
+#else
+    static const uint32_t dims[] = {13, 64};
+#endif
+    static const struct {
+        const char *name;
+        const char *roi;
+        rvv_gemm_ukernel_t uk;
+    } kernels[] = {
+        {"blocked-8xm2", "rvv_gemm_f32.blocked-8xm2", RVV_GEMM_UK_8X_M2},
+        {"blocked-4xm4", "rvv_gemm_f32.blocked-4xm4", RVV_GEMM_UK_4X_M4},
+    };
+    bool passed = true;
+
+    for (uint32_t d = 0; d < sizeof(dims) / sizeof(dims[0]); d++) {
+        uint32_t dim = dims[d];
+
+        for (uint32_t i = 0; i < dim * dim; i++) {
+            A[i] = (float) ((int32_t) ((i * 3) % 5) - 2);
+            B[i] = (float) ((int32_t) ((i * 7) % 9) - 4);
+        }
+
+        roi_begin("rvv_gemm_f32.row");
+        rvv_matmul_f32(A, B, C_row, dim, dim, dim);
+        uint64_t row_cycles = roi_end();
+        print_gemm_result("row", dim, row_cycles);
+
+        for (uint32_t u = 0; u < sizeof(kernels) / sizeof(kernels[0]); u++) {
+            roi_begin(kernels[u].roi);
+            rvv_gemm_f32_uk(A, B, C_blk, dim, dim, dim, kernels[u].uk);
+            uint64_t blk_cycles = roi_end();
+            print_gemm_result(kernels[u].name, dim, blk_cycles);
+
+            for (uint32_t i = 0; i < dim * dim; i++) {
+                if (C_row[i] != C_blk[i]) {
+                    passed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    record_test("Blocked GEMM (float32)", passed);
+}
+
+/**
+ * @brief Test 9: Dot product reduction modes (ordered vs fast) sweep
+ *
+ * The inputs are multiples of 0.25 whose running sum grows past 2^22, the
+ * limit for exact quarter multiples, so rounding depends on the summation
+ * order. The ordered mode must match the scalar reference bit-for-bit. The
+ * fast mode is checked against the exact sum (computed in integers) to a
+ * relative 1e-5; its per-lane partial sums are more accurate than the
+ * sequential scalar sum, which drifts by ~0.2% at 1M elements.
+ */
+static void test_rvv_dot_modes(void)
+{
+    static float a[RVV_DOT_MAX_LEN];
+    static float b[RVV_DOT_MAX_LEN];
+    bool passed = true;
+
+    for (uint32_t i = 0; i < RVV_DOT_MAX_LEN; i++) {
+        a[i] = (float) ((i % 17) + 1) * 0.25f;
+        b[i] = (float) ((i % 5) + 1);
+    }
+
+    for (size_t n = 64; n <= RVV_DOT_MAX_LEN; n *= 4) {
+        uint64_t exact_x4 = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            exact_x4 += (uint64_t) ((i % 17) + 1) * ((i % 5) + 1);
+        }
+        float exact = (float) exact_x4 * 0.25f;
+
+        roi_begin("scalar_dot_product_f32");
+        float scalar_result = scalar_dot_product_f32(a, b, n);
+        uint64_t scalar_cycles = roi_end();
+
+        roi_begin("rvv_dot_product_f32_mode.ordered");
+        float ordered_result = rvv_dot_product_f32_mode(a, b, n, RVV_REDUCE_ORDERED);
+        uint64_t ordered_cycles = roi_end();
+
+        roi_begin("rvv_dot_product_f32_mode.fast");
+        float fast_result = rvv_dot_product_f32_mode(a, b, n, RVV_REDUCE_FAST);
+        uint64_t fast_cycles = roi_end();
+
+        if (ordered_result != scalar_result ||
+            !rvv_float_eq(fast_result, exact, exact * 1e-5f)) {
+            passed = false;
+        }
+
+        console_printf("[RVV] dot n=%zu: scalar=%lu ordered=%lu fast=%lu cycles\n", n,
+                       scalar_cycles, ordered_cycles, fast_cycles);
+    }
+
+    record_test("Dot product modes (float32)", passed);
+}
+
+/**
+ * @brief Check a copy/fill result and its guard bytes
+ * @return true if buf[off..off+n) matches ref[off..off+n) and the
+ *         RVV_MEM_GUARD bytes on either side still hold the guard value
+ */
+static bool mem_region_ok(const uint8_t *buf, const uint8_t *ref, size_t off, size_t n)
+{
+    for (size_t i = off - RVV_MEM_GUARD; i < off; i++) {
+        if (buf[i] != 0xA5) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (buf[off + i] != ref[off + i]) {
+            return false;
+        }
+    }
+    for (size_t i = off + n; i < off + n + RVV_MEM_GUARD; i++) {
+        if (buf[i] != 0xA5) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Test 10: memcpy/memset family correctness and bytes/cycle sweep
+ *
+ * Correctness covers every src/dst misalignment (0-7) for lengths around
+ * the scalar, single-strip and e64 bulk thresholds, with guard bytes to
+ * catch overruns. The sweep then times each path from 1 B up to
+ * RVV_MEM_MAX_LEN on 64-byte aligned buffers.
+ */
+static void test_rvv_mem_family(void)
+{
+    static uint8_t mem_src[RVV_MEM_MAX_LEN + 2 * RVV_MEM_GUARD] __attribute__((aligned(64)));
+    static uint8_t mem_dst[RVV_MEM_MAX_LEN + 2 * RVV_MEM_GUARD] __attribute__((aligned(64)));
+    static uint8_t mem_ref[RVV_MEM_CHECK_LEN + 8 + 2 * RVV_MEM_GUARD];
+    static const size_t lens[] = {0,   1,   7,   8,   15,  16,  63,  64,
+                                  65,  127, 128, 129, 255, 256, 257, 1000,
+                                  RVV_MEM_CHECK_LEN};
+    bool passed = true;
+
+    for (size_t i = 0; i < sizeof(mem_src); i++) {
+        mem_src[i] = (uint8_t) (i * 7 + 3);
+    }
+
+    /* Correctness: all relative alignments, all size classes */
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]) && passed; l++) {
+        size_t n = lens[l];
+        for (size_t so = 0; so < 8 && passed; so++) {
+            for (size_t d_off = 0; d_off < 8 && passed; d_off++) {
+                size_t doff = RVV_MEM_GUARD + d_off;
+                size_t span = doff + n + RVV_MEM_GUARD;
+
+                scalar_memset(mem_dst, 0xA5, span);
+                scalar_memset(mem_ref, 0xA5, span);
+                scalar_memcpy(&mem_ref[doff], &mem_src[so], n);
+                rvv_memcpy(&mem_dst[doff], &mem_src[so], n);
+                passed = mem_region_ok(mem_dst, mem_ref, doff, n);
+
+                if (passed) {
+                    scalar_memset(mem_dst, 0xA5, span);
+                    rvv_memcpy_stream(&mem_dst[doff], &mem_src[so], n);
+                    passed = mem_region_ok(mem_dst, mem_ref, doff, n);
+                }
+
+                if (passed && so == 0) {
+                    scalar_memset(mem_dst, 0xA5, span);
+                    scalar_memset(&mem_ref[doff], 0x3C, n);
+                    rvv_memset(&mem_dst[doff], 0x3C, n);
+                    passed = mem_region_ok(mem_dst, mem_ref, doff, n);
+                }
+            }
+        }
+    }
+
+    /* Sweep: bytes per cycle for each path */
+    for (size_t n = 1; n <= RVV_MEM_MAX_LEN; n *= 2) {
+        roi_begin("scalar_memcpy");
+        scalar_memcpy(mem_dst, mem_src, n);
+        uint64_t scalar_cycles = roi_end();
+
+        roi_begin("rvv_memcpy");
+        rvv_memcpy(mem_dst, mem_src, n);
+        uint64_t copy_cycles = roi_end();
+
+        roi_begin("rvv_memcpy_stream");
+        rvv_memcpy_stream(mem_dst, mem_src, n);
+        uint64_t stream_cycles = roi_end();
+
+        roi_begin("rvv_memset");
+        rvv_memset(mem_dst, 0, n);
+        uint64_t set_cycles = roi_end();
+
+        console_printf("[RVV] mem n=%zu: B/cycle scalar=", n);
+        print_fixed2(n * 100 / (scalar_cycles ? scalar_cycles : 1));
+        console_puts(" memcpy=");
+        print_fixed2(n * 100 / (copy_cycles ? copy_cycles : 1));
+        console_puts(" stream=");
+        print_fixed2(n * 100 / (stream_cycles ? stream_cycles : 1));
+        console_puts(" memset=");
+        print_fixed2(n * 100 / (set_cycles ? set_cycles : 1));
+        console_puts("\n");
+    }
+
+    record_test("Mem copy/set family", passed);
+}
+
+/* Buffers shared by the HPM profile kernels */
+static float hpm_x[RVV_HPM_LARGE_SIZE] __attribute__((aligned(64)));
+static float hpm_y[RVV_HPM_LARGE_SIZE] __attribute__((aligned(64)));
+static int32_t hpm_a[RVV_HPM_LARGE_SIZE] __attribute__((aligned(64)));
+static int32_t hpm_b[RVV_HPM_LARGE_SIZE] __attribute__((aligned(64)));
+static int32_t hpm_c[RVV_HPM_LARGE_SIZE] __attribute__((aligned(64)));
+static volatile float hpm_sink;
+
+static void hpm_run_scalar_vec_add(size_t n)
+{
+    scalar_vec_add_i32(hpm_a, hpm_b, hpm_c, n);
+}
+
+static void hpm_run_rvv_vec_add(size_t n)
+{
+    rvv_vec_add_i32(hpm_a, hpm_b, hpm_c, n);
+}
+
+static void hpm_run_scalar_dot(size_t n)
+{
+    hpm_sink = scalar_dot_product_f32(hpm_x, hpm_y, n);
+}
+
+static void hpm_run_rvv_dot(size_t n)
+{
+    hpm_sink = rvv_dot_product_f32(hpm_x, hpm_y, n);
+}
+
+static void hpm_run_scalar_saxpy(size_t n)
+{
+    scalar_saxpy(1.5f, hpm_x, hpm_y, n);
+}
+
+static void hpm_run_rvv_saxpy(size_t n)
+{
+    rvv_saxpy(1.5f, hpm_x, hpm_y, n);
+}
+
+static void hpm_run_rvv_memcpy(size_t n)
+{
+    rvv_memcpy(hpm_c, hpm_a, n * sizeof(int32_t));
+}
+
+/**
+ * @brief Test 11: HPM profile of the streaming kernels
+ *
+ * Runs each kernel at RVV_TEST_SIZE and RVV_HPM_LARGE_SIZE elements under
+ * hpm_begin()/hpm_end() and prints IPC plus cache-miss and branch-mispredict
+ * counts per element. Passes when every region retired instructions after
+ * the counter-read overhead was subtracted.
+ */
+static void test_rvv_hpm_profile(void)
+{
+    static const hpm_event_t events[] = {HPM_EVENT_L1D_MISS, HPM_EVENT_L1I_MISS,
+                                         HPM_EVENT_BRANCH_MISS, HPM_EVENT_DTLB_MISS};
+    static const struct {
+        const char *name;
+        void (*run)(size_t n);
+    } kernels[] = {
+        {"scalar_vec_add_i32", hpm_run_scalar_vec_add},
+        {"rvv_vec_add_i32", hpm_run_rvv_vec_add},
+        {"scalar_dot_product_f32", hpm_run_scalar_dot},
+        {"rvv_dot_product_f32", hpm_run_rvv_dot},
+        {"scalar_saxpy", hpm_run_scalar_saxpy},
+        {"rvv_saxpy", hpm_run_rvv_saxpy},
+        {"rvv_memcpy", hpm_run_rvv_memcpy},
+    };
+    static const size_t sizes[] = {RVV_TEST_SIZE, RVV_HPM_LARGE_SIZE};
+    bool passed = true;
+
+    for (uint32_t i = 0; i < RVV_HPM_LARGE_SIZE; i++) {
+        hpm_x[i] = (float) (i & 63) * 0.25f;
+        hpm_y[i] = 1.0f;
+        hpm_a[i] = (int32_t) i;
+        hpm_b[i] = (int32_t) (3 * i);
+    }
+
+    hpm_init(events, sizeof(events) / sizeof(events[0]));
+
+    const hpm_sample_t *cost = hpm_overhead();
+    console_printf("[HPM] overhead: cycles=%lu instret=%lu\n", cost->cycles, cost->instret);
+    for (uint32_t s = 0; s < hpm_num_events(); s++) {
+        console_printf("[HPM] mhpmcounter%u: %s %s\n", CSR_HPM_FIRST + s,
+                       hpm_event_name(hpm_slot_event(s)),
+                       hpm_slot_live(s) ? "programmed" : "n/a");
+    }
+
+    for (size_t z = 0; z < sizeof(sizes) / sizeof(sizes[0]); z++) {
+        for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+            hpm_sample_t start, delta;
+
+            hpm_begin(&start);
+            kernels[k].run(sizes[z]);
+            hpm_end(&start, &delta);
+
+            hpm_report(kernels[k].name, &delta, sizes[z]);
+            if (delta.instret == 0 || delta.cycles == 0) {
+                passed = false;
+            }
+        }
+    }
+
+    record_test("HPM profiling", passed);
+}
+
+/**
+ * @brief Test 12: Benchmark runner (warm-up, repeated runs, size sweep)
+ *
+ * Runs the rvv_bench registry and emits one [BENCH-CSV]/[BENCH-JSON]
+ * line per kernel, implementation and size for CI to collect. Passes when
+ * every kernel matched its scalar reference at every size.
+ */
+static void test_rvv_bench_runner(void)
+{
+    uint32_t failures = rvv_bench_run_all();
+
+    if (failures != 0) {
+        console_printf("[BENCH] %u kernel/size checks failed\n", failures);
+    }
+    record_test("Benchmark runner", failures == 0);
+}
+
+#define DISPATCH_TEST_LEN 1000
+#define DISPATCH_TEST_GUARD 4
+
+/* Select one variant and check it at every test length */
+static bool dispatch_check_variant(rvv_kernel_t kernel, rvv_variant_t variant)
+{
+    static int32_t ia[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+    static int32_t ib[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+    static int32_t ic[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+    static int32_t iref[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+    static float fa[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+    static float fb[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+    static float fc[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+    static float fref[DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD];
+
+    /* VLMAX for e32 at this variant's LMUL */
+    static const uint32_t lmul[RVV_VARIANT_COUNT] = {
+        [RVV_VARIANT_M1] = 1,    [RVV_VARIANT_M2] = 2,    [RVV_VARIANT_M4] = 4,
+        [RVV_VARIANT_M8] = 8,    [RVV_VARIANT_M2_X2] = 2, [RVV_VARIANT_M4_X2] = 4,
+    };
+    size_t vlmax = (size_t) (rvv_get_vlen() / 32) * lmul[variant];
+    size_t lens[] = {0, 1, vlmax - 1, vlmax, vlmax + 1, 2 * vlmax + 1, DISPATCH_TEST_LEN - 1};
+
+    rvv_dispatch_select(kernel, variant);
+
+    for (size_t t = 0; t < sizeof(lens) / sizeof(lens[0]); t++) {
+        size_t n = lens[t];
+        bool ok = true;
+
+        if (n > DISPATCH_TEST_LEN) {
+            continue;
+        }
+
+        for (size_t i = 0; i < DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD; i++) {
+            ia[i] = (int32_t) (i * 5) - 700;
+            ib[i] = (int32_t) (i % 97);
+            ic[i] = -1;
+            iref[i] = -1;
+            fa[i] = (float) (i % 11) * 0.5f - 2.0f;
+            fb[i] = (float) (i % 7) + 0.25f;
+            fc[i] = fb[i];
+            fref[i] = fb[i];
+        }
+
+        switch (kernel) {
+        case RVV_KERNEL_VEC_ADD_I32:
+            rvv_vec_add_i32(ia, ib, ic, n);
+            scalar_vec_add_i32(ia, ib, iref, n);
+            for (size_t i = 0; i < DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD; i++) {
+                ok = ok && ic[i] == iref[i];
+            }
+            break;
+        case RVV_KERNEL_VEC_ADD_F32:
+            rvv_vec_add_f32(fa, fb, fc, n);
+            scalar_vec_add_f32(fa, fb, fref, n);
+            for (size_t i = 0; i < DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD; i++) {
+                ok = ok && fc[i] == fref[i];
+            }
+            break;
+        case RVV_KERNEL_SAXPY:
+            rvv_saxpy(1.5f, fa, fc, n);
+            scalar_saxpy(1.5f, fa, fref, n);
+            for (size_t i = 0; i < DISPATCH_TEST_LEN + DISPATCH_TEST_GUARD; i++) {
+                ok = ok && rvv_float_eq(fc[i], fref[i], 1e-5f);
+            }
+            break;
+        case RVV_KERNEL_DOT_F32:
+            ok = rvv_dot_product_f32(fa, fb, n) == scalar_dot_product_f32(fa, fb, n);
+            break;
+        default:
+            ok = false;
+            break;
+        }
+
+        if (!ok) {
+            console_printf("[RVV] dispatch %s %s: mismatch at n=%zu\n", rvv_kernel_name(kernel),
+                           rvv_variant_name(variant), n);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Test 13: Kernel dispatch (every LMUL variant vs the scalar reference)
+ *
+ * Selects each compiled variant of each dispatched kernel in turn and
+ * checks it through the public entry point at lengths around the strip
+ * boundaries (0, 1, VLMAX - 1, VLMAX, VLMAX + 1 for that LMUL, and an odd
+ * length covering several strips). Guard elements past n must be left
+ * untouched. The startup selection is restored afterwards.
+ */
+static void test_rvv_dispatch(void)
+{
+    rvv_variant_t saved[RVV_KERNEL_COUNT];
+    uint32_t checked = 0;
+    uint32_t failures = 0;
+
+    for (int k = 0; k < RVV_KERNEL_COUNT; k++) {
+        saved[k] = rvv_dispatch.selected[k];
+    }
+
+    for (int k = 0; k < RVV_KERNEL_COUNT; k++) {
+        for (int v = 0; v < RVV_VARIANT_COUNT; v++) {
+            if (!rvv_variant_available((rvv_kernel_t) k, (rvv_variant_t) v)) {
+                continue;
+            }
+            checked++;
+            if (!dispatch_check_variant((rvv_kernel_t) k, (rvv_variant_t) v)) {
+                failures++;
+            }
+        }
+    }
+
+    for (int k = 0; k < RVV_KERNEL_COUNT; k++) {
+        rvv_dispatch_select((rvv_kernel_t) k, saved[k]);
+    }
+
+    console_printf("[RVV] dispatch: %u variants checked, %u mismatched\n", checked, failures);
+    console_printf("[RVV] dispatch heuristic for VLEN=%lu: %s\n", rvv_get_vlen(),
+                   rvv_variant_name(rvv_dispatch_heuristic(rvv_get_vlen())));
+    rvv_dispatch_print();
+
+    record_test("Kernel dispatch", failures == 0);
+}
+
+#define EXT_TEST_LEN 1000
+#define EXT_TEST_GUARD 4
+#define EXT_WIDE_STRIDE 3
+
+/* Every length the extended-kernel checks run at */
+static const size_t ext_lens[] = {0, 1, 7, 16, 17, 63, 64, 65, 255, 256, 257, EXT_TEST_LEN};
+
+/* memcmp with no, first, middle and last byte differing; strlen at 0-7 byte offsets */
+static bool ext_check_string(void)
+{
+    static uint8_t a[EXT_TEST_LEN + 8];
+    static uint8_t b[EXT_TEST_LEN + 8];
+    static char str[EXT_TEST_LEN + 8];
+
+    for (size_t t = 0; t < sizeof(ext_lens) / sizeof(ext_lens[0]); t++) {
+        size_t n = ext_lens[t];
+        size_t where[] = {n, 0, n / 2, n - 1};
+
+        for (size_t w = 0; w < sizeof(where) / sizeof(where[0]); w++) {
+            for (size_t i = 0; i < n + 1; i++) {
+                a[i] = (uint8_t) (i * 13 + 1);
+                b[i + 1] = a[i];
+            }
+            if (where[w] < n) {
+                b[where[w] + 1] += (uint8_t) (w * 50 + 1);
+            }
+            if (rvv_memcmp(a, &b[1], n) != scalar_memcmp(a, &b[1], n)) {
+                console_printf("[RVV] ext memcmp: mismatch at n=%zu\n", n);
+                return false;
+            }
+        }
+
+        for (size_t off = 0; off < 8; off++) {
+            for (size_t i = 0; i < n; i++) {
+                str[off + i] = (char) ('A' + (i % 26));
+            }
+            str[off + n] = '\0';
+            if (rvv_strlen(&str[off]) != n) {
+                console_printf("[RVV] ext strlen: mismatch at n=%zu offset %zu\n", n, off);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Integer and float sum/min/max, float min/max with a NaN, prefix sum in and out of place */
+static bool ext_check_reduce(void)
+{
+    static int32_t x[EXT_TEST_LEN + EXT_TEST_GUARD];
+    static int32_t y[EXT_TEST_LEN + EXT_TEST_GUARD];
+    static int32_t ref[EXT_TEST_LEN + EXT_TEST_GUARD];
+    static float f[EXT_TEST_LEN];
+
+    for (size_t t = 0; t < sizeof(ext_lens) / sizeof(ext_lens[0]); t++) {
+        size_t n = ext_lens[t];
+        bool ok = true;
+
+        for (size_t i = 0; i < EXT_TEST_LEN + EXT_TEST_GUARD; i++) {
+            x[i] = (int32_t) ((i * 2654435761u) >> 1) - 0x20000000;
+            y[i] = -1;
+            ref[i] = -1;
+        }
+        for (size_t i = 0; i < EXT_TEST_LEN; i++) {
+            f[i] = (float) ((int32_t) (i % 23) - 11) * 0.375f;
+        }
+
+        ok = ok && rvv_reduce_sum_i32(x, n) == scalar_reduce_sum_i32(x, n);
+        ok = ok && rvv_reduce_min_i32(x, n) == scalar_reduce_min_i32(x, n);
+        ok = ok && rvv_reduce_max_i32(x, n) == scalar_reduce_max_i32(x, n);
+        ok = ok && rvv_reduce_sum_f32(f, n) == scalar_reduce_sum_f32(f, n);
+        ok = ok && rvv_reduce_min_f32(f, n) == scalar_reduce_min_f32(f, n);
+        ok = ok && rvv_reduce_max_f32(f, n) == scalar_reduce_max_f32(f, n);
+        if (n > 1) {
+            f[n / 2] = __builtin_nanf("");
+            ok = ok && rvv_reduce_min_f32(f, n) == scalar_reduce_min_f32(f, n);
+            ok = ok && rvv_reduce_max_f32(f, n) == scalar_reduce_max_f32(f, n);
+        }
+
+        rvv_prefix_sum_i32(x, y, n);
+        scalar_prefix_sum_i32(x, ref, n);
+        for (size_t i = 0; i < EXT_TEST_LEN + EXT_TEST_GUARD; i++) {
+            ok = ok && y[i] == ref[i];
+        }
+        rvv_prefix_sum_i32(x, x, n);
+        for (size_t i = 0; i < n; i++) {
+            ok = ok && x[i] == ref[i];
+        }
+
+        if (!ok) {
+            console_printf("[RVV] ext reduce/scan: mismatch at n=%zu\n", n);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Strided (stride 1, 3, -2, and 0 for the gather) and indexed gather/scatter */
+static bool ext_check_gather(void)
+{
+    static float src[EXT_TEST_LEN * EXT_WIDE_STRIDE];
+    static float out[EXT_TEST_LEN * EXT_WIDE_STRIDE + EXT_TEST_GUARD];
+    static float ref[EXT_TEST_LEN * EXT_WIDE_STRIDE + EXT_TEST_GUARD];
+    static uint32_t idx[EXT_TEST_LEN];
+    static const ptrdiff_t strides[] = {1, EXT_WIDE_STRIDE, -2, 0};
+    const size_t span = EXT_TEST_LEN * EXT_WIDE_STRIDE + EXT_TEST_GUARD;
+
+    for (size_t i = 0; i < EXT_TEST_LEN * EXT_WIDE_STRIDE; i++) {
+        src[i] = (float) i * 0.5f;
+    }
+
+    for (size_t t = 0; t < sizeof(ext_lens) / sizeof(ext_lens[0]); t++) {
+        size_t n = ext_lens[t];
+        bool ok = true;
+
+        for (size_t s = 0; s < sizeof(strides) / sizeof(strides[0]); s++) {
+            ptrdiff_t stride = strides[s];
+            /* Negative strides start at the highest element they touch */
+            size_t base = stride < 0 && n > 0 ? (n - 1) * (size_t) -stride : 0;
+
+            for (size_t i = 0; i < span; i++) {
+                out[i] = -1.0f;
+                ref[i] = -1.0f;
+            }
+            rvv_gather_strided_f32(out, &src[base], stride, n);
+            scalar_gather_strided_f32(ref, &src[base], stride, n);
+            for (size_t i = 0; i < span; i++) {
+                ok = ok && out[i] == ref[i];
+            }
+
+            if (stride != 0) {
+                rvv_scatter_strided_f32(&out[base], stride, src, n);
+                scalar_scatter_strided_f32(&ref[base], stride, src, n);
+                for (size_t i = 0; i < span; i++) {
+                    ok = ok && out[i] == ref[i];
+                }
+            }
+        }
+
+        /* Reversed, rotated permutation: distinct indices for any n */
+        for (size_t i = 0; i < n; i++) {
+            idx[i] = (uint32_t) ((n + 6 - i) % n);
+        }
+        for (size_t i = 0; i < span; i++) {
+            out[i] = -1.0f;
+            ref[i] = -1.0f;
+        }
+        rvv_gather_f32(out, src, idx, n);
+        scalar_gather_f32(ref, src, idx, n);
+        rvv_scatter_f32(&out[EXT_TEST_LEN], idx, src, n);
+        scalar_scatter_f32(&ref[EXT_TEST_LEN], idx, src, n);
+        for (size_t i = 0; i < span; i++) {
+            ok = ok && out[i] == ref[i];
+        }
+
+        if (!ok) {
+            console_printf("[RVV] ext gather/scatter: mismatch at n=%zu\n", n);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Test 14: Extended kernels (memcmp/strlen, reductions, scan, gather/scatter)
+ *
+ * Checks every extended kernel against its scalar reference at lengths
+ * around the strip boundaries, with guard elements past n that must stay
+ * untouched. The reductions, the prefix sum and the data movement kernels
+ * must match exactly; timings are in the benchmark runner (Test 12).
+ */
+static void test_rvv_ext_kernels(void)
+{
+    bool string_ok = ext_check_string();
+    bool reduce_ok = ext_check_reduce();
+    bool gather_ok = ext_check_gather();
+
+    console_printf("[RVV] ext: memcmp/strlen %s, reduce/scan %s, gather/scatter %s\n",
+                   string_ok ? "ok" : "mismatch", reduce_ok ? "ok" : "mismatch",
+                   gather_ok ? "ok" : "mismatch");
+    record_test("Extended kernels", string_ok && reduce_ok && gather_ok);
+}
 
-    /* Verify correctness */
-    bool passed = rvv_float_eq(scalar_result, vector_result, 0.01f);
+#define FUSED_TEST_LEN RVV_HPM_LARGE_SIZE
 
-    record_test("Dot product (float32)", passed);
+/**
+ * @brief Test 15: Fused element-wise chain (AXPBY + clamp) vs the unfused chain
+ *
+ * rvv_axpbz_clamp_f32() and rvv_clamp_f32() are checked against their
+ * scalar references (tolerance: the vector kernels fuse a*x + t), with y
+ * aliasing x as well. With b = 1 the fused kernel computes exactly what
+ * the three-pass chain z -> y, rvv_saxpy(), rvv_clamp_f32() does, so the
+ * two must agree bit for bit; the test then prints the cycles of both
+ * at FUSED_TEST_LEN elements.
+ */
+static void test_rvv_fused_chain(void)
+{
+    static float x[FUSED_TEST_LEN] __attribute__((aligned(64)));
+    static float z[FUSED_TEST_LEN] __attribute__((aligned(64)));
+    static float y[FUSED_TEST_LEN + EXT_TEST_GUARD] __attribute__((aligned(64)));
+    static float ref[FUSED_TEST_LEN + EXT_TEST_GUARD] __attribute__((aligned(64)));
+    const float a = 0.75f;
+    const float lo = -2.0f;
+    const float hi = 6.0f;
+    bool passed = true;
 
-    console_puts("[RVV] dot_product: scalar=");
-    int_to_str(scalar_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" vec=");
-    int_to_str(vector_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" cycles\n");
+    for (size_t t = 0; t < sizeof(ext_lens) / sizeof(ext_lens[0]) && passed; t++) {
+        size_t n = ext_lens[t];
+
+        for (size_t i = 0; i < FUSED_TEST_LEN; i++) {
+            x[i] = (float) ((int32_t) (i % 29) - 9) * 0.5f;
+            z[i] = (float) ((int32_t) (i % 13) - 4) * 0.75f;
+        }
+        for (size_t i = 0; i < FUSED_TEST_LEN + EXT_TEST_GUARD; i++) {
+            y[i] = 42.0f;
+            ref[i] = 42.0f;
+        }
+
+        rvv_axpbz_clamp_f32(a, x, -1.25f, z, lo, hi, y, n);
+        scalar_axpbz_clamp_f32(a, x, -1.25f, z, lo, hi, ref, n);
+        for (size_t i = 0; i < FUSED_TEST_LEN + EXT_TEST_GUARD; i++) {
+            passed = passed && rvv_float_eq(y[i], ref[i], 1e-5f);
+        }
+
+        rvv_clamp_f32(z, lo, 1.0f, y, n);
+        scalar_clamp_f32(z, lo, 1.0f, ref, n);
+        for (size_t i = 0; i < FUSED_TEST_LEN + EXT_TEST_GUARD; i++) {
+            passed = passed && y[i] == ref[i];
+        }
+
+        /* In place: y aliases x */
+        scalar_axpbz_clamp_f32(a, x, -1.25f, z, lo, hi, ref, n);
+        rvv_axpbz_clamp_f32(a, x, -1.25f, z, lo, hi, x, n);
+        for (size_t i = 0; i < n; i++) {
+            passed = passed && rvv_float_eq(x[i], ref[i], 1e-5f);
+        }
+
+        if (!passed) {
+            console_printf("[RVV] fused: mismatch at n=%zu\n", n);
+        }
+    }
+
+    for (size_t i = 0; i < FUSED_TEST_LEN; i++) {
+        x[i] = (float) ((int32_t) (i % 29) - 9) * 0.5f;
+        z[i] = (float) ((int32_t) (i % 13) - 4) * 0.75f;
+    }
+
+    roi_begin("scalar_axpbz_clamp_f32");
+    scalar_axpbz_clamp_f32(a, x, 1.0f, z, lo, hi, ref, FUSED_TEST_LEN);
+    uint64_t scalar_cycles = roi_end();
+
+    roi_begin("rvv_axpbz_clamp_f32.chained");
+    rvv_memcpy(ref, z, FUSED_TEST_LEN * sizeof(float));
+    rvv_saxpy(a, x, ref, FUSED_TEST_LEN);
+    rvv_clamp_f32(ref, lo, hi, ref, FUSED_TEST_LEN);
+    uint64_t chained_cycles = roi_end();
+
+    roi_begin("rvv_axpbz_clamp_f32.fused");
+    rvv_axpbz_clamp_f32(a, x, 1.0f, z, lo, hi, y, FUSED_TEST_LEN);
+    uint64_t fused_cycles = roi_end();
+
+    for (size_t i = 0; i < FUSED_TEST_LEN; i++) {
+        passed = passed && y[i] == ref[i];
+    }
+
+    console_printf("[RVV] fused n=%u: scalar=%lu chained=%lu fused=%lu cycles\n",
+                   (unsigned) FUSED_TEST_LEN, scalar_cycles, chained_cycles, fused_cycles);
+    record_test("Fused element-wise chain", passed);
 }
 
+#define MIXED_TEST_LEN RVV_HPM_LARGE_SIZE
+#define MIXED_MATRIX_DIM 32
+
 /**
- * @brief Test 6: SAXPY correctness
+ * @brief Print one mixed-precision timing line with rates relative to float32
+ * @param elems Elements processed (multiply-accumulates for matmul)
+ * @param bytes Bytes of input and output streamed
  */
-static void test_rvv_saxpy(void)
+static void print_mixed_rate(const char *kernel, const char *type, uint64_t elems, uint64_t bytes,
+                             uint64_t cycles, uint64_t f32_cycles)
 {
-    static float x[RVV_TEST_SIZE];
-    static float y_scalar[RVV_TEST_SIZE];
-    static float y_vector[RVV_TEST_SIZE];
-    char buf[32];
-    float a = 2.0f;
+    if (cycles == 0) {
+        cycles = 1;
+    }
 
-    /* Initialize test data */
-    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
-        x[i] = (float) (i + 1);
-        y_scalar[i] = (float) i * 0.5f;
-        y_vector[i] = (float) i * 0.5f;
+    console_printf("[RVV] mixed %s %s: cycles=%lu elem/cycle=", kernel, type, cycles);
+    print_fixed2(elems * 100 / cycles);
+    console_puts(" B/cycle=");
+    print_fixed2(bytes * 100 / cycles);
+    console_puts(" vs-f32=");
+    print_fixed2(f32_cycles * 100 / cycles);
+    console_puts("x\n");
+}
+
+/* Encodings of a few boundary values, and an fp16 round trip at every ext length */
+static bool mixed_check_convert(void)
+{
+    bool ok = true;
+
+    ok = ok && rvv_f32_to_f16(1.0f) == 0x3c00 && rvv_f32_to_f16(-2.5f) == 0xc100;
+    ok = ok && rvv_f32_to_f16(65504.0f) == 0x7bff && rvv_f32_to_f16(65520.0f) == 0x7c00;
+    ok = ok && rvv_f32_to_f16(0x1p-24f) == 0x0001 && rvv_f32_to_f16(0x1p-25f) == 0x0000;
+    ok = ok && rvv_f32_to_f16(1.0f + 0x1p-11f) == 0x3c00; /* tie rounds to even */
+    ok = ok && rvv_f32_to_bf16(1.0f) == 0x3f80 && rvv_f32_to_bf16(1.0f + 0x1p-8f) == 0x3f80;
+    ok = ok && rvv_f16_to_f32(0x0001) == 0x1p-24f && rvv_bf16_to_f32(0xc040) == -3.0f;
+
+    for (size_t t = 0; t < sizeof(ext_lens) / sizeof(ext_lens[0]); t++) {
+        float v = (float) ((int32_t) ext_lens[t] - 500) * 0.125f;
+        ok = ok && rvv_f16_to_f32(rvv_f32_to_f16(v)) == v;
     }
+    return ok;
+}
 
-    /* Scalar reference */
-    uint64_t start = rvv_read_mcycle();
-    scalar_saxpy(a, x, y_scalar, RVV_TEST_SIZE);
-    uint64_t scalar_cycles = rvv_read_mcycle() - start;
+/*
+ * int8 dot product at every ext length with values down to -128 (the
+ * largest products), and int8 matmul at a size with a partial column strip
+ */
+static bool mixed_check_i8(void)
+{
+    static int8_t a[EXT_TEST_LEN];
+    static int8_t b[EXT_TEST_LEN];
+    static int32_t C[13 * 13];
+    static int32_t C_ref[13 * 13];
+
+    for (size_t i = 0; i < EXT_TEST_LEN; i++) {
+        a[i] = (int8_t) ((int32_t) ((i * 37) & 255) - 128);
+        b[i] = (int8_t) (i % 3 == 0 ? -128 : (int32_t) (i % 255) - 127);
+    }
+    for (size_t t = 0; t < sizeof(ext_lens) / sizeof(ext_lens[0]); t++) {
+        size_t n = ext_lens[t];
+        if (rvv_dot_product_i8(a, b, n) != scalar_dot_product_i8(a, b, n)) {
+            console_printf("[RVV] mixed dot i8: mismatch at n=%zu\n", n);
+            return false;
+        }
+    }
 
-    /* RVV implementation */
-    start = rvv_read_mcycle();
-    rvv_saxpy(a, x, y_vector, RVV_TEST_SIZE);
-    uint64_t vector_cycles = rvv_read_mcycle() - start;
+    rvv_matmul_i8(a, b, C, 13, 13, 13);
+    scalar_matmul_i8(a, b, C_ref, 13, 13, 13);
+    for (size_t i = 0; i < 13 * 13; i++) {
+        if (C[i] != C_ref[i]) {
+            console_puts("[RVV] mixed matmul i8: mismatch\n");
+            return false;
+        }
+    }
+    return true;
+}
 
-    /* Verify correctness */
-    bool passed = true;
-    for (uint32_t i = 0; i < RVV_TEST_SIZE; i++) {
-        if (!rvv_float_eq(y_scalar[i], y_vector[i], 0.01f)) {
-            passed = false;
-            break;
+#if defined(RVV_HAVE_ZVFH) || defined(RVV_HAVE_ZVFBFWMA)
+typedef float (*mixed_dot_fn_t)(const uint16_t *a, const uint16_t *b, size_t n);
+typedef void (*mixed_matmul_fn_t)(const uint16_t *A, const uint16_t *B, float *C, uint32_t m,
+                                  uint32_t n, uint32_t k);
+
+/*
+ * fp16/bf16 dot product and matmul against the scalar references,
+ * bit for bit: inputs are eighths whose running sums need rounding
+ */
+static bool mixed_check_half(const char *type, uint16_t (*to_half)(float), mixed_dot_fn_t dot,
+                             mixed_dot_fn_t dot_ref, mixed_matmul_fn_t matmul,
+                             mixed_matmul_fn_t matmul_ref)
+{
+    static uint16_t a[EXT_TEST_LEN];
+    static uint16_t b[EXT_TEST_LEN];
+    static float C[13 * 13];
+    static float C_ref[13 * 13];
+
+    for (size_t i = 0; i < EXT_TEST_LEN; i++) {
+        a[i] = to_half((float) ((int32_t) (i % 29) - 14) * 0.125f);
+        b[i] = to_half((float) ((int32_t) (i % 23) - 11) * 1.125f);
+    }
+    for (size_t t = 0; t < sizeof(ext_lens) / sizeof(ext_lens[0]); t++) {
+        size_t n = ext_lens[t];
+        if (dot(a, b, n) != dot_ref(a, b, n)) {
+            console_printf("[RVV] mixed dot %s: mismatch at n=%zu\n", type, n);
+            return false;
         }
     }
 
-    record_test("SAXPY (float32)", passed);
+    matmul(a, b, C, 13, 13, 13);
+    matmul_ref(a, b, C_ref, 13, 13, 13);
+    for (size_t i = 0; i < 13 * 13; i++) {
+        if (C[i] != C_ref[i]) {
+            console_printf("[RVV] mixed matmul %s: mismatch\n", type);
+            return false;
+        }
+    }
+    return true;
+}
+#endif
 
-    console_puts("[RVV] saxpy: scalar=");
-    int_to_str(scalar_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" vec=");
-    int_to_str(vector_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" cycles\n");
+/**
+ * @brief Test 16: Mixed-precision kernels (int8, fp16, bf16) vs float32
+ *
+ * Checks the int8 kernels (always built) and the fp16/bf16 kernels (built
+ * with -DRVV_ZVFH / -DRVV_ZVFBFWMA) against their scalar references, then
+ * times each dot product at MIXED_TEST_LEN elements and each matmul at
+ * MIXED_MATRIX_DIM on the same small-integer data, which every format
+ * holds exactly: all results must equal the float32 ones. Each line gives
+ * elements (MACs for matmul) and bytes per cycle and the speedup over the
+ * float32 kernel.
+ */
+static void test_rvv_mixed_precision(void)
+{
+    static float fa[MIXED_TEST_LEN] __attribute__((aligned(64)));
+    static float fb[MIXED_TEST_LEN] __attribute__((aligned(64)));
+    static int8_t qa[MIXED_TEST_LEN] __attribute__((aligned(64)));
+    static int8_t qb[MIXED_TEST_LEN] __attribute__((aligned(64)));
+    static float fC[MIXED_MATRIX_DIM * MIXED_MATRIX_DIM] __attribute__((aligned(64)));
+    static int32_t qC[MIXED_MATRIX_DIM * MIXED_MATRIX_DIM] __attribute__((aligned(64)));
+#if defined(RVV_HAVE_ZVFH) || defined(RVV_HAVE_ZVFBFWMA)
+    static uint16_t ha[MIXED_TEST_LEN] __attribute__((aligned(64)));
+    static uint16_t hb[MIXED_TEST_LEN] __attribute__((aligned(64)));
+#endif
+    const uint64_t n = MIXED_TEST_LEN;
+    const uint32_t dim = MIXED_MATRIX_DIM;
+    const uint64_t macs = (uint64_t) dim * dim * dim;
+    const uint64_t cells = (uint64_t) dim * dim;
+    bool passed = mixed_check_convert() && mixed_check_i8();
+
+#if defined(RVV_HAVE_ZVFH)
+    passed = passed &&
+             mixed_check_half("f16", rvv_f32_to_f16, rvv_dot_product_f16, scalar_dot_product_f16,
+                              rvv_matmul_f16, scalar_matmul_f16);
+#endif
+#if defined(RVV_HAVE_ZVFBFWMA)
+    passed = passed && mixed_check_half("bf16", rvv_f32_to_bf16, rvv_dot_product_bf16,
+                                        scalar_dot_product_bf16, rvv_matmul_bf16,
+                                        scalar_matmul_bf16);
+#endif
+
+    for (size_t i = 0; i < MIXED_TEST_LEN; i++) {
+        qa[i] = (int8_t) ((int32_t) (i % 17) - 8);
+        qb[i] = (int8_t) ((int32_t) (i % 13) - 6);
+        fa[i] = (float) qa[i];
+        fb[i] = (float) qb[i];
+    }
+
+    roi_begin("rvv_dot_product_f32");
+    float dot_f32 = rvv_dot_product_f32(fa, fb, MIXED_TEST_LEN);
+    uint64_t dot_f32_cycles = roi_end();
+    print_mixed_rate("dot", "f32", n, n * 8, dot_f32_cycles, dot_f32_cycles);
+
+    roi_begin("rvv_dot_product_i8");
+    int32_t dot_i8 = rvv_dot_product_i8(qa, qb, MIXED_TEST_LEN);
+    uint64_t dot_i8_cycles = roi_end();
+    print_mixed_rate("dot", "i8", n, n * 2, dot_i8_cycles, dot_f32_cycles);
+    passed = passed && (float) dot_i8 == dot_f32;
+
+    roi_begin("rvv_matmul_f32");
+    rvv_matmul_f32(fa, fb, fC, dim, dim, dim);
+    uint64_t mm_f32_cycles = roi_end();
+    print_mixed_rate("matmul", "f32", macs, cells * 12, mm_f32_cycles, mm_f32_cycles);
+
+    roi_begin("rvv_matmul_i8");
+    rvv_matmul_i8(qa, qb, qC, dim, dim, dim);
+    uint64_t mm_i8_cycles = roi_end();
+    print_mixed_rate("matmul", "i8", macs, cells * 6, mm_i8_cycles, mm_f32_cycles);
+    for (size_t i = 0; i < cells; i++) {
+        passed = passed && (float) qC[i] == fC[i];
+    }
+
+#ifdef RVV_HAVE_ZVFH
+    for (size_t i = 0; i < MIXED_TEST_LEN; i++) {
+        ha[i] = rvv_f32_to_f16(fa[i]);
+        hb[i] = rvv_f32_to_f16(fb[i]);
+    }
+
+    roi_begin("rvv_dot_product_f16");
+    float dot_f16 = rvv_dot_product_f16(ha, hb, MIXED_TEST_LEN);
+    uint64_t dot_f16_cycles = roi_end();
+    print_mixed_rate("dot", "f16", n, n * 4, dot_f16_cycles, dot_f32_cycles);
+    passed = passed && dot_f16 == dot_f32;
+
+    roi_begin("rvv_matmul_f16");
+    rvv_matmul_f16(ha, hb, fC, dim, dim, dim);
+    uint64_t mm_f16_cycles = roi_end();
+    print_mixed_rate("matmul", "f16", macs, cells * 8, mm_f16_cycles, mm_f32_cycles);
+    for (size_t i = 0; i < cells; i++) {
+        passed = passed && fC[i] == (float) qC[i];
+    }
+#else
+    console_puts("[RVV] mixed f16: not built (-DRVV_ZVFH=ON)\n");
+#endif
+#ifdef RVV_HAVE_ZVFBFWMA
+    for (size_t i = 0; i < MIXED_TEST_LEN; i++) {
+        ha[i] = rvv_f32_to_bf16(fa[i]);
+        hb[i] = rvv_f32_to_bf16(fb[i]);
+    }
+
+    roi_begin("rvv_dot_product_bf16");
+    float dot_bf16 = rvv_dot_product_bf16(ha, hb, MIXED_TEST_LEN);
+    uint64_t dot_bf16_cycles = roi_end();
+    print_mixed_rate("dot", "bf16", n, n * 4, dot_bf16_cycles, dot_f32_cycles);
+    passed = passed && dot_bf16 == dot_f32;
+
+    roi_begin("rvv_matmul_bf16");
+    rvv_matmul_bf16(ha, hb, fC, dim, dim, dim);
+    uint64_t mm_bf16_cycles = roi_end();
+    print_mixed_rate("matmul", "bf16", macs, cells * 8, mm_bf16_cycles, mm_f32_cycles);
+    for (size_t i = 0; i < cells; i++) {
+        passed = passed && fC[i] == (float) qC[i];
+    }
+#else
+    console_puts("[RVV] mixed bf16: not built (-DRVV_ZVFBFWMA=ON)\n");
+#endif
+
+    record_test("Mixed-precision kernels", passed);
 }
 
 /**
- * @brief Test 7: Matrix multiply correctness
+ * @brief Relative float32 comparison for long reductions over dataset inputs
  */
-static void test_rvv_matmul(void)
+static bool dataset_float_close(float ref, float got)
 {
-    static float A[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
-    static float B[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
-    static float C_scalar[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
-    static float C_vector[RVV_MATRIX_DIM * RVV_MATRIX_DIM];
-    char buf[32];
-    uint32_t dim = RVV_MATRIX_DIM;
+    float mag = ref < 0 ? -ref : ref;
+    return rvv_float_eq(ref, got, 1e-3f * (mag + 1.0f));
+}
 
-    /* Initialize test matrices */
-    for (uint32_t i = 0; i < dim * dim; i++) {
-        A[i] = (float) ((i % dim) + 1);
-        B[i] = (float) ((i / dim) + 1);
+/**
+ * @brief Test 17: Kernels on host datasets (gem5 SE)
+ *
+ * argv[1] is A (M x K), argv[2] is B (K x N), both mapped in place with
+ * dataset_map(); C comes from anonymous mappings. Runs the matmul and a
+ * dot product over the first min(|A|, |B|) elements against the scalar
+ * references. Without datasets on the command line (every other
+ * platform, or gem5 SE without --options) the test is skipped and not
+ * counted, so the Phase 5 totals stay the same.
+ */
+static void test_rvv_datasets(void)
+{
+    if (gem5_se_argc() < 3) {
+        console_puts("[DATA] No datasets (gem5 SE: --options=\"A.rvds B.rvds\"), skipped\n");
+        return;
     }
 
-    /* Scalar reference */
-    uint64_t start = rvv_read_mcycle();
-    scalar_matmul_f32(A, B, C_scalar, dim, dim, dim);
-    uint64_t scalar_cycles = rvv_read_mcycle() - start;
+    dataset_t a, b;
+    dataset_status_t st = dataset_map(&a, gem5_se_argv(1));
+    if (st == DATASET_OK) {
+        st = dataset_map(&b, gem5_se_argv(2));
+        if (st != DATASET_OK) {
+            dataset_unmap(&a);
+        }
+    }
+    if (st != DATASET_OK) {
+        console_printf("[DATA] %s / %s: %s\n", gem5_se_argv(1), gem5_se_argv(2),
+                       dataset_strerror(st));
+        record_test("Dataset kernels", false);
+        return;
+    }
 
-    /* RVV implementation */
-    start = rvv_read_mcycle();
-    rvv_matmul_f32(A, B, C_vector, dim, dim, dim);
-    uint64_t vector_cycles = rvv_read_mcycle() - start;
+    uint32_t m = (uint32_t) a.rows;
+    uint32_t k = (uint32_t) a.cols;
+    uint32_t n = (uint32_t) b.cols;
+    console_printf("[DATA] A: %lux%lu (%zu bytes mapped), B: %lux%lu (%zu bytes mapped)\n",
+                   a.rows, a.cols, a.map_bytes, b.rows, b.cols, b.map_bytes);
+
+    bool passed = b.rows == k;
+    size_t c_bytes = (size_t) m * n * sizeof(float);
+    float *c_scalar = passed ? (float *) dataset_scratch(c_bytes) : (float *) 0;
+    float *c_vector = passed ? (float *) dataset_scratch(c_bytes) : (float *) 0;
+    if (c_scalar == (float *) 0 || c_vector == (float *) 0) {
+        console_puts("[DATA] A.cols != B.rows or no memory for C\n");
+        passed = false;
+    }
 
-    /* Verify correctness */
-    bool passed = true;
-    for (uint32_t i = 0; i < dim * dim; i++) {
-        if (!rvv_float_eq(C_scalar[i], C_vector[i], 0.1f)) {
-            passed = false;
-            break;
+    if (passed) {
+        roi_begin("scalar_matmul_f32.dataset");
+        scalar_matmul_f32(dataset_f32(&a), dataset_f32(&b), c_scalar, m, n, k);
+        uint64_t scalar_cycles = roi_end();
+
+        roi_begin("rvv_matmul_f32.dataset");
+        rvv_matmul_f32(dataset_f32(&a), dataset_f32(&b), c_vector, m, n, k);
+        uint64_t vector_cycles = roi_end();
+
+        for (size_t i = 0; i < (size_t) m * n; i++) {
+            if (!dataset_float_close(c_scalar[i], c_vector[i])) {
+                passed = false;
+                break;
+            }
         }
+        console_printf("[DATA] matmul %ux%ux%u: scalar=%lu vec=%lu cycles\n", m, n, k,
+                       scalar_cycles, vector_cycles);
+
+        size_t len = (size_t) (dataset_elems(&a) < dataset_elems(&b) ? dataset_elems(&a)
+                                                                     : dataset_elems(&b));
+        roi_begin("scalar_dot_product_f32.dataset");
+        float scalar_dot = scalar_dot_product_f32(dataset_f32(&a), dataset_f32(&b), len);
+        scalar_cycles = roi_end();
+
+        roi_begin("rvv_dot_product_f32.dataset");
+        float vector_dot = rvv_dot_product_f32(dataset_f32(&a), dataset_f32(&b), len);
+        vector_cycles = roi_end();
+
+        passed = passed && dataset_float_close(scalar_dot, vector_dot);
+        console_printf("[DATA] dot_product n=%zu: scalar=%lu vec=%lu cycles\n", len,
+                       scalar_cycles, vector_cycles);
     }
 
-    record_test("Matrix multiply (float32)", passed);
+    dataset_scratch_free(c_vector, c_bytes);
+    dataset_scratch_free(c_scalar, c_bytes);
+    dataset_unmap(&b);
+    dataset_unmap(&a);
+    record_test("Dataset kernels", passed);
+}
+
+/* =============================================================================
+ * Cache-Block Streaming (Zicbop / Zicboz)
+ * ============================================================================= */
+
+/** Destination offsets (elements) of the cbo correctness check: every block phase */
+#define CBO_CHECK_OFFSETS 17
+
+/** Guard elements around each cbo correctness output (catches stray cbo.zero) */
+#define CBO_CHECK_GUARD (RVV_CBO_BLOCK_MAX / 4)
+
+/** Value the guard elements hold */
+#define CBO_GUARD_WORD 0x5A5A5A5A
+
+static float cbo_x[RVV_CBO_BENCH_LEN] __attribute__((aligned(64)));
+static float cbo_y[RVV_CBO_BENCH_LEN] __attribute__((aligned(64)));
+static float cbo_z[RVV_CBO_BENCH_LEN] __attribute__((aligned(64)));
+
+/**
+ * @brief vec_add_i32/memcpy *_cbo results at every output alignment
+ *
+ * Each length is run at destination offsets 0..16 elements (bytes for
+ * memcpy) so partial head and tail blocks occur in every position; the
+ * guard words on both sides must survive (a cbo.zero of a block not fully overwritten would
+ * clear them). Also checks the in-place case, where zeroing is skipped.
+ */
+static bool cbo_check_kernels(void)
+{
+    static int32_t a[RVV_MEM_CHECK_LEN];
+    static int32_t b[RVV_MEM_CHECK_LEN];
+    static int32_t c[RVV_MEM_CHECK_LEN + CBO_CHECK_OFFSETS + 2 * CBO_CHECK_GUARD]
+        __attribute__((aligned(RVV_CBO_BLOCK_MAX)));
+    static const size_t lens[] = {0, 1, 15, 16, 17, 255, 256, 257, 1000, RVV_MEM_CHECK_LEN};
+
+    for (size_t i = 0; i < RVV_MEM_CHECK_LEN; i++) {
+        a[i] = (int32_t) (i * 2654435761U);
+        b[i] = (int32_t) (i ^ 0x1234567U);
+    }
+
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+        size_t n = lens[l];
+        for (size_t d = 0; d < CBO_CHECK_OFFSETS; d++) {
+            size_t off = CBO_CHECK_GUARD + d;
+            size_t span = off + n + CBO_CHECK_GUARD;
+
+            for (size_t i = 0; i < span; i++) {
+                c[i] = CBO_GUARD_WORD;
+            }
+            rvv_vec_add_i32_cbo(a, b, &c[off], n);
+            for (size_t i = 0; i < span; i++) {
+                bool inside = i >= off && i < off + n;
+                int32_t want = inside ? a[i - off] + b[i - off] : CBO_GUARD_WORD;
+                if (c[i] != want) {
+                    return false;
+                }
+            }
+
+            /* memcpy: the same bytes at byte offset d (any alignment) */
+            for (size_t i = 0; i < span; i++) {
+                c[i] = CBO_GUARD_WORD;
+            }
+            const uint8_t *src = (const uint8_t *) a;
+            const uint8_t *buf = (const uint8_t *) c;
+            size_t lo = CBO_CHECK_GUARD * sizeof(int32_t) + d;
+            size_t bytes = n * sizeof(int32_t);
+            rvv_memcpy_cbo((uint8_t *) c + lo, src, bytes);
+            for (size_t i = 0; i < span * sizeof(int32_t); i++) {
+                bool inside = i >= lo && i < lo + bytes;
+                if (buf[i] != (inside ? src[i - lo] : (uint8_t) CBO_GUARD_WORD)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    /* In place: c aliases a, so the output must not be zeroed first */
+    for (size_t i = 0; i < RVV_MEM_CHECK_LEN; i++) {
+        c[i] = a[i];
+    }
+    rvv_vec_add_i32_cbo(c, b, c, RVV_MEM_CHECK_LEN);
+    for (size_t i = 0; i < RVV_MEM_CHECK_LEN; i++) {
+        if (c[i] != a[i] + b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Bitwise checksum of a float array (equal only for identical results) */
+static uint64_t cbo_checksum(const float *v, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum = sum * 31 + rvv_f32_bits(v[i]);
+    }
+    return sum;
+}
+
+static void cbo_init_inputs(void)
+{
+    for (size_t i = 0; i < RVV_CBO_BENCH_LEN; i++) {
+        cbo_x[i] = (float) (i % 251) * 0.5f;
+        cbo_y[i] = (float) (i % 509) - 254.0f;
+    }
+}
+
+/** One "[CBO] <kernel>" line: cycles without and with cache-block management */
+static void cbo_print(const char *kernel, uint64_t base, uint64_t cbo)
+{
+    console_printf("[CBO] %-11s n=%zu base=%lu cbo=%lu cycles speedup=", kernel,
+                   (size_t) RVV_CBO_BENCH_LEN, base, cbo);
+    print_fixed2(base * 100 / (cbo ? cbo : 1));
+    console_puts("x\n");
+}
 
-    console_puts("[RVV] matmul: scalar=");
-    int_to_str(scalar_cycles, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" vec=");
-    int_to_str(vector_cycles, buf, sizeof(buf));
-    console_puts(buf);
+/**
+ * @brief Test 19: Cache-block managed streaming kernels (Zicbop/Zicboz)
+ *
+ * Checks the *_cbo kernels at every output alignment, then times SAXPY,
+ * float32 vec_add and memcpy on RVV_CBO_BENCH_LEN-element arrays (three
+ * arrays exceed the 256 KiB gem5 L2) with and without prefetch and
+ * output zeroing, plus a SAXPY prefetch-distance sweep. Each run is its
+ * own ROI ("cbo_<kernel>_base" / "cbo_<kernel>"), so on gem5
+ * parse-gem5-stats.py --roi shows the DRAM bytes read and written next
+ * to the cycles. QEMU and Spike model no caches: their cycle counts only
+ * show the instruction overhead. Results must match the plain kernels
+ * bit for bit.
+ */
+static void test_rvv_cbo_stream(void)
+{
+    static const size_t dists[] = {0, 256, 1024, 4096};
+    static const char *const dist_rois[] = {"cbo_saxpy_pf0", "cbo_saxpy_pf256",
+                                            "cbo_saxpy_pf1024", "cbo_saxpy_pf4096"};
+    const size_t n = RVV_CBO_BENCH_LEN;
+
+    rvv_cbo_init();
+    console_printf("[CBO] zicbop=%s zicboz=%s block=%zu bytes prefetch=%zu bytes\n",
+                   (rvv_get_extensions() & RVV_EXT_ZICBOP) ? "yes" : "no",
+                   (rvv_get_extensions() & RVV_EXT_ZICBOZ) ? "yes" : "no", rvv_cbo.block,
+                   rvv_cbo.prefetch_dist);
+
+    bool passed = cbo_check_kernels();
+
+    /*
+     * Every timed run starts from the same cache state: the output is
+     * written first, then the inputs (twice the L2), which evicts most of
+     * the output again.
+     */
+
+    /* SAXPY: x read, y read and written (prefetch only) */
+    cbo_init_inputs();
+    roi_begin("cbo_saxpy_base");
+    rvv_saxpy(1.5f, cbo_x, cbo_y, n);
+    uint64_t base = roi_end();
+    uint64_t ref = cbo_checksum(cbo_y, n);
+
+    cbo_init_inputs();
+    roi_begin("cbo_saxpy");
+    rvv_saxpy_cbo(1.5f, cbo_x, cbo_y, n);
+    uint64_t cbo = roi_end();
+    passed = passed && cbo_checksum(cbo_y, n) == ref;
+    cbo_print("saxpy", base, cbo);
+
+    /* vec_add: z fully overwritten (prefetch x, y; zero z) */
+    rvv_memset(cbo_z, 0xff, sizeof(cbo_z));
+    cbo_init_inputs();
+    roi_begin("cbo_vec_add_f32_base");
+    rvv_vec_add_f32(cbo_x, cbo_y, cbo_z, n);
+    base = roi_end();
+    ref = cbo_checksum(cbo_z, n);
+
+    rvv_memset(cbo_z, 0xff, sizeof(cbo_z));
+    cbo_init_inputs();
+    roi_begin("cbo_vec_add_f32");
+    rvv_vec_add_f32_cbo(cbo_x, cbo_y, cbo_z, n);
+    cbo = roi_end();
+    passed = passed && cbo_checksum(cbo_z, n) == ref;
+    cbo_print("vec_add_f32", base, cbo);
+
+    /* memcpy: x into z */
+    rvv_memset(cbo_z, 0xff, sizeof(cbo_z));
+    cbo_init_inputs();
+    roi_begin("cbo_memcpy_base");
+    rvv_memcpy(cbo_z, cbo_x, sizeof(cbo_x));
+    base = roi_end();
+
+    rvv_memset(cbo_z, 0xff, sizeof(cbo_z));
+    cbo_init_inputs();
+    roi_begin("cbo_memcpy");
+    rvv_memcpy_cbo(cbo_z, cbo_x, sizeof(cbo_x));
+    cbo = roi_end();
+    passed = passed && cbo_checksum(cbo_z, n) == cbo_checksum(cbo_x, n);
+    cbo_print("memcpy", base, cbo);
+
+    /* Prefetch distance sweep (SAXPY); hints are no-ops without Zicbop */
+    size_t dist = rvv_cbo.prefetch_dist;
+    console_puts("[CBO] saxpy prefetch distance:");
+    for (size_t d = 0; d < sizeof(dists) / sizeof(dists[0]); d++) {
+        rvv_cbo.prefetch_dist = dists[d];
+        cbo_init_inputs();
+        roi_begin(dist_rois[d]);
+        rvv_saxpy_cbo(1.5f, cbo_x, cbo_y, n);
+        console_printf(" %zu=%lu", dists[d], roi_end());
+    }
     console_puts(" cycles\n");
+    rvv_cbo.prefetch_dist = dist;
+
+    record_test("Cache-block streaming", passed);
+}
+
+#if defined(ENABLE_PREEMPT)
+
+/** Elements per vector kernel call in the preemption test */
+#define TASK_TEST_LEN 2048
+
+/** Kernel calls per vector task, loop iterations per scalar task */
+#define TASK_TEST_VEC_REPS 400
+#define TASK_TEST_FP_ITERS 200000
+#define TASK_TEST_INT_ITERS 500000
+
+static float task_test_fa[TASK_TEST_LEN];
+static float task_test_fb[TASK_TEST_LEN];
+static int32_t task_test_ia[TASK_TEST_LEN];
+static int32_t task_test_ib[TASK_TEST_LEN];
+static int32_t task_test_ic[TASK_TEST_LEN];
+static float task_test_dot_ref;
+static double task_test_fp_ref;
+static uint64_t task_test_int_ref;
+
+/** Mismatches seen by each task (one writer each) */
+static volatile uint32_t task_test_errors[4];
+
+/** FP-only chain: divides and adds (nothing to contract), so the result is exact */
+static double task_test_fp_chain(void)
+{
+    double s = 0.0;
+    for (uint32_t i = 0; i < TASK_TEST_FP_ITERS; i++) {
+        s = s / 3.0 + (double) i;
+    }
+    return s;
+}
+
+/** Integer-only chain (xorshift64): never touches FP or vector state */
+static uint64_t task_test_int_chain(void)
+{
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t i = 0; i < TASK_TEST_INT_ITERS; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+/** Vector + FP task: repeated dot products, each compared bit for bit */
+static void task_test_dot(void *arg)
+{
+    (void) arg;
+    for (uint32_t r = 0; r < TASK_TEST_VEC_REPS; r++) {
+        if (rvv_dot_product_f32(task_test_fa, task_test_fb, TASK_TEST_LEN) != task_test_dot_ref) {
+            task_test_errors[0]++;
+        }
+    }
+}
+
+/** Vector-only task: repeated int32 adds, checked element by element */
+static void task_test_add(void *arg)
+{
+    (void) arg;
+    for (uint32_t r = 0; r < TASK_TEST_VEC_REPS; r++) {
+        rvv_vec_add_i32(task_test_ia, task_test_ib, task_test_ic, TASK_TEST_LEN);
+        for (uint32_t i = 0; i < TASK_TEST_LEN; i++) {
+            if (task_test_ic[i] != task_test_ia[i] + task_test_ib[i]) {
+                task_test_errors[1]++;
+                break;
+            }
+        }
+    }
+}
+
+static void task_test_fp(void *arg)
+{
+    (void) arg;
+    if (task_test_fp_chain() != task_test_fp_ref) {
+        task_test_errors[2]++;
+    }
+}
+
+static void task_test_int(void *arg)
+{
+    (void) arg;
+    if (task_test_int_chain() != task_test_int_ref) {
+        task_test_errors[3]++;
+    }
+}
+
+/** Idle-context pattern held in f8 (fs0) and v8 across task_run() */
+#define TASK_TEST_LIVE_F 0x3FF4000000000000ULL /* 1.25 */
+#define TASK_TEST_LIVE_V 0x5EED0000U           /* element i holds this + i */
+
+/** Load the patterns into f8 and every e32 element of v8 (VLMAX) */
+static void task_test_live_set(void)
+{
+    __asm__ __volatile__("fmv.d.x fs0, %0\n\t"
+                         "vsetvli t0, zero, e32, m1, ta, ma\n\t"
+                         "vid.v   v8\n\t"
+                         "vadd.vx v8, v8, %1"
+                         :
+                         : "r"(TASK_TEST_LIVE_F), "r"(TASK_TEST_LIVE_V)
+                         : "t0", "fs0", "v8");
+}
+
+/** True if f8 and v8 still hold the patterns of task_test_live_set() */
+static bool task_test_live_check(void)
+{
+    static uint32_t v8[TASK_VLEN_MAX / 32];
+    uint64_t f8;
+    size_t vl;
+
+    __asm__ __volatile__("fmv.x.d %0, fs0\n\t"
+                         "vsetvli %1, zero, e32, m1, ta, ma\n\t"
+                         "vse32.v v8, (%2)"
+                         : "=&r"(f8), "=&r"(vl)
+                         : "r"(v8)
+                         : "memory");
+
+    bool ok = f8 == TASK_TEST_LIVE_F;
+    for (size_t i = 0; i < vl; i++) {
+        ok = ok && v8[i] == TASK_TEST_LIVE_V + (uint32_t) i;
+    }
+    return ok;
+}
+
+/** One task_run() of the four tasks; false on a setup error or a mismatch */
+static bool task_test_run(task_save_mode_t mode, task_stats_t *stats)
+{
+    for (uint32_t t = 0; t < 4; t++) {
+        task_test_errors[t] = 0;
+    }
+    task_create(task_test_dot, NULL);
+    task_create(task_test_add, NULL);
+    task_create(task_test_fp, NULL);
+    task_create(task_test_int, NULL);
+
+    /*
+     * Idle-context FP and vector registers across task_run(): the tasks
+     * overwrite v8 (vector kernels) and FP registers, so the values only
+     * come back if the switches saved and restored the idle context.
+     */
+    task_test_live_set();
+    bool ok = task_run(mode, stats) == 0;
+    ok = task_test_live_check() && ok;
+
+    for (uint32_t t = 0; t < 4; t++) {
+        ok = ok && task_test_errors[t] == 0;
+    }
+
+    uint64_t n = stats->switches ? stats->switches : 1;
+    console_printf("[TASK] %-5s switches=%lu cycles/switch=%lu saves f=%lu v=%lu restores f=%lu "
+                   "v=%lu bytes/switch=%lu\n",
+                   mode == TASK_SAVE_LAZY ? "lazy" : "eager", stats->switches,
+                   stats->switch_cycles / n, stats->f_saves, stats->v_saves, stats->f_restores,
+                   stats->v_restores, stats->bytes / n);
+    return ok && stats->switches > 0;
+}
+
+/**
+ * @brief Test 18: Preemptive tasks with lazy FP/vector save (ENABLE_PREEMPT)
+ *
+ * Four tasks share the hart in TASK_SLICE_US slices: a dot product
+ * (vector + FP), an int32 vector add (vector only), a scalar FP chain and
+ * an integer chain. Every result must match its unpreempted reference
+ * exactly, once with the lazy save and once with the eager baseline, and
+ * the lazy run must move no more register bytes per switch. The caller's
+ * f8 and v8 must hold the same values after each task_run().
+ */
+static void test_rvv_preempt(void)
+{
+    for (uint32_t i = 0; i < TASK_TEST_LEN; i++) {
+        task_test_fa[i] = (float) (i % 97) * 0.25f;
+        task_test_fb[i] = (float) (i % 13) - 6.0f;
+        task_test_ia[i] = (int32_t) (i * 7919U);
+        task_test_ib[i] = -(int32_t) i;
+    }
+    task_test_dot_ref = rvv_dot_product_f32(task_test_fa, task_test_fb, TASK_TEST_LEN);
+    task_test_fp_ref = task_test_fp_chain();
+    task_test_int_ref = task_test_int_chain();
+
+    console_printf("[TASK] VLEN=%lu slice=%uus tasks=4 (dot, vec_add, fp, int)\n", rvv_get_vlen(),
+                   (unsigned) TASK_SLICE_US);
+
+    task_stats_t lazy;
+    task_stats_t eager;
+    bool passed = task_test_run(TASK_SAVE_LAZY, &lazy);
+    passed = task_test_run(TASK_SAVE_EAGER, &eager) && passed;
+    passed = passed && lazy.bytes / lazy.switches <= eager.bytes / eager.switches;
+
+    record_test("Preemptive tasks", passed);
 }
 
+#endif /* ENABLE_PREEMPT */
+
 static void run_phase5_tests(void)
 {
     console_puts("[INFO] Running Phase 5 RVV tests...\n");
@@ -714,6 +3245,56 @@ static void run_phase5_tests(void)
     /* Test 7: Matrix multiply */
     test_rvv_matmul();
     console_puts("\n");
+
+    /* Test 8: Blocked GEMM */
+    test_rvv_gemm();
+    console_puts("\n");
+
+    /* Test 9: Dot product reduction modes */
+    test_rvv_dot_modes();
+    console_puts("\n");
+
+    /* Test 10: memcpy/memset family */
+    test_rvv_mem_family();
+    console_puts("\n");
+
+    /* Test 11: HPM counter profile */
+    test_rvv_hpm_profile();
+    console_puts("\n");
+
+    /* Test 12: Benchmark runner */
+    test_rvv_bench_runner();
+    console_puts("\n");
+
+    /* Test 13: Kernel dispatch */
+    test_rvv_dispatch();
+    console_puts("\n");
+
+    /* Test 14: Extended kernels */
+    test_rvv_ext_kernels();
+    console_puts("\n");
+
+    /* Test 15: Fused element-wise chain */
+    test_rvv_fused_chain();
+    console_puts("\n");
+
+    /* Test 16: Mixed-precision kernels */
+    test_rvv_mixed_precision();
+    console_puts("\n");
+
+    /* Test 17: Host datasets (gem5 SE, counted only when given) */
+    test_rvv_datasets();
+    console_puts("\n");
+
+#if defined(ENABLE_PREEMPT)
+    /* Test 18: Preemptive tasks, lazy vs eager FP/vector save */
+    test_rvv_preempt();
+    console_puts("\n");
+#endif
+
+    /* Test 19: Cache-block streaming, prefetch and cbo.zero vs demand fetch */
+    test_rvv_cbo_stream();
+    console_puts("\n");
 }
 
 #endif /* ENABLE_RVV && NUM_HARTS <= 1 */
@@ -728,18 +3309,14 @@ static void print_banner(void)
     console_puts("=================================================================\n");
     console_puts("RISC-V Bare-Metal System Explorer\n");
     console_puts("=================================================================\n");
-    console_puts("Platform: ");
-    console_puts(platform_get_name());
-    console_puts("\n");
+    console_printf("Platform: %s\n", platform_get_name());
 
 #if NUM_HARTS > 1
-    {
-        char buf[32];
-        console_puts("Phase: 4 - Multi-Core SMP (");
-        int_to_str(NUM_HARTS, buf, sizeof(buf));
-        console_puts(buf);
-        console_puts(" harts)\n");
-    }
+#if defined(ENABLE_RVV)
+    console_printf("Phase: 4 - Multi-Core SMP (%d harts + RVV)\n", NUM_HARTS);
+#else
+    console_printf("Phase: 4 - Multi-Core SMP (%d harts)\n", NUM_HARTS);
+#endif
 #elif defined(ENABLE_RVV)
     console_puts("Phase: 5 - RISC-V Vector Extension (RVV)\n");
 #else
@@ -756,8 +3333,13 @@ static void print_banner(void)
 
 int main(void)
 {
-    /* Print banner */
+    /* Sample everything main() runs (no-op without ENABLE_PROFILER) */
+    prof_start();
+
+    /* Print banner and the reset-to-main() breakdown */
     print_banner();
+    platform_boot_report();
+    mmu_report();
 
     /* Print hello message (common to all phases) */
     console_puts("Hello RISC-V\n");
@@ -766,9 +3348,11 @@ int main(void)
     /* Run phase-appropriate tests */
 #if NUM_HARTS > 1
     run_phase4_tests();
+    roi_report();
     print_summary(4);
 #elif defined(ENABLE_RVV)
     run_phase5_tests();
+    roi_report();
     print_summary(5);
 #else
     run_phase2_tests();
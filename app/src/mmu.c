@@ -0,0 +1,123 @@
+/**
+ * @file mmu.c
+ * @brief Sv39 identity mapping of RAM with 4 KiB, 2 MiB or 1 GiB pages (ENABLE_MMU)
+ *
+ * See mmu.h. The tables are static and zero from the BSS clear; hart 0
+ * fills them in once and every hart shares them read-only.
+ */
+
+#include "mmu.h"
+
+#include "console.h"
+#include "csr.h"
+#include "platform.h"
+
+#if defined(ENABLE_MMU)
+
+typedef uint64_t mmu_pte_t;
+
+_Static_assert(RAM_BASE % MMU_PAGE_1G == 0, "RAM_BASE must be gigapage aligned");
+_Static_assert(RAM_SIZE <= MMU_PAGE_1G, "RAM must fit one gigapage (a single L1 table)");
+_Static_assert(RAM_SIZE % MMU_PAGE_2M == 0, "RAM_SIZE must be a multiple of 2 MiB");
+
+/** Leaf permissions: RAM (code, data, stacks) and the device space below RAM_BASE */
+#define MMU_RAM_PERM (PTE_R | PTE_W | PTE_X | PTE_U | PTE_G)
+#define MMU_IO_PERM (PTE_R | PTE_W | PTE_U | PTE_G)
+
+/* =============================================================================
+ * Page Tables
+ * ============================================================================= */
+
+static mmu_pte_t mmu_root[MMU_PT_ENTRIES] __attribute__((aligned(MMU_PAGE_4K)));
+
+#if MMU_PAGE_SIZE != MMU_PAGE_1G
+static mmu_pte_t mmu_l1[MMU_PT_ENTRIES] __attribute__((aligned(MMU_PAGE_4K)));
+#endif
+
+#if MMU_PAGE_SIZE == MMU_PAGE_4K
+/** One L0 table per 2 MiB of RAM */
+#define MMU_L0_TABLES (RAM_SIZE / MMU_PAGE_2M)
+static mmu_pte_t mmu_l0[MMU_L0_TABLES][MMU_PT_ENTRIES] __attribute__((aligned(MMU_PAGE_4K)));
+#endif
+
+static inline mmu_pte_t pte_leaf(uintptr_t pa, mmu_pte_t perm)
+{
+    return ((pa / MMU_PAGE_4K) << PTE_PPN_SHIFT) | perm | PTE_A | PTE_D | PTE_V;
+}
+
+static inline mmu_pte_t pte_table(const mmu_pte_t *table)
+{
+    return (((uintptr_t) table / MMU_PAGE_4K) << PTE_PPN_SHIFT) | PTE_V;
+}
+
+/** Sv39 VPN[2] (root index) of an address */
+static inline size_t vpn2(uintptr_t va)
+{
+    return (va / MMU_PAGE_1G) % MMU_PT_ENTRIES;
+}
+
+/* =============================================================================
+ * API
+ * ============================================================================= */
+
+void mmu_init(void)
+{
+    /* Devices (CLINT, PLIC, UART, test finisher) all sit below RAM_BASE */
+    for (uintptr_t pa = 0; pa < RAM_BASE; pa += MMU_PAGE_1G) {
+        mmu_root[vpn2(pa)] = pte_leaf(pa, MMU_IO_PERM);
+    }
+
+#if MMU_PAGE_SIZE == MMU_PAGE_1G
+    mmu_root[vpn2(RAM_BASE)] = pte_leaf(RAM_BASE, MMU_RAM_PERM);
+#else
+    mmu_root[vpn2(RAM_BASE)] = pte_table(mmu_l1);
+    for (size_t i = 0; i < RAM_SIZE / MMU_PAGE_2M; i++) {
+        uintptr_t pa = RAM_BASE + i * MMU_PAGE_2M;
+#if MMU_PAGE_SIZE == MMU_PAGE_2M
+        mmu_l1[i] = pte_leaf(pa, MMU_RAM_PERM);
+#else
+        for (size_t j = 0; j < MMU_PT_ENTRIES; j++) {
+            mmu_l0[i][j] = pte_leaf(pa + j * MMU_PAGE_4K, MMU_RAM_PERM);
+        }
+        mmu_l1[i] = pte_table(mmu_l0[i]);
+#endif
+    }
+#endif
+
+    mmu_enable_hart();
+}
+
+void mmu_enable_hart(void)
+{
+    /* S/U-mode accesses (and the page walks) need a PMP grant: all of memory */
+    write_csr(pmpaddr0, ~0UL);
+    write_csr(pmpcfg0, PMP_NAPOT | PMP_R | PMP_W | PMP_X);
+
+    /* The table stores are ordered before this hart's walks by sfence.vma */
+    write_csr(satp, SATP_MODE_SV39 | ((uintptr_t) mmu_root / MMU_PAGE_4K));
+    __asm__ __volatile__("sfence.vma" ::: "memory");
+
+    /* Translate loads/stores from here on: MPP = S, SUM for the U leaves, MPRV */
+    clear_csr(mstatus, MSTATUS_MPP);
+    set_csr(mstatus, MSTATUS_MPP_S | MSTATUS_SUM | MSTATUS_MPRV);
+}
+
+void mmu_report(void)
+{
+    size_t table_bytes = sizeof(mmu_root);
+#if MMU_PAGE_SIZE == MMU_PAGE_1G
+    size_t leaves = 1; /* The gigapage covers RAM and the rest of its 1 GiB */
+#else
+    size_t leaves = RAM_SIZE / MMU_PAGE_SIZE;
+    table_bytes += sizeof(mmu_l1);
+#endif
+#if MMU_PAGE_SIZE == MMU_PAGE_4K
+    table_bytes += sizeof(mmu_l0);
+#endif
+
+    console_printf("[MMU] Sv39: RAM 0x%lx + %zu MiB as %zu x %s pages, %zu bytes of page tables, "
+                   "data accesses translated (mstatus.MPRV)\n",
+                   RAM_BASE, (size_t) RAM_SIZE >> 20, leaves, MMU_PAGE_NAME, table_bytes);
+}
+
+#endif /* ENABLE_MMU */
@@ -0,0 +1,209 @@
+/**
+ * @file msgq.c
+ * @brief Bounded lock-free inter-hart message queues with IPI doorbells
+ *
+ * See msgq.h. The sleep/wake handshake is the one sched.c uses for
+ * parking: the consumer announces itself in the sleeper mask (AMO, aqrl)
+ * before its last emptiness check, the producer publishes, fences and
+ * then reads the mask, so at least one side always sees the other.
+ */
+
+#include "msgq.h"
+
+#include "atomic.h"
+#include "csr.h"
+#include "platform.h"
+#include "smp.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Doorbell
+ * ============================================================================= */
+
+void msgq_bell_wake(msgq_bell_t *bell)
+{
+    uint32_t sleepers = bell->sleepers;
+
+    for (uint32_t h = 0; sleepers != 0; h++, sleepers >>= 1) {
+        if ((sleepers & 1) && (atomic_and_u32(&bell->sleepers, ~(1U << h)) & (1U << h))) {
+            smp_send_ipi(h);
+            return;
+        }
+    }
+}
+
+/** Sleep in wfi unless ready(q) turns true after announcing on the bell */
+static void msgq_sleep(msgq_bell_t *bell, bool (*ready)(const void *q), const void *q)
+{
+    uint32_t hart = smp_hart_id();
+    uint32_t bit = 1U << hart;
+#if defined(SMP_HAVE_IPI)
+    /* Keep the MSIP pending for wfi instead of letting trap.c acknowledge it */
+    unsigned long mie_was = clear_csr(mstatus, MSTATUS_MIE) & MSTATUS_MIE;
+    unsigned long msie_was = set_csr(mie, MIE_MSIE) & MIE_MSIE;
+#endif
+
+    atomic_or_u32(&bell->sleepers, bit); /* aqrl: announce before re-check */
+
+    if (!ready(q)) {
+#if defined(SMP_HAVE_IPI)
+        __asm__ __volatile__("wfi");
+#endif
+    }
+
+    atomic_and_u32(&bell->sleepers, ~bit);
+    smp_clear_ipi(hart);
+#if defined(SMP_HAVE_IPI)
+    if (!msie_was) {
+        clear_csr(mie, MIE_MSIE);
+    }
+    set_csr(mstatus, mie_was);
+#endif
+}
+
+static bool msgq_capacity_ok(uint32_t capacity)
+{
+    return capacity >= 2 && (capacity & (capacity - 1)) == 0;
+}
+
+/* =============================================================================
+ * SPSC Queue
+ * ============================================================================= */
+
+bool spsc_init(spsc_queue_t *q, uint64_t *slots, uint32_t capacity)
+{
+    if (!msgq_capacity_ok(capacity)) {
+        return false;
+    }
+    q->prod.tail = 0;
+    q->prod.head_cache = 0;
+    q->cons.head = 0;
+    q->cons.tail_cache = 0;
+    q->bell.sleepers = 0;
+    q->ring.slots = slots;
+    q->ring.mask = capacity - 1;
+    wmb();
+    return true;
+}
+
+static bool spsc_ready(const void *arg)
+{
+    const spsc_queue_t *q = (const spsc_queue_t *) arg;
+
+    return q->prod.tail != q->cons.head;
+}
+
+void spsc_push_wait(spsc_queue_t *q, uint64_t msg)
+{
+    while (!spsc_push(q, msg)) {
+        /* Spin: the consumer frees a slot without ringing back */
+    }
+}
+
+uint64_t spsc_pop_wait(spsc_queue_t *q)
+{
+    uint64_t msg;
+
+    while (!spsc_pop(q, &msg)) {
+        msgq_sleep(&q->bell, spsc_ready, q);
+    }
+    return msg;
+}
+
+/* =============================================================================
+ * MPMC Queue
+ * ============================================================================= */
+
+bool mpmc_init(mpmc_queue_t *q, mpmc_cell_t *cells, uint32_t capacity)
+{
+    if (!msgq_capacity_ok(capacity)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < capacity; i++) {
+        cells[i].seq = i;
+        cells[i].msg = 0;
+    }
+    q->enq.pos = 0;
+    q->deq.pos = 0;
+    q->bell.sleepers = 0;
+    q->ring.cells = cells;
+    q->ring.mask = capacity - 1;
+    wmb();
+    return true;
+}
+
+bool mpmc_push(mpmc_queue_t *q, uint64_t msg)
+{
+    uint32_t pos = q->enq.pos;
+    mpmc_cell_t *cell;
+
+    while (1) {
+        cell = &q->ring.cells[pos & q->ring.mask];
+        int32_t diff = (int32_t) (atomic_load_u32(&cell->seq) - pos);
+
+        if (diff == 0) {
+            if (atomic_cas_u32(&q->enq.pos, pos, pos + 1)) {
+                break; /* Cell claimed */
+            }
+        } else if (diff < 0) {
+            return false; /* Cell still holds a message from a lap ago: full */
+        }
+        pos = q->enq.pos; /* Lost the race or stale view: retry */
+    }
+
+    cell->msg = msg;
+    atomic_store_u32(&cell->seq, pos + 1); /* Release the message */
+    msgq_bell_ring(&q->bell);
+    return true;
+}
+
+bool mpmc_pop(mpmc_queue_t *q, uint64_t *msg)
+{
+    uint32_t pos = q->deq.pos;
+    mpmc_cell_t *cell;
+
+    while (1) {
+        cell = &q->ring.cells[pos & q->ring.mask];
+        int32_t diff = (int32_t) (atomic_load_u32(&cell->seq) - (pos + 1));
+
+        if (diff == 0) {
+            if (atomic_cas_u32(&q->deq.pos, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; /* Not written yet: empty */
+        }
+        pos = q->deq.pos;
+    }
+
+    *msg = cell->msg;
+    atomic_store_u32(&cell->seq, pos + q->ring.mask + 1); /* Free for the next lap */
+    return true;
+}
+
+static bool mpmc_ready(const void *arg)
+{
+    const mpmc_queue_t *q = (const mpmc_queue_t *) arg;
+    uint32_t pos = q->deq.pos;
+
+    return q->ring.cells[pos & q->ring.mask].seq == pos + 1;
+}
+
+void mpmc_push_wait(mpmc_queue_t *q, uint64_t msg)
+{
+    while (!mpmc_push(q, msg)) {
+        /* Spin: consumers free cells without ringing back */
+    }
+}
+
+uint64_t mpmc_pop_wait(mpmc_queue_t *q)
+{
+    uint64_t msg;
+
+    while (!mpmc_pop(q, &msg)) {
+        msgq_sleep(&q->bell, mpmc_ready, q);
+    }
+    return msg;
+}
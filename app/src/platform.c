@@ -5,7 +5,11 @@
 
 #include "platform.h"
 
+#include "alloc.h"
+#include "console.h"
 #include "csr.h"
+#include "mmu.h"
+#include "prof.h"
 
 /* Include platform-specific I/O drivers */
 #if defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
@@ -27,7 +31,7 @@ void platform_init(void)
     htif_init();
 #endif
 
-#if defined(ENABLE_RVV)
+#if defined(ENABLE_RVV) && !(defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE))
     /* Enable the floating-point unit (mstatus.FS = Initial).
      * Required for FP vector instructions which use fcsr rounding mode. */
     {
@@ -45,11 +49,24 @@ void platform_init(void)
     }
 #endif
 
+    /* Carve the heap into per-hart arenas before anything allocates */
+    heap_init();
+
+    /* Sv39 page tables, translation on for hart 0 (no-op without ENABLE_MMU) */
+    mmu_init();
+
     /* Platform-specific initialization can go here */
 }
 
 void platform_exit(int exit_code)
 {
+    /* Sampling ends here; report it before the final flush */
+    prof_stop();
+    prof_dump();
+
+    /* Push out console output still staged in line buffers and TX rings */
+    console_flush();
+
 #if defined(PLATFORM_SPIKE)
     /* Spike: use HTIF to tell the host to shutdown */
     htif_poweroff(exit_code);
@@ -80,3 +97,25 @@ const char *platform_get_name(void)
 {
     return PLATFORM_NAME;
 }
+
+/* =============================================================================
+ * Boot Timing
+ * ============================================================================= */
+
+/** Written by startup.S just before main() (after the BSS clear) */
+uint64_t platform_boot_cycles[BOOT_STAMP_COUNT];
+
+/** Written by startup.S next to the stamps: RVV builds fall back to sd without misa.V */
+uint32_t platform_boot_bss_rvv;
+
+void platform_boot_report(void)
+{
+    const uint64_t *c = platform_boot_cycles;
+    const char *clear = platform_boot_bss_rvv ? "rvv_memset" : "sd loop";
+
+    console_printf("[BOOT] %s: reset->_start=%lu bss_clear=%lu (%zu bytes, %d harts, %s) "
+                   "init=%lu reset->main=%lu cycles\n",
+                   PLATFORM_NAME, c[BOOT_STAMP_START], c[BOOT_STAMP_BSS] - c[BOOT_STAMP_START],
+                   (size_t) (__bss_end - __bss_start), NUM_HARTS, clear,
+                   c[BOOT_STAMP_MAIN] - c[BOOT_STAMP_BSS], c[BOOT_STAMP_MAIN]);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file prof.c
+ * @brief PC-sampling profiler on the machine timer interrupt
+ *
+ * See prof.h. Each hart owns one open-addressing histogram of
+ * (PC, count) pairs, written only from its own timer handler, so the
+ * tick path takes no locks and no AMOs. Built with -fno-tree-vectorize:
+ * the tick runs in interrupt context, which saves only integer registers.
+ */
+
+#include "prof.h"
+
+#include "console.h"
+#include "csr.h"
+#include "platform.h"
+#include "smp.h"
+#include "trap.h"
+
+#include <stdint.h>
+
+#if defined(ENABLE_PROFILER)
+
+/* =============================================================================
+ * Histograms
+ * ============================================================================= */
+
+_Static_assert((PROF_SLOTS & (PROF_SLOTS - 1)) == 0, "PROF_SLOTS must be a power of two");
+
+/** mtime ticks per sample */
+#define PROF_PERIOD_TICKS ((uint64_t) PROF_PERIOD_US * CLINT_TIMEBASE_HZ / 1000000UL)
+
+#define PROF_MTIMECMP(hart) (*(volatile uint64_t *) (CLINT_MTIMECMP + 8UL * (hart)))
+
+typedef struct {
+    uintptr_t pc; /* 0 = free slot */
+    uint64_t count;
+} prof_slot_t;
+
+/** One hart's samples; harts never write each other's lines */
+typedef struct {
+    prof_slot_t slot[PROF_SLOTS];
+    uint64_t samples;
+    uint64_t dropped; /* Samples whose PC found no free slot */
+    uint32_t pcs;     /* Slots in use */
+} __attribute__((aligned(SMP_CACHE_LINE))) prof_hist_t;
+
+static prof_hist_t prof_hist[NUM_HARTS];
+
+enum { PROF_IDLE, PROF_RUNNING, PROF_STOPPED };
+
+static volatile uint32_t prof_state;
+
+/* =============================================================================
+ * Timer Tick
+ * ============================================================================= */
+
+static inline uint64_t prof_read_mtime(void)
+{
+    return *(volatile uint64_t *) CLINT_MTIME;
+}
+
+/** Next tick one period from now (not from the last deadline: no catch-up bursts) */
+static inline void prof_arm(uint32_t hart)
+{
+    PROF_MTIMECMP(hart) = prof_read_mtime() + PROF_PERIOD_TICKS;
+}
+
+static void prof_record(prof_hist_t *hist, uintptr_t pc)
+{
+    /* Instructions are 2-byte aligned; fold in the page bits to spread loops */
+    uint32_t idx = (uint32_t) ((pc >> 1) ^ (pc >> 11)) & (PROF_SLOTS - 1);
+
+    hist->samples++;
+    for (uint32_t probe = 0; probe < PROF_MAX_PROBES; probe++) {
+        prof_slot_t *s = &hist->slot[idx];
+
+        if (s->pc == pc) {
+            s->count++;
+            return;
+        }
+        if (s->pc == 0) {
+            s->pc = pc;
+            s->count = 1;
+            hist->pcs++;
+            return;
+        }
+        idx = (idx + 1) & (PROF_SLOTS - 1);
+    }
+    hist->dropped++;
+}
+
+static void prof_tick(trap_frame_t *frame)
+{
+    uint32_t hart = smp_hart_id();
+
+    if (prof_state != PROF_RUNNING || hart >= NUM_HARTS) {
+        PROF_MTIMECMP(hart) = UINT64_MAX;
+        return;
+    }
+    prof_record(&prof_hist[hart], (uintptr_t) frame->mepc);
+    prof_arm(hart);
+}
+
+/* =============================================================================
+ * Public API
+ * ============================================================================= */
+
+void prof_start(void)
+{
+    uint32_t hart = smp_hart_id();
+
+    if (prof_state == PROF_STOPPED || hart >= NUM_HARTS) {
+        return;
+    }
+    trap_set_handler(IRQ_M_TIMER, prof_tick);
+    prof_state = PROF_RUNNING;
+
+    prof_arm(hart);
+    set_csr(mie, MIE_MTIE);
+    set_csr(mstatus, MSTATUS_MIE);
+}
+
+void prof_stop(void)
+{
+    uint32_t hart = smp_hart_id();
+
+    prof_state = PROF_STOPPED;
+    mb(); /* Other harts' next tick sees the stop */
+    if (hart < NUM_HARTS) {
+        clear_csr(mie, MIE_MTIE);
+        PROF_MTIMECMP(hart) = UINT64_MAX;
+    }
+}
+
+void prof_dump(void)
+{
+    rmb(); /* Samples of the other harts' last ticks */
+
+    console_printf("[PROF] period=%uus ticks=%lu harts=%d slots=%d\n", (unsigned) PROF_PERIOD_US,
+                   (uint64_t) PROF_PERIOD_TICKS, NUM_HARTS, PROF_SLOTS);
+
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        const prof_hist_t *hist = &prof_hist[h];
+
+        for (uint32_t i = 0; i < PROF_SLOTS; i++) {
+            if (hist->slot[i].pc != 0) {
+                console_printf("[PROF] hart=%u pc=0x%lx samples=%lu\n", h,
+                               (uint64_t) hist->slot[i].pc, hist->slot[i].count);
+            }
+        }
+        console_printf("[PROF] hart=%u samples=%lu pcs=%u dropped=%lu\n", h, hist->samples,
+                       hist->pcs, hist->dropped);
+    }
+}
+
+#endif /* ENABLE_PROFILER */
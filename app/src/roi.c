@@ -0,0 +1,69 @@
+/**
+ * @file roi.c
+ * @brief Region-of-interest bookkeeping and report
+ *
+ * Keeps the name and cycle count of each region so the report can be
+ * printed after the measurements, outside any region.
+ */
+
+#include "roi.h"
+
+#include "console.h"
+
+#include <stdint.h>
+
+/* =============================================================================
+ * Region Table
+ * ============================================================================= */
+
+typedef struct {
+    const char *name;
+    uint64_t cycles;
+} roi_record_t;
+
+uint64_t roi_start_cycle;
+
+static roi_record_t roi_records[ROI_MAX_REGIONS];
+static uint32_t roi_regions;
+
+uint32_t roi_open(const char *name)
+{
+    uint32_t index = roi_regions++;
+
+    if (index < ROI_MAX_REGIONS) {
+        roi_records[index].name = name;
+        roi_records[index].cycles = 0;
+    }
+    return index;
+}
+
+void roi_close(uint64_t cycles)
+{
+    uint32_t index = roi_regions - 1;
+
+    if (index < ROI_MAX_REGIONS) {
+        roi_records[index].cycles = cycles;
+    }
+}
+
+uint32_t roi_count(void)
+{
+    return roi_regions;
+}
+
+/* =============================================================================
+ * Report
+ * ============================================================================= */
+
+void roi_report(void)
+{
+    uint32_t listed = roi_regions < ROI_MAX_REGIONS ? roi_regions : ROI_MAX_REGIONS;
+
+    for (uint32_t i = 0; i < listed; i++) {
+        console_printf("[ROI] %u %s cycles=%lu\n", i, roi_records[i].name, roi_records[i].cycles);
+    }
+    if (roi_regions > listed) {
+        console_printf("[ROI] %u more regions not listed (ROI_MAX_REGIONS=%d)\n",
+                       roi_regions - listed, ROI_MAX_REGIONS);
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file vec_add.c
+ * @brief Vector addition workloads, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Level 1: Integer vector add (c[i] = a[i] + b[i])
+ * Level 2: Float32 vector add
+ *
+ * Same variants and contract as the inline-asm src/rvv/vec_add.c, written
+ * with riscv_vector.h intrinsics so the compiler allocates registers and
+ * schedules the loop. The x2 variants keep the one-branch-per-two-strips
+ * shape: the second strip's vsetvl returns 0 once n is exhausted.
+ */
+
+#include "rvv/rvv_common.h"
+#include "rvv/rvv_dispatch.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Variant Generators
+ * ============================================================================= */
+
+/* One strip of c = a op b for element type t (i32/f32) at lmul */
+#define VEC_ADD_STRIP(t, op, lmul)                                                                 \
+    vl = __riscv_vsetvl_e32##lmul(n);                                                              \
+    __riscv_vse32_v_##t##lmul(c,                                                                   \
+                              op##_vv_##t##lmul(__riscv_vle32_v_##t##lmul(a, vl),                  \
+                                                __riscv_vle32_v_##t##lmul(b, vl), vl),             \
+                              vl);                                                                 \
+    a += vl;                                                                                       \
+    b += vl;                                                                                       \
+    c += vl;                                                                                       \
+    n -= vl
+
+#define DEFINE_VEC_ADD(linkage, name, type, t, op, lmul)                                           \
+    linkage void name(const type *a, const type *b, type *c, size_t n)                             \
+    {                                                                                              \
+        size_t vl;                                                                                 \
+        while (n > 0) {                                                                            \
+            VEC_ADD_STRIP(t, op, lmul);                                                            \
+        }                                                                                          \
+    }
+
+#define DEFINE_VEC_ADD_X2(linkage, name, type, t, op, lmul)                                        \
+    linkage void name(const type *a, const type *b, type *c, size_t n)                             \
+    {                                                                                              \
+        size_t vl;                                                                                 \
+        while (n > 0) {                                                                            \
+            VEC_ADD_STRIP(t, op, lmul);                                                            \
+            VEC_ADD_STRIP(t, op, lmul);                                                            \
+        }                                                                                          \
+    }
+
+/* =============================================================================
+ * Level 1: Integer Vector Addition
+ * ============================================================================= */
+
+DEFINE_VEC_ADD(extern, rvv_vec_add_i32_m1, int32_t, i32, __riscv_vadd, m1)
+DEFINE_VEC_ADD(static, vec_add_i32_m2, int32_t, i32, __riscv_vadd, m2)
+DEFINE_VEC_ADD(static, vec_add_i32_m4, int32_t, i32, __riscv_vadd, m4)
+DEFINE_VEC_ADD(static, vec_add_i32_m8, int32_t, i32, __riscv_vadd, m8)
+DEFINE_VEC_ADD_X2(static, vec_add_i32_m2_x2, int32_t, i32, __riscv_vadd, m2)
+DEFINE_VEC_ADD_X2(static, vec_add_i32_m4_x2, int32_t, i32, __riscv_vadd, m4)
+
+const rvv_vec_add_i32_fn rvv_vec_add_i32_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_vec_add_i32_m1,
+    [RVV_VARIANT_M2] = vec_add_i32_m2,
+    [RVV_VARIANT_M4] = vec_add_i32_m4,
+    [RVV_VARIANT_M8] = vec_add_i32_m8,
+    [RVV_VARIANT_M2_X2] = vec_add_i32_m2_x2,
+    [RVV_VARIANT_M4_X2] = vec_add_i32_m4_x2,
+};
+
+void rvv_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n)
+{
+    rvv_dispatch.vec_add_i32(a, b, c, n);
+}
+
+/* =============================================================================
+ * Level 2: Float32 Vector Addition
+ * ============================================================================= */
+
+DEFINE_VEC_ADD(extern, rvv_vec_add_f32_m1, float, f32, __riscv_vfadd, m1)
+DEFINE_VEC_ADD(static, vec_add_f32_m2, float, f32, __riscv_vfadd, m2)
+DEFINE_VEC_ADD(static, vec_add_f32_m4, float, f32, __riscv_vfadd, m4)
+DEFINE_VEC_ADD(static, vec_add_f32_m8, float, f32, __riscv_vfadd, m8)
+DEFINE_VEC_ADD_X2(static, vec_add_f32_m2_x2, float, f32, __riscv_vfadd, m2)
+DEFINE_VEC_ADD_X2(static, vec_add_f32_m4_x2, float, f32, __riscv_vfadd, m4)
+
+const rvv_vec_add_f32_fn rvv_vec_add_f32_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_vec_add_f32_m1,
+    [RVV_VARIANT_M2] = vec_add_f32_m2,
+    [RVV_VARIANT_M4] = vec_add_f32_m4,
+    [RVV_VARIANT_M8] = vec_add_f32_m8,
+    [RVV_VARIANT_M2_X2] = vec_add_f32_m2_x2,
+    [RVV_VARIANT_M4_X2] = vec_add_f32_m4_x2,
+};
+
+void rvv_vec_add_f32(const float *a, const float *b, float *c, size_t n)
+{
+    rvv_dispatch.vec_add_f32(a, b, c, n);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file vec_dotprod.c
+ * @brief Vector dot product, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Level 2: Float32 dot product: result = sum(a[i] * b[i])
+ *
+ * Same reduction modes as the inline-asm src/rvv/vec_dotprod.c:
+ *
+ * - Ordered: vfmul + vfredosum per strip, bit-identical to
+ *   scalar_dot_product_f32(); built at LMUL 1/2/4/8 for rvv_dispatch.
+ *
+ * - Fast: a tail-undisturbed LMUL=4 accumulator (__riscv_vfmacc_vv_f32m4_tu)
+ *   and one vfredusum over all VLMAX lanes after the loop.
+ */
+
+#include "rvv/rvv_common.h"
+#include "rvv/rvv_dispatch.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Ordered Reduction Variants
+ * ============================================================================= */
+
+/* Running sum in element 0 of an m1 register; products reduced per strip */
+#define DEFINE_DOT_ORDERED(linkage, name, lmul)                                                    \
+    linkage float name(const float *a, const float *b, size_t n)                                   \
+    {                                                                                              \
+        vfloat32m1_t acc = __riscv_vfmv_s_f_f32m1(0.0f, 1);                                        \
+        while (n > 0) {                                                                            \
+            size_t vl = __riscv_vsetvl_e32##lmul(n);                                               \
+            vfloat32##lmul##_t prod = __riscv_vfmul_vv_f32##lmul(                                  \
+                __riscv_vle32_v_f32##lmul(a, vl), __riscv_vle32_v_f32##lmul(b, vl), vl);           \
+            acc = __riscv_vfredosum_vs_f32##lmul##_f32m1(prod, acc, vl);                           \
+            a += vl;                                                                               \
+            b += vl;                                                                               \
+            n -= vl;                                                                               \
+        }                                                                                          \
+        return __riscv_vfmv_f_s_f32m1_f32(acc);                                                    \
+    }
+
+DEFINE_DOT_ORDERED(extern, rvv_dot_product_f32_m1, m1)
+DEFINE_DOT_ORDERED(static, dot_product_ordered_m2, m2)
+DEFINE_DOT_ORDERED(static, dot_product_ordered_m4, m4)
+DEFINE_DOT_ORDERED(static, dot_product_ordered_m8, m8)
+
+const rvv_dot_f32_fn rvv_dot_f32_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_dot_product_f32_m1,
+    [RVV_VARIANT_M2] = dot_product_ordered_m2,
+    [RVV_VARIANT_M4] = dot_product_ordered_m4,
+    [RVV_VARIANT_M8] = dot_product_ordered_m8,
+};
+
+/* =============================================================================
+ * Fast Reduction
+ * ============================================================================= */
+
+static float dot_product_fast(const float *a, const float *b, size_t n)
+{
+    size_t vlmax = __riscv_vsetvlmax_e32m4();
+    vfloat32m4_t acc = __riscv_vfmv_v_f_f32m4(0.0f, vlmax);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m4(n);
+        vfloat32m4_t va = __riscv_vle32_v_f32m4(a, vl);
+        vfloat32m4_t vb = __riscv_vle32_v_f32m4(b, vl);
+
+        /* acc[i] += a[i] * b[i]; lanes >= vl keep their partial sums */
+        acc = __riscv_vfmacc_vv_f32m4_tu(acc, va, vb, vl);
+        a += vl;
+        b += vl;
+        n -= vl;
+    }
+
+    /* One unordered reduction over all VLMAX lanes */
+    vfloat32m1_t zero = __riscv_vfmv_s_f_f32m1(0.0f, 1);
+    return __riscv_vfmv_f_s_f32m1_f32(__riscv_vfredusum_vs_f32m4_f32m1(acc, zero, vlmax));
+}
+
+/* =============================================================================
+ * Entry Points
+ * ============================================================================= */
+
+float rvv_dot_product_f32(const float *a, const float *b, size_t n)
+{
+    return rvv_dispatch.dot_f32(a, b, n);
+}
+
+float rvv_dot_product_f32_mode(const float *a, const float *b, size_t n, rvv_reduce_mode_t mode)
+{
+    if (mode == RVV_REDUCE_FAST) {
+        return dot_product_fast(a, b, n);
+    }
+    return rvv_dispatch.dot_f32(a, b, n);
+}
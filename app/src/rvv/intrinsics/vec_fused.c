@@ -0,0 +1,47 @@
+/**
+ * @file vec_fused.c
+ * @brief Fused element-wise chains, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Same kernels as the inline-asm src/rvv/vec_fused.c: the AXPBY + clamp
+ * result stays in one vfloat32m8_t from the loads to the single store.
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Clamp
+ * ============================================================================= */
+
+void rvv_clamp_f32(const float *x, float lo, float hi, float *y, size_t n)
+{
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        vfloat32m8_t v = __riscv_vfmax_vf_f32m8(__riscv_vle32_v_f32m8(x, vl), lo, vl);
+        __riscv_vse32_v_f32m8(y, __riscv_vfmin_vf_f32m8(v, hi, vl), vl);
+        x += vl;
+        y += vl;
+        n -= vl;
+    }
+}
+
+/* =============================================================================
+ * AXPBY + Clamp
+ * ============================================================================= */
+
+void rvv_axpbz_clamp_f32(float a, const float *x, float b, const float *z, float lo, float hi,
+                         float *y, size_t n)
+{
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        vfloat32m8_t v = __riscv_vfmul_vf_f32m8(__riscv_vle32_v_f32m8(z, vl), b, vl);
+        v = __riscv_vfmacc_vf_f32m8(v, a, __riscv_vle32_v_f32m8(x, vl), vl);
+        v = __riscv_vfmax_vf_f32m8(v, lo, vl);
+        __riscv_vse32_v_f32m8(y, __riscv_vfmin_vf_f32m8(v, hi, vl), vl);
+        x += vl;
+        z += vl;
+        y += vl;
+        n -= vl;
+    }
+}
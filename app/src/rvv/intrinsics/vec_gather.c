@@ -0,0 +1,70 @@
+/**
+ * @file vec_gather.c
+ * @brief Strided and indexed gather/scatter, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Same contract as the inline-asm src/rvv/vec_gather.c: strides in
+ * elements, indices below 2^30 scaled to 32-bit byte offsets, distinct
+ * indices for the unordered scatter.
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Strided Access
+ * ============================================================================= */
+
+void rvv_gather_strided_f32(float *dst, const float *src, ptrdiff_t stride, size_t n)
+{
+    ptrdiff_t sb = stride * (ptrdiff_t) sizeof(float);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        __riscv_vse32_v_f32m8(dst, __riscv_vlse32_v_f32m8(src, sb, vl), vl);
+        dst += vl;
+        src += (ptrdiff_t) vl * stride;
+        n -= vl;
+    }
+}
+
+void rvv_scatter_strided_f32(float *dst, ptrdiff_t stride, const float *src, size_t n)
+{
+    ptrdiff_t sb = stride * (ptrdiff_t) sizeof(float);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        __riscv_vsse32_v_f32m8(dst, sb, __riscv_vle32_v_f32m8(src, vl), vl);
+        src += vl;
+        dst += (ptrdiff_t) vl * stride;
+        n -= vl;
+    }
+}
+
+/* =============================================================================
+ * Indexed Access
+ * ============================================================================= */
+
+void rvv_gather_f32(float *dst, const float *src, const uint32_t *idx, size_t n)
+{
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m4(n);
+        vuint32m4_t off = __riscv_vsll_vx_u32m4(__riscv_vle32_v_u32m4(idx, vl), 2, vl);
+        __riscv_vse32_v_f32m4(dst, __riscv_vluxei32_v_f32m4(src, off, vl), vl);
+        idx += vl;
+        dst += vl;
+        n -= vl;
+    }
+}
+
+void rvv_scatter_f32(float *dst, const uint32_t *idx, const float *src, size_t n)
+{
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m4(n);
+        vuint32m4_t off = __riscv_vsll_vx_u32m4(__riscv_vle32_v_u32m4(idx, vl), 2, vl);
+        __riscv_vsuxei32_v_f32m4(dst, off, __riscv_vle32_v_f32m4(src, vl), vl);
+        idx += vl;
+        src += vl;
+        n -= vl;
+    }
+}
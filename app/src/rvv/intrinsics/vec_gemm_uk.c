@@ -0,0 +1,100 @@
+/**
+ * @file vec_gemm_uk.c
+ * @brief GEMM microkernels, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Same contract as the inline-asm src/rvv/vec_gemm_uk.c: the MR x vl tile
+ * of C is held in MR vector accumulators for the whole k-loop, each k step
+ * loads one B row and broadcasts MR A values through vfmacc.vf. The
+ * compiler chooses the registers (8 LMUL=2 or 4 LMUL=4 groups plus the B
+ * row fit in the 32 architectural registers without spilling).
+ */
+
+#include "rvv/rvv_gemm_uk.h"
+
+#include <riscv_vector.h>
+
+void rvv_gemm_ukernel_8x_m2(const float *ap, const float *bp, size_t kc, float *c, size_t ldc,
+                            size_t vl, size_t acc)
+{
+    size_t ldf = ldc / sizeof(float);
+    vfloat32m2_t c0, c1, c2, c3, c4, c5, c6, c7;
+
+    if (acc) {
+        c0 = __riscv_vle32_v_f32m2(c + 0 * ldf, vl);
+        c1 = __riscv_vle32_v_f32m2(c + 1 * ldf, vl);
+        c2 = __riscv_vle32_v_f32m2(c + 2 * ldf, vl);
+        c3 = __riscv_vle32_v_f32m2(c + 3 * ldf, vl);
+        c4 = __riscv_vle32_v_f32m2(c + 4 * ldf, vl);
+        c5 = __riscv_vle32_v_f32m2(c + 5 * ldf, vl);
+        c6 = __riscv_vle32_v_f32m2(c + 6 * ldf, vl);
+        c7 = __riscv_vle32_v_f32m2(c + 7 * ldf, vl);
+    } else {
+        c0 = __riscv_vfmv_v_f_f32m2(0.0f, vl);
+        c1 = c0;
+        c2 = c0;
+        c3 = c0;
+        c4 = c0;
+        c5 = c0;
+        c6 = c0;
+        c7 = c0;
+    }
+
+    for (; kc > 0; kc--) {
+        vfloat32m2_t b = __riscv_vle32_v_f32m2(bp, vl); /* Bp[p][0..vl-1] */
+
+        c0 = __riscv_vfmacc_vf_f32m2(c0, ap[0], b, vl);
+        c1 = __riscv_vfmacc_vf_f32m2(c1, ap[1], b, vl);
+        c2 = __riscv_vfmacc_vf_f32m2(c2, ap[2], b, vl);
+        c3 = __riscv_vfmacc_vf_f32m2(c3, ap[3], b, vl);
+        c4 = __riscv_vfmacc_vf_f32m2(c4, ap[4], b, vl);
+        c5 = __riscv_vfmacc_vf_f32m2(c5, ap[5], b, vl);
+        c6 = __riscv_vfmacc_vf_f32m2(c6, ap[6], b, vl);
+        c7 = __riscv_vfmacc_vf_f32m2(c7, ap[7], b, vl);
+        ap += 8;
+        bp += vl;
+    }
+
+    __riscv_vse32_v_f32m2(c + 0 * ldf, c0, vl);
+    __riscv_vse32_v_f32m2(c + 1 * ldf, c1, vl);
+    __riscv_vse32_v_f32m2(c + 2 * ldf, c2, vl);
+    __riscv_vse32_v_f32m2(c + 3 * ldf, c3, vl);
+    __riscv_vse32_v_f32m2(c + 4 * ldf, c4, vl);
+    __riscv_vse32_v_f32m2(c + 5 * ldf, c5, vl);
+    __riscv_vse32_v_f32m2(c + 6 * ldf, c6, vl);
+    __riscv_vse32_v_f32m2(c + 7 * ldf, c7, vl);
+}
+
+void rvv_gemm_ukernel_4x_m4(const float *ap, const float *bp, size_t kc, float *c, size_t ldc,
+                            size_t vl, size_t acc)
+{
+    size_t ldf = ldc / sizeof(float);
+    vfloat32m4_t c0, c1, c2, c3;
+
+    if (acc) {
+        c0 = __riscv_vle32_v_f32m4(c + 0 * ldf, vl);
+        c1 = __riscv_vle32_v_f32m4(c + 1 * ldf, vl);
+        c2 = __riscv_vle32_v_f32m4(c + 2 * ldf, vl);
+        c3 = __riscv_vle32_v_f32m4(c + 3 * ldf, vl);
+    } else {
+        c0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+        c1 = c0;
+        c2 = c0;
+        c3 = c0;
+    }
+
+    for (; kc > 0; kc--) {
+        vfloat32m4_t b = __riscv_vle32_v_f32m4(bp, vl); /* Bp[p][0..vl-1] */
+
+        c0 = __riscv_vfmacc_vf_f32m4(c0, ap[0], b, vl);
+        c1 = __riscv_vfmacc_vf_f32m4(c1, ap[1], b, vl);
+        c2 = __riscv_vfmacc_vf_f32m4(c2, ap[2], b, vl);
+        c3 = __riscv_vfmacc_vf_f32m4(c3, ap[3], b, vl);
+        ap += 4;
+        bp += vl;
+    }
+
+    __riscv_vse32_v_f32m4(c + 0 * ldf, c0, vl);
+    __riscv_vse32_v_f32m4(c + 1 * ldf, c1, vl);
+    __riscv_vse32_v_f32m4(c + 2 * ldf, c2, vl);
+    __riscv_vse32_v_f32m4(c + 3 * ldf, c3, vl);
+}
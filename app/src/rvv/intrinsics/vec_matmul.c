@@ -0,0 +1,44 @@
+/**
+ * @file vec_matmul.c
+ * @brief Matrix multiplication, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Level 3: Matrix multiply (float32), same algorithm as the inline-asm
+ * src/rvv/vec_matmul.c: for each A[i][k], C[i][0..n-1] += A[i][k] *
+ * B[k][0..n-1] with vfmacc.vf across the columns at LMUL=1.
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+void rvv_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n, uint32_t k)
+{
+    /* Zero out C first */
+    for (uint32_t i = 0; i < m * n; i++) {
+        C[i] = 0.0f;
+    }
+
+    /* For each row i of A */
+    for (uint32_t i = 0; i < m; i++) {
+        /* For each element in the k-dimension */
+        for (uint32_t p = 0; p < k; p++) {
+            float a_ik = A[i * k + p];
+
+            /* Vectorize across columns of B[p][0..n-1] and C[i][0..n-1] */
+            const float *b_row = &B[p * n];
+            float *c_row = &C[i * n];
+            size_t remaining = n;
+
+            while (remaining > 0) {
+                size_t vl = __riscv_vsetvl_e32m1(remaining);
+                vfloat32m1_t vb = __riscv_vle32_v_f32m1(b_row, vl);
+                vfloat32m1_t vc = __riscv_vle32_v_f32m1(c_row, vl);
+
+                __riscv_vse32_v_f32m1(c_row, __riscv_vfmacc_vf_f32m1(vc, a_ik, vb, vl), vl);
+                b_row += vl;
+                c_row += vl;
+                remaining -= vl;
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file vec_memcpy.c
+ * @brief Vectorized memory copy, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Same size/alignment strategy as the inline-asm src/rvv/vec_memcpy.c:
+ *   n < RVV_MEM_SMALL_BYTES    one e8,m1 strip
+ *   n <= VLMAX(e8, m8)         one e8,m8 strip, no loop
+ *   (dst ^ src) & 7 != 0       e8,m8 loop
+ *   otherwise                  e8 head to align dst to 8 bytes,
+ *                              e64,m8 bulk, e8 tail
+ *
+ * Two differences from the asm backend:
+ *   - Short copies and the 0-7 byte head/tail are a single e8 strip rather
+ *     than a scalar byte loop. The compiler may turn a plain C byte loop
+ *     into a call to memcpy(), which this freestanding image does not have.
+ *   - rvv_memcpy_stream() copies like rvv_memcpy(). A Zihintntl hint only
+ *     applies to the instruction right after it, and intrinsics give no
+ *     control over what the compiler schedules between the two.
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Building Blocks
+ * ============================================================================= */
+
+/** Copy n <= VLMAX(e8, m1) bytes; VLEN >= 128 covers every n < 16 */
+static inline void copy_bytes_short(uint8_t *d, const uint8_t *s, size_t n)
+{
+    size_t vl = __riscv_vsetvl_e8m1(n);
+    __riscv_vse8_v_u8m1(d, __riscv_vle8_v_u8m1(s, vl), vl);
+}
+
+/** Byte-granular vector copy, LMUL=8 */
+static inline void copy_e8(uint8_t *d, const uint8_t *s, size_t n)
+{
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e8m8(n);
+        __riscv_vse8_v_u8m8(d, __riscv_vle8_v_u8m8(s, vl), vl);
+        s += vl;
+        d += vl;
+        n -= vl;
+    }
+}
+
+/** 64-bit element vector copy, LMUL=8; d and s 8-byte aligned */
+static inline void copy_e64(uint8_t *d, const uint8_t *s, size_t nwords)
+{
+    uint64_t *dw = (uint64_t *) (void *) d;
+    const uint64_t *sw = (const uint64_t *) (const void *) s;
+
+    while (nwords > 0) {
+        size_t vl = __riscv_vsetvl_e64m8(nwords);
+        __riscv_vse64_v_u64m8(dw, __riscv_vle64_v_u64m8(sw, vl), vl);
+        sw += vl;
+        dw += vl;
+        nwords -= vl;
+    }
+}
+
+/* =============================================================================
+ * Copy Driver
+ * ============================================================================= */
+
+static void memcpy_adaptive(void *dst, const void *src, size_t n)
+{
+    uint8_t *d = (uint8_t *) dst;
+    const uint8_t *s = (const uint8_t *) src;
+
+    if (n < RVV_MEM_SMALL_BYTES) {
+        copy_bytes_short(d, s, n);
+        return;
+    }
+
+    if (n <= __riscv_vsetvlmax_e8m8() || ((uintptr_t) d ^ (uintptr_t) s) & 7) {
+        copy_e8(d, s, n);
+        return;
+    }
+
+    /* Head: bring dst (and therefore src) up to 8-byte alignment */
+    size_t head = (size_t) (-(uintptr_t) d & 7);
+    copy_bytes_short(d, s, head);
+    d += head;
+    s += head;
+    n -= head;
+
+    /* Bulk: whole 64-bit words */
+    size_t nwords = n >> 3;
+    copy_e64(d, s, nwords);
+
+    /* Tail: remaining 0-7 bytes */
+    copy_bytes_short(d + (nwords << 3), s + (nwords << 3), n & 7);
+}
+
+void rvv_memcpy(void *dst, const void *src, size_t n)
+{
+    memcpy_adaptive(dst, src, n);
+}
+
+void rvv_memcpy_stream(void *dst, const void *src, size_t n)
+{
+    memcpy_adaptive(dst, src, n);
+}
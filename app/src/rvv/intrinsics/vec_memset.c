@@ -0,0 +1,87 @@
+/**
+ * @file vec_memset.c
+ * @brief Vectorized memory set, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Same fill strategy as the inline-asm src/rvv/vec_memset.c (short fill,
+ * one e8,m8 strip, or aligned e64,m8 bulk with the byte replicated 8x).
+ * As in intrinsics/vec_memcpy.c, short fills and the head/tail are one
+ * e8 strip instead of a byte loop (which the compiler may turn into a
+ * memset() call), and there is no ntl.all streaming path.
+ *
+ * Startup code calls rvv_memset() to clear .bss before main(), so this
+ * file must not use any zero-initialized data of its own.
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Building Blocks
+ * ============================================================================= */
+
+/** Fill n <= VLMAX(e8, m1) bytes; VLEN >= 128 covers every n < 16 */
+static inline void set_bytes_short(uint8_t *d, uint8_t c, size_t n)
+{
+    size_t vl = __riscv_vsetvl_e8m1(n);
+    __riscv_vse8_v_u8m1(d, __riscv_vmv_v_x_u8m1(c, vl), vl);
+}
+
+static inline void set_e8(uint8_t *d, uint8_t c, size_t n)
+{
+    vuint8m8_t v = __riscv_vmv_v_x_u8m8(c, __riscv_vsetvlmax_e8m8());
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e8m8(n);
+        __riscv_vse8_v_u8m8(d, v, vl);
+        d += vl;
+        n -= vl;
+    }
+}
+
+/** 64-bit element vector fill, LMUL=8; d 8-byte aligned */
+static inline void set_e64(uint8_t *d, uint64_t pattern, size_t nwords)
+{
+    uint64_t *dw = (uint64_t *) (void *) d;
+    vuint64m8_t v = __riscv_vmv_v_x_u64m8(pattern, __riscv_vsetvlmax_e64m8());
+
+    while (nwords > 0) {
+        size_t vl = __riscv_vsetvl_e64m8(nwords);
+        __riscv_vse64_v_u64m8(dw, v, vl);
+        dw += vl;
+        nwords -= vl;
+    }
+}
+
+/* =============================================================================
+ * Fill Driver
+ * ============================================================================= */
+
+void rvv_memset(void *dst, int c, size_t n)
+{
+    uint8_t *d = (uint8_t *) dst;
+    uint8_t byte = (uint8_t) c;
+
+    if (n < RVV_MEM_SMALL_BYTES) {
+        set_bytes_short(d, byte, n);
+        return;
+    }
+
+    if (n <= __riscv_vsetvlmax_e8m8()) {
+        set_e8(d, byte, n);
+        return;
+    }
+
+    /* Head: bring dst up to 8-byte alignment */
+    size_t head = (size_t) (-(uintptr_t) d & 7);
+    set_bytes_short(d, byte, head);
+    d += head;
+    n -= head;
+
+    /* Bulk: whole 64-bit words */
+    size_t nwords = n >> 3;
+    set_e64(d, (uint64_t) byte * 0x0101010101010101ULL, nwords);
+
+    /* Tail: remaining 0-7 bytes */
+    set_bytes_short(d + (nwords << 3), byte, n & 7);
+}
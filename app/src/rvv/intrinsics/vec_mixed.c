@@ -0,0 +1,177 @@
+/**
+ * @file vec_mixed.c
+ * @brief Mixed-precision dot product and matrix multiply, intrinsics backend
+ *        (RVV_BACKEND=intrinsics)
+ *
+ * Same algorithms as the inline-asm src/rvv/vec_mixed.c: vsext + _tu
+ * vwmacc into int32 lanes for int8, vfwmul + per-strip vfredosum for the
+ * fp16 dot product, vfwmaccbf16 into a zeroed strip for the bf16 dot
+ * product, and one C row-strip kept in registers across k for the
+ * matrix kernels. The fp16/bf16 patterns are reinterpreted from uint16
+ * vectors; the scalar A[i][p] goes through a union.
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * int8
+ * ============================================================================= */
+
+int32_t rvv_dot_product_i8(const int8_t *a, const int8_t *b, size_t n)
+{
+    size_t vlmax = __riscv_vsetvlmax_e32m8();
+    vint32m8_t acc = __riscv_vmv_v_x_i32m8(0, vlmax);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e8m2(n);
+        vint16m4_t va = __riscv_vsext_vf2_i16m4(__riscv_vle8_v_i8m2(a, vl), vl);
+        vint16m4_t vb = __riscv_vsext_vf2_i16m4(__riscv_vle8_v_i8m2(b, vl), vl);
+
+        acc = __riscv_vwmacc_vv_i32m8_tu(acc, va, vb, vl);
+        a += vl;
+        b += vl;
+        n -= vl;
+    }
+
+    vint32m1_t zero = __riscv_vmv_s_x_i32m1(0, 1);
+    return __riscv_vmv_x_s_i32m1_i32(__riscv_vredsum_vs_i32m8_i32m1(acc, zero, vlmax));
+}
+
+void rvv_matmul_i8(const int8_t *A, const int8_t *B, int32_t *C, uint32_t m, uint32_t n,
+                   uint32_t k)
+{
+    for (uint32_t i = 0; i < m; i++) {
+        int32_t *c_row = &C[i * n];
+        size_t remaining = n;
+        size_t j = 0;
+
+        while (remaining > 0) {
+            size_t vl = __riscv_vsetvl_e32m4(remaining);
+            vint32m4_t acc = __riscv_vmv_v_x_i32m4(0, vl);
+
+            for (uint32_t p = 0; p < k; p++) {
+                vint8m1_t vb = __riscv_vle8_v_i8m1(&B[p * n + j], vl);
+                acc = __riscv_vwmacc_vx_i32m4(acc, A[i * k + p], __riscv_vsext_vf2_i16m2(vb, vl),
+                                              vl);
+            }
+            __riscv_vse32_v_i32m4(c_row, acc, vl);
+            c_row += vl;
+            j += vl;
+            remaining -= vl;
+        }
+    }
+}
+
+/* =============================================================================
+ * fp16 (Zvfh)
+ * ============================================================================= */
+
+#ifdef RVV_HAVE_ZVFH
+
+float rvv_dot_product_f16(const rvv_f16_t *a, const rvv_f16_t *b, size_t n)
+{
+    vfloat32m1_t acc = __riscv_vfmv_s_f_f32m1(0.0f, 1);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e16m4(n);
+        vfloat16m4_t va = __riscv_vreinterpret_v_u16m4_f16m4(__riscv_vle16_v_u16m4(a, vl));
+        vfloat16m4_t vb = __riscv_vreinterpret_v_u16m4_f16m4(__riscv_vle16_v_u16m4(b, vl));
+
+        acc = __riscv_vfredosum_vs_f32m8_f32m1(__riscv_vfwmul_vv_f32m8(va, vb, vl), acc, vl);
+        a += vl;
+        b += vl;
+        n -= vl;
+    }
+    return __riscv_vfmv_f_s_f32m1_f32(acc);
+}
+
+void rvv_matmul_f16(const rvv_f16_t *A, const rvv_f16_t *B, float *C, uint32_t m, uint32_t n,
+                    uint32_t k)
+{
+    for (uint32_t i = 0; i < m; i++) {
+        float *c_row = &C[i * n];
+        size_t remaining = n;
+        size_t j = 0;
+
+        while (remaining > 0) {
+            size_t vl = __riscv_vsetvl_e32m4(remaining);
+            vfloat32m4_t acc = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+
+            for (uint32_t p = 0; p < k; p++) {
+                union {
+                    rvv_f16_t u;
+                    _Float16 h;
+                } a_ik = {.u = A[i * k + p]};
+                vfloat16m2_t vb =
+                    __riscv_vreinterpret_v_u16m2_f16m2(__riscv_vle16_v_u16m2(&B[p * n + j], vl));
+
+                acc = __riscv_vfwmacc_vf_f32m4(acc, a_ik.h, vb, vl);
+            }
+            __riscv_vse32_v_f32m4(c_row, acc, vl);
+            c_row += vl;
+            j += vl;
+            remaining -= vl;
+        }
+    }
+}
+
+#endif /* RVV_HAVE_ZVFH */
+
+/* =============================================================================
+ * bf16 (Zvfbfwma)
+ * ============================================================================= */
+
+#ifdef RVV_HAVE_ZVFBFWMA
+
+float rvv_dot_product_bf16(const rvv_bf16_t *a, const rvv_bf16_t *b, size_t n)
+{
+    vfloat32m1_t acc = __riscv_vfmv_s_f_f32m1(0.0f, 1);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e16m4(n);
+        vbfloat16m4_t va = __riscv_vreinterpret_v_u16m4_bf16m4(__riscv_vle16_v_u16m4(a, vl));
+        vbfloat16m4_t vb = __riscv_vreinterpret_v_u16m4_bf16m4(__riscv_vle16_v_u16m4(b, vl));
+        vfloat32m8_t prod = __riscv_vfmv_v_f_f32m8(0.0f, vl);
+
+        prod = __riscv_vfwmaccbf16_vv_f32m8(prod, va, vb, vl);
+        acc = __riscv_vfredosum_vs_f32m8_f32m1(prod, acc, vl);
+        a += vl;
+        b += vl;
+        n -= vl;
+    }
+    return __riscv_vfmv_f_s_f32m1_f32(acc);
+}
+
+void rvv_matmul_bf16(const rvv_bf16_t *A, const rvv_bf16_t *B, float *C, uint32_t m, uint32_t n,
+                     uint32_t k)
+{
+    for (uint32_t i = 0; i < m; i++) {
+        float *c_row = &C[i * n];
+        size_t remaining = n;
+        size_t j = 0;
+
+        while (remaining > 0) {
+            size_t vl = __riscv_vsetvl_e32m4(remaining);
+            vfloat32m4_t acc = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+
+            for (uint32_t p = 0; p < k; p++) {
+                union {
+                    rvv_bf16_t u;
+                    __bf16 h;
+                } a_ik = {.u = A[i * k + p]};
+                vbfloat16m2_t vb =
+                    __riscv_vreinterpret_v_u16m2_bf16m2(__riscv_vle16_v_u16m2(&B[p * n + j], vl));
+
+                acc = __riscv_vfwmaccbf16_vf_f32m4(acc, a_ik.h, vb, vl);
+            }
+            __riscv_vse32_v_f32m4(c_row, acc, vl);
+            c_row += vl;
+            j += vl;
+            remaining -= vl;
+        }
+    }
+}
+
+#endif /* RVV_HAVE_ZVFBFWMA */
@@ -0,0 +1,142 @@
+/**
+ * @file vec_reduce.c
+ * @brief Reductions and prefix sum, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Same algorithms as the inline-asm src/rvv/vec_reduce.c: tail-undisturbed
+ * (_tu) per-lane accumulators reduced once for the integer sum and the
+ * min/max reductions, vfredosum per strip for the bit-exact float sum,
+ * and a vslideup log-step scan for the prefix sum.
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Integer Reductions
+ * ============================================================================= */
+
+int64_t rvv_reduce_sum_i32(const int32_t *x, size_t n)
+{
+    size_t vlmax = __riscv_vsetvlmax_e64m8();
+    vint64m8_t acc = __riscv_vmv_v_x_i64m8(0, vlmax);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m4(n);
+        acc = __riscv_vwadd_wv_i64m8_tu(acc, acc, __riscv_vle32_v_i32m4(x, vl), vl);
+        x += vl;
+        n -= vl;
+    }
+
+    vint64m1_t zero = __riscv_vmv_s_x_i64m1(0, 1);
+    return __riscv_vmv_x_s_i64m1_i64(__riscv_vredsum_vs_i64m8_i64m1(acc, zero, vlmax));
+}
+
+int32_t rvv_reduce_min_i32(const int32_t *x, size_t n)
+{
+    size_t vlmax = __riscv_vsetvlmax_e32m8();
+    vint32m8_t acc = __riscv_vmv_v_x_i32m8(INT32_MAX, vlmax);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        acc = __riscv_vmin_vv_i32m8_tu(acc, acc, __riscv_vle32_v_i32m8(x, vl), vl);
+        x += vl;
+        n -= vl;
+    }
+
+    vint32m1_t init = __riscv_vmv_s_x_i32m1(INT32_MAX, 1);
+    return __riscv_vmv_x_s_i32m1_i32(__riscv_vredmin_vs_i32m8_i32m1(acc, init, vlmax));
+}
+
+int32_t rvv_reduce_max_i32(const int32_t *x, size_t n)
+{
+    size_t vlmax = __riscv_vsetvlmax_e32m8();
+    vint32m8_t acc = __riscv_vmv_v_x_i32m8(INT32_MIN, vlmax);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        acc = __riscv_vmax_vv_i32m8_tu(acc, acc, __riscv_vle32_v_i32m8(x, vl), vl);
+        x += vl;
+        n -= vl;
+    }
+
+    vint32m1_t init = __riscv_vmv_s_x_i32m1(INT32_MIN, 1);
+    return __riscv_vmv_x_s_i32m1_i32(__riscv_vredmax_vs_i32m8_i32m1(acc, init, vlmax));
+}
+
+/* =============================================================================
+ * Float Reductions
+ * ============================================================================= */
+
+float rvv_reduce_sum_f32(const float *x, size_t n)
+{
+    vfloat32m1_t acc = __riscv_vfmv_s_f_f32m1(0.0f, 1);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        acc = __riscv_vfredosum_vs_f32m8_f32m1(__riscv_vle32_v_f32m8(x, vl), acc, vl);
+        x += vl;
+        n -= vl;
+    }
+    return __riscv_vfmv_f_s_f32m1_f32(acc);
+}
+
+float rvv_reduce_min_f32(const float *x, size_t n)
+{
+    size_t vlmax = __riscv_vsetvlmax_e32m8();
+    vfloat32m8_t acc = __riscv_vfmv_v_f_f32m8(__builtin_inff(), vlmax);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        acc = __riscv_vfmin_vv_f32m8_tu(acc, acc, __riscv_vle32_v_f32m8(x, vl), vl);
+        x += vl;
+        n -= vl;
+    }
+
+    vfloat32m1_t init = __riscv_vfmv_s_f_f32m1(__builtin_inff(), 1);
+    return __riscv_vfmv_f_s_f32m1_f32(__riscv_vfredmin_vs_f32m8_f32m1(acc, init, vlmax));
+}
+
+float rvv_reduce_max_f32(const float *x, size_t n)
+{
+    size_t vlmax = __riscv_vsetvlmax_e32m8();
+    vfloat32m8_t acc = __riscv_vfmv_v_f_f32m8(-__builtin_inff(), vlmax);
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m8(n);
+        acc = __riscv_vfmax_vv_f32m8_tu(acc, acc, __riscv_vle32_v_f32m8(x, vl), vl);
+        x += vl;
+        n -= vl;
+    }
+
+    vfloat32m1_t init = __riscv_vfmv_s_f_f32m1(-__builtin_inff(), 1);
+    return __riscv_vfmv_f_s_f32m1_f32(__riscv_vfredmax_vs_f32m8_f32m1(acc, init, vlmax));
+}
+
+/* =============================================================================
+ * Prefix Sum
+ * ============================================================================= */
+
+void rvv_prefix_sum_i32(const int32_t *x, int32_t *y, size_t n)
+{
+    int32_t carry = 0;
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e32m4(n);
+        vint32m4_t v = __riscv_vle32_v_i32m4(x, vl);
+
+        /* v[i] += v[i - off] (0 below off) for off = 1, 2, 4, ... */
+        for (size_t off = 1; off < vl; off <<= 1) {
+            vint32m4_t shifted =
+                __riscv_vslideup_vx_i32m4(__riscv_vmv_v_x_i32m4(0, vl), v, off, vl);
+            v = __riscv_vadd_vv_i32m4(v, shifted, vl);
+        }
+        v = __riscv_vadd_vx_i32m4(v, carry, vl);
+        __riscv_vse32_v_i32m4(y, v, vl);
+        carry = __riscv_vmv_x_s_i32m4_i32(__riscv_vslidedown_vx_i32m4(v, vl - 1, vl));
+
+        x += vl;
+        y += vl;
+        n -= vl;
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file vec_saxpy.c
+ * @brief SAXPY, intrinsics backend (RVV_BACKEND=intrinsics): y[i] = a * x[i] + y[i]
+ *
+ * Same variants and contract as the inline-asm src/rvv/vec_saxpy.c;
+ * __riscv_vfmacc_vf computes vd[i] = rs1 * vs2[i] + vd[i] (fused).
+ */
+
+#include "rvv/rvv_common.h"
+#include "rvv/rvv_dispatch.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Variant Generators
+ * ============================================================================= */
+
+/* One strip: y[0..vl) += a * x[0..vl), then advance pointers and n */
+#define SAXPY_STRIP(lmul)                                                                          \
+    vl = __riscv_vsetvl_e32##lmul(n);                                                              \
+    __riscv_vse32_v_f32##lmul(y,                                                                   \
+                              __riscv_vfmacc_vf_f32##lmul(__riscv_vle32_v_f32##lmul(y, vl), a,     \
+                                                          __riscv_vle32_v_f32##lmul(x, vl), vl),   \
+                              vl);                                                                 \
+    x += vl;                                                                                       \
+    y += vl;                                                                                       \
+    n -= vl
+
+#define DEFINE_SAXPY(linkage, name, lmul)                                                          \
+    linkage void name(float a, const float *x, float *y, size_t n)                                 \
+    {                                                                                              \
+        size_t vl;                                                                                 \
+        while (n > 0) {                                                                            \
+            SAXPY_STRIP(lmul);                                                                     \
+        }                                                                                          \
+    }
+
+#define DEFINE_SAXPY_X2(linkage, name, lmul)                                                       \
+    linkage void name(float a, const float *x, float *y, size_t n)                                 \
+    {                                                                                              \
+        size_t vl;                                                                                 \
+        while (n > 0) {                                                                            \
+            SAXPY_STRIP(lmul);                                                                     \
+            SAXPY_STRIP(lmul);                                                                     \
+        }                                                                                          \
+    }
+
+/* =============================================================================
+ * SAXPY
+ * ============================================================================= */
+
+DEFINE_SAXPY(extern, rvv_saxpy_m1, m1)
+DEFINE_SAXPY(static, saxpy_m2, m2)
+DEFINE_SAXPY(static, saxpy_m4, m4)
+DEFINE_SAXPY(static, saxpy_m8, m8)
+DEFINE_SAXPY_X2(static, saxpy_m2_x2, m2)
+DEFINE_SAXPY_X2(static, saxpy_m4_x2, m4)
+
+const rvv_saxpy_fn rvv_saxpy_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_saxpy_m1,
+    [RVV_VARIANT_M2] = saxpy_m2,
+    [RVV_VARIANT_M4] = saxpy_m4,
+    [RVV_VARIANT_M8] = saxpy_m8,
+    [RVV_VARIANT_M2_X2] = saxpy_m2_x2,
+    [RVV_VARIANT_M4_X2] = saxpy_m4_x2,
+};
+
+void rvv_saxpy(float a, const float *x, float *y, size_t n)
+{
+    rvv_dispatch.saxpy(a, x, y, n);
+}
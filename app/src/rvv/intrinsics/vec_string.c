@@ -0,0 +1,58 @@
+/**
+ * @file vec_string.c
+ * @brief Vectorized memory compare and string length, intrinsics backend (RVV_BACKEND=intrinsics)
+ *
+ * Same strategy as the inline-asm src/rvv/vec_string.c: e8,m8 compare
+ * strips with vfirst for rvv_memcmp(), VLMAX fault-only-first loads
+ * (__riscv_vle8ff) for rvv_strlen().
+ */
+
+#include "rvv/rvv_common.h"
+
+#include <riscv_vector.h>
+
+/* =============================================================================
+ * Memory Compare
+ * ============================================================================= */
+
+int rvv_memcmp(const void *a, const void *b, size_t n)
+{
+    const uint8_t *pa = (const uint8_t *) a;
+    const uint8_t *pb = (const uint8_t *) b;
+
+    while (n > 0) {
+        size_t vl = __riscv_vsetvl_e8m8(n);
+        vbool1_t ne = __riscv_vmsne_vv_u8m8_b1(__riscv_vle8_v_u8m8(pa, vl),
+                                               __riscv_vle8_v_u8m8(pb, vl), vl);
+        long first = __riscv_vfirst_m_b1(ne, vl);
+
+        if (first >= 0) {
+            return (int) pa[first] - (int) pb[first];
+        }
+        pa += vl;
+        pb += vl;
+        n -= vl;
+    }
+    return 0;
+}
+
+/* =============================================================================
+ * String Length
+ * ============================================================================= */
+
+size_t rvv_strlen(const char *s)
+{
+    const uint8_t *p = (const uint8_t *) s;
+    size_t vlmax = __riscv_vsetvlmax_e8m8();
+
+    for (;;) {
+        size_t vl;
+        vuint8m8_t v = __riscv_vle8ff_v_u8m8(p, &vl, vlmax);
+        long first = __riscv_vfirst_m_b1(__riscv_vmseq_vx_u8m8_b1(v, 0, vl), vl);
+
+        if (first >= 0) {
+            return (size_t) (p - (const uint8_t *) s) + (size_t) first;
+        }
+        p += vl;
+    }
+}
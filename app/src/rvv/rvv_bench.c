@@ -0,0 +1,846 @@
+/**
+ * @file rvv_bench.c
+ * @brief RVV micro-benchmark registry, statistics and CSV/JSON output
+ *
+ * Kernels run on shared static buffers sized for RVV_BENCH_MAX_LEN
+ * elements: scalar references write the *_ref outputs and RVV kernels
+ * the *_out outputs. Timing uses the same counters as hpm.h; the reads
+ * are not bracketed by gem5 ROI dumps, so hundreds of timed runs do not
+ * produce hundreds of stats dumps.
+ */
+
+#include "rvv/rvv_bench.h"
+
+#include "console.h"
+#include "hpm.h"
+#include "rvv/rvv_common.h"
+#include "rvv/rvv_detect.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Platform Tag
+ * ============================================================================= */
+
+/** Short platform name used as the first CSV/JSON field */
+#if defined(PLATFORM_QEMU_VIRT)
+#define RVV_BENCH_PLATFORM "qemu"
+#elif defined(PLATFORM_SPIKE)
+#define RVV_BENCH_PLATFORM "spike"
+#elif defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE)
+#define RVV_BENCH_PLATFORM "gem5-se"
+#elif defined(PLATFORM_GEM5)
+#define RVV_BENCH_PLATFORM "gem5-fs"
+#elif defined(PLATFORM_RENODE)
+#define RVV_BENCH_PLATFORM "renode"
+#else
+#define RVV_BENCH_PLATFORM "unknown"
+#endif
+
+/* =============================================================================
+ * Benchmark Buffers
+ * ============================================================================= */
+
+static float bench_fa[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static float bench_fb[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static float bench_fref[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static float bench_fout[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+
+static int32_t bench_ia[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static int32_t bench_ib[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static int32_t bench_iref[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static int32_t bench_iout[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+
+/** Element stride of the strided gather/scatter benchmarks */
+#define BENCH_STRIDE 4
+
+static float bench_fwide[RVV_BENCH_MAX_LEN * BENCH_STRIDE] __attribute__((aligned(64)));
+static float bench_fwide_ref[RVV_BENCH_MAX_LEN * BENCH_STRIDE] __attribute__((aligned(64)));
+static uint32_t bench_idx[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static char bench_str[RVV_BENCH_MAX_LEN + 1] __attribute__((aligned(64)));
+
+/* Narrow inputs of the mixed-precision kernels (fp16 or bf16 bit patterns) */
+static int8_t bench_qa[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static int8_t bench_qb[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+#if defined(RVV_HAVE_ZVFH) || defined(RVV_HAVE_ZVFBFWMA)
+static uint16_t bench_ha[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+static uint16_t bench_hb[RVV_BENCH_MAX_LEN] __attribute__((aligned(64)));
+#endif
+
+static float bench_dot_ref;
+static float bench_dot_out;
+
+/* Scalar results of the reductions and compare/search kernels */
+static int64_t bench_ival_ref;
+static int64_t bench_ival_out;
+static float bench_fval_ref;
+static float bench_fval_out;
+
+/** SAXPY scale factor */
+#define BENCH_SAXPY_A 1.5f
+
+/** AXPBY + clamp parameters (the clamp cuts off part of the input range) */
+#define BENCH_AXPBZ_A 0.75f
+#define BENCH_AXPBZ_B -0.5f
+#define BENCH_CLAMP_LO -2.0f
+#define BENCH_CLAMP_HI 8.0f
+
+/* =============================================================================
+ * Setup and Checks
+ * ============================================================================= */
+
+static void bench_setup_f32(size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        bench_fa[i] = (float) (i & 63) * 0.25f;
+        bench_fb[i] = (float) ((i * 7) & 31) * 0.5f;
+        bench_fref[i] = 1.0f;
+        bench_fout[i] = 1.0f;
+    }
+}
+
+static void bench_setup_i32(size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        bench_ia[i] = (int32_t) i;
+        bench_ib[i] = (int32_t) (3 * i) - 1000;
+        bench_iref[i] = 0;
+        bench_iout[i] = -1;
+    }
+}
+
+static void bench_setup_matrix(size_t dim)
+{
+    bench_setup_f32(dim * dim);
+}
+
+/* ib is a copy of ia except for its last byte, so memcmp scans all of it */
+static void bench_setup_memcmp(size_t n)
+{
+    bench_setup_i32(n);
+    for (size_t i = 0; i < n; i++) {
+        bench_ib[i] = bench_ia[i];
+    }
+    if (n > 0) {
+        bench_ib[n - 1] ^= (int32_t) 0x01000000;
+    }
+}
+
+static void bench_setup_strlen(size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        bench_str[i] = (char) ('a' + (i % 26));
+    }
+    bench_str[n] = '\0';
+}
+
+/*
+ * Wide source for the strided gather (and identical wide destinations
+ * for the strided scatter, which leaves the gaps alone), plus the
+ * permutation idx[i] = (37 * i + 11) mod n for the indexed kernels:
+ * distinct because every sweep size is a power of 2.
+ */
+static void bench_setup_gather(size_t n)
+{
+    bench_setup_f32(n);
+    for (size_t i = 0; i < n * BENCH_STRIDE; i++) {
+        bench_fwide[i] = (float) (i & 255) * 0.5f;
+        bench_fwide_ref[i] = bench_fwide[i];
+    }
+    for (size_t i = 0; i < n; i++) {
+        bench_idx[i] = (uint32_t) ((37 * i + 11) % n);
+    }
+}
+
+/* Full int8 range, different sequences for a and b */
+static void bench_setup_i8(size_t n)
+{
+    bench_setup_i32(n);
+    for (size_t i = 0; i < n; i++) {
+        bench_qa[i] = (int8_t) ((int32_t) ((i * 37) & 255) - 128);
+        bench_qb[i] = (int8_t) ((int32_t) ((i * 11 + 5) & 255) - 128);
+    }
+}
+
+static void bench_setup_matrix_i8(size_t dim)
+{
+    bench_setup_i8(dim * dim);
+}
+
+/* The float32 inputs in fp16 and bf16 (exact in both), so every format runs the same data */
+#ifdef RVV_HAVE_ZVFH
+static void bench_setup_f16(size_t n)
+{
+    bench_setup_f32(n);
+    for (size_t i = 0; i < n; i++) {
+        bench_ha[i] = rvv_f32_to_f16(bench_fa[i]);
+        bench_hb[i] = rvv_f32_to_f16(bench_fb[i]);
+    }
+}
+
+static void bench_setup_matrix_f16(size_t dim)
+{
+    bench_setup_f16(dim * dim);
+}
+#endif
+
+#ifdef RVV_HAVE_ZVFBFWMA
+static void bench_setup_bf16(size_t n)
+{
+    bench_setup_f32(n);
+    for (size_t i = 0; i < n; i++) {
+        bench_ha[i] = rvv_f32_to_bf16(bench_fa[i]);
+        bench_hb[i] = rvv_f32_to_bf16(bench_fb[i]);
+    }
+}
+
+static void bench_setup_matrix_bf16(size_t dim)
+{
+    bench_setup_bf16(dim * dim);
+}
+#endif
+
+static bool bench_check_i32(size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (bench_iref[i] != bench_iout[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bench_check_f32(size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (!rvv_float_eq(bench_fref[i], bench_fout[i], 0.01f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bench_check_matrix(size_t dim)
+{
+    for (size_t i = 0; i < dim * dim; i++) {
+        float tol = bench_fref[i] * 1e-4f;
+        if (!rvv_float_eq(bench_fref[i], bench_fout[i], tol > 0.01f ? tol : 0.01f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bench_check_matrix_i32(size_t dim)
+{
+    return bench_check_i32(dim * dim);
+}
+
+static bool bench_check_wide(size_t n)
+{
+    for (size_t i = 0; i < n * BENCH_STRIDE; i++) {
+        if (bench_fwide_ref[i] != bench_fwide[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bench_check_ival(size_t n)
+{
+    (void) n;
+    return bench_ival_ref == bench_ival_out;
+}
+
+/* Reductions compared exactly: min/max and the ordered sum are bit-identical */
+static bool bench_check_fval(size_t n)
+{
+    (void) n;
+    return bench_fval_ref == bench_fval_out;
+}
+
+static bool bench_check_dot(size_t n)
+{
+    float tol = bench_dot_ref * 1e-4f;
+
+    (void) n;
+    return rvv_float_eq(bench_dot_ref, bench_dot_out, tol > 0.01f ? tol : 0.01f);
+}
+
+/* =============================================================================
+ * Kernel Adapters
+ * ============================================================================= */
+
+static void bench_scalar_vec_add_i32(size_t n)
+{
+    scalar_vec_add_i32(bench_ia, bench_ib, bench_iref, n);
+}
+
+static void bench_rvv_vec_add_i32(size_t n)
+{
+    rvv_vec_add_i32(bench_ia, bench_ib, bench_iout, n);
+}
+
+static void bench_scalar_vec_add_f32(size_t n)
+{
+    scalar_vec_add_f32(bench_fa, bench_fb, bench_fref, n);
+}
+
+static void bench_rvv_vec_add_f32(size_t n)
+{
+    rvv_vec_add_f32(bench_fa, bench_fb, bench_fout, n);
+}
+
+static void bench_scalar_memcpy(size_t n)
+{
+    scalar_memcpy(bench_iref, bench_ia, n * sizeof(int32_t));
+}
+
+static void bench_rvv_memcpy(size_t n)
+{
+    rvv_memcpy(bench_iout, bench_ia, n * sizeof(int32_t));
+}
+
+static void bench_scalar_memset(size_t n)
+{
+    scalar_memset(bench_iref, 0x5A, n * sizeof(int32_t));
+}
+
+static void bench_rvv_memset(size_t n)
+{
+    rvv_memset(bench_iout, 0x5A, n * sizeof(int32_t));
+}
+
+static void bench_scalar_memcmp(size_t n)
+{
+    bench_ival_ref = scalar_memcmp(bench_ia, bench_ib, n * sizeof(int32_t));
+}
+
+static void bench_rvv_memcmp(size_t n)
+{
+    bench_ival_out = rvv_memcmp(bench_ia, bench_ib, n * sizeof(int32_t));
+}
+
+static void bench_scalar_strlen(size_t n)
+{
+    (void) n;
+    bench_ival_ref = (int64_t) scalar_strlen(bench_str);
+}
+
+static void bench_rvv_strlen(size_t n)
+{
+    (void) n;
+    bench_ival_out = (int64_t) rvv_strlen(bench_str);
+}
+
+static void bench_scalar_gather_strided(size_t n)
+{
+    scalar_gather_strided_f32(bench_fref, bench_fwide, BENCH_STRIDE, n);
+}
+
+static void bench_rvv_gather_strided(size_t n)
+{
+    rvv_gather_strided_f32(bench_fout, bench_fwide, BENCH_STRIDE, n);
+}
+
+static void bench_scalar_scatter_strided(size_t n)
+{
+    scalar_scatter_strided_f32(bench_fwide_ref, BENCH_STRIDE, bench_fa, n);
+}
+
+static void bench_rvv_scatter_strided(size_t n)
+{
+    rvv_scatter_strided_f32(bench_fwide, BENCH_STRIDE, bench_fa, n);
+}
+
+static void bench_scalar_gather(size_t n)
+{
+    scalar_gather_f32(bench_fref, bench_fa, bench_idx, n);
+}
+
+static void bench_rvv_gather(size_t n)
+{
+    rvv_gather_f32(bench_fout, bench_fa, bench_idx, n);
+}
+
+static void bench_scalar_scatter(size_t n)
+{
+    scalar_scatter_f32(bench_fref, bench_idx, bench_fa, n);
+}
+
+static void bench_rvv_scatter(size_t n)
+{
+    rvv_scatter_f32(bench_fout, bench_idx, bench_fa, n);
+}
+
+static void bench_scalar_dot(size_t n)
+{
+    bench_dot_ref = scalar_dot_product_f32(bench_fa, bench_fb, n);
+}
+
+static void bench_rvv_dot(size_t n)
+{
+    bench_dot_out = rvv_dot_product_f32(bench_fa, bench_fb, n);
+}
+
+static void bench_scalar_saxpy(size_t n)
+{
+    scalar_saxpy(BENCH_SAXPY_A, bench_fa, bench_fref, n);
+}
+
+static void bench_rvv_saxpy(size_t n)
+{
+    rvv_saxpy(BENCH_SAXPY_A, bench_fa, bench_fout, n);
+}
+
+static void bench_scalar_sum_i32(size_t n)
+{
+    bench_ival_ref = scalar_reduce_sum_i32(bench_ib, n);
+}
+
+static void bench_rvv_sum_i32(size_t n)
+{
+    bench_ival_out = rvv_reduce_sum_i32(bench_ib, n);
+}
+
+static void bench_scalar_min_i32(size_t n)
+{
+    bench_ival_ref = scalar_reduce_min_i32(bench_ib, n);
+}
+
+static void bench_rvv_min_i32(size_t n)
+{
+    bench_ival_out = rvv_reduce_min_i32(bench_ib, n);
+}
+
+static void bench_scalar_max_i32(size_t n)
+{
+    bench_ival_ref = scalar_reduce_max_i32(bench_ib, n);
+}
+
+static void bench_rvv_max_i32(size_t n)
+{
+    bench_ival_out = rvv_reduce_max_i32(bench_ib, n);
+}
+
+static void bench_scalar_sum_f32(size_t n)
+{
+    bench_fval_ref = scalar_reduce_sum_f32(bench_fb, n);
+}
+
+static void bench_rvv_sum_f32(size_t n)
+{
+    bench_fval_out = rvv_reduce_sum_f32(bench_fb, n);
+}
+
+static void bench_scalar_min_f32(size_t n)
+{
+    bench_fval_ref = scalar_reduce_min_f32(bench_fb, n);
+}
+
+static void bench_rvv_min_f32(size_t n)
+{
+    bench_fval_out = rvv_reduce_min_f32(bench_fb, n);
+}
+
+static void bench_scalar_max_f32(size_t n)
+{
+    bench_fval_ref = scalar_reduce_max_f32(bench_fb, n);
+}
+
+static void bench_rvv_max_f32(size_t n)
+{
+    bench_fval_out = rvv_reduce_max_f32(bench_fb, n);
+}
+
+static void bench_scalar_prefix_sum(size_t n)
+{
+    scalar_prefix_sum_i32(bench_ib, bench_iref, n);
+}
+
+static void bench_rvv_prefix_sum(size_t n)
+{
+    rvv_prefix_sum_i32(bench_ib, bench_iout, n);
+}
+
+static void bench_scalar_clamp(size_t n)
+{
+    scalar_clamp_f32(bench_fb, BENCH_CLAMP_LO, BENCH_CLAMP_HI, bench_fref, n);
+}
+
+static void bench_rvv_clamp(size_t n)
+{
+    rvv_clamp_f32(bench_fb, BENCH_CLAMP_LO, BENCH_CLAMP_HI, bench_fout, n);
+}
+
+static void bench_scalar_axpbz_clamp(size_t n)
+{
+    scalar_axpbz_clamp_f32(BENCH_AXPBZ_A, bench_fa, BENCH_AXPBZ_B, bench_fb, BENCH_CLAMP_LO,
+                           BENCH_CLAMP_HI, bench_fref, n);
+}
+
+static void bench_rvv_axpbz_clamp(size_t n)
+{
+    rvv_axpbz_clamp_f32(BENCH_AXPBZ_A, bench_fa, BENCH_AXPBZ_B, bench_fb, BENCH_CLAMP_LO,
+                        BENCH_CLAMP_HI, bench_fout, n);
+}
+
+static void bench_scalar_matmul(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    scalar_matmul_f32(bench_fa, bench_fb, bench_fref, d, d, d);
+}
+
+static void bench_rvv_matmul(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    rvv_matmul_f32(bench_fa, bench_fb, bench_fout, d, d, d);
+}
+
+static void bench_rvv_gemm(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    rvv_gemm_f32(bench_fa, bench_fb, bench_fout, d, d, d);
+}
+
+static void bench_scalar_dot_i8(size_t n)
+{
+    bench_ival_ref = scalar_dot_product_i8(bench_qa, bench_qb, n);
+}
+
+static void bench_rvv_dot_i8(size_t n)
+{
+    bench_ival_out = rvv_dot_product_i8(bench_qa, bench_qb, n);
+}
+
+static void bench_scalar_matmul_i8(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    scalar_matmul_i8(bench_qa, bench_qb, bench_iref, d, d, d);
+}
+
+static void bench_rvv_matmul_i8(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    rvv_matmul_i8(bench_qa, bench_qb, bench_iout, d, d, d);
+}
+
+#ifdef RVV_HAVE_ZVFH
+static void bench_scalar_dot_f16(size_t n)
+{
+    bench_fval_ref = scalar_dot_product_f16(bench_ha, bench_hb, n);
+}
+
+static void bench_rvv_dot_f16(size_t n)
+{
+    bench_fval_out = rvv_dot_product_f16(bench_ha, bench_hb, n);
+}
+
+static void bench_scalar_matmul_f16(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    scalar_matmul_f16(bench_ha, bench_hb, bench_fref, d, d, d);
+}
+
+static void bench_rvv_matmul_f16(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    rvv_matmul_f16(bench_ha, bench_hb, bench_fout, d, d, d);
+}
+#endif
+
+#ifdef RVV_HAVE_ZVFBFWMA
+static void bench_scalar_dot_bf16(size_t n)
+{
+    bench_fval_ref = scalar_dot_product_bf16(bench_ha, bench_hb, n);
+}
+
+static void bench_rvv_dot_bf16(size_t n)
+{
+    bench_fval_out = rvv_dot_product_bf16(bench_ha, bench_hb, n);
+}
+
+static void bench_scalar_matmul_bf16(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    scalar_matmul_bf16(bench_ha, bench_hb, bench_fref, d, d, d);
+}
+
+static void bench_rvv_matmul_bf16(size_t dim)
+{
+    uint32_t d = (uint32_t) dim;
+    rvv_matmul_bf16(bench_ha, bench_hb, bench_fout, d, d, d);
+}
+#endif
+
+/* =============================================================================
+ * Registry
+ * ============================================================================= */
+
+#ifdef RVV_BENCH_SWEEP
+static const size_t bench_vec_sizes[] = {16, 64, 256, 1024, 4096, 16384, 65536};
+static const size_t bench_mat_sizes[] = {8, 16, 32, 64, 128, 256};
+#else
+static const size_t bench_vec_sizes[] = {16, 64, 256, 1024, 4096};
+static const size_t bench_mat_sizes[] = {8, 16, 32};
+#endif
+
+#define BENCH_SIZES(a) (a), (sizeof(a) / sizeof((a)[0]))
+
+static const rvv_bench_case_t bench_registry[] = {
+    {"vec_add_i32", bench_setup_i32, bench_scalar_vec_add_i32, bench_rvv_vec_add_i32,
+     bench_check_i32, BENCH_SIZES(bench_vec_sizes)},
+    {"vec_add_f32", bench_setup_f32, bench_scalar_vec_add_f32, bench_rvv_vec_add_f32,
+     bench_check_f32, BENCH_SIZES(bench_vec_sizes)},
+    {"memcpy_i32", bench_setup_i32, bench_scalar_memcpy, bench_rvv_memcpy, bench_check_i32,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"memset_i32", bench_setup_i32, bench_scalar_memset, bench_rvv_memset, bench_check_i32,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"memcmp_i32", bench_setup_memcmp, bench_scalar_memcmp, bench_rvv_memcmp, bench_check_ival,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"strlen", bench_setup_strlen, bench_scalar_strlen, bench_rvv_strlen, bench_check_ival,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"gather_strided_f32", bench_setup_gather, bench_scalar_gather_strided,
+     bench_rvv_gather_strided, bench_check_f32, BENCH_SIZES(bench_vec_sizes)},
+    {"scatter_strided_f32", bench_setup_gather, bench_scalar_scatter_strided,
+     bench_rvv_scatter_strided, bench_check_wide, BENCH_SIZES(bench_vec_sizes)},
+    {"gather_f32", bench_setup_gather, bench_scalar_gather, bench_rvv_gather, bench_check_f32,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"scatter_f32", bench_setup_gather, bench_scalar_scatter, bench_rvv_scatter, bench_check_f32,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"dot_product_f32", bench_setup_f32, bench_scalar_dot, bench_rvv_dot, bench_check_dot,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"saxpy", bench_setup_f32, bench_scalar_saxpy, bench_rvv_saxpy, bench_check_f32,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"reduce_sum_i32", bench_setup_i32, bench_scalar_sum_i32, bench_rvv_sum_i32, bench_check_ival,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"reduce_min_i32", bench_setup_i32, bench_scalar_min_i32, bench_rvv_min_i32, bench_check_ival,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"reduce_max_i32", bench_setup_i32, bench_scalar_max_i32, bench_rvv_max_i32, bench_check_ival,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"reduce_sum_f32", bench_setup_f32, bench_scalar_sum_f32, bench_rvv_sum_f32, bench_check_fval,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"reduce_min_f32", bench_setup_f32, bench_scalar_min_f32, bench_rvv_min_f32, bench_check_fval,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"reduce_max_f32", bench_setup_f32, bench_scalar_max_f32, bench_rvv_max_f32, bench_check_fval,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"prefix_sum_i32", bench_setup_i32, bench_scalar_prefix_sum, bench_rvv_prefix_sum,
+     bench_check_i32, BENCH_SIZES(bench_vec_sizes)},
+    {"clamp_f32", bench_setup_f32, bench_scalar_clamp, bench_rvv_clamp, bench_check_f32,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"axpbz_clamp_f32", bench_setup_f32, bench_scalar_axpbz_clamp, bench_rvv_axpbz_clamp,
+     bench_check_f32, BENCH_SIZES(bench_vec_sizes)},
+    {"matmul_f32", bench_setup_matrix, bench_scalar_matmul, bench_rvv_matmul, bench_check_matrix,
+     BENCH_SIZES(bench_mat_sizes)},
+    {"gemm_f32", bench_setup_matrix, bench_scalar_matmul, bench_rvv_gemm, bench_check_matrix,
+     BENCH_SIZES(bench_mat_sizes)},
+    {"dot_product_i8", bench_setup_i8, bench_scalar_dot_i8, bench_rvv_dot_i8, bench_check_ival,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"matmul_i8", bench_setup_matrix_i8, bench_scalar_matmul_i8, bench_rvv_matmul_i8,
+     bench_check_matrix_i32, BENCH_SIZES(bench_mat_sizes)},
+#ifdef RVV_HAVE_ZVFH
+    {"dot_product_f16", bench_setup_f16, bench_scalar_dot_f16, bench_rvv_dot_f16, bench_check_fval,
+     BENCH_SIZES(bench_vec_sizes)},
+    {"matmul_f16", bench_setup_matrix_f16, bench_scalar_matmul_f16, bench_rvv_matmul_f16,
+     bench_check_matrix, BENCH_SIZES(bench_mat_sizes)},
+#endif
+#ifdef RVV_HAVE_ZVFBFWMA
+    {"dot_product_bf16", bench_setup_bf16, bench_scalar_dot_bf16, bench_rvv_dot_bf16,
+     bench_check_fval, BENCH_SIZES(bench_vec_sizes)},
+    {"matmul_bf16", bench_setup_matrix_bf16, bench_scalar_matmul_bf16, bench_rvv_matmul_bf16,
+     bench_check_matrix, BENCH_SIZES(bench_mat_sizes)},
+#endif
+};
+
+const rvv_bench_case_t *rvv_bench_registry(size_t *count)
+{
+    *count = sizeof(bench_registry) / sizeof(bench_registry[0]);
+    return bench_registry;
+}
+
+/* =============================================================================
+ * Statistics
+ * ============================================================================= */
+
+/** Sort a small array in place (insertion sort; n <= 64) */
+static void bench_sort(uint64_t *v, size_t n)
+{
+    for (size_t i = 1; i < n; i++) {
+        uint64_t key = v[i];
+        size_t j = i;
+        while (j > 0 && v[j - 1] > key) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = key;
+    }
+}
+
+/** Median of a sorted array */
+static uint64_t bench_median(const uint64_t *sorted, size_t n)
+{
+    if (n % 2 != 0) {
+        return sorted[n / 2];
+    }
+    return (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+/** Integer square root (floor) */
+static uint64_t bench_isqrt(uint64_t x)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static void bench_reduce(uint64_t *samples, size_t n, rvv_bench_stats_t *stats)
+{
+    uint64_t sum = 0;
+    uint64_t var = 0;
+
+    bench_sort(samples, n);
+    for (size_t i = 0; i < n; i++) {
+        sum += samples[i];
+    }
+
+    stats->min = samples[0];
+    stats->max = samples[n - 1];
+    stats->median = bench_median(samples, n);
+    stats->mean = sum / n;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t d = samples[i] > stats->mean ? samples[i] - stats->mean : stats->mean - samples[i];
+        var += d * d;
+    }
+    stats->stddev = bench_isqrt(var / n);
+}
+
+/* =============================================================================
+ * Measurement
+ * ============================================================================= */
+
+void rvv_bench_measure(void (*fn)(size_t n), size_t n, rvv_bench_stats_t *stats,
+                       uint64_t *instret)
+{
+    uint64_t cycles[RVV_BENCH_REPS];
+    uint64_t insts[RVV_BENCH_REPS];
+
+    for (uint32_t i = 0; i < RVV_BENCH_WARMUP; i++) {
+        fn(n);
+    }
+
+    for (uint32_t i = 0; i < RVV_BENCH_REPS; i++) {
+        uint64_t i0 = hpm_read_instret();
+        uint64_t c0 = hpm_read_cycle();
+        fn(n);
+        uint64_t c1 = hpm_read_cycle();
+        uint64_t i1 = hpm_read_instret();
+
+        cycles[i] = c1 - c0;
+        insts[i] = i1 - i0;
+    }
+
+    bench_reduce(cycles, RVV_BENCH_REPS, stats);
+    if (instret != NULL) {
+        bench_sort(insts, RVV_BENCH_REPS);
+        *instret = bench_median(insts, RVV_BENCH_REPS);
+    }
+}
+
+void rvv_bench_run(const rvv_bench_case_t *bench, size_t n, rvv_bench_result_t *result)
+{
+    *result = (rvv_bench_result_t) {0};
+    result->name = bench->name;
+    result->n = n;
+    result->has_scalar = bench->scalar != NULL;
+
+    /* One cold run of each for the correctness check */
+    bench->setup(n);
+    if (bench->scalar != NULL) {
+        bench->scalar(n);
+    }
+    bench->vector(n);
+    result->passed = bench->check == NULL || bench->check(n);
+
+    if (bench->scalar != NULL) {
+        rvv_bench_measure(bench->scalar, n, &result->scalar, &result->scalar_instret);
+        result->scalar_cycles = result->scalar.median;
+    }
+    rvv_bench_measure(bench->vector, n, &result->vector, &result->vector_instret);
+    result->vector_cycles = result->vector.median;
+}
+
+/* =============================================================================
+ * Output
+ * ============================================================================= */
+
+static void bench_emit_one(const rvv_bench_result_t *r, const char *impl,
+                           const rvv_bench_stats_t *s, uint64_t instret)
+{
+    unsigned long vlen = (unsigned long) rvv_get_vlen();
+
+#ifdef RVV_BENCH_FORMAT_CSV
+    console_printf("[BENCH-CSV] %s,%lu,%s,%s,%zu,%u,%lu,%lu,%lu,%lu,%lu,%lu,%d,%s\n",
+                   RVV_BENCH_PLATFORM, vlen, r->name, impl, r->n, (unsigned) RVV_BENCH_REPS,
+                   s->min, s->median, s->max, s->mean, s->stddev, instret, r->passed ? 1 : 0,
+                   RVV_BACKEND_NAME);
+#endif
+#ifdef RVV_BENCH_FORMAT_JSON
+    console_printf("[BENCH-JSON] {\"platform\":\"%s\",\"vlen\":%lu,\"kernel\":\"%s\","
+                   "\"impl\":\"%s\",\"n\":%zu,\"reps\":%u,",
+                   RVV_BENCH_PLATFORM, vlen, r->name, impl, r->n, (unsigned) RVV_BENCH_REPS);
+    console_printf("\"min\":%lu,\"median\":%lu,\"max\":%lu,\"mean\":%lu,\"stddev\":%lu,"
+                   "\"instret\":%lu,\"passed\":%s,\"backend\":\"%s\"}\n",
+                   s->min, s->median, s->max, s->mean, s->stddev, instret,
+                   r->passed ? "true" : "false", RVV_BACKEND_NAME);
+#endif
+}
+
+void rvv_bench_emit(const rvv_bench_result_t *result)
+{
+    if (result->has_scalar) {
+        bench_emit_one(result, "scalar", &result->scalar, result->scalar_instret);
+    }
+    bench_emit_one(result, "rvv", &result->vector, result->vector_instret);
+}
+
+uint32_t rvv_bench_run_all(void)
+{
+    size_t count;
+    const rvv_bench_case_t *benches = rvv_bench_registry(&count);
+    uint32_t failures = 0;
+
+#ifdef RVV_BENCH_FORMAT_CSV
+    console_puts("[BENCH-CSV] platform,vlen,kernel,impl,n,reps,min,median,max,mean,stddev,"
+                 "instret,passed,backend\n");
+#endif
+
+    for (size_t b = 0; b < count; b++) {
+        for (size_t s = 0; s < benches[b].num_sizes; s++) {
+            rvv_bench_result_t result;
+
+            rvv_bench_run(&benches[b], benches[b].sizes[s], &result);
+            rvv_bench_emit(&result);
+            if (!result.passed) {
+                failures++;
+            }
+        }
+    }
+
+    return failures;
+}
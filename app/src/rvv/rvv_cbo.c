@@ -0,0 +1,237 @@
+/**
+ * @file rvv_cbo.c
+ * @brief Cache-block managed streaming kernels (Zicbop prefetch, Zicboz cbo.zero)
+ *
+ * Each public function packs its arguments into a job descriptor and
+ * hands a per-chunk worker to cbo_stream(), which issues the prefetches
+ * and cbo.zero for the chunk and then runs the dispatched kernel from
+ * vec_*.c on it. The vector code is the same for both RVV backends, so
+ * this file is backend-independent.
+ */
+
+#include "rvv/rvv_cbo.h"
+
+#include "rvv/rvv_detect.h"
+
+rvv_cbo_config_t rvv_cbo = {
+    .block = 0,
+#if defined(RVV_HAVE_ZICBOP)
+    .prefetch_dist = RVV_CBO_PREFETCH_DIST,
+#else
+    .prefetch_dist = 0,
+#endif
+#if defined(RVV_HAVE_ZICBOZ)
+    .zero_dst = true,
+#else
+    .zero_dst = false,
+#endif
+};
+
+void rvv_cbo_init(void)
+{
+    size_t block = rvv_get_cbo_block_size();
+
+    /* A failed probe (nothing zeroed, odd size) must not reach the block loops */
+    if (block == 0 || (block & (block - 1)) != 0) {
+        block = RVV_CBO_BLOCK_BYTES;
+        rvv_cbo.zero_dst = false;
+    }
+    rvv_cbo.block = block;
+}
+
+/* =============================================================================
+ * Building Blocks
+ * ============================================================================= */
+
+/** Prefetch every block touching [lo, hi), clipped to end */
+static void cbo_prefetch(const uint8_t *lo, const uint8_t *hi, const uint8_t *end, bool write,
+                         size_t block)
+{
+    uintptr_t p = (uintptr_t) lo & ~(uintptr_t) (block - 1);
+    uintptr_t e = (uintptr_t) (hi < end ? hi : end);
+
+    for (; p < e; p += block) {
+        if (write) {
+            rvv_prefetch_w((const void *) p);
+        } else {
+            rvv_prefetch_r((const void *) p);
+        }
+    }
+}
+
+/** cbo.zero every block lying entirely inside [lo, hi) */
+static void cbo_zero_blocks(uint8_t *lo, uint8_t *hi, size_t block)
+{
+    uintptr_t p = ((uintptr_t) lo + block - 1) & ~(uintptr_t) (block - 1);
+    uintptr_t e = (uintptr_t) hi & ~(uintptr_t) (block - 1);
+
+    for (; p < e; p += block) {
+        rvv_cbo_zero((void *) p);
+    }
+}
+
+/* =============================================================================
+ * Chunk Driver
+ * ============================================================================= */
+
+typedef struct cbo_job cbo_job_t;
+
+struct cbo_job {
+    const uint8_t *in[2]; /**< Input streams (NULL when unused), n * esz bytes each */
+    uint8_t *out;         /**< Output stream, n * esz bytes */
+    bool out_read;        /**< The kernel also reads out (never zeroed) */
+    size_t esz;           /**< Element size in bytes */
+    float scalar;         /**< SAXPY's a */
+    void (*run)(const cbo_job_t *job, size_t lo, size_t n); /**< Kernel on [lo, lo + n) */
+};
+
+/** True when out shares a byte with one of the inputs */
+static bool cbo_out_overlaps(const cbo_job_t *job, size_t bytes)
+{
+    for (size_t s = 0; s < 2; s++) {
+        const uint8_t *in = job->in[s];
+        if (in && in < job->out + bytes && job->out < in + bytes) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Run job->run over n elements, one output chunk at a time
+ *
+ * Chunks end on output chunk boundaries (multiples of the block size),
+ * so only the first and last chunk can hold a partial block, which
+ * cbo_zero_blocks() leaves alone. Before each chunk its inputs are
+ * prefetched prefetch_dist bytes ahead and its whole output blocks are
+ * zeroed; an output that is not zeroed is prefetched for writing.
+ */
+static void cbo_stream(const cbo_job_t *job, size_t n)
+{
+    if (rvv_cbo.block == 0) {
+        rvv_cbo_init(); /* Probe once; never cbo.zero with an assumed block size */
+    }
+
+    size_t block = rvv_cbo.block;
+    size_t dist = rvv_cbo.prefetch_dist;
+    size_t chunk = RVV_CBO_CHUNK_BYTES > block ? RVV_CBO_CHUNK_BYTES : block;
+    size_t bytes = n * job->esz;
+    bool zero = rvv_cbo.zero_dst && !job->out_read && !cbo_out_overlaps(job, bytes);
+
+    /* Prologue: the first prefetch distance is ahead of no chunk */
+    if (dist) {
+        for (size_t s = 0; s < 2; s++) {
+            if (job->in[s]) {
+                cbo_prefetch(job->in[s], job->in[s] + dist, job->in[s] + bytes, false, block);
+            }
+        }
+        if (!zero) {
+            cbo_prefetch(job->out, job->out + dist, job->out + bytes, true, block);
+        }
+    }
+
+    size_t done = 0;
+    while (done < n) {
+        size_t off = done * job->esz;
+        uintptr_t o = (uintptr_t) (job->out + off);
+        size_t m = (size_t) (((o | (chunk - 1)) + 1 - o) / job->esz);
+        if (m > n - done) {
+            m = n - done;
+        }
+        if (m == 0) {
+            m = 1; /* out not element-aligned: no chunk boundary to stop at */
+        }
+        size_t len = m * job->esz;
+
+        if (dist) {
+            for (size_t s = 0; s < 2; s++) {
+                if (job->in[s]) {
+                    const uint8_t *p = job->in[s] + off + dist;
+                    cbo_prefetch(p, p + len, job->in[s] + bytes, false, block);
+                }
+            }
+            if (!zero) {
+                uint8_t *p = job->out + off + dist;
+                cbo_prefetch(p, p + len, job->out + bytes, true, block);
+            }
+        }
+        if (zero) {
+            cbo_zero_blocks(job->out + off, job->out + off + len, block);
+        }
+
+        job->run(job, done, m);
+        done += m;
+    }
+}
+
+/* =============================================================================
+ * Streaming Kernels
+ * ============================================================================= */
+
+static void cbo_run_saxpy(const cbo_job_t *job, size_t lo, size_t n)
+{
+    rvv_saxpy(job->scalar, (const float *) job->in[0] + lo, (float *) job->out + lo, n);
+}
+
+static void cbo_run_add_i32(const cbo_job_t *job, size_t lo, size_t n)
+{
+    rvv_vec_add_i32((const int32_t *) job->in[0] + lo, (const int32_t *) job->in[1] + lo,
+                    (int32_t *) job->out + lo, n);
+}
+
+static void cbo_run_add_f32(const cbo_job_t *job, size_t lo, size_t n)
+{
+    rvv_vec_add_f32((const float *) job->in[0] + lo, (const float *) job->in[1] + lo,
+                    (float *) job->out + lo, n);
+}
+
+static void cbo_run_memcpy(const cbo_job_t *job, size_t lo, size_t n)
+{
+    rvv_memcpy(job->out + lo, job->in[0] + lo, n);
+}
+
+void rvv_saxpy_cbo(float a, const float *x, float *y, size_t n)
+{
+    cbo_job_t job = {
+        .in = {(const uint8_t *) x, NULL},
+        .out = (uint8_t *) y,
+        .out_read = true,
+        .esz = sizeof(float),
+        .scalar = a,
+        .run = cbo_run_saxpy,
+    };
+    cbo_stream(&job, n);
+}
+
+void rvv_vec_add_i32_cbo(const int32_t *a, const int32_t *b, int32_t *c, size_t n)
+{
+    cbo_job_t job = {
+        .in = {(const uint8_t *) a, (const uint8_t *) b},
+        .out = (uint8_t *) c,
+        .esz = sizeof(int32_t),
+        .run = cbo_run_add_i32,
+    };
+    cbo_stream(&job, n);
+}
+
+void rvv_vec_add_f32_cbo(const float *a, const float *b, float *c, size_t n)
+{
+    cbo_job_t job = {
+        .in = {(const uint8_t *) a, (const uint8_t *) b},
+        .out = (uint8_t *) c,
+        .esz = sizeof(float),
+        .run = cbo_run_add_f32,
+    };
+    cbo_stream(&job, n);
+}
+
+void rvv_memcpy_cbo(void *dst, const void *src, size_t n)
+{
+    cbo_job_t job = {
+        .in = {(const uint8_t *) src, NULL},
+        .out = (uint8_t *) dst,
+        .esz = 1,
+        .run = cbo_run_memcpy,
+    };
+    cbo_stream(&job, n);
+}
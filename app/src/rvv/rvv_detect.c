@@ -3,17 +3,99 @@
  * @brief RVV runtime detection and capability reporting
  *
  * Queries the hardware for RVV support (via misa), reads VLEN/VLENB,
- * and prints VL for various SEW/LMUL configurations.
+ * reports ELEN, the vector sub-extensions and the cache-block size, and
+ * prints VL for various SEW/LMUL configurations.
  */
 
 #include "rvv/rvv_detect.h"
 
 #include "console.h"
+#include "rvv/rvv_cbo.h"
+#include "rvv/rvv_common.h"
 
-void rvv_print_info(void)
+/* =============================================================================
+ * Sub-Extensions
+ * ============================================================================= */
+
+static const struct {
+    uint32_t bit;
+    const char *name;
+} rvv_ext_names[] = {
+    {RVV_EXT_ZVE32X, "zve32x"}, {RVV_EXT_ZVE32F, "zve32f"}, {RVV_EXT_ZVE64X, "zve64x"},
+    {RVV_EXT_ZVE64F, "zve64f"}, {RVV_EXT_ZVE64D, "zve64d"}, {RVV_EXT_ZVFH, "zvfh"},
+    {RVV_EXT_ZVFBFWMA, "zvfbfwma"}, {RVV_EXT_ZICBOP, "zicbop"}, {RVV_EXT_ZICBOZ, "zicboz"},
+};
+
+uint32_t rvv_get_extensions(void)
+{
+    if (!rvv_available()) {
+        return 0;
+    }
+
+    uint64_t misa = rvv_read_misa();
+    uint32_t ext = RVV_EXT_ZVE32X;
+
+    rvv_enable();
+    if (rvv_get_elen() >= 64) {
+        ext |= RVV_EXT_ZVE64X;
+    }
+    if (misa & MISA_F_BIT) {
+        ext |= RVV_EXT_ZVE32F;
+        if (ext & RVV_EXT_ZVE64X) {
+            ext |= RVV_EXT_ZVE64F;
+        }
+    }
+    if ((misa & MISA_D_BIT) && (ext & RVV_EXT_ZVE64F)) {
+        ext |= RVV_EXT_ZVE64D;
+    }
+
+#ifdef RVV_HAVE_ZVFH
+    ext |= RVV_EXT_ZVFH;
+#endif
+#ifdef RVV_HAVE_ZVFBFWMA
+    ext |= RVV_EXT_ZVFBFWMA;
+#endif
+#ifdef RVV_HAVE_ZICBOP
+    ext |= RVV_EXT_ZICBOP;
+#endif
+#ifdef RVV_HAVE_ZICBOZ
+    ext |= RVV_EXT_ZICBOZ;
+#endif
+    return ext;
+}
+
+/* =============================================================================
+ * Cache-Block Size
+ * ============================================================================= */
+
+size_t rvv_get_cbo_block_size(void)
 {
-    char buf[32];
+#ifdef RVV_HAVE_ZICBOZ
+    static uint8_t probe[RVV_CBO_BLOCK_MAX] __attribute__((aligned(RVV_CBO_BLOCK_MAX)));
+    volatile uint8_t *p = probe;
+
+    /* The block holding probe[0] starts at probe[0] for every size up to the alignment */
+    for (size_t i = 0; i < RVV_CBO_BLOCK_MAX; i++) {
+        p[i] = 0xff;
+    }
+    rvv_cbo_zero(probe);
+
+    size_t block = 0;
+    while (block < RVV_CBO_BLOCK_MAX && p[block] == 0) {
+        block++;
+    }
+    return block;
+#else
+    return RVV_CBO_BLOCK_BYTES;
+#endif
+}
 
+/* =============================================================================
+ * Capability Report
+ * ============================================================================= */
+
+void rvv_print_info(void)
+{
     if (!rvv_available()) {
         console_puts("[RVV] Not available (misa V-bit not set)\n");
         return;
@@ -27,15 +109,24 @@ void rvv_print_info(void)
     uint64_t vlen = rvv_get_vlen();
     uint64_t vlenb = rvv_get_vlenb();
 
-    console_puts("[RVV] VLEN  = ");
-    console_put_dec(vlen, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" bits\n");
+    console_printf("[RVV] VLEN  = %lu bits\n", vlen);
+    console_printf("[RVV] VLENB = %lu bytes\n", vlenb);
+    console_printf("[RVV] ELEN  = %lu bits\n", rvv_get_elen());
+    console_printf("[RVV] Backend = %s\n", RVV_BACKEND_NAME);
 
-    console_puts("[RVV] VLENB = ");
-    console_put_dec(vlenb, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts(" bytes\n");
+    uint32_t ext = rvv_get_extensions();
+    console_puts("[RVV] Extensions:");
+    for (size_t i = 0; i < sizeof(rvv_ext_names) / sizeof(rvv_ext_names[0]); i++) {
+        if (ext & rvv_ext_names[i].bit) {
+            console_printf(" %s", rvv_ext_names[i].name);
+        }
+    }
+    console_puts("\n");
+#ifdef RVV_HAVE_ZICBOZ
+    console_printf("[RVV] CBO block = %zu bytes (measured)\n", rvv_get_cbo_block_size());
+#else
+    console_printf("[RVV] CBO block = %zu bytes (assumed)\n", rvv_get_cbo_block_size());
+#endif
 
     /* Query VL for various SEW/LMUL combinations using vsetvli */
     size_t vl;
@@ -43,29 +134,17 @@ void rvv_print_info(void)
 
     /* e8, m1: VL = VLEN/8 */
     __asm__ __volatile__("vsetvli %0, %1, e8, m1, ta, ma" : "=r"(vl) : "r"(avl));
-    console_puts("[RVV] VL(e8,m1)   = ");
-    console_put_dec((uint64_t) vl, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("\n");
+    console_printf("[RVV] VL(e8,m1)   = %zu\n", vl);
 
     /* e32, m1: VL = VLEN/32 */
     __asm__ __volatile__("vsetvli %0, %1, e32, m1, ta, ma" : "=r"(vl) : "r"(avl));
-    console_puts("[RVV] VL(e32,m1)  = ");
-    console_put_dec((uint64_t) vl, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("\n");
+    console_printf("[RVV] VL(e32,m1)  = %zu\n", vl);
 
     /* e32, m4: VL = 4*VLEN/32 */
     __asm__ __volatile__("vsetvli %0, %1, e32, m4, ta, ma" : "=r"(vl) : "r"(avl));
-    console_puts("[RVV] VL(e32,m4)  = ");
-    console_put_dec((uint64_t) vl, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("\n");
+    console_printf("[RVV] VL(e32,m4)  = %zu\n", vl);
 
     /* e64, m1: VL = VLEN/64 */
     __asm__ __volatile__("vsetvli %0, %1, e64, m1, ta, ma" : "=r"(vl) : "r"(avl));
-    console_puts("[RVV] VL(e64,m1)  = ");
-    console_put_dec((uint64_t) vl, buf, sizeof(buf));
-    console_puts(buf);
-    console_puts("\n");
+    console_printf("[RVV] VL(e64,m1)  = %zu\n", vl);
 }
@@ -0,0 +1,308 @@
+/**
+ * @file rvv_dispatch.c
+ * @brief Startup selection of VLEN/LMUL-specialized kernel variants
+ *
+ * rvv_dispatch starts out on the m1 variants, so the public kernels work
+ * before rvv_dispatch_init() runs (and on a hart that never calls it).
+ * rvv_dispatch_init() replaces them with the heuristic choice for the
+ * detected VLEN and, under RVV_AUTOTUNE, with the fastest variant measured
+ * on this target.
+ */
+
+#include "rvv/rvv_dispatch.h"
+
+#include "console.h"
+#include "hpm.h"
+#include "rvv/rvv_common.h"
+#include "rvv/rvv_detect.h"
+
+/* =============================================================================
+ * Dispatch Table
+ * ============================================================================= */
+
+rvv_dispatch_t rvv_dispatch = {
+    .vec_add_i32 = rvv_vec_add_i32_m1,
+    .vec_add_f32 = rvv_vec_add_f32_m1,
+    .saxpy = rvv_saxpy_m1,
+    .dot_f32 = rvv_dot_product_f32_m1,
+    .selected = {RVV_VARIANT_M1, RVV_VARIANT_M1, RVV_VARIANT_M1, RVV_VARIANT_M1},
+    .tuned = false,
+};
+
+static const char *const variant_names[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = "m1",     [RVV_VARIANT_M2] = "m2",     [RVV_VARIANT_M4] = "m4",
+    [RVV_VARIANT_M8] = "m8",     [RVV_VARIANT_M2_X2] = "m2x2", [RVV_VARIANT_M4_X2] = "m4x2",
+};
+
+static const char *const kernel_names[RVV_KERNEL_COUNT] = {
+    [RVV_KERNEL_VEC_ADD_I32] = "vec_add_i32",
+    [RVV_KERNEL_VEC_ADD_F32] = "vec_add_f32",
+    [RVV_KERNEL_SAXPY] = "saxpy",
+    [RVV_KERNEL_DOT_F32] = "dot_f32",
+};
+
+const char *rvv_variant_name(rvv_variant_t variant)
+{
+    if ((unsigned) variant >= RVV_VARIANT_COUNT) {
+        return "?";
+    }
+    return variant_names[variant];
+}
+
+const char *rvv_kernel_name(rvv_kernel_t kernel)
+{
+    if ((unsigned) kernel >= RVV_KERNEL_COUNT) {
+        return "?";
+    }
+    return kernel_names[kernel];
+}
+
+bool rvv_variant_available(rvv_kernel_t kernel, rvv_variant_t variant)
+{
+    if ((unsigned) variant >= RVV_VARIANT_COUNT) {
+        return false;
+    }
+
+    switch (kernel) {
+    case RVV_KERNEL_VEC_ADD_I32:
+        return rvv_vec_add_i32_variants[variant] != NULL;
+    case RVV_KERNEL_VEC_ADD_F32:
+        return rvv_vec_add_f32_variants[variant] != NULL;
+    case RVV_KERNEL_SAXPY:
+        return rvv_saxpy_variants[variant] != NULL;
+    case RVV_KERNEL_DOT_F32:
+        return rvv_dot_f32_variants[variant] != NULL;
+    default:
+        return false;
+    }
+}
+
+bool rvv_dispatch_select(rvv_kernel_t kernel, rvv_variant_t variant)
+{
+    if (!rvv_variant_available(kernel, variant)) {
+        return false;
+    }
+
+    switch (kernel) {
+    case RVV_KERNEL_VEC_ADD_I32:
+        rvv_dispatch.vec_add_i32 = rvv_vec_add_i32_variants[variant];
+        break;
+    case RVV_KERNEL_VEC_ADD_F32:
+        rvv_dispatch.vec_add_f32 = rvv_vec_add_f32_variants[variant];
+        break;
+    case RVV_KERNEL_SAXPY:
+        rvv_dispatch.saxpy = rvv_saxpy_variants[variant];
+        break;
+    case RVV_KERNEL_DOT_F32:
+        rvv_dispatch.dot_f32 = rvv_dot_f32_variants[variant];
+        break;
+    default:
+        return false;
+    }
+
+    rvv_dispatch.selected[kernel] = variant;
+    return true;
+}
+
+/* =============================================================================
+ * Heuristic
+ * ============================================================================= */
+
+rvv_variant_t rvv_dispatch_heuristic(uint64_t vlen)
+{
+    if (vlen >= RVV_DISPATCH_STRIP_BITS) {
+        return RVV_VARIANT_M1;
+    }
+    if (vlen * 2 >= RVV_DISPATCH_STRIP_BITS) {
+        return RVV_VARIANT_M2;
+    }
+    if (vlen * 4 >= RVV_DISPATCH_STRIP_BITS) {
+        return RVV_VARIANT_M4;
+    }
+    return RVV_VARIANT_M8;
+}
+
+/* =============================================================================
+ * Autotune
+ * ============================================================================= */
+
+/* Odd length for the correctness check, so every variant runs a tail strip */
+#define AUTOTUNE_CHECK_LEN (RVV_AUTOTUNE_LEN - 3)
+
+static int32_t tune_ia[RVV_AUTOTUNE_LEN] __attribute__((aligned(64)));
+static int32_t tune_ib[RVV_AUTOTUNE_LEN] __attribute__((aligned(64)));
+static int32_t tune_ic[RVV_AUTOTUNE_LEN] __attribute__((aligned(64)));
+static int32_t tune_iref[RVV_AUTOTUNE_LEN];
+static float tune_fa[RVV_AUTOTUNE_LEN] __attribute__((aligned(64)));
+static float tune_fb[RVV_AUTOTUNE_LEN] __attribute__((aligned(64)));
+static float tune_fc[RVV_AUTOTUNE_LEN] __attribute__((aligned(64)));
+static float tune_fref[RVV_AUTOTUNE_LEN];
+
+static void tune_fill(void)
+{
+    for (size_t i = 0; i < RVV_AUTOTUNE_LEN; i++) {
+        tune_ia[i] = (int32_t) (i * 7) - 300;
+        tune_ib[i] = (int32_t) (i * 3) + 11;
+        tune_fa[i] = (float) (i % 17) * 0.25f - 2.0f;
+        tune_fb[i] = (float) (i % 13) * 0.5f + 1.0f;
+    }
+}
+
+/* Run one variant once on the tuning buffers (dot receives the dot product) */
+static void tune_run(rvv_kernel_t kernel, rvv_variant_t variant, size_t n, float *dot)
+{
+    switch (kernel) {
+    case RVV_KERNEL_VEC_ADD_I32:
+        rvv_vec_add_i32_variants[variant](tune_ia, tune_ib, tune_ic, n);
+        break;
+    case RVV_KERNEL_VEC_ADD_F32:
+        rvv_vec_add_f32_variants[variant](tune_fa, tune_fb, tune_fc, n);
+        break;
+    case RVV_KERNEL_SAXPY:
+        rvv_saxpy_variants[variant](1.5f, tune_fa, tune_fc, n);
+        break;
+    case RVV_KERNEL_DOT_F32:
+        *dot = rvv_dot_f32_variants[variant](tune_fa, tune_fb, n);
+        break;
+    default:
+        break;
+    }
+}
+
+static bool tune_check(rvv_kernel_t kernel, rvv_variant_t variant)
+{
+    const size_t n = AUTOTUNE_CHECK_LEN;
+    float dot = 0.0f;
+
+    /* Sentinel past the end catches a strip that overruns n */
+    for (size_t i = 0; i < RVV_AUTOTUNE_LEN; i++) {
+        tune_ic[i] = -1;
+        tune_fc[i] = tune_fb[i];
+        tune_fref[i] = tune_fb[i];
+    }
+
+    tune_run(kernel, variant, n, &dot);
+
+    switch (kernel) {
+    case RVV_KERNEL_VEC_ADD_I32:
+        scalar_vec_add_i32(tune_ia, tune_ib, tune_iref, n);
+        for (size_t i = 0; i < n; i++) {
+            if (tune_ic[i] != tune_iref[i]) {
+                return false;
+            }
+        }
+        return tune_ic[n] == -1;
+    case RVV_KERNEL_VEC_ADD_F32:
+        scalar_vec_add_f32(tune_fa, tune_fb, tune_fref, n);
+        break;
+    case RVV_KERNEL_SAXPY:
+        /* vfmacc is fused, the scalar reference is not: allow one rounding */
+        scalar_saxpy(1.5f, tune_fa, tune_fref, n);
+        for (size_t i = 0; i < n; i++) {
+            if (!rvv_float_eq(tune_fc[i], tune_fref[i], 1e-5f)) {
+                return false;
+            }
+        }
+        return tune_fc[n] == tune_fb[n];
+    case RVV_KERNEL_DOT_F32:
+        /* Ordered reduction: bit-identical at every LMUL */
+        return dot == scalar_dot_product_f32(tune_fa, tune_fb, n);
+    default:
+        return false;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (tune_fc[i] != tune_fref[i]) {
+            return false;
+        }
+    }
+    return tune_fc[n] == tune_fb[n];
+}
+
+static uint64_t tune_time(rvv_kernel_t kernel, rvv_variant_t variant)
+{
+    uint64_t best = UINT64_MAX;
+    float dot = 0.0f;
+
+    /* Warm-up run (I-cache, branch predictor, data already cached by the check) */
+    tune_run(kernel, variant, RVV_AUTOTUNE_LEN, &dot);
+
+    for (int rep = 0; rep < RVV_AUTOTUNE_REPS; rep++) {
+        uint64_t start = hpm_read_cycle();
+        tune_run(kernel, variant, RVV_AUTOTUNE_LEN, &dot);
+        uint64_t cycles = hpm_read_cycle() - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+
+    return best;
+}
+
+void rvv_dispatch_autotune(void)
+{
+    tune_fill();
+
+    for (int k = 0; k < RVV_KERNEL_COUNT; k++) {
+        rvv_kernel_t kernel = (rvv_kernel_t) k;
+        rvv_variant_t best = rvv_dispatch.selected[kernel];
+        uint64_t best_cycles = UINT64_MAX;
+
+        for (int v = 0; v < RVV_VARIANT_COUNT; v++) {
+            rvv_variant_t variant = (rvv_variant_t) v;
+
+            if (!rvv_variant_available(kernel, variant)) {
+                continue;
+            }
+            if (!tune_check(kernel, variant)) {
+                console_printf("[RVV] autotune %s %s: mismatch, skipped\n",
+                               rvv_kernel_name(kernel), rvv_variant_name(variant));
+                continue;
+            }
+
+            uint64_t cycles = tune_time(kernel, variant);
+            console_printf("[RVV] autotune %s %s: %lu cycles\n", rvv_kernel_name(kernel),
+                           rvv_variant_name(variant), cycles);
+            if (cycles < best_cycles) {
+                best_cycles = cycles;
+                best = variant;
+            }
+        }
+
+        rvv_dispatch_select(kernel, best);
+    }
+
+    rvv_dispatch.tuned = true;
+}
+
+/* =============================================================================
+ * Initialization
+ * ============================================================================= */
+
+void rvv_dispatch_init(void)
+{
+    uint64_t vlen = rvv_get_vlen();
+    rvv_variant_t variant = rvv_dispatch_heuristic(vlen);
+
+    for (int k = 0; k < RVV_KERNEL_COUNT; k++) {
+        rvv_kernel_t kernel = (rvv_kernel_t) k;
+        if (!rvv_dispatch_select(kernel, variant)) {
+            rvv_dispatch_select(kernel, RVV_VARIANT_M1);
+        }
+    }
+    rvv_dispatch.tuned = false;
+
+#ifdef RVV_AUTOTUNE
+    rvv_dispatch_autotune();
+#endif
+}
+
+void rvv_dispatch_print(void)
+{
+    for (int k = 0; k < RVV_KERNEL_COUNT; k++) {
+        rvv_kernel_t kernel = (rvv_kernel_t) k;
+        console_printf("[RVV] dispatch %s: %s (%s)\n", rvv_kernel_name(kernel),
+                       rvv_variant_name(rvv_dispatch.selected[kernel]),
+                       rvv_dispatch.tuned ? "autotuned" : "heuristic");
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * @file rvv_parallel.c
+ * @brief Multi-hart work-partitioned RVV kernels (SMP + Vector)
+ *
+ * Each public function packs its arguments into a job descriptor and
+ * hands a per-hart worker to smp_parallel_run(). Workers run the
+ * single-hart RVV kernels from vec_*.c on their slice, so every hart
+ * needs its own mstatus.VS enabled (smp_secondary_entry() does this).
+ */
+
+#include "rvv/rvv_parallel.h"
+
+#include "platform.h"
+#include "smp.h"
+
+/* =============================================================================
+ * Partitioning
+ * ============================================================================= */
+
+void rvv_par_range(size_t n, uint32_t hart, uint32_t nharts, size_t *lo, size_t *hi)
+{
+    size_t per = (n + nharts - 1) / nharts;
+
+    per = (per + RVV_PAR_CHUNK_ALIGN - 1) & ~(size_t) (RVV_PAR_CHUNK_ALIGN - 1);
+    *lo = (size_t) hart * per;
+    *hi = *lo + per;
+    if (*lo > n) {
+        *lo = n;
+    }
+    if (*hi > n) {
+        *hi = n;
+    }
+}
+
+/* =============================================================================
+ * Tree Reduction
+ * ============================================================================= */
+
+/**
+ * Per-hart partial sum slot, one cache line each so that publishing a
+ * partial never invalidates a neighbour's line.
+ */
+typedef struct {
+    volatile float value;
+    volatile uint32_t epoch; /**< == reduce epoch once value is final */
+    uint8_t pad[56];
+} rvv_par_slot_t;
+
+static rvv_par_slot_t rvv_par_slots[MAX_HARTS] __attribute__((aligned(64)));
+
+/** Bumped by hart 0 before each reducing job; slots match it when ready */
+static volatile uint32_t rvv_par_epoch;
+
+/** Final reduction result, written by hart 0 */
+static float rvv_par_result;
+
+/**
+ * @brief Combine per-hart partials into rvv_par_result (binary tree)
+ *
+ * Called by every participating hart with its own partial. At each level
+ * a hart either sends (publishes its running sum and stops) or receives
+ * from hart + stride. No barrier is needed: receivers spin only on their
+ * partner's slot.
+ */
+static void rvv_par_tree_reduce(uint32_t hart, uint32_t nharts, float partial)
+{
+    uint32_t epoch = rvv_par_epoch;
+
+    for (uint32_t stride = 1; stride < nharts; stride <<= 1) {
+        if (hart & stride) {
+            rvv_par_slots[hart].value = partial;
+            wmb(); /* Value before the ready flag */
+            rvv_par_slots[hart].epoch = epoch;
+            return;
+        }
+
+        uint32_t partner = hart + stride;
+        if (partner < nharts) {
+            while (rvv_par_slots[partner].epoch != epoch) {
+                /* Spin until partner publishes */
+            }
+            rmb(); /* Ready flag before the value */
+            partial += rvv_par_slots[partner].value;
+        }
+    }
+
+    /* Only hart 0 falls through every level */
+    rvv_par_result = partial;
+}
+
+/* =============================================================================
+ * Element-wise Kernels
+ * ============================================================================= */
+
+typedef struct {
+    const void *a;
+    const void *b;
+    void *c;
+    float scalar;
+    size_t n;
+} rvv_par_vec_job_t;
+
+static void par_saxpy_worker(uint32_t hart, uint32_t nharts, void *arg)
+{
+    const rvv_par_vec_job_t *job = (const rvv_par_vec_job_t *) arg;
+    const float *x = (const float *) job->a;
+    float *y = (float *) job->c;
+    size_t lo;
+    size_t hi;
+
+    rvv_par_range(job->n, hart, nharts, &lo, &hi);
+    if (hi > lo) {
+        rvv_saxpy(job->scalar, &x[lo], &y[lo], hi - lo);
+    }
+}
+
+static void par_add_i32_worker(uint32_t hart, uint32_t nharts, void *arg)
+{
+    const rvv_par_vec_job_t *job = (const rvv_par_vec_job_t *) arg;
+    const int32_t *a = (const int32_t *) job->a;
+    const int32_t *b = (const int32_t *) job->b;
+    int32_t *c = (int32_t *) job->c;
+    size_t lo;
+    size_t hi;
+
+    rvv_par_range(job->n, hart, nharts, &lo, &hi);
+    if (hi > lo) {
+        rvv_vec_add_i32(&a[lo], &b[lo], &c[lo], hi - lo);
+    }
+}
+
+static void par_add_f32_worker(uint32_t hart, uint32_t nharts, void *arg)
+{
+    const rvv_par_vec_job_t *job = (const rvv_par_vec_job_t *) arg;
+    const float *a = (const float *) job->a;
+    const float *b = (const float *) job->b;
+    float *c = (float *) job->c;
+    size_t lo;
+    size_t hi;
+
+    rvv_par_range(job->n, hart, nharts, &lo, &hi);
+    if (hi > lo) {
+        rvv_vec_add_f32(&a[lo], &b[lo], &c[lo], hi - lo);
+    }
+}
+
+static void par_dot_worker(uint32_t hart, uint32_t nharts, void *arg)
+{
+    const rvv_par_vec_job_t *job = (const rvv_par_vec_job_t *) arg;
+    const float *a = (const float *) job->a;
+    const float *b = (const float *) job->b;
+    float partial = 0.0f;
+    size_t lo;
+    size_t hi;
+
+    rvv_par_range(job->n, hart, nharts, &lo, &hi);
+    if (hi > lo) {
+        partial = rvv_dot_product_f32(&a[lo], &b[lo], hi - lo);
+    }
+    rvv_par_tree_reduce(hart, nharts, partial);
+}
+
+void rvv_par_saxpy(float a, const float *x, float *y, size_t n, uint32_t nharts)
+{
+    rvv_par_vec_job_t job = {x, NULL, y, a, n};
+    smp_parallel_run(par_saxpy_worker, &job, nharts);
+}
+
+void rvv_par_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n,
+                         uint32_t nharts)
+{
+    rvv_par_vec_job_t job = {a, b, c, 0.0f, n};
+    smp_parallel_run(par_add_i32_worker, &job, nharts);
+}
+
+void rvv_par_vec_add_f32(const float *a, const float *b, float *c, size_t n, uint32_t nharts)
+{
+    rvv_par_vec_job_t job = {a, b, c, 0.0f, n};
+    smp_parallel_run(par_add_f32_worker, &job, nharts);
+}
+
+float rvv_par_dot_product_f32(const float *a, const float *b, size_t n, uint32_t nharts)
+{
+    rvv_par_vec_job_t job = {a, b, NULL, 0.0f, n};
+
+    rvv_par_epoch = rvv_par_epoch + 1;
+    smp_parallel_run(par_dot_worker, &job, nharts);
+    return rvv_par_result;
+}
+
+/* =============================================================================
+ * Matrix Multiply
+ * ============================================================================= */
+
+typedef struct {
+    const float *A;
+    const float *B;
+    float *C;
+    uint32_t m;
+    uint32_t n;
+    uint32_t k;
+} rvv_par_matmul_job_t;
+
+static void par_matmul_worker(uint32_t hart, uint32_t nharts, void *arg)
+{
+    const rvv_par_matmul_job_t *job = (const rvv_par_matmul_job_t *) arg;
+    uint32_t per = (job->m + nharts - 1) / nharts;
+    uint32_t r0 = hart * per;
+    uint32_t r1 = r0 + per;
+
+    if (r1 > job->m) {
+        r1 = job->m;
+    }
+    if (r0 < r1) {
+        rvv_matmul_f32(&job->A[r0 * job->k], job->B, &job->C[r0 * job->n], r1 - r0, job->n,
+                       job->k);
+    }
+}
+
+void rvv_par_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n,
+                        uint32_t k, uint32_t nharts)
+{
+    rvv_par_matmul_job_t job = {A, B, C, m, n, k};
+    smp_parallel_run(par_matmul_worker, &job, nharts);
+}
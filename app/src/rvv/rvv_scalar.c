@@ -0,0 +1,312 @@
+/**
+ * @file rvv_scalar.c
+ * @brief Scalar reference implementations of the rvv_common.h kernels
+ *
+ * Plain C loops used as the correctness and speed baseline for every RVV
+ * kernel. They live apart from the kernels so the inline-asm and the
+ * intrinsics backends (RVV_BACKEND) are checked against the same code.
+ */
+
+#include "rvv/rvv_common.h"
+
+/* =============================================================================
+ * Level 1: Basic Vector Operations
+ * ============================================================================= */
+
+void scalar_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        c[i] = a[i] + b[i];
+    }
+}
+
+void scalar_memcpy(void *dst, const void *src, size_t n)
+{
+    uint8_t *d = (uint8_t *) dst;
+    const uint8_t *s = (const uint8_t *) src;
+
+    for (size_t i = 0; i < n; i++) {
+        d[i] = s[i];
+    }
+}
+
+void scalar_memset(void *dst, int c, size_t n)
+{
+    uint8_t *d = (uint8_t *) dst;
+
+    for (size_t i = 0; i < n; i++) {
+        d[i] = (uint8_t) c;
+    }
+}
+
+int scalar_memcmp(const void *a, const void *b, size_t n)
+{
+    const uint8_t *pa = (const uint8_t *) a;
+    const uint8_t *pb = (const uint8_t *) b;
+
+    for (size_t i = 0; i < n; i++) {
+        if (pa[i] != pb[i]) {
+            return (int) pa[i] - (int) pb[i];
+        }
+    }
+    return 0;
+}
+
+size_t scalar_strlen(const char *s)
+{
+    size_t n = 0;
+
+    while (s[n] != '\0') {
+        n++;
+    }
+    return n;
+}
+
+void scalar_gather_strided_f32(float *dst, const float *src, ptrdiff_t stride, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = src[(ptrdiff_t) i * stride];
+    }
+}
+
+void scalar_scatter_strided_f32(float *dst, ptrdiff_t stride, const float *src, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        dst[(ptrdiff_t) i * stride] = src[i];
+    }
+}
+
+void scalar_gather_f32(float *dst, const float *src, const uint32_t *idx, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = src[idx[i]];
+    }
+}
+
+void scalar_scatter_f32(float *dst, const uint32_t *idx, const float *src, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        dst[idx[i]] = src[i];
+    }
+}
+
+/* =============================================================================
+ * Level 2: Floating-Point Vector Operations
+ * ============================================================================= */
+
+void scalar_vec_add_f32(const float *a, const float *b, float *c, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        c[i] = a[i] + b[i];
+    }
+}
+
+float scalar_dot_product_f32(const float *a, const float *b, size_t n)
+{
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void scalar_saxpy(float a, const float *x, float *y, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        y[i] = a * x[i] + y[i];
+    }
+}
+
+/* =============================================================================
+ * Level 2: Reductions and Scans
+ * ============================================================================= */
+
+int64_t scalar_reduce_sum_i32(const int32_t *x, size_t n)
+{
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += x[i];
+    }
+    return sum;
+}
+
+int32_t scalar_reduce_min_i32(const int32_t *x, size_t n)
+{
+    int32_t m = INT32_MAX;
+    for (size_t i = 0; i < n; i++) {
+        m = x[i] < m ? x[i] : m;
+    }
+    return m;
+}
+
+int32_t scalar_reduce_max_i32(const int32_t *x, size_t n)
+{
+    int32_t m = INT32_MIN;
+    for (size_t i = 0; i < n; i++) {
+        m = x[i] > m ? x[i] : m;
+    }
+    return m;
+}
+
+float scalar_reduce_sum_f32(const float *x, size_t n)
+{
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += x[i];
+    }
+    return sum;
+}
+
+/* A NaN compares false and is skipped, like vfredmin/vfredmax */
+float scalar_reduce_min_f32(const float *x, size_t n)
+{
+    float m = __builtin_inff();
+    for (size_t i = 0; i < n; i++) {
+        m = x[i] < m ? x[i] : m;
+    }
+    return m;
+}
+
+float scalar_reduce_max_f32(const float *x, size_t n)
+{
+    float m = -__builtin_inff();
+    for (size_t i = 0; i < n; i++) {
+        m = x[i] > m ? x[i] : m;
+    }
+    return m;
+}
+
+void scalar_prefix_sum_i32(const int32_t *x, int32_t *y, size_t n)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += (uint32_t) x[i];
+        y[i] = (int32_t) sum;
+    }
+}
+
+/* =============================================================================
+ * Level 2: Fused Element-Wise Chains
+ * ============================================================================= */
+
+/* Written so a NaN becomes lo, matching vfmax.vf followed by vfmin.vf */
+static inline float clamp_f32(float v, float lo, float hi)
+{
+    v = v > lo ? v : lo;
+    return v < hi ? v : hi;
+}
+
+void scalar_clamp_f32(const float *x, float lo, float hi, float *y, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        y[i] = clamp_f32(x[i], lo, hi);
+    }
+}
+
+void scalar_axpbz_clamp_f32(float a, const float *x, float b, const float *z, float lo, float hi,
+                            float *y, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        y[i] = clamp_f32(a * x[i] + b * z[i], lo, hi);
+    }
+}
+
+/* =============================================================================
+ * Level 3: Advanced Operations
+ * ============================================================================= */
+
+void scalar_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n, uint32_t k)
+{
+    /* Zero out C */
+    for (uint32_t i = 0; i < m * n; i++) {
+        C[i] = 0.0f;
+    }
+
+    /* Standard triple-loop matrix multiply */
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t p = 0; p < k; p++) {
+            float a_ik = A[i * k + p];
+            for (uint32_t j = 0; j < n; j++) {
+                C[i * n + j] += a_ik * B[p * n + j];
+            }
+        }
+    }
+}
+
+/* =============================================================================
+ * Mixed Precision: int8, fp16 and bf16
+ * ============================================================================= */
+
+int32_t scalar_dot_product_i8(const int8_t *a, const int8_t *b, size_t n)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += (uint32_t) ((int32_t) a[i] * (int32_t) b[i]);
+    }
+    return (int32_t) sum;
+}
+
+void scalar_matmul_i8(const int8_t *A, const int8_t *B, int32_t *C, uint32_t m, uint32_t n,
+                      uint32_t k)
+{
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t j = 0; j < n; j++) {
+            uint32_t sum = 0;
+            for (uint32_t p = 0; p < k; p++) {
+                sum += (uint32_t) ((int32_t) A[i * k + p] * (int32_t) B[p * n + j]);
+            }
+            C[i * n + j] = (int32_t) sum;
+        }
+    }
+}
+
+/* fp16 and bf16 products are exact in float32, so only the sums round */
+float scalar_dot_product_f16(const rvv_f16_t *a, const rvv_f16_t *b, size_t n)
+{
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += rvv_f16_to_f32(a[i]) * rvv_f16_to_f32(b[i]);
+    }
+    return sum;
+}
+
+void scalar_matmul_f16(const rvv_f16_t *A, const rvv_f16_t *B, float *C, uint32_t m, uint32_t n,
+                       uint32_t k)
+{
+    for (uint32_t i = 0; i < m * n; i++) {
+        C[i] = 0.0f;
+    }
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t p = 0; p < k; p++) {
+            float a_ik = rvv_f16_to_f32(A[i * k + p]);
+            for (uint32_t j = 0; j < n; j++) {
+                C[i * n + j] += a_ik * rvv_f16_to_f32(B[p * n + j]);
+            }
+        }
+    }
+}
+
+float scalar_dot_product_bf16(const rvv_bf16_t *a, const rvv_bf16_t *b, size_t n)
+{
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += rvv_bf16_to_f32(a[i]) * rvv_bf16_to_f32(b[i]);
+    }
+    return sum;
+}
+
+void scalar_matmul_bf16(const rvv_bf16_t *A, const rvv_bf16_t *B, float *C, uint32_t m,
+                        uint32_t n, uint32_t k)
+{
+    for (uint32_t i = 0; i < m * n; i++) {
+        C[i] = 0.0f;
+    }
+    for (uint32_t i = 0; i < m; i++) {
+        for (uint32_t p = 0; p < k; p++) {
+            float a_ik = rvv_bf16_to_f32(A[i * k + p]);
+            for (uint32_t j = 0; j < n; j++) {
+                C[i * n + j] += a_ik * rvv_bf16_to_f32(B[p * n + j]);
+            }
+        }
+    }
+}
@@ -7,68 +7,102 @@
  *
  * Demonstrates: vsetvli, vle32, vadd/vfadd, vse32
  * All implementations are VLEN-agnostic (work with any VLEN).
+ *
+ * Each kernel is built in the LMUL variants listed in rvv_dispatch.h;
+ * rvv_vec_add_i32()/rvv_vec_add_f32() call the one rvv_dispatch selected.
+ * Single-strip variants use the groups v0/v8/v16 (valid up to LMUL=8).
+ * The x2 variants run two strips per iteration on v0/v4/v8 and
+ * v12/v16/v20: when the first strip consumes the rest of n, the second
+ * vsetvli yields vl=0 and its loads/stores access nothing, so the loop
+ * needs a single branch per two strips.
  */
 
 #include "rvv/rvv_common.h"
+#include "rvv/rvv_dispatch.h"
+
+/* =============================================================================
+ * Variant Generators
+ * ============================================================================= */
+
+/* One strip: c[0..vl) = a[0..vl) op b[0..vl), then advance pointers and n */
+#define VEC_ADD_STRIP(op, lmul, va, vb, vc)                                                        \
+    "vsetvli  %[vl], %[n], e32, " #lmul ", ta, ma\n\t"                                             \
+    "vle32.v  " va ", (%[a])\n\t"                                                                  \
+    "vle32.v  " vb ", (%[b])\n\t"                                                                  \
+    op "  " vc ", " va ", " vb "\n\t"                                                              \
+    "vse32.v  " vc ", (%[c])\n\t"                                                                  \
+    "slli     t0, %[vl], 2\n\t" /* vl * 4 bytes */                                                 \
+    "add      %[a], %[a], t0\n\t"                                                                  \
+    "add      %[b], %[b], t0\n\t"                                                                  \
+    "add      %[c], %[c], t0\n\t"                                                                  \
+    "sub      %[n], %[n], %[vl]\n\t"
+
+#define VEC_ADD_LOOP(strips)                                                                       \
+    size_t vl;                                                                                     \
+    __asm__ __volatile__("1:\n\t" strips "bnez     %[n], 1b\n\t"                                   \
+                         : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [c] "+r"(c), [n] "+r"(n)      \
+                         :                                                                         \
+                         : "t0", RVV_CLOBBER_V0_V23, "memory")
+
+#define DEFINE_VEC_ADD(linkage, name, type, op, lmul)                                              \
+    linkage void name(const type *a, const type *b, type *c, size_t n)                             \
+    {                                                                                              \
+        VEC_ADD_LOOP(VEC_ADD_STRIP(op, lmul, "v0", "v8", "v16"));                                  \
+    }
+
+#define DEFINE_VEC_ADD_X2(linkage, name, type, op, lmul)                                           \
+    linkage void name(const type *a, const type *b, type *c, size_t n)                             \
+    {                                                                                              \
+        VEC_ADD_LOOP(VEC_ADD_STRIP(op, lmul, "v0", "v4", "v8")                                     \
+                         VEC_ADD_STRIP(op, lmul, "v12", "v16", "v20"));                            \
+    }
 
 /* =============================================================================
  * Level 1: Integer Vector Addition
  * ============================================================================= */
 
-void rvv_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n)
-{
-    size_t vl;
-    __asm__ __volatile__("1:\n\t"
-                         "vsetvli %[vl], %[n], e32, m1, ta, ma\n\t"
-                         "vle32.v v0, (%[a])\n\t"
-                         "vle32.v v1, (%[b])\n\t"
-                         "vadd.vv v2, v0, v1\n\t"
-                         "vse32.v v2, (%[c])\n\t"
-                         "slli    t0, %[vl], 2\n\t" /* vl * 4 bytes */
-                         "add     %[a], %[a], t0\n\t"
-                         "add     %[b], %[b], t0\n\t"
-                         "add     %[c], %[c], t0\n\t"
-                         "sub     %[n], %[n], %[vl]\n\t"
-                         "bnez    %[n], 1b\n\t"
-                         : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [c] "+r"(c), [n] "+r"(n)
-                         :
-                         : "t0", "v0", "v1", "v2", "memory");
-}
+DEFINE_VEC_ADD(extern, rvv_vec_add_i32_m1, int32_t, "vadd.vv", m1)
+DEFINE_VEC_ADD(static, vec_add_i32_m2, int32_t, "vadd.vv", m2)
+DEFINE_VEC_ADD(static, vec_add_i32_m4, int32_t, "vadd.vv", m4)
+DEFINE_VEC_ADD(static, vec_add_i32_m8, int32_t, "vadd.vv", m8)
+DEFINE_VEC_ADD_X2(static, vec_add_i32_m2_x2, int32_t, "vadd.vv", m2)
+DEFINE_VEC_ADD_X2(static, vec_add_i32_m4_x2, int32_t, "vadd.vv", m4)
+
+const rvv_vec_add_i32_fn rvv_vec_add_i32_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_vec_add_i32_m1,
+    [RVV_VARIANT_M2] = vec_add_i32_m2,
+    [RVV_VARIANT_M4] = vec_add_i32_m4,
+    [RVV_VARIANT_M8] = vec_add_i32_m8,
+    [RVV_VARIANT_M2_X2] = vec_add_i32_m2_x2,
+    [RVV_VARIANT_M4_X2] = vec_add_i32_m4_x2,
+};
 
-void scalar_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n)
+void rvv_vec_add_i32(const int32_t *a, const int32_t *b, int32_t *c, size_t n)
 {
-    for (size_t i = 0; i < n; i++) {
-        c[i] = a[i] + b[i];
-    }
+    rvv_dispatch.vec_add_i32(a, b, c, n);
 }
 
 /* =============================================================================
  * Level 2: Float32 Vector Addition
  * ============================================================================= */
 
-void rvv_vec_add_f32(const float *a, const float *b, float *c, size_t n)
-{
-    size_t vl;
-    __asm__ __volatile__("1:\n\t"
-                         "vsetvli %[vl], %[n], e32, m1, ta, ma\n\t"
-                         "vle32.v v0, (%[a])\n\t"
-                         "vle32.v v1, (%[b])\n\t"
-                         "vfadd.vv v2, v0, v1\n\t"
-                         "vse32.v v2, (%[c])\n\t"
-                         "slli    t0, %[vl], 2\n\t"
-                         "add     %[a], %[a], t0\n\t"
-                         "add     %[b], %[b], t0\n\t"
-                         "add     %[c], %[c], t0\n\t"
-                         "sub     %[n], %[n], %[vl]\n\t"
-                         "bnez    %[n], 1b\n\t"
-                         : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [c] "+r"(c), [n] "+r"(n)
-                         :
-                         : "t0", "v0", "v1", "v2", "memory");
-}
+DEFINE_VEC_ADD(extern, rvv_vec_add_f32_m1, float, "vfadd.vv", m1)
+DEFINE_VEC_ADD(static, vec_add_f32_m2, float, "vfadd.vv", m2)
+DEFINE_VEC_ADD(static, vec_add_f32_m4, float, "vfadd.vv", m4)
+DEFINE_VEC_ADD(static, vec_add_f32_m8, float, "vfadd.vv", m8)
+DEFINE_VEC_ADD_X2(static, vec_add_f32_m2_x2, float, "vfadd.vv", m2)
+DEFINE_VEC_ADD_X2(static, vec_add_f32_m4_x2, float, "vfadd.vv", m4)
+
+const rvv_vec_add_f32_fn rvv_vec_add_f32_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_vec_add_f32_m1,
+    [RVV_VARIANT_M2] = vec_add_f32_m2,
+    [RVV_VARIANT_M4] = vec_add_f32_m4,
+    [RVV_VARIANT_M8] = vec_add_f32_m8,
+    [RVV_VARIANT_M2_X2] = vec_add_f32_m2_x2,
+    [RVV_VARIANT_M4_X2] = vec_add_f32_m4_x2,
+};
 
-void scalar_vec_add_f32(const float *a, const float *b, float *c, size_t n)
+void rvv_vec_add_f32(const float *a, const float *b, float *c, size_t n)
 {
-    for (size_t i = 0; i < n; i++) {
-        c[i] = a[i] + b[i];
-    }
+    rvv_dispatch.vec_add_f32(a, b, c, n);
 }
@@ -3,59 +3,134 @@
  * @brief Vector dot product using RVV
  *
  * Level 2: Float32 dot product: result = sum(a[i] * b[i])
- * Demonstrates: vfmul.vv, vfredosum (ordered FP reduction)
+ * Demonstrates: vfmul.vv, vfredosum (ordered FP reduction),
+ *               vfmacc.vv + vfredusum (unordered, reduce once)
  *
- * The reduction accumulates partial sums across the vector register
- * into a scalar result using the ordered floating-point reduction
- * instruction (vfredosum).
+ * Two reduction modes are provided:
+ *
+ * - Ordered (RVV_REDUCE_ORDERED): every strip is folded into a running
+ *   scalar with vfredosum. The additions happen in element order, so the
+ *   result is bit-identical to scalar_dot_product_f32() for any VLEN/LMUL.
+ *   The cost is a serial, long-latency reduction inside the loop.
+ *
+ * - Fast (RVV_REDUCE_FAST): each lane keeps its own partial sum in a
+ *   full-width LMUL=4 accumulator (vfmacc.vv, tail-undisturbed so the
+ *   last short strip leaves the other lanes intact), and a single
+ *   vfredusum runs after the loop. The result is deterministic for a given
+ *   VLEN but may differ in the last bits from the ordered sum.
+ *
+ * The ordered mode is built in LMUL 1/2/4/8 variants (rvv_dispatch.h) and
+ * called through rvv_dispatch; the fast mode always uses LMUL=4.
  */
 
 #include "rvv/rvv_common.h"
+#include "rvv/rvv_dispatch.h"
 
-float rvv_dot_product_f32(const float *a, const float *b, size_t n)
+/* =============================================================================
+ * Ordered Reduction Variants
+ * ============================================================================= */
+
+/*
+ * Strategy:
+ * 1. Initialize the running sum v24[0] to 0 (vsetivli with vl=1: a
+ *    vfmv.s.f under vl=0 would not write it, and n may be 0)
+ * 2. For each chunk: load a (v0), load b (v8), multiply (v16) and fold the
+ *    products into v24[0] with vfredosum
+ * 3. Extract the final scalar sum
+ *
+ * The groups v0/v8/v16 are valid up to LMUL=8; the accumulator is a
+ * single register. Not unrolled: the vfredosum chain is serial either way.
+ */
+#define DEFINE_DOT_ORDERED(linkage, name, lmul)                                                    \
+    linkage float name(const float *a, const float *b, size_t n)                                   \
+    {                                                                                              \
+        float result = 0.0f;                                                                       \
+        size_t vl;                                                                                 \
+        __asm__ __volatile__("fmv.w.x    ft0, zero\n\t"                                            \
+                             "vsetivli   zero, 1, e32, m1, ta, ma\n\t"                             \
+                             "vfmv.s.f   v24, ft0\n\t" /* v24[0] = 0.0 */                          \
+                             "1:\n\t"                                                              \
+                             "vsetvli    %[vl], %[n], e32, " #lmul ", ta, ma\n\t"                  \
+                             "vle32.v    v0, (%[a])\n\t"                                           \
+                             "vle32.v    v8, (%[b])\n\t"                                           \
+                             "vfmul.vv   v16, v0, v8\n\t"                                          \
+                             "vfredosum.vs v24, v16, v24\n\t" /* v24[0] += sum(v16) */             \
+                             "slli       t0, %[vl], 2\n\t"                                         \
+                             "add        %[a], %[a], t0\n\t"                                       \
+                             "add        %[b], %[b], t0\n\t"                                       \
+                             "sub        %[n], %[n], %[vl]\n\t"                                    \
+                             "bnez       %[n], 1b\n\t"                                             \
+                             "vfmv.f.s   %[result], v24\n\t"                                       \
+                             : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [n] "+r"(n),              \
+                               [result] "=f"(result)                                               \
+                             :                                                                     \
+                             : "t0", "ft0", RVV_CLOBBER_V0_V23, "v24", "memory");                  \
+        return result;                                                                             \
+    }
+
+DEFINE_DOT_ORDERED(extern, rvv_dot_product_f32_m1, m1)
+DEFINE_DOT_ORDERED(static, dot_product_ordered_m2, m2)
+DEFINE_DOT_ORDERED(static, dot_product_ordered_m4, m4)
+DEFINE_DOT_ORDERED(static, dot_product_ordered_m8, m8)
+
+const rvv_dot_f32_fn rvv_dot_f32_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_dot_product_f32_m1,
+    [RVV_VARIANT_M2] = dot_product_ordered_m2,
+    [RVV_VARIANT_M4] = dot_product_ordered_m4,
+    [RVV_VARIANT_M8] = dot_product_ordered_m8,
+};
+
+/* =============================================================================
+ * Fast Reduction
+ * ============================================================================= */
+
+static float dot_product_fast(const float *a, const float *b, size_t n)
 {
-    float result = 0.0f;
+    float result;
     size_t vl;
 
-    /*
-     * Strategy:
-     * 1. Initialize accumulator vector to 0
-     * 2. For each chunk: load a, load b, multiply, accumulate via reduction
-     * 3. Extract final scalar sum
-     *
-     * We use a loop that multiplies chunks and reduces them into a
-     * running scalar sum held in v4[0].
-     */
     __asm__ __volatile__(
-        /* Initialize v4 to hold the running sum (scalar 0.0) */
-        "fmv.w.x    ft0, zero\n\t"
-        "vsetvli    zero, %[n], e32, m1, ta, ma\n\t"
-        "vfmv.s.f   v4, ft0\n\t" /* v4[0] = 0.0 */
+        /* Zero the whole LMUL=4 accumulator group v8-v11 */
+        "vsetvli    t0, zero, e32, m4, ta, ma\n\t"
+        "vmv.v.i    v8, 0\n\t"
+        "beqz       %[n], 2f\n\t"
         "1:\n\t"
-        "vsetvli    %[vl], %[n], e32, m1, ta, ma\n\t"
+        "vsetvli    %[vl], %[n], e32, m4, tu, ma\n\t"
         "vle32.v    v0, (%[a])\n\t"
-        "vle32.v    v1, (%[b])\n\t"
-        "vfmul.vv   v2, v0, v1\n\t"
-        "vfredosum.vs v4, v2, v4\n\t" /* v4[0] += sum(v2) */
+        "vle32.v    v4, (%[b])\n\t"
+        "vfmacc.vv  v8, v0, v4\n\t" /* v8[i] += a[i] * b[i], lanes >= vl kept */
         "slli       t0, %[vl], 2\n\t"
         "add        %[a], %[a], t0\n\t"
         "add        %[b], %[b], t0\n\t"
         "sub        %[n], %[n], %[vl]\n\t"
         "bnez       %[n], 1b\n\t"
-        /* Extract result from v4[0] */
-        "vfmv.f.s   %[result], v4\n\t"
+        "2:\n\t"
+        /* One unordered reduction over all VLMAX lanes */
+        "vsetvli    t0, zero, e32, m4, ta, ma\n\t"
+        "vmv.s.x    v16, zero\n\t"
+        "vfredusum.vs v16, v8, v16\n\t"
+        "vfmv.f.s   %[result], v16\n\t"
         : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [n] "+r"(n), [result] "=f"(result)
         :
-        : "t0", "ft0", "v0", "v1", "v2", "v4", "memory");
+        : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8", "v9", "v10", "v11", "v16",
+          "memory");
 
     return result;
 }
 
-float scalar_dot_product_f32(const float *a, const float *b, size_t n)
+/* =============================================================================
+ * Entry Points
+ * ============================================================================= */
+
+float rvv_dot_product_f32(const float *a, const float *b, size_t n)
+{
+    return rvv_dispatch.dot_f32(a, b, n);
+}
+
+float rvv_dot_product_f32_mode(const float *a, const float *b, size_t n, rvv_reduce_mode_t mode)
 {
-    float sum = 0.0f;
-    for (size_t i = 0; i < n; i++) {
-        sum += a[i] * b[i];
+    if (mode == RVV_REDUCE_FAST) {
+        return dot_product_fast(a, b, n);
     }
-    return sum;
+    return rvv_dispatch.dot_f32(a, b, n);
 }
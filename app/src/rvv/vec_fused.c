@@ -0,0 +1,75 @@
+/**
+ * @file vec_fused.c
+ * @brief Fused element-wise chains using RVV
+ *
+ * Level 2: Multi-op element-wise pipelines in a single pass.
+ * Demonstrates: vfmul.vf + vfmacc.vf, vfmax.vf/vfmin.vf clamping
+ *
+ * Chaining the single-op kernels (scale z, rvv_saxpy, rvv_clamp_f32)
+ * writes and re-reads the intermediate array once per op. The fused
+ * kernel loads x and z once, keeps a*x + b*z in a register group through
+ * the clamp and stores y once: 3 streams per element instead of 7.
+ *
+ * rvv_clamp_f32() is also the last stage of the unfused chain, which the
+ * fused-chain test times against the fused kernel.
+ */
+
+#include "rvv/rvv_common.h"
+
+/* =============================================================================
+ * Clamp
+ * ============================================================================= */
+
+void rvv_clamp_f32(const float *x, float lo, float hi, float *y, size_t n)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz     %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli  %[vl], %[n], e32, m8, ta, ma\n\t"
+                         "vle32.v  v0, (%[x])\n\t"
+                         "vfmax.vf v0, v0, %[lo]\n\t"
+                         "vfmin.vf v0, v0, %[hi]\n\t"
+                         "vse32.v  v0, (%[y])\n\t"
+                         "slli     t0, %[vl], 2\n\t"
+                         "add      %[x], %[x], t0\n\t"
+                         "add      %[y], %[y], t0\n\t"
+                         "sub      %[n], %[n], %[vl]\n\t"
+                         "bnez     %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [x] "+r"(x), [y] "+r"(y), [n] "+r"(n)
+                         : [lo] "f"(lo), [hi] "f"(hi)
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+/* =============================================================================
+ * AXPBY + Clamp
+ * ============================================================================= */
+
+/* x in v0, z in v8, result in v16 (LMUL=8) */
+void rvv_axpbz_clamp_f32(float a, const float *x, float b, const float *z, float lo, float hi,
+                         float *y, size_t n)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz     %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli  %[vl], %[n], e32, m8, ta, ma\n\t"
+                         "vle32.v  v0, (%[x])\n\t"
+                         "vle32.v  v8, (%[z])\n\t"
+                         "vfmul.vf v16, v8, %[b]\n\t"   /* v16 = b * z */
+                         "vfmacc.vf v16, %[a], v0\n\t"  /* v16 = a * x + v16 */
+                         "vfmax.vf v16, v16, %[lo]\n\t" /* clamp below */
+                         "vfmin.vf v16, v16, %[hi]\n\t" /* clamp above */
+                         "vse32.v  v16, (%[y])\n\t"
+                         "slli     t0, %[vl], 2\n\t"
+                         "add      %[x], %[x], t0\n\t"
+                         "add      %[z], %[z], t0\n\t"
+                         "add      %[y], %[y], t0\n\t"
+                         "sub      %[n], %[n], %[vl]\n\t"
+                         "bnez     %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [x] "+r"(x), [z] "+r"(z), [y] "+r"(y), [n] "+r"(n)
+                         : [a] "f"(a), [b] "f"(b), [lo] "f"(lo), [hi] "f"(hi)
+                         : "t0", RVV_CLOBBER_V0_V23, "memory");
+}
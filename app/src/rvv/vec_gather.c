@@ -0,0 +1,113 @@
+/**
+ * @file vec_gather.c
+ * @brief Strided and indexed gather/scatter using RVV
+ *
+ * Level 1: Non-unit-stride memory access.
+ * Demonstrates: vlse32/vsse32 (constant byte stride in a scalar register),
+ *               vluxei32/vsuxei32 (per-element byte offsets in a vector)
+ *
+ * Strides are given in elements and converted to bytes once. Indices are
+ * loaded as e32, scaled to byte offsets with vsll.vi and used directly as
+ * the offset vector (zero-extended to XLEN by the unordered indexed
+ * accesses), so an index must be below 2^30. The scatter uses the
+ * unordered form: indices are required to be distinct.
+ */
+
+#include "rvv/rvv_common.h"
+
+/* =============================================================================
+ * Strided Access
+ * ============================================================================= */
+
+void rvv_gather_strided_f32(float *dst, const float *src, ptrdiff_t stride, size_t n)
+{
+    ptrdiff_t sb = stride * (ptrdiff_t) sizeof(float);
+    size_t vl;
+
+    __asm__ __volatile__("beqz     %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli  %[vl], %[n], e32, m8, ta, ma\n\t"
+                         "vlse32.v v0, (%[src]), %[sb]\n\t" /* v0[i] = src[i * stride] */
+                         "vse32.v  v0, (%[dst])\n\t"
+                         "slli     t0, %[vl], 2\n\t"
+                         "add      %[dst], %[dst], t0\n\t"
+                         "mul      t0, %[vl], %[sb]\n\t"
+                         "add      %[src], %[src], t0\n\t"
+                         "sub      %[n], %[n], %[vl]\n\t"
+                         "bnez     %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [dst] "+r"(dst), [src] "+r"(src), [n] "+r"(n)
+                         : [sb] "r"(sb)
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+void rvv_scatter_strided_f32(float *dst, ptrdiff_t stride, const float *src, size_t n)
+{
+    ptrdiff_t sb = stride * (ptrdiff_t) sizeof(float);
+    size_t vl;
+
+    __asm__ __volatile__("beqz     %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli  %[vl], %[n], e32, m8, ta, ma\n\t"
+                         "vle32.v  v0, (%[src])\n\t"
+                         "vsse32.v v0, (%[dst]), %[sb]\n\t" /* dst[i * stride] = v0[i] */
+                         "slli     t0, %[vl], 2\n\t"
+                         "add      %[src], %[src], t0\n\t"
+                         "mul      t0, %[vl], %[sb]\n\t"
+                         "add      %[dst], %[dst], t0\n\t"
+                         "sub      %[n], %[n], %[vl]\n\t"
+                         "bnez     %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [dst] "+r"(dst), [src] "+r"(src), [n] "+r"(n)
+                         : [sb] "r"(sb)
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+/* =============================================================================
+ * Indexed Access
+ * ============================================================================= */
+
+/* Data in v0, offsets in v8 (both e32, m4) */
+void rvv_gather_f32(float *dst, const float *src, const uint32_t *idx, size_t n)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz     %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli  %[vl], %[n], e32, m4, ta, ma\n\t"
+                         "vle32.v  v8, (%[idx])\n\t"
+                         "vsll.vi  v8, v8, 2\n\t"          /* element -> byte offsets */
+                         "vluxei32.v v0, (%[src]), v8\n\t" /* v0[i] = src[idx[i]] */
+                         "vse32.v  v0, (%[dst])\n\t"
+                         "slli     t0, %[vl], 2\n\t"
+                         "add      %[idx], %[idx], t0\n\t"
+                         "add      %[dst], %[dst], t0\n\t"
+                         "sub      %[n], %[n], %[vl]\n\t"
+                         "bnez     %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [dst] "+r"(dst), [idx] "+r"(idx), [n] "+r"(n)
+                         : [src] "r"(src)
+                         : "t0", "v0", "v1", "v2", "v3", "v8", "v9", "v10", "v11", "memory");
+}
+
+void rvv_scatter_f32(float *dst, const uint32_t *idx, const float *src, size_t n)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz     %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli  %[vl], %[n], e32, m4, ta, ma\n\t"
+                         "vle32.v  v0, (%[src])\n\t"
+                         "vle32.v  v8, (%[idx])\n\t"
+                         "vsll.vi  v8, v8, 2\n\t"
+                         "vsuxei32.v v0, (%[dst]), v8\n\t" /* dst[idx[i]] = v0[i] */
+                         "slli     t0, %[vl], 2\n\t"
+                         "add      %[idx], %[idx], t0\n\t"
+                         "add      %[src], %[src], t0\n\t"
+                         "sub      %[n], %[n], %[vl]\n\t"
+                         "bnez     %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [src] "+r"(src), [idx] "+r"(idx), [n] "+r"(n)
+                         : [dst] "r"(dst)
+                         : "t0", "v0", "v1", "v2", "v3", "v8", "v9", "v10", "v11", "memory");
+}
@@ -0,0 +1,188 @@
+/**
+ * @file vec_gemm.c
+ * @brief Register-blocked matrix multiplication using RVV: C = A * B
+ *
+ * Level 3: Blocked GEMM (float32)
+ * Demonstrates: register blocking, LMUL=2/4 accumulators, panel packing
+ *
+ * rvv_matmul_f32() streams the whole C[i][*] row through memory for every
+ * element of the k-loop, so it is bound by vector loads/stores. This version
+ * follows the GotoBLAS/BLIS structure instead:
+ *
+ *   for jc in 0..n step NC:                 B block  [KC x NC] -> L2
+ *     for pc in 0..k step KC:
+ *       pack B[pc.., jc..] into NR-wide column panels
+ *       for ic in 0..m step MC:             A block  [MC x KC] -> L2
+ *         pack A[ic.., pc..] into MR-tall row panels
+ *         for each NR x MR micro-tile:      C tile   [MR x NR] -> registers
+ *           k-loop: 1 vector load of B, MR scalar loads of A, MR vfmacc.vf
+ *
+ * The MR x NR tile of C lives in vector registers for the whole KC loop, so
+ * C is loaded and stored once per KC block instead of once per k. Packing
+ * makes every A and B access in the microkernel unit-stride.
+ *
+ * Two microkernels (rvv_gemm_uk.h, one implementation per RVV_BACKEND):
+ *   - 8 x m2: 8 rows of C, NR = 2 * VLEN / 32 columns
+ *   - 4 x m4: 4 rows of C, NR = 4 * VLEN / 32 columns
+ */
+
+#include "rvv/rvv_common.h"
+#include "rvv/rvv_detect.h"
+#include "rvv/rvv_gemm_uk.h"
+
+/* =============================================================================
+ * Blocking Parameters
+ * ============================================================================= */
+
+/** Depth of a packed block (k-dimension); one A/B micro-panel is ~4KB */
+#define GEMM_KC 128
+
+/** Rows of A per packed block; must be a multiple of every MR */
+#define GEMM_MC 64
+
+/** Columns of B per packed block; must be a multiple of every NR */
+#define GEMM_NC 256
+
+/** Largest MR x NR micro-tile (8 x 64 for m2, 4 x 128 for m4 at VLEN=1024) */
+#define GEMM_TILE_ELEMS 512
+
+static float gemm_a_pack[GEMM_MC * GEMM_KC] __attribute__((aligned(64)));
+static float gemm_b_pack[GEMM_KC * GEMM_NC] __attribute__((aligned(64)));
+static float gemm_tile[GEMM_TILE_ELEMS] __attribute__((aligned(64)));
+
+/* =============================================================================
+ * Packing
+ * ============================================================================= */
+
+/**
+ * @brief Pack A[i0..i0+mb-1][p0..p0+kb-1] into MR-tall row panels
+ *
+ * Layout: panel r holds rows [r*MR, r*MR+MR); within a panel the MR values
+ * of column p are contiguous. Rows past mb are zero-filled so the
+ * microkernel never needs a row-edge case.
+ */
+static void gemm_pack_a(const float *A, uint32_t lda, uint32_t i0, uint32_t mb, uint32_t p0,
+                        uint32_t kb, uint32_t mr, float *dst)
+{
+    for (uint32_t ir = 0; ir < mb; ir += mr) {
+        for (uint32_t p = 0; p < kb; p++) {
+            for (uint32_t r = 0; r < mr; r++) {
+                *dst++ = (ir + r < mb) ? A[(i0 + ir + r) * lda + p0 + p] : 0.0f;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Pack B[p0..p0+kb-1][j0..j0+nb-1] into NR-wide column panels
+ *
+ * Layout: panel j holds columns [j*NR, j*NR+w) with w = min(NR, nb - j*NR);
+ * within a panel the w values of row p are contiguous.
+ */
+static void gemm_pack_b(const float *B, uint32_t ldb, uint32_t p0, uint32_t kb, uint32_t j0,
+                        uint32_t nb, uint32_t nr, float *dst)
+{
+    for (uint32_t jr = 0; jr < nb; jr += nr) {
+        uint32_t w = (nb - jr < nr) ? nb - jr : nr;
+        for (uint32_t p = 0; p < kb; p++) {
+            const float *src = &B[(p0 + p) * ldb + j0 + jr];
+            for (uint32_t j = 0; j < w; j++) {
+                *dst++ = src[j];
+            }
+        }
+    }
+}
+
+/* =============================================================================
+ * Driver
+ * ============================================================================= */
+
+typedef void (*gemm_ukernel_fn)(const float *, const float *, size_t, float *, size_t, size_t,
+                                size_t);
+
+void rvv_gemm_f32_uk(const float *A, const float *B, float *C, uint32_t m, uint32_t n, uint32_t k,
+                     rvv_gemm_ukernel_t uk)
+{
+    gemm_ukernel_fn kernel;
+    uint32_t mr;
+    size_t vlmax;
+
+    /* VLMAX for e32 at the microkernel's LMUL: VLENB / 4 * LMUL */
+    if (uk == RVV_GEMM_UK_4X_M4) {
+        kernel = rvv_gemm_ukernel_4x_m4;
+        mr = 4;
+        vlmax = (size_t) rvv_get_vlenb();
+    } else {
+        kernel = rvv_gemm_ukernel_8x_m2;
+        mr = 8;
+        vlmax = (size_t) rvv_get_vlenb() / 2;
+    }
+
+    /* NR is one full register group, capped so an edge tile fits gemm_tile */
+    uint32_t nr = (uint32_t) vlmax;
+    if (nr > GEMM_TILE_ELEMS / mr) {
+        nr = GEMM_TILE_ELEMS / mr;
+    }
+
+    if (k == 0) {
+        for (uint32_t i = 0; i < m * n; i++) {
+            C[i] = 0.0f;
+        }
+        return;
+    }
+
+    size_t ldc = (size_t) n * sizeof(float);
+
+    for (uint32_t jc = 0; jc < n; jc += GEMM_NC) {
+        uint32_t nb = (n - jc < GEMM_NC) ? n - jc : GEMM_NC;
+
+        for (uint32_t pc = 0; pc < k; pc += GEMM_KC) {
+            uint32_t kb = (k - pc < GEMM_KC) ? k - pc : GEMM_KC;
+            size_t acc = (pc != 0);
+
+            gemm_pack_b(B, n, pc, kb, jc, nb, nr, gemm_b_pack);
+
+            for (uint32_t ic = 0; ic < m; ic += GEMM_MC) {
+                uint32_t mb = (m - ic < GEMM_MC) ? m - ic : GEMM_MC;
+
+                gemm_pack_a(A, k, ic, mb, pc, kb, mr, gemm_a_pack);
+
+                for (uint32_t jr = 0; jr < nb; jr += nr) {
+                    uint32_t w = (nb - jr < nr) ? nb - jr : nr;
+                    const float *bp = &gemm_b_pack[jr * kb];
+
+                    for (uint32_t ir = 0; ir < mb; ir += mr) {
+                        const float *ap = &gemm_a_pack[ir * kb];
+                        float *c = &C[(ic + ir) * n + jc + jr];
+                        uint32_t rows = (mb - ir < mr) ? mb - ir : mr;
+
+                        if (rows == mr) {
+                            kernel(ap, bp, kb, c, ldc, w, acc);
+                            continue;
+                        }
+
+                        /* Row edge: run the full tile on scratch, copy back valid rows */
+                        if (acc) {
+                            for (uint32_t r = 0; r < rows; r++) {
+                                for (uint32_t j = 0; j < w; j++) {
+                                    gemm_tile[r * w + j] = c[r * n + j];
+                                }
+                            }
+                        }
+                        kernel(ap, bp, kb, gemm_tile, (size_t) w * sizeof(float), w, acc);
+                        for (uint32_t r = 0; r < rows; r++) {
+                            for (uint32_t j = 0; j < w; j++) {
+                                c[r * n + j] = gemm_tile[r * w + j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void rvv_gemm_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n, uint32_t k)
+{
+    rvv_gemm_f32_uk(A, B, C, m, n, k, RVV_GEMM_UK_8X_M2);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file vec_gemm_uk.c
+ * @brief GEMM microkernels in inline assembly (RVV_BACKEND=asm)
+ *
+ * Both microkernels keep the C tile in the same 16 accumulator registers
+ * (v8-v23): eight LMUL=2 groups for 8 x m2, four LMUL=4 groups for 4 x m4.
+ * The B row is loaded into v0 and the MR A values into ft0-ft7 for each
+ * k step. See vec_gemm.c for the blocking driver.
+ */
+
+#include "rvv/rvv_gemm_uk.h"
+
+void rvv_gemm_ukernel_8x_m2(const float *ap, const float *bp, size_t kc, float *c, size_t ldc,
+                            size_t vl, size_t acc)
+{
+    size_t bstride = vl * 4;
+
+    __asm__ __volatile__("vsetvli  zero, %[vl], e32, m2, ta, ma\n\t"
+                         "mv       t1, %[c]\n\t"
+                         "beqz     %[acc], 2f\n\t"
+                         "vle32.v  v8, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v10, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v12, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v14, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v16, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v18, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v20, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v22, (t1)\n\t"
+                         "j        1f\n\t"
+                         "2:\n\t"
+                         "vmv.v.i  v8, 0\n\t"
+                         "vmv.v.i  v10, 0\n\t"
+                         "vmv.v.i  v12, 0\n\t"
+                         "vmv.v.i  v14, 0\n\t"
+                         "vmv.v.i  v16, 0\n\t"
+                         "vmv.v.i  v18, 0\n\t"
+                         "vmv.v.i  v20, 0\n\t"
+                         "vmv.v.i  v22, 0\n\t"
+                         "1:\n\t"
+                         "vle32.v  v0, (%[bp])\n\t" /* v0 = Bp[p][0..vl-1] */
+                         "flw      ft0, 0(%[ap])\n\t"
+                         "flw      ft1, 4(%[ap])\n\t"
+                         "flw      ft2, 8(%[ap])\n\t"
+                         "flw      ft3, 12(%[ap])\n\t"
+                         "flw      ft4, 16(%[ap])\n\t"
+                         "flw      ft5, 20(%[ap])\n\t"
+                         "flw      ft6, 24(%[ap])\n\t"
+                         "flw      ft7, 28(%[ap])\n\t"
+                         "vfmacc.vf v8, ft0, v0\n\t"
+                         "vfmacc.vf v10, ft1, v0\n\t"
+                         "vfmacc.vf v12, ft2, v0\n\t"
+                         "vfmacc.vf v14, ft3, v0\n\t"
+                         "vfmacc.vf v16, ft4, v0\n\t"
+                         "vfmacc.vf v18, ft5, v0\n\t"
+                         "vfmacc.vf v20, ft6, v0\n\t"
+                         "vfmacc.vf v22, ft7, v0\n\t"
+                         "addi     %[ap], %[ap], 32\n\t"
+                         "add      %[bp], %[bp], %[bstride]\n\t"
+                         "addi     %[kc], %[kc], -1\n\t"
+                         "bnez     %[kc], 1b\n\t"
+                         "mv       t1, %[c]\n\t"
+                         "vse32.v  v8, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v10, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v12, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v14, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v16, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v18, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v20, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v22, (t1)\n\t"
+                         : [ap] "+r"(ap), [bp] "+r"(bp), [kc] "+r"(kc)
+                         : [c] "r"(c), [ldc] "r"(ldc), [vl] "r"(vl), [acc] "r"(acc),
+                           [bstride] "r"(bstride)
+                         : "t1", "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7", "v0",
+                           "v1", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15", "v16", "v17",
+                           "v18", "v19", "v20", "v21", "v22", "v23", "memory");
+}
+
+void rvv_gemm_ukernel_4x_m4(const float *ap, const float *bp, size_t kc, float *c, size_t ldc,
+                            size_t vl, size_t acc)
+{
+    size_t bstride = vl * 4;
+
+    __asm__ __volatile__("vsetvli  zero, %[vl], e32, m4, ta, ma\n\t"
+                         "mv       t1, %[c]\n\t"
+                         "beqz     %[acc], 2f\n\t"
+                         "vle32.v  v8, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v12, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v16, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vle32.v  v20, (t1)\n\t"
+                         "j        1f\n\t"
+                         "2:\n\t"
+                         "vmv.v.i  v8, 0\n\t"
+                         "vmv.v.i  v12, 0\n\t"
+                         "vmv.v.i  v16, 0\n\t"
+                         "vmv.v.i  v20, 0\n\t"
+                         "1:\n\t"
+                         "vle32.v  v0, (%[bp])\n\t" /* v0 = Bp[p][0..vl-1] */
+                         "flw      ft0, 0(%[ap])\n\t"
+                         "flw      ft1, 4(%[ap])\n\t"
+                         "flw      ft2, 8(%[ap])\n\t"
+                         "flw      ft3, 12(%[ap])\n\t"
+                         "vfmacc.vf v8, ft0, v0\n\t"
+                         "vfmacc.vf v12, ft1, v0\n\t"
+                         "vfmacc.vf v16, ft2, v0\n\t"
+                         "vfmacc.vf v20, ft3, v0\n\t"
+                         "addi     %[ap], %[ap], 16\n\t"
+                         "add      %[bp], %[bp], %[bstride]\n\t"
+                         "addi     %[kc], %[kc], -1\n\t"
+                         "bnez     %[kc], 1b\n\t"
+                         "mv       t1, %[c]\n\t"
+                         "vse32.v  v8, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v12, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v16, (t1)\n\t"
+                         "add      t1, t1, %[ldc]\n\t"
+                         "vse32.v  v20, (t1)\n\t"
+                         : [ap] "+r"(ap), [bp] "+r"(bp), [kc] "+r"(kc)
+                         : [c] "r"(c), [ldc] "r"(ldc), [vl] "r"(vl), [acc] "r"(acc),
+                           [bstride] "r"(bstride)
+                         : "t1", "ft0", "ft1", "ft2", "ft3", "v0", "v1", "v2", "v3", "v8", "v9",
+                           "v10", "v11", "v12", "v13", "v14", "v15", "v16", "v17", "v18", "v19",
+                           "v20", "v21", "v22", "v23", "memory");
+}
@@ -54,21 +54,3 @@ void rvv_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32
         }
     }
 }
-
-void scalar_matmul_f32(const float *A, const float *B, float *C, uint32_t m, uint32_t n, uint32_t k)
-{
-    /* Zero out C */
-    for (uint32_t i = 0; i < m * n; i++) {
-        C[i] = 0.0f;
-    }
-
-    /* Standard triple-loop matrix multiply */
-    for (uint32_t i = 0; i < m; i++) {
-        for (uint32_t p = 0; p < k; p++) {
-            float a_ik = A[i * k + p];
-            for (uint32_t j = 0; j < n; j++) {
-                C[i * n + j] += a_ik * B[p * n + j];
-            }
-        }
-    }
-}
@@ -2,23 +2,58 @@
  * @file vec_memcpy.c
  * @brief Vectorized memory copy using RVV
  *
- * Level 1: Byte-granular memory copy using e8, m8 for maximum throughput.
- * Demonstrates: vle8, vse8, LMUL=8 for wide loads/stores.
+ * Level 1: Size-adaptive memory copy.
+ * Demonstrates: vle8/vse8 and vle64/vse64 at LMUL=8, alignment prologue,
+ *               Zihintntl non-temporal hints for streaming copies.
  *
- * The LMUL=8 configuration groups 8 vector registers together,
- * allowing each iteration to copy 8*VLEN/8 = VLEN bytes.
+ * Copy strategy by size and alignment:
+ *   n < RVV_MEM_SMALL_BYTES    scalar byte loop (cheaper than vsetvli)
+ *   n <= VLMAX(e8, m8)         one e8,m8 strip, no loop
+ *   (dst ^ src) & 7 != 0       e8,m8 loop (no common alignment to exploit)
+ *   otherwise                  scalar head to align dst to 8 bytes,
+ *                              e64,m8 bulk, scalar tail
+ *
+ * At LMUL=8 each strip moves 8*VLEN/8 = VLEN bytes. The e64 bulk path
+ * moves the same bytes per strip but as naturally aligned 64-bit
+ * elements, which many implementations handle at full bandwidth where
+ * e8 accesses are split or misaligned.
+ *
+ * Copies of RVV_MEM_STREAM_BYTES or more (and rvv_memcpy_stream())
+ * prefix each bulk load/store with ntl.all, telling the memory system
+ * the data will not be reused soon so it should not displace cached
+ * working sets. On cores without Zihintntl the hint is a no-op.
  */
 
 #include "rvv/rvv_common.h"
 
-void rvv_memcpy(void *dst, const void *src, size_t n)
+/* =============================================================================
+ * Building Blocks
+ * ============================================================================= */
+
+/** Scalar byte copy for copies shorter than one vsetvli round trip */
+static inline void copy_bytes_scalar(uint8_t *d, const uint8_t *s, size_t n)
+{
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "1:\n\t"
+                         "lbu     t0, 0(%[s])\n\t"
+                         "sb      t0, 0(%[d])\n\t"
+                         "addi    %[s], %[s], 1\n\t"
+                         "addi    %[d], %[d], 1\n\t"
+                         "addi    %[n], %[n], -1\n\t"
+                         "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [s] "+r"(s), [d] "+r"(d), [n] "+r"(n)
+                         :
+                         : "t0", "memory");
+}
+
+/** Byte-granular vector copy, LMUL=8 */
+static inline void copy_e8(uint8_t *d, const uint8_t *s, size_t n)
 {
-    // cppcheck-suppress constVariablePointer
-    uint8_t *d = (uint8_t *) dst;
-    const uint8_t *s = (const uint8_t *) src;
     size_t vl;
 
-    __asm__ __volatile__("1:\n\t"
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "1:\n\t"
                          "vsetvli %[vl], %[n], e8, m8, ta, ma\n\t"
                          "vle8.v  v0, (%[s])\n\t"
                          "vse8.v  v0, (%[d])\n\t"
@@ -26,17 +61,112 @@ void rvv_memcpy(void *dst, const void *src, size_t n)
                          "add     %[d], %[d], %[vl]\n\t"
                          "sub     %[n], %[n], %[vl]\n\t"
                          "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
                          : [vl] "=&r"(vl), [s] "+r"(s), [d] "+r"(d), [n] "+r"(n)
                          :
                          : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
 }
 
-void scalar_memcpy(void *dst, const void *src, size_t n)
+/** 64-bit element vector copy, LMUL=8; d and s 8-byte aligned */
+static inline void copy_e64(uint8_t *d, const uint8_t *s, size_t nwords)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli %[vl], %[n], e64, m8, ta, ma\n\t"
+                         "vle64.v v0, (%[s])\n\t"
+                         "vse64.v v0, (%[d])\n\t"
+                         "slli    t0, %[vl], 3\n\t"
+                         "add     %[s], %[s], t0\n\t"
+                         "add     %[d], %[d], t0\n\t"
+                         "sub     %[n], %[n], %[vl]\n\t"
+                         "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [s] "+r"(s), [d] "+r"(d), [n] "+r"(nwords)
+                         :
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+/** As copy_e64(), with an ntl.all hint (add x0, x0, x5) on every access */
+static inline void copy_e64_stream(uint8_t *d, const uint8_t *s, size_t nwords)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli %[vl], %[n], e64, m8, ta, ma\n\t"
+                         "add     x0, x0, x5\n\t" /* ntl.all */
+                         "vle64.v v0, (%[s])\n\t"
+                         "add     x0, x0, x5\n\t" /* ntl.all */
+                         "vse64.v v0, (%[d])\n\t"
+                         "slli    t0, %[vl], 3\n\t"
+                         "add     %[s], %[s], t0\n\t"
+                         "add     %[d], %[d], t0\n\t"
+                         "sub     %[n], %[n], %[vl]\n\t"
+                         "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [s] "+r"(s), [d] "+r"(d), [n] "+r"(nwords)
+                         :
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+/** VLMAX in bytes for e8,m8 (= VLEN) */
+static inline size_t vlmax_e8m8(void)
+{
+    size_t vlmax;
+    __asm__ __volatile__("vsetvli %0, zero, e8, m8, ta, ma" : "=r"(vlmax));
+    return vlmax;
+}
+
+/* =============================================================================
+ * Copy Driver
+ * ============================================================================= */
+
+static void memcpy_adaptive(void *dst, const void *src, size_t n, int stream)
 {
     uint8_t *d = (uint8_t *) dst;
     const uint8_t *s = (const uint8_t *) src;
 
-    for (size_t i = 0; i < n; i++) {
-        d[i] = s[i];
+    if (n < RVV_MEM_SMALL_BYTES) {
+        copy_bytes_scalar(d, s, n);
+        return;
+    }
+
+    if (n <= vlmax_e8m8() || ((uintptr_t) d ^ (uintptr_t) s) & 7) {
+        copy_e8(d, s, n);
+        return;
     }
+
+    /* Head: bring dst (and therefore src) up to 8-byte alignment */
+    size_t head = (size_t) (-(uintptr_t) d & 7);
+    copy_bytes_scalar(d, s, head);
+    d += head;
+    s += head;
+    n -= head;
+
+    /* Bulk: whole 64-bit words */
+    size_t nwords = n >> 3;
+    if (stream) {
+        copy_e64_stream(d, s, nwords);
+    } else {
+        copy_e64(d, s, nwords);
+    }
+
+    /* Tail: remaining 0-7 bytes */
+    copy_bytes_scalar(d + (nwords << 3), s + (nwords << 3), n & 7);
+}
+
+void rvv_memcpy(void *dst, const void *src, size_t n)
+{
+#if RVV_MEM_STREAM_BYTES > 0
+    memcpy_adaptive(dst, src, n, n >= RVV_MEM_STREAM_BYTES);
+#else
+    memcpy_adaptive(dst, src, n, 0);
+#endif
+}
+
+void rvv_memcpy_stream(void *dst, const void *src, size_t n)
+{
+    memcpy_adaptive(dst, src, n, 1);
 }
@@ -0,0 +1,144 @@
+/**
+ * @file vec_memset.c
+ * @brief Vectorized memory set using RVV
+ *
+ * Level 1: Size-adaptive memory fill, the store-only sibling of rvv_memcpy().
+ * Demonstrates: vmv.v.x splat, vse8/vse64 at LMUL=8, alignment prologue.
+ *
+ * Fill strategy by size:
+ *   n < RVV_MEM_SMALL_BYTES    scalar byte loop
+ *   n <= VLMAX(e8, m8)         one e8,m8 strip
+ *   otherwise                  scalar head to align dst to 8 bytes,
+ *                              e64,m8 bulk with the byte replicated 8x,
+ *                              scalar tail
+ *
+ * The splat is done once per call; the bulk loop is a bare vse64 stream.
+ * Fills of RVV_MEM_STREAM_BYTES or more use ntl.all store hints, like
+ * rvv_memcpy(). Startup code uses this to clear .bss.
+ */
+
+#include "rvv/rvv_common.h"
+
+/* =============================================================================
+ * Building Blocks
+ * ============================================================================= */
+
+static inline void set_bytes_scalar(uint8_t *d, uint8_t c, size_t n)
+{
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "1:\n\t"
+                         "sb      %[c], 0(%[d])\n\t"
+                         "addi    %[d], %[d], 1\n\t"
+                         "addi    %[n], %[n], -1\n\t"
+                         "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [d] "+r"(d), [n] "+r"(n)
+                         : [c] "r"(c)
+                         : "memory");
+}
+
+static inline void set_e8(uint8_t *d, uint8_t c, size_t n)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "vsetvli %[vl], %[n], e8, m8, ta, ma\n\t"
+                         "vmv.v.x v0, %[c]\n\t"
+                         "1:\n\t"
+                         "vsetvli %[vl], %[n], e8, m8, ta, ma\n\t"
+                         "vse8.v  v0, (%[d])\n\t"
+                         "add     %[d], %[d], %[vl]\n\t"
+                         "sub     %[n], %[n], %[vl]\n\t"
+                         "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [d] "+r"(d), [n] "+r"(n)
+                         : [c] "r"(c)
+                         : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+/** 64-bit element vector fill, LMUL=8; d 8-byte aligned */
+static inline void set_e64(uint8_t *d, uint64_t pattern, size_t nwords)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "vsetvli %[vl], %[n], e64, m8, ta, ma\n\t"
+                         "vmv.v.x v0, %[p]\n\t"
+                         "1:\n\t"
+                         "vsetvli %[vl], %[n], e64, m8, ta, ma\n\t"
+                         "vse64.v v0, (%[d])\n\t"
+                         "slli    t0, %[vl], 3\n\t"
+                         "add     %[d], %[d], t0\n\t"
+                         "sub     %[n], %[n], %[vl]\n\t"
+                         "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [d] "+r"(d), [n] "+r"(nwords)
+                         : [p] "r"(pattern)
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+/** As set_e64(), with an ntl.all hint (add x0, x0, x5) on every store */
+static inline void set_e64_stream(uint8_t *d, uint64_t pattern, size_t nwords)
+{
+    size_t vl;
+
+    __asm__ __volatile__("beqz    %[n], 2f\n\t"
+                         "vsetvli %[vl], %[n], e64, m8, ta, ma\n\t"
+                         "vmv.v.x v0, %[p]\n\t"
+                         "1:\n\t"
+                         "vsetvli %[vl], %[n], e64, m8, ta, ma\n\t"
+                         "add     x0, x0, x5\n\t" /* ntl.all */
+                         "vse64.v v0, (%[d])\n\t"
+                         "slli    t0, %[vl], 3\n\t"
+                         "add     %[d], %[d], t0\n\t"
+                         "sub     %[n], %[n], %[vl]\n\t"
+                         "bnez    %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [d] "+r"(d), [n] "+r"(nwords)
+                         : [p] "r"(pattern)
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "memory");
+}
+
+/* =============================================================================
+ * Fill Driver
+ * ============================================================================= */
+
+void rvv_memset(void *dst, int c, size_t n)
+{
+    uint8_t *d = (uint8_t *) dst;
+    uint8_t byte = (uint8_t) c;
+    size_t vlmax;
+
+    if (n < RVV_MEM_SMALL_BYTES) {
+        set_bytes_scalar(d, byte, n);
+        return;
+    }
+
+    __asm__ __volatile__("vsetvli %0, zero, e8, m8, ta, ma" : "=r"(vlmax));
+    if (n <= vlmax) {
+        set_e8(d, byte, n);
+        return;
+    }
+
+    /* Head: bring dst up to 8-byte alignment */
+    size_t head = (size_t) (-(uintptr_t) d & 7);
+    set_bytes_scalar(d, byte, head);
+    d += head;
+    n -= head;
+
+    /* Bulk: whole 64-bit words */
+    size_t nwords = n >> 3;
+    uint64_t pattern = (uint64_t) byte * 0x0101010101010101ULL;
+#if RVV_MEM_STREAM_BYTES > 0
+    if (n >= RVV_MEM_STREAM_BYTES) {
+        set_e64_stream(d, pattern, nwords);
+    } else {
+        set_e64(d, pattern, nwords);
+    }
+#else
+    set_e64(d, pattern, nwords);
+#endif
+
+    /* Tail: remaining 0-7 bytes */
+    set_bytes_scalar(d + (nwords << 3), byte, n & 7);
+}
@@ -0,0 +1,276 @@
+/**
+ * @file vec_mixed.c
+ * @brief Mixed-precision dot product and matrix multiply using RVV
+ *
+ * Level 2/3: int8, fp16 and bf16 inputs with 32-bit accumulation.
+ * Demonstrates: vsext.vf2 + vwmacc (int8 -> int16 -> int32),
+ *               vfwmul/vfwmacc at SEW=16 (Zvfh), vfwmaccbf16 (Zvfbfwma),
+ *               vsetvli zero, zero to switch SEW at a constant SEW/LMUL ratio
+ *
+ * Narrow elements move 2x (fp16/bf16) or 4x (int8) as many values per
+ * byte of memory traffic as float32. Every kernel widens once into a
+ * 32-bit accumulator: int8 is sign-extended to int16 so vwmacc produces
+ * exact int32 products, and fp16/bf16 products are exact in float32, so
+ * only the accumulation rounds. The float kernels accumulate in the same
+ * order as rvv_dot_product_f32() / rvv_matmul_f32() and their scalar
+ * references, and match them bit for bit.
+ *
+ * The matrix kernels keep one strip of a C row in registers across the
+ * whole k loop (B is read one row-strip per k) and store it once.
+ *
+ * The fp16 kernels need Zvfh (-DRVV_ZVFH=ON) and the bf16 kernels
+ * Zvfbfwma (-DRVV_ZVFBFWMA=ON); the int8 kernels only need V.
+ */
+
+#include "rvv/rvv_common.h"
+
+/* =============================================================================
+ * int8
+ * ============================================================================= */
+
+/* int8 strips at m2 (v0, v2), int16 at m4 (v4, v8), int32 accumulator at m8 (v16) */
+int32_t rvv_dot_product_i8(const int8_t *a, const int8_t *b, size_t n)
+{
+    int32_t result;
+    size_t vl;
+
+    __asm__ __volatile__("vsetvli    t0, zero, e32, m8, ta, ma\n\t"
+                         "vmv.v.i    v16, 0\n\t"
+                         "beqz       %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli    %[vl], %[n], e8, m2, ta, ma\n\t"
+                         "vle8.v     v0, (%[a])\n\t"
+                         "vle8.v     v2, (%[b])\n\t"
+                         "vsetvli    zero, zero, e16, m4, tu, ma\n\t"
+                         "vsext.vf2  v4, v0\n\t"
+                         "vsext.vf2  v8, v2\n\t"
+                         "vwmacc.vv  v16, v4, v8\n\t" /* v16[i] += (int32) a[i] * b[i] */
+                         "add        %[a], %[a], %[vl]\n\t"
+                         "add        %[b], %[b], %[vl]\n\t"
+                         "sub        %[n], %[n], %[vl]\n\t"
+                         "bnez       %[n], 1b\n\t"
+                         "2:\n\t"
+                         "vsetvli    t0, zero, e32, m8, ta, ma\n\t"
+                         "vmv.s.x    v24, zero\n\t"
+                         "vredsum.vs v24, v16, v24\n\t"
+                         "vmv.x.s    %[result], v24\n\t"
+                         : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [n] "+r"(n),
+                           [result] "=r"(result)
+                         :
+                         : "t0", RVV_CLOBBER_V0_V23, "v24", "memory");
+    return result;
+}
+
+/* C strip in v16 (e32, m4); B row-strip in v0 (e8, m1), widened to v2 (e16, m2) */
+void rvv_matmul_i8(const int8_t *A, const int8_t *B, int32_t *C, uint32_t m, uint32_t n,
+                   uint32_t k)
+{
+    for (uint32_t i = 0; i < m; i++) {
+        int32_t *c_row = &C[i * n];
+        const int8_t *b_col = B;
+        size_t remaining = n;
+        size_t vl;
+
+        while (remaining > 0) {
+            const int8_t *a_ik = &A[i * k];
+            const int8_t *b_pj = b_col;
+            size_t p = k;
+
+            __asm__ __volatile__("vsetvli  %[vl], %[remaining], e32, m4, ta, ma\n\t"
+                                 "vmv.v.i  v16, 0\n\t"
+                                 "beqz     %[p], 2f\n\t"
+                                 "1:\n\t"
+                                 "lb       t0, 0(%[a])\n\t" /* t0 = A[i][p] */
+                                 "vsetvli  zero, zero, e8, m1, ta, ma\n\t"
+                                 "vle8.v   v0, (%[b])\n\t" /* v0 = B[p][j..] */
+                                 "vsetvli  zero, zero, e16, m2, ta, ma\n\t"
+                                 "vsext.vf2 v2, v0\n\t"
+                                 "vwmacc.vx v16, t0, v2\n\t" /* v16 += A[i][p] * B[p][j..] */
+                                 "addi     %[a], %[a], 1\n\t"
+                                 "add      %[b], %[b], %[ldb]\n\t"
+                                 "addi     %[p], %[p], -1\n\t"
+                                 "bnez     %[p], 1b\n\t"
+                                 "2:\n\t"
+                                 "vsetvli  zero, zero, e32, m4, ta, ma\n\t"
+                                 "vse32.v  v16, (%[c])\n\t"
+                                 : [vl] "=&r"(vl), [a] "+r"(a_ik), [b] "+r"(b_pj), [p] "+r"(p)
+                                 : [remaining] "r"(remaining), [ldb] "r"((size_t) n),
+                                   [c] "r"(c_row)
+                                 : "t0", "v0", "v2", "v3", "v16", "v17", "v18", "v19", "memory");
+
+            b_col += vl;
+            c_row += vl;
+            remaining -= vl;
+        }
+    }
+}
+
+/* =============================================================================
+ * fp16 (Zvfh)
+ * ============================================================================= */
+
+#ifdef RVV_HAVE_ZVFH
+
+/* fp16 strips at m4 (v0, v4), float32 products at m8 (v8), running sum in v24[0] */
+float rvv_dot_product_f16(const rvv_f16_t *a, const rvv_f16_t *b, size_t n)
+{
+    float result;
+    size_t vl;
+
+    __asm__ __volatile__("fmv.w.x    ft0, zero\n\t"
+                         "vsetivli   zero, 1, e32, m1, ta, ma\n\t"
+                         "vfmv.s.f   v24, ft0\n\t"
+                         "beqz       %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli    %[vl], %[n], e16, m4, ta, ma\n\t"
+                         "vle16.v    v0, (%[a])\n\t"
+                         "vle16.v    v4, (%[b])\n\t"
+                         "vfwmul.vv  v8, v0, v4\n\t" /* exact float32 products */
+                         "vsetvli    zero, zero, e32, m8, ta, ma\n\t"
+                         "vfredosum.vs v24, v8, v24\n\t" /* v24[0] += sum(v8), in order */
+                         "slli       t0, %[vl], 1\n\t"
+                         "add        %[a], %[a], t0\n\t"
+                         "add        %[b], %[b], t0\n\t"
+                         "sub        %[n], %[n], %[vl]\n\t"
+                         "bnez       %[n], 1b\n\t"
+                         "2:\n\t"
+                         "vfmv.f.s   %[result], v24\n\t"
+                         : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [n] "+r"(n),
+                           [result] "=f"(result)
+                         :
+                         : "t0", "ft0", RVV_CLOBBER_V0_V23, "v24", "memory");
+    return result;
+}
+
+/* C strip in v16 (e32, m4); B row-strip in v0 (e16, m2); A[i][p] in ft0 */
+void rvv_matmul_f16(const rvv_f16_t *A, const rvv_f16_t *B, float *C, uint32_t m, uint32_t n,
+                    uint32_t k)
+{
+    size_t ldb = (size_t) n * sizeof(rvv_f16_t);
+
+    for (uint32_t i = 0; i < m; i++) {
+        float *c_row = &C[i * n];
+        const rvv_f16_t *b_col = B;
+        size_t remaining = n;
+        size_t vl;
+
+        while (remaining > 0) {
+            const rvv_f16_t *a_ik = &A[i * k];
+            const rvv_f16_t *b_pj = b_col;
+            size_t p = k;
+
+            __asm__ __volatile__("vsetvli  %[vl], %[remaining], e32, m4, ta, ma\n\t"
+                                 "vmv.v.i  v16, 0\n\t"
+                                 "beqz     %[p], 2f\n\t"
+                                 "vsetvli  zero, zero, e16, m2, ta, ma\n\t"
+                                 "1:\n\t"
+                                 "flh      ft0, 0(%[a])\n\t" /* ft0 = A[i][p] */
+                                 "vle16.v  v0, (%[b])\n\t"   /* v0 = B[p][j..] */
+                                 "vfwmacc.vf v16, ft0, v0\n\t"
+                                 "addi     %[a], %[a], 2\n\t"
+                                 "add      %[b], %[b], %[ldb]\n\t"
+                                 "addi     %[p], %[p], -1\n\t"
+                                 "bnez     %[p], 1b\n\t"
+                                 "vsetvli  zero, zero, e32, m4, ta, ma\n\t"
+                                 "2:\n\t"
+                                 "vse32.v  v16, (%[c])\n\t"
+                                 : [vl] "=&r"(vl), [a] "+r"(a_ik), [b] "+r"(b_pj), [p] "+r"(p)
+                                 : [remaining] "r"(remaining), [ldb] "r"(ldb), [c] "r"(c_row)
+                                 : "ft0", "v0", "v1", "v16", "v17", "v18", "v19", "memory");
+
+            b_col += vl;
+            c_row += vl;
+            remaining -= vl;
+        }
+    }
+}
+
+#endif /* RVV_HAVE_ZVFH */
+
+/* =============================================================================
+ * bf16 (Zvfbfwma)
+ * ============================================================================= */
+
+#ifdef RVV_HAVE_ZVFBFWMA
+
+/*
+ * bf16 strips at m4 (v0, v4). Each strip's products go into a zeroed
+ * float32 group (v8, m8) with vfwmaccbf16 (0 + exact product) and are
+ * then folded into v24[0] in element order.
+ */
+float rvv_dot_product_bf16(const rvv_bf16_t *a, const rvv_bf16_t *b, size_t n)
+{
+    float result;
+    size_t vl;
+
+    __asm__ __volatile__("fmv.w.x    ft0, zero\n\t"
+                         "vsetivli   zero, 1, e32, m1, ta, ma\n\t"
+                         "vfmv.s.f   v24, ft0\n\t"
+                         "beqz       %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli    %[vl], %[n], e32, m8, ta, ma\n\t"
+                         "vmv.v.i    v8, 0\n\t"
+                         "vsetvli    zero, zero, e16, m4, ta, ma\n\t"
+                         "vle16.v    v0, (%[a])\n\t"
+                         "vle16.v    v4, (%[b])\n\t"
+                         "vfwmaccbf16.vv v8, v0, v4\n\t" /* v8 = exact float32 products */
+                         "vsetvli    zero, zero, e32, m8, ta, ma\n\t"
+                         "vfredosum.vs v24, v8, v24\n\t"
+                         "slli       t0, %[vl], 1\n\t"
+                         "add        %[a], %[a], t0\n\t"
+                         "add        %[b], %[b], t0\n\t"
+                         "sub        %[n], %[n], %[vl]\n\t"
+                         "bnez       %[n], 1b\n\t"
+                         "2:\n\t"
+                         "vfmv.f.s   %[result], v24\n\t"
+                         : [vl] "=&r"(vl), [a] "+r"(a), [b] "+r"(b), [n] "+r"(n),
+                           [result] "=f"(result)
+                         :
+                         : "t0", "ft0", RVV_CLOBBER_V0_V23, "v24", "memory");
+    return result;
+}
+
+/* Same register layout as rvv_matmul_f16(); flh is provided by Zfbfmin */
+void rvv_matmul_bf16(const rvv_bf16_t *A, const rvv_bf16_t *B, float *C, uint32_t m, uint32_t n,
+                     uint32_t k)
+{
+    size_t ldb = (size_t) n * sizeof(rvv_bf16_t);
+
+    for (uint32_t i = 0; i < m; i++) {
+        float *c_row = &C[i * n];
+        const rvv_bf16_t *b_col = B;
+        size_t remaining = n;
+        size_t vl;
+
+        while (remaining > 0) {
+            const rvv_bf16_t *a_ik = &A[i * k];
+            const rvv_bf16_t *b_pj = b_col;
+            size_t p = k;
+
+            __asm__ __volatile__("vsetvli  %[vl], %[remaining], e32, m4, ta, ma\n\t"
+                                 "vmv.v.i  v16, 0\n\t"
+                                 "beqz     %[p], 2f\n\t"
+                                 "vsetvli  zero, zero, e16, m2, ta, ma\n\t"
+                                 "1:\n\t"
+                                 "flh      ft0, 0(%[a])\n\t"
+                                 "vle16.v  v0, (%[b])\n\t"
+                                 "vfwmaccbf16.vf v16, ft0, v0\n\t"
+                                 "addi     %[a], %[a], 2\n\t"
+                                 "add      %[b], %[b], %[ldb]\n\t"
+                                 "addi     %[p], %[p], -1\n\t"
+                                 "bnez     %[p], 1b\n\t"
+                                 "vsetvli  zero, zero, e32, m4, ta, ma\n\t"
+                                 "2:\n\t"
+                                 "vse32.v  v16, (%[c])\n\t"
+                                 : [vl] "=&r"(vl), [a] "+r"(a_ik), [b] "+r"(b_pj), [p] "+r"(p)
+                                 : [remaining] "r"(remaining), [ldb] "r"(ldb), [c] "r"(c_row)
+                                 : "ft0", "v0", "v1", "v16", "v17", "v18", "v19", "memory");
+
+            b_col += vl;
+            c_row += vl;
+            remaining -= vl;
+        }
+    }
+}
+
+#endif /* RVV_HAVE_ZVFBFWMA */
@@ -0,0 +1,213 @@
+/**
+ * @file vec_reduce.c
+ * @brief Integer and float reductions and an inclusive prefix sum using RVV
+ *
+ * Level 2: sum/min/max over int32 and float32, prefix sum over int32.
+ * Demonstrates: tail-undisturbed per-lane accumulators (vmin/vmax/vwadd.wv
+ *               with tu), vredsum/vredmin/vredmax, vfredosum,
+ *               vslideup-based in-register scan
+ *
+ * Reductions whose result does not depend on the order of operations
+ * (integer sum, min, max) keep one partial result per lane in a full
+ * LMUL=8 group and reduce once after the loop, like the fast dot product.
+ * The accumulator is tail-undisturbed so the short last strip leaves the
+ * other lanes intact. The int32 sum widens into an e64 accumulator
+ * (vwadd.wv), so it cannot overflow for any n that fits in memory.
+ *
+ * The float32 sum folds every strip into a running scalar with vfredosum,
+ * so it is bit-identical to scalar_reduce_sum_f32().
+ *
+ * The prefix sum scans each strip in log2(vl) vslideup + vadd steps and
+ * adds the carry (last element of the previous strip) to the whole strip.
+ */
+
+#include "rvv/rvv_common.h"
+
+/* =============================================================================
+ * Integer Reductions
+ * ============================================================================= */
+
+int64_t rvv_reduce_sum_i32(const int32_t *x, size_t n)
+{
+    int64_t result;
+    size_t vl;
+
+    /* v8 (e64, m8): per-lane sums of the e32, m4 strips in v0 */
+    __asm__ __volatile__("vsetvli    t0, zero, e64, m8, ta, ma\n\t"
+                         "vmv.v.i    v8, 0\n\t"
+                         "beqz       %[n], 2f\n\t"
+                         "1:\n\t"
+                         "vsetvli    %[vl], %[n], e32, m4, tu, ma\n\t"
+                         "vle32.v    v0, (%[x])\n\t"
+                         "vwadd.wv   v8, v8, v0\n\t" /* v8[i] += (int64) v0[i] */
+                         "slli       t0, %[vl], 2\n\t"
+                         "add        %[x], %[x], t0\n\t"
+                         "sub        %[n], %[n], %[vl]\n\t"
+                         "bnez       %[n], 1b\n\t"
+                         "2:\n\t"
+                         "vsetvli    t0, zero, e64, m8, ta, ma\n\t"
+                         "vmv.s.x    v16, zero\n\t"
+                         "vredsum.vs v16, v8, v16\n\t"
+                         "vmv.x.s    %[result], v16\n\t"
+                         : [vl] "=&r"(vl), [x] "+r"(x), [n] "+r"(n), [result] "=r"(result)
+                         :
+                         : "t0", RVV_CLOBBER_V0_V23, "memory");
+    return result;
+}
+
+/* Per-lane op into v8 (e32, m8), then one reduction seeded with init */
+#define DEFINE_REDUCE_I32(name, vop, redop)                                                        \
+    static int32_t name(const int32_t *x, size_t n, int32_t init)                                  \
+    {                                                                                              \
+        int32_t result;                                                                            \
+        size_t vl;                                                                                 \
+        __asm__ __volatile__("vsetvli    t0, zero, e32, m8, ta, ma\n\t"                            \
+                             "vmv.v.x    v8, %[init]\n\t"                                          \
+                             "beqz       %[n], 2f\n\t"                                             \
+                             "1:\n\t"                                                              \
+                             "vsetvli    %[vl], %[n], e32, m8, tu, ma\n\t"                         \
+                             "vle32.v    v0, (%[x])\n\t"                                           \
+                             vop "     v8, v8, v0\n\t"                                             \
+                             "slli       t0, %[vl], 2\n\t"                                         \
+                             "add        %[x], %[x], t0\n\t"                                       \
+                             "sub        %[n], %[n], %[vl]\n\t"                                    \
+                             "bnez       %[n], 1b\n\t"                                             \
+                             "2:\n\t"                                                              \
+                             "vsetvli    t0, zero, e32, m8, ta, ma\n\t"                            \
+                             "vmv.s.x    v16, %[init]\n\t"                                         \
+                             redop " v16, v8, v16\n\t"                                             \
+                             "vmv.x.s    %[result], v16\n\t"                                       \
+                             : [vl] "=&r"(vl), [x] "+r"(x), [n] "+r"(n), [result] "=r"(result)     \
+                             : [init] "r"(init)                                                    \
+                             : "t0", RVV_CLOBBER_V0_V23, "memory");                                \
+        return result;                                                                             \
+    }
+
+DEFINE_REDUCE_I32(reduce_min_i32, "vmin.vv", "vredmin.vs")
+DEFINE_REDUCE_I32(reduce_max_i32, "vmax.vv", "vredmax.vs")
+
+int32_t rvv_reduce_min_i32(const int32_t *x, size_t n)
+{
+    return reduce_min_i32(x, n, INT32_MAX);
+}
+
+int32_t rvv_reduce_max_i32(const int32_t *x, size_t n)
+{
+    return reduce_max_i32(x, n, INT32_MIN);
+}
+
+/* =============================================================================
+ * Float Reductions
+ * ============================================================================= */
+
+float rvv_reduce_sum_f32(const float *x, size_t n)
+{
+    float result;
+    size_t vl;
+
+    /* Running sum in v24[0], seeded under vl=1 because n may be 0 */
+    __asm__ __volatile__("fmv.w.x    ft0, zero\n\t"
+                         "vsetivli   zero, 1, e32, m1, ta, ma\n\t"
+                         "vfmv.s.f   v24, ft0\n\t"
+                         "1:\n\t"
+                         "vsetvli    %[vl], %[n], e32, m8, ta, ma\n\t"
+                         "vle32.v    v0, (%[x])\n\t"
+                         "vfredosum.vs v24, v0, v24\n\t" /* v24[0] += sum(v0), in order */
+                         "slli       t0, %[vl], 2\n\t"
+                         "add        %[x], %[x], t0\n\t"
+                         "sub        %[n], %[n], %[vl]\n\t"
+                         "bnez       %[n], 1b\n\t"
+                         "vfmv.f.s   %[result], v24\n\t"
+                         : [vl] "=&r"(vl), [x] "+r"(x), [n] "+r"(n), [result] "=f"(result)
+                         :
+                         : "t0", "ft0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v24",
+                           "memory");
+    return result;
+}
+
+/* Same shape as DEFINE_REDUCE_I32 with the float ops */
+#define DEFINE_REDUCE_F32(name, vop, redop)                                                        \
+    static float name(const float *x, size_t n, float init)                                        \
+    {                                                                                              \
+        float result;                                                                              \
+        size_t vl;                                                                                 \
+        __asm__ __volatile__("vsetvli    t0, zero, e32, m8, ta, ma\n\t"                            \
+                             "vfmv.v.f   v8, %[init]\n\t"                                          \
+                             "beqz       %[n], 2f\n\t"                                             \
+                             "1:\n\t"                                                              \
+                             "vsetvli    %[vl], %[n], e32, m8, tu, ma\n\t"                         \
+                             "vle32.v    v0, (%[x])\n\t"                                           \
+                             vop "    v8, v8, v0\n\t"                                              \
+                             "slli       t0, %[vl], 2\n\t"                                         \
+                             "add        %[x], %[x], t0\n\t"                                       \
+                             "sub        %[n], %[n], %[vl]\n\t"                                    \
+                             "bnez       %[n], 1b\n\t"                                             \
+                             "2:\n\t"                                                              \
+                             "vsetvli    t0, zero, e32, m8, ta, ma\n\t"                            \
+                             "vfmv.s.f   v16, %[init]\n\t"                                         \
+                             redop " v16, v8, v16\n\t"                                             \
+                             "vfmv.f.s   %[result], v16\n\t"                                       \
+                             : [vl] "=&r"(vl), [x] "+r"(x), [n] "+r"(n), [result] "=f"(result)     \
+                             : [init] "f"(init)                                                    \
+                             : "t0", RVV_CLOBBER_V0_V23, "memory");                                \
+        return result;                                                                             \
+    }
+
+DEFINE_REDUCE_F32(reduce_min_f32, "vfmin.vv", "vfredmin.vs")
+DEFINE_REDUCE_F32(reduce_max_f32, "vfmax.vv", "vfredmax.vs")
+
+float rvv_reduce_min_f32(const float *x, size_t n)
+{
+    return reduce_min_f32(x, n, __builtin_inff());
+}
+
+float rvv_reduce_max_f32(const float *x, size_t n)
+{
+    return reduce_max_f32(x, n, -__builtin_inff());
+}
+
+/* =============================================================================
+ * Prefix Sum
+ * ============================================================================= */
+
+/*
+ * Per strip (e32, m4; data in v0, shifted copy in v8):
+ *   for (off = 1; off < vl; off *= 2) v0 += (v0 slid up by off, zero-filled)
+ *   v0 += carry; store; carry = v0[vl - 1]
+ */
+void rvv_prefix_sum_i32(const int32_t *x, int32_t *y, size_t n)
+{
+    size_t vl;
+    size_t off;
+    int64_t carry = 0;
+
+    __asm__ __volatile__("beqz       %[n], 4f\n\t"
+                         "1:\n\t"
+                         "vsetvli    %[vl], %[n], e32, m4, ta, ma\n\t"
+                         "vle32.v    v0, (%[x])\n\t"
+                         "li         %[off], 1\n\t"
+                         "2:\n\t"
+                         "bgeu       %[off], %[vl], 3f\n\t"
+                         "vmv.v.i    v8, 0\n\t"
+                         "vslideup.vx v8, v0, %[off]\n\t" /* v8[i] = v0[i - off], 0 below */
+                         "vadd.vv    v0, v0, v8\n\t"
+                         "slli       %[off], %[off], 1\n\t"
+                         "j          2b\n\t"
+                         "3:\n\t"
+                         "vadd.vx    v0, v0, %[carry]\n\t"
+                         "vse32.v    v0, (%[y])\n\t"
+                         "addi       t0, %[vl], -1\n\t"
+                         "vslidedown.vx v8, v0, t0\n\t"
+                         "vmv.x.s    %[carry], v8\n\t" /* carry = y[vl - 1] */
+                         "slli       t0, %[vl], 2\n\t"
+                         "add        %[x], %[x], t0\n\t"
+                         "add        %[y], %[y], t0\n\t"
+                         "sub        %[n], %[n], %[vl]\n\t"
+                         "bnez       %[n], 1b\n\t"
+                         "4:\n\t"
+                         : [vl] "=&r"(vl), [off] "=&r"(off), [carry] "+r"(carry), [x] "+r"(x),
+                           [y] "+r"(y), [n] "+r"(n)
+                         :
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8", "v9", "v10",
+                           "v11", "memory");
+}
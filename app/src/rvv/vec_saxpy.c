@@ -7,33 +7,75 @@
  *
  * vfmacc.vf vd, rs1, vs2 computes: vd[i] = rs1 * vs2[i] + vd[i]
  * This maps directly to the SAXPY pattern.
+ *
+ * Built in the LMUL variants listed in rvv_dispatch.h; rvv_saxpy() calls
+ * the one rvv_dispatch selected.
  */
 
 #include "rvv/rvv_common.h"
+#include "rvv/rvv_dispatch.h"
 
-void rvv_saxpy(float a, const float *x, float *y, size_t n)
-{
-    size_t vl;
-
-    __asm__ __volatile__("1:\n\t"
-                         "vsetvli  %[vl], %[n], e32, m1, ta, ma\n\t"
-                         "vle32.v  v0, (%[x])\n\t"    /* v0 = x[...] */
-                         "vle32.v  v1, (%[y])\n\t"    /* v1 = y[...] */
-                         "vfmacc.vf v1, %[a], v0\n\t" /* v1 = a * v0 + v1 */
-                         "vse32.v  v1, (%[y])\n\t"    /* y[...] = v1 */
-                         "slli     t0, %[vl], 2\n\t"
-                         "add      %[x], %[x], t0\n\t"
-                         "add      %[y], %[y], t0\n\t"
-                         "sub      %[n], %[n], %[vl]\n\t"
-                         "bnez     %[n], 1b\n\t"
-                         : [vl] "=&r"(vl), [x] "+r"(x), [y] "+r"(y), [n] "+r"(n)
-                         : [a] "f"(a)
-                         : "t0", "v0", "v1", "memory");
-}
+/* =============================================================================
+ * Variant Generators
+ * ============================================================================= */
 
-void scalar_saxpy(float a, const float *x, float *y, size_t n)
-{
-    for (size_t i = 0; i < n; i++) {
-        y[i] = a * x[i] + y[i];
+/*
+ * Same register layout as vec_add.c: x in v0, y in v8 for the single-strip
+ * variants (valid up to LMUL=8); v0/v4 and v12/v16 for the x2 variants.
+ */
+
+/* One strip: y[0..vl) += a * x[0..vl), then advance pointers and n */
+#define SAXPY_STRIP(lmul, vx, vy)                                                                  \
+    "vsetvli  %[vl], %[n], e32, " #lmul ", ta, ma\n\t"                                             \
+    "vle32.v  " vx ", (%[x])\n\t"        /* vx = x[...] */                                         \
+    "vle32.v  " vy ", (%[y])\n\t"        /* vy = y[...] */                                         \
+    "vfmacc.vf " vy ", %[a], " vx "\n\t" /* vy = a * vx + vy */                                    \
+    "vse32.v  " vy ", (%[y])\n\t"        /* y[...] = vy */                                         \
+    "slli     t0, %[vl], 2\n\t"                                                                    \
+    "add      %[x], %[x], t0\n\t"                                                                  \
+    "add      %[y], %[y], t0\n\t"                                                                  \
+    "sub      %[n], %[n], %[vl]\n\t"
+
+#define SAXPY_LOOP(strips)                                                                         \
+    size_t vl;                                                                                     \
+    __asm__ __volatile__("1:\n\t" strips "bnez     %[n], 1b\n\t"                                   \
+                         : [vl] "=&r"(vl), [x] "+r"(x), [y] "+r"(y), [n] "+r"(n)                   \
+                         : [a] "f"(a)                                                              \
+                         : "t0", RVV_CLOBBER_V0_V23, "memory")
+
+#define DEFINE_SAXPY(linkage, name, lmul)                                                          \
+    linkage void name(float a, const float *x, float *y, size_t n)                                 \
+    {                                                                                              \
+        SAXPY_LOOP(SAXPY_STRIP(lmul, "v0", "v8"));                                                 \
     }
+
+#define DEFINE_SAXPY_X2(linkage, name, lmul)                                                       \
+    linkage void name(float a, const float *x, float *y, size_t n)                                 \
+    {                                                                                              \
+        SAXPY_LOOP(SAXPY_STRIP(lmul, "v0", "v4") SAXPY_STRIP(lmul, "v12", "v16"));                 \
+    }
+
+/* =============================================================================
+ * SAXPY
+ * ============================================================================= */
+
+DEFINE_SAXPY(extern, rvv_saxpy_m1, m1)
+DEFINE_SAXPY(static, saxpy_m2, m2)
+DEFINE_SAXPY(static, saxpy_m4, m4)
+DEFINE_SAXPY(static, saxpy_m8, m8)
+DEFINE_SAXPY_X2(static, saxpy_m2_x2, m2)
+DEFINE_SAXPY_X2(static, saxpy_m4_x2, m4)
+
+const rvv_saxpy_fn rvv_saxpy_variants[RVV_VARIANT_COUNT] = {
+    [RVV_VARIANT_M1] = rvv_saxpy_m1,
+    [RVV_VARIANT_M2] = saxpy_m2,
+    [RVV_VARIANT_M4] = saxpy_m4,
+    [RVV_VARIANT_M8] = saxpy_m8,
+    [RVV_VARIANT_M2_X2] = saxpy_m2_x2,
+    [RVV_VARIANT_M4_X2] = saxpy_m4_x2,
+};
+
+void rvv_saxpy(float a, const float *x, float *y, size_t n)
+{
+    rvv_dispatch.saxpy(a, x, y, n);
 }
@@ -0,0 +1,88 @@
+/**
+ * @file vec_string.c
+ * @brief Vectorized memory compare and string length using RVV
+ *
+ * Level 1: Byte-wise search kernels.
+ * Demonstrates: vmsne/vmseq + vfirst.m (first set mask bit),
+ *               vle8ff.v (fault-only-first load) with vl read back from CSR
+ *
+ * rvv_memcmp() knows n up front, so every strip is an ordinary vle8 at
+ * e8,m8 and the loop stops at the first strip whose compare mask is not
+ * empty. rvv_strlen() does not know where the string ends: it loads whole
+ * VLMAX strips with vle8ff.v, which only traps if element 0 faults and
+ * otherwise trims vl to the elements that could be read. A strip that
+ * reaches past the NUL into an unmapped page is therefore cut short
+ * rather than faulting, and the next strip starts at the first element
+ * that was not loaded.
+ */
+
+#include "rvv/rvv_common.h"
+
+/* =============================================================================
+ * Memory Compare
+ * ============================================================================= */
+
+int rvv_memcmp(const void *a, const void *b, size_t n)
+{
+    const uint8_t *pa = (const uint8_t *) a;
+    const uint8_t *pb = (const uint8_t *) b;
+    size_t vl;
+    long first;
+
+    /*
+     * On a mismatch the loop exits before advancing, so pa/pb point at
+     * the strip that holds it and first is its index within the strip.
+     * n == 0 runs one empty strip: vfirst.m under vl=0 returns -1.
+     */
+    __asm__ __volatile__("1:\n\t"
+                         "vsetvli  %[vl], %[n], e8, m8, ta, ma\n\t"
+                         "vle8.v   v0, (%[pa])\n\t"
+                         "vle8.v   v8, (%[pb])\n\t"
+                         "vmsne.vv v16, v0, v8\n\t"   /* v16 = (a != b) */
+                         "vfirst.m %[first], v16\n\t" /* first mismatch, or -1 */
+                         "bgez     %[first], 2f\n\t"
+                         "add      %[pa], %[pa], %[vl]\n\t"
+                         "add      %[pb], %[pb], %[vl]\n\t"
+                         "sub      %[n], %[n], %[vl]\n\t"
+                         "bnez     %[n], 1b\n\t"
+                         "2:\n\t"
+                         : [vl] "=&r"(vl), [first] "=&r"(first), [pa] "+r"(pa), [pb] "+r"(pb),
+                           [n] "+r"(n)
+                         :
+                         : RVV_CLOBBER_V0_V23, "memory");
+
+    if (first < 0) {
+        return 0;
+    }
+    return (int) pa[first] - (int) pb[first];
+}
+
+/* =============================================================================
+ * String Length
+ * ============================================================================= */
+
+size_t rvv_strlen(const char *s)
+{
+    const char *p = s;
+    size_t vl;
+    long first;
+
+    /*
+     * vsetvli with rs1=x0 and rd!=x0 requests VLMAX; vle8ff.v may lower
+     * vl, so the compare and vfirst run on what was actually loaded.
+     */
+    __asm__ __volatile__("1:\n\t"
+                         "vsetvli  t0, zero, e8, m8, ta, ma\n\t"
+                         "vle8ff.v v0, (%[p])\n\t"
+                         "csrr     %[vl], vl\n\t"
+                         "vmseq.vi v8, v0, 0\n\t" /* v8 = (byte == NUL) */
+                         "vfirst.m %[first], v8\n\t"
+                         "add      %[p], %[p], %[vl]\n\t"
+                         "bltz     %[first], 1b\n\t"
+                         : [vl] "=&r"(vl), [first] "=&r"(first), [p] "+r"(p)
+                         :
+                         : "t0", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8", "memory");
+
+    /* p is one strip past the strip that held the NUL */
+    return (size_t) (p - s) - vl + (size_t) first;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file sched.c
+ * @brief Work-stealing task scheduler implementation
+ *
+ * Chase-Lev deques over a fixed ring of SCHED_DEQUE_SIZE tasks per hart:
+ *   - bottom is written only by the owner (push/pop)
+ *   - top is advanced by thieves with CAS, and by the owner only when
+ *     it races thieves for the last remaining task
+ * Indices are free-running 32-bit counters; (int32_t) (bottom - top) is
+ * the deque length. A slot is overwritten only after top has moved past
+ * it, so a thief that read a stale slot always loses its CAS.
+ *
+ * Parking protocol (no lost wakeups): an idle hart sets its bit in
+ * sched_parked, then re-checks for work before wfi; a spawner publishes
+ * its task, then reads sched_parked. With full fences on both sides at
+ * least one of them sees the other's write.
+ */
+
+#include "sched.h"
+
+#include "atomic.h"
+#include "csr.h"
+#include "platform.h"
+#include "smp.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Scheduler State
+ * ============================================================================= */
+
+#define SCHED_DEQUE_MASK (SCHED_DEQUE_SIZE - 1)
+
+typedef struct {
+    sched_task_fn_t fn;
+    void *arg;
+    size_t lo;
+    size_t hi;
+} sched_task_t;
+
+/**
+ * Per-hart deque. top and bottom live on separate cache lines so thieves
+ * polling top do not steal the owner's line on every push/pop.
+ */
+typedef struct {
+    volatile uint32_t top __attribute__((aligned(64)));
+    volatile uint32_t bottom __attribute__((aligned(64)));
+    sched_task_t tasks[SCHED_DEQUE_SIZE] __attribute__((aligned(64)));
+} sched_deque_t;
+
+/** Statistics padded to one cache line per hart (written by owner only) */
+typedef struct {
+    sched_stats_t s;
+    uint8_t pad[64 - sizeof(sched_stats_t)];
+} sched_stats_slot_t;
+
+static sched_deque_t sched_deques[NUM_HARTS];
+
+static sched_stats_slot_t sched_stats[NUM_HARTS] __attribute__((aligned(64)));
+
+/** Tasks spawned but not yet completed (all harts) */
+static volatile uint32_t sched_pending;
+
+/** Bitmask of harts parked (or about to park) in wfi */
+static volatile uint32_t sched_parked;
+
+/** Broadcast job descriptor, published before sched_job_gen is bumped */
+static struct {
+    smp_job_fn_t fn;
+    void *arg;
+    uint32_t nharts;
+} sched_job;
+
+static volatile uint32_t sched_job_gen;
+static volatile uint32_t sched_job_acks;
+
+/* =============================================================================
+ * Chase-Lev Deque
+ * ============================================================================= */
+
+/** Owner: push at bottom; false if full */
+static bool deque_push(sched_deque_t *dq, const sched_task_t *task)
+{
+    uint32_t b = dq->bottom;
+    uint32_t t = atomic_load_u32(&dq->top);
+
+    if (b - t >= SCHED_DEQUE_SIZE) {
+        return false;
+    }
+
+    dq->tasks[b & SCHED_DEQUE_MASK] = *task;
+    wmb(); /* Task contents before the new bottom */
+    dq->bottom = b + 1;
+    return true;
+}
+
+/** Owner: pop at bottom; false if empty or the last task was stolen */
+static bool deque_pop(sched_deque_t *dq, sched_task_t *task)
+{
+    uint32_t b = dq->bottom - 1;
+
+    dq->bottom = b;
+    mb(); /* Reserve bottom before reading top (pairs with deque_steal) */
+    uint32_t t = dq->top;
+
+    if ((int32_t) (b - t) < 0) {
+        /* Empty: restore */
+        dq->bottom = b + 1;
+        return false;
+    }
+
+    *task = dq->tasks[b & SCHED_DEQUE_MASK];
+    if (b != t) {
+        return true;
+    }
+
+    /* Last task: race thieves for it by advancing top ourselves */
+    bool won = atomic_cas_u32(&dq->top, t, t + 1) != 0;
+    dq->bottom = b + 1;
+    return won;
+}
+
+/** Thief: take the oldest task at top; false if empty or CAS lost */
+static bool deque_steal(sched_deque_t *dq, sched_task_t *task)
+{
+    uint32_t t = atomic_load_u32(&dq->top);
+    mb(); /* Read top before bottom (pairs with deque_pop) */
+    uint32_t b = atomic_load_u32(&dq->bottom); /* Acquire: pairs with deque_push's wmb() */
+
+    if ((int32_t) (b - t) <= 0) {
+        return false;
+    }
+
+    *task = dq->tasks[t & SCHED_DEQUE_MASK];
+    return atomic_cas_u32(&dq->top, t, t + 1) != 0;
+}
+
+/** True if any deque looks non-empty (racy hint, used before parking) */
+static bool sched_work_visible(void)
+{
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        if ((int32_t) (sched_deques[h].bottom - sched_deques[h].top) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* =============================================================================
+ * Task Execution
+ * ============================================================================= */
+
+/** Steal from the other harts, starting with the next hart up */
+static bool sched_steal(uint32_t hart, sched_task_t *task)
+{
+    for (uint32_t i = 1; i < NUM_HARTS; i++) {
+        uint32_t victim = (hart + i) % NUM_HARTS;
+        if (deque_steal(&sched_deques[victim], task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Run one task from our deque or a victim's; false if none found */
+static bool sched_run_one(uint32_t hart)
+{
+    sched_task_t task;
+
+    if (!deque_pop(&sched_deques[hart], &task)) {
+        if (!sched_steal(hart, &task)) {
+            return false;
+        }
+        sched_stats[hart].s.stolen++;
+    }
+
+    task.fn(task.arg, task.lo, task.hi);
+    sched_stats[hart].s.executed++;
+
+    /* Release: the task's writes are visible before it counts as done */
+    atomic_add_u32(&sched_pending, (uint32_t) -1);
+    return true;
+}
+
+/* =============================================================================
+ * Parking and Wakeup
+ * ============================================================================= */
+
+/** Wake one parked hart other than self, claiming its parked bit */
+static void sched_wake_one(uint32_t self)
+{
+    mb(); /* Task published before reading sched_parked */
+    uint32_t parked = sched_parked & ~(1U << self);
+
+    for (uint32_t h = 0; parked != 0; h++, parked >>= 1) {
+        if ((parked & 1) && (atomic_and_u32(&sched_parked, ~(1U << h)) & (1U << h))) {
+            smp_send_ipi(h);
+            return;
+        }
+    }
+}
+
+/** Park in wfi unless work or a broadcast shows up after announcing */
+static void sched_park(uint32_t hart, uint32_t seen_gen)
+{
+    uint32_t bit = 1U << hart;
+#if defined(SMP_HAVE_IPI)
+    /* Traps off until the IPI is cleared: a trap between the re-check and
+     * wfi would acknowledge MSIP (trap.h) and leave wfi nothing to wake on.
+     * A pending interrupt still wakes wfi and is taken once MIE is back. */
+    unsigned long mie_was = clear_csr(mstatus, MSTATUS_MIE) & MSTATUS_MIE;
+#endif
+
+    atomic_or_u32(&sched_parked, bit); /* aqrl: announce before re-check */
+
+    if (sched_job_gen == seen_gen && !sched_work_visible()) {
+        sched_stats[hart].s.parks++;
+#if defined(SMP_HAVE_IPI)
+        __asm__ __volatile__("wfi");
+#endif
+    }
+
+    atomic_and_u32(&sched_parked, ~bit);
+    smp_clear_ipi(hart);
+#if defined(SMP_HAVE_IPI)
+    set_csr(mstatus, mie_was);
+#endif
+}
+
+/* =============================================================================
+ * Public API
+ * ============================================================================= */
+
+void sched_init(void)
+{
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        sched_deques[h].top = 0;
+        sched_deques[h].bottom = 0;
+    }
+    sched_reset_stats();
+
+    sched_pending = 0;
+    sched_parked = 0;
+    sched_job_gen = 0;
+    sched_job_acks = 0;
+
+    wmb();
+}
+
+void sched_spawn(sched_task_fn_t fn, void *arg, size_t lo, size_t hi)
+{
+    uint32_t hart = (uint32_t) csr_read_hartid();
+    sched_task_t task = {fn, arg, lo, hi};
+
+    /* Count before publishing so sched_pending never underflows */
+    atomic_add_u32(&sched_pending, 1);
+
+    if (!deque_push(&sched_deques[hart], &task)) {
+        sched_stats[hart].s.inlined++;
+        fn(arg, lo, hi);
+        sched_stats[hart].s.executed++;
+        atomic_add_u32(&sched_pending, (uint32_t) -1);
+        return;
+    }
+
+    sched_wake_one(hart);
+}
+
+void sched_wait(void)
+{
+    while (atomic_load_u32(&sched_pending) != 0) {
+        sched_run_one(0);
+    }
+}
+
+void sched_broadcast(smp_job_fn_t fn, void *arg, uint32_t nharts)
+{
+    sched_job.fn = fn;
+    sched_job.arg = arg;
+    sched_job.nharts = nharts;
+    sched_job_acks = 0;
+    wmb(); /* Descriptor before the generation bump */
+    sched_job_gen = sched_job_gen + 1;
+
+    for (uint32_t h = 1; h < NUM_HARTS; h++) {
+        smp_send_ipi(h);
+    }
+
+    fn(0, nharts, arg);
+
+    /* Every secondary acknowledges, so the descriptor can be reused */
+    while (atomic_load_u32(&sched_job_acks) != NUM_HARTS - 1) {
+        /* Spin */
+    }
+}
+
+void sched_worker_loop(uint32_t hart)
+{
+    /* sched_init() zeroed the generation before this hart was released */
+    uint32_t seen_gen = 0;
+
+#if defined(SMP_HAVE_IPI)
+    /* Software interrupt wakes wfi; parking keeps mstatus.MIE clear (no trap) */
+    set_csr(mie, MIE_MSIE);
+#endif
+
+    while (1) {
+        uint32_t gen = sched_job_gen;
+
+        if (gen != seen_gen) {
+            seen_gen = gen;
+            rmb(); /* Generation before descriptor */
+            if (hart < sched_job.nharts) {
+                sched_job.fn(hart, sched_job.nharts, sched_job.arg);
+            }
+            atomic_add_u32(&sched_job_acks, 1);
+            continue;
+        }
+
+        if (!sched_run_one(hart)) {
+            sched_park(hart, seen_gen);
+        }
+    }
+}
+
+void sched_get_stats(uint32_t hart, sched_stats_t *stats)
+{
+    rmb();
+    *stats = sched_stats[hart].s;
+}
+
+void sched_reset_stats(void)
+{
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        sched_stats[h].s = (sched_stats_t) {0, 0, 0, 0};
+    }
+    wmb();
+}
@@ -6,7 +6,7 @@
  * and test coordination for SMP configurations.
  *
  * Secondary harts spin in startup.S until smp_hart_release is set,
- * then call smp_secondary_entry() to participate in SMP tests.
+ * then call smp_secondary_entry(), which enters the scheduler loop.
  */
 
 #include "smp.h"
@@ -14,56 +14,188 @@
 #include "atomic.h"
 #include "console.h"
 #include "csr.h"
+#include "mmu.h"
 #include "platform.h"
+#include "prof.h"
+#include "sched.h"
 
 #include <stdint.h>
 
+#if defined(ENABLE_RVV)
+#include "rvv/rvv_detect.h"
+#endif
+
 /* =============================================================================
  * SMP Global State
  * ============================================================================= */
 
+/*
+ * Everything a spinning hart reads or another hart writes lives in
+ * .bss.smp_shared (smp.h), one object per cache line, so e.g. the
+ * secondaries polling smp_hart_release do not steal the line holding
+ * smp_lock_counter from the harts updating it.
+ */
+
 /**
- * Release flag for secondary harts.
- * Initialized to 0 via BSS clearing by hart 0.
- * Set to 1 by smp_release_harts().
+ * Per-hart data areas, reached through tp (see smp_this_hart()).
  * Referenced from startup.S.
  */
-volatile uint32_t smp_hart_release;
+smp_hart_local_t smp_hart_local[MAX_HARTS] __smp_shared;
 
 /**
- * Count of secondary harts that have completed boot.
+ * Release flag for secondary harts.
+ * Initialized to 0 via BSS clearing by hart 0.
+ * Set to 1 by smp_release_harts().
+ * Referenced from startup.S.
  */
-static volatile uint32_t smp_harts_online;
+volatile uint32_t smp_hart_release __smp_shared;
 
 /**
  * Global print lock - serializes console output across harts.
  */
-spinlock_t smp_print_lock;
+spinlock_t smp_print_lock __smp_shared;
 
 /**
  * Global test barrier - synchronizes harts between test phases.
  */
-barrier_t smp_test_barrier;
+barrier_t smp_test_barrier __smp_shared;
 
 /**
  * Shared counter for spinlock correctness test.
  */
-volatile uint32_t smp_lock_counter;
+volatile uint32_t smp_lock_counter __smp_shared;
 
 /**
  * Shared lock for spinlock correctness test.
  */
-spinlock_t smp_test_lock;
+spinlock_t smp_test_lock __smp_shared;
 
 /**
  * Shared counter for atomic operation test.
  */
-volatile uint32_t smp_atomic_counter;
+volatile uint32_t smp_atomic_counter __smp_shared;
 
 /* =============================================================================
  * Barrier Implementation
  * ============================================================================= */
 
+#if defined(SMP_BARRIER_SENSE)
+
+void barrier_init(barrier_t *bar, uint32_t total)
+{
+    bar->count = 0;
+    bar->total = total;
+    bar->sense = 0;
+}
+
+void barrier_wait(barrier_t *bar)
+{
+    /* The sense cannot flip before we arrive, so this is our episode's */
+    uint32_t sense = bar->sense;
+
+    /* acq_rel: publish our accesses; the last arrival acquires everyone's */
+    if (atomic_add_u32_explicit(&bar->count, 1, ATOMIC_ACQ_REL) == bar->total - 1) {
+        /* Last hart to arrive: reset, then release everyone at once */
+        bar->count = 0;
+        atomic_store_u32_explicit(&bar->sense, sense ^ 1, ATOMIC_RELEASE);
+    } else {
+        while (bar->sense == sense) {
+            /* Spin on the read-shared sense line */
+        }
+        /* Pairs with the release of the sense flip */
+        atomic_thread_fence(ATOMIC_ACQUIRE);
+    }
+}
+
+#elif defined(SMP_BARRIER_TREE)
+
+void barrier_init(barrier_t *bar, uint32_t total)
+{
+    for (uint32_t h = 0; h < MAX_HARTS; h++) {
+        bar->slot[h].flag[0] = 0;
+        bar->slot[h].release = 0;
+        bar->slot[h].epoch = 0;
+    }
+    bar->total = total;
+}
+
+void barrier_wait(barrier_t *bar)
+{
+    uint32_t hart = (uint32_t) csr_read_hartid();
+    barrier_slot_t *me = &bar->slot[hart];
+    uint32_t target = ++me->epoch;
+    uint32_t first = hart * SMP_BARRIER_TREE_ARITY + 1;
+    uint32_t last = first + SMP_BARRIER_TREE_ARITY;
+
+    if (last > bar->total) {
+        last = bar->total;
+    }
+
+    /* Arrival: wait for every child subtree */
+    for (uint32_t c = first; c < last; c++) {
+        while ((int32_t) (bar->slot[c].flag[0] - target) < 0) {
+            /* Spin on the child's line */
+        }
+    }
+
+    /* Report to the parent and wait to be released (root skips this) */
+    if (hart != 0) {
+        /* Release: our accesses and our subtree's arrivals */
+        atomic_store_u32_explicit(&me->flag[0], target, ATOMIC_RELEASE);
+        while ((int32_t) (me->release - target) < 0) {
+            /* Spin on our own line */
+        }
+    }
+
+    /*
+     * One fence.tso covers both directions: the flags read above (and so
+     * everyone's accesses) before our later accesses, and our own stores
+     * before the children's release flags, which can then be plain.
+     */
+    atomic_thread_fence(ATOMIC_ACQ_REL);
+
+    /* Wakeup: release our children */
+    for (uint32_t c = first; c < last; c++) {
+        atomic_store_u32_explicit(&bar->slot[c].release, target, ATOMIC_RELAXED);
+    }
+}
+
+#elif defined(SMP_BARRIER_DISSEMINATION)
+
+void barrier_init(barrier_t *bar, uint32_t total)
+{
+    for (uint32_t h = 0; h < MAX_HARTS; h++) {
+        for (uint32_t r = 0; r < SMP_BARRIER_MAX_ROUNDS; r++) {
+            bar->slot[h].flag[r] = 0;
+        }
+        bar->slot[h].epoch = 0;
+    }
+    bar->total = total;
+}
+
+void barrier_wait(barrier_t *bar)
+{
+    uint32_t hart = (uint32_t) csr_read_hartid();
+    barrier_slot_t *me = &bar->slot[hart];
+    uint32_t target = ++me->epoch;
+
+    for (uint32_t r = 0, dist = 1; dist < bar->total; r++, dist <<= 1) {
+        uint32_t partner = (hart + dist) % bar->total;
+
+        /* Only hart (partner - dist) ever writes partner's flag[r] */
+        /* Release: also carries the flags of the earlier rounds on */
+        atomic_store_u32_explicit(&bar->slot[partner].flag[r], target, ATOMIC_RELEASE);
+        while ((int32_t) (me->flag[r] - target) < 0) {
+            /* Spin on our own line */
+        }
+    }
+
+    /* Pairs with the releases of the last round's partner */
+    atomic_thread_fence(ATOMIC_ACQUIRE);
+}
+
+#else /* SMP_BARRIER_CENTRAL */
+
 void barrier_init(barrier_t *bar, uint32_t total)
 {
     bar->count = 0;
@@ -80,23 +212,27 @@ void barrier_wait(barrier_t *bar)
     uint32_t gen = bar->generation;
 
     if (bar->count >= bar->total) {
-        /* Last hart to arrive: reset and advance generation */
+        /*
+         * Last hart to arrive: the lock acquire saw everyone's accesses.
+         * The next episode's arrivals see the count reset through the
+         * lock; the release bump publishes the rest to the spinners.
+         */
         bar->count = 0;
-        mb(); /* Ensure count reset is visible before generation bump */
-        bar->generation++;
+        atomic_store_u32_explicit(&bar->generation, gen + 1, ATOMIC_RELEASE);
         spin_unlock(&bar->lock);
     } else {
         spin_unlock(&bar->lock);
         /* Wait for generation to advance */
-        while (*(volatile uint32_t *) &bar->generation == gen) {
+        while (bar->generation == gen) {
             /* Spin */
         }
+        /* Pairs with the release of the generation bump */
+        atomic_thread_fence(ATOMIC_ACQUIRE);
     }
-
-    /* Ensure all memory operations from before the barrier are visible */
-    mb();
 }
 
+#endif /* SMP_BARRIER_* */
+
 /* =============================================================================
  * SMP Boot Protocol
  * ============================================================================= */
@@ -104,7 +240,9 @@ void barrier_wait(barrier_t *bar)
 void smp_init(void)
 {
     /* Initialize shared state */
-    smp_harts_online = 0;
+    for (uint32_t h = 1; h < MAX_HARTS; h++) {
+        smp_hart_local[h].online = 0;
+    }
     smp_lock_counter = 0;
     smp_atomic_counter = 0;
     smp_print_lock = (spinlock_t) SPINLOCK_INIT;
@@ -113,24 +251,33 @@ void smp_init(void)
     /* Initialize barrier for all harts */
     barrier_init(&smp_test_barrier, NUM_HARTS);
 
-    wmb(); /* Ensure all initializations are visible */
+    /* Deques and dispatch state must be ready before secondaries run */
+    sched_init();
+
+    /* Published by the release store in smp_release_harts() */
 }
 
 void smp_release_harts(void)
 {
-    /* Ensure all initialization is visible to secondary harts */
-    wmb();
-
-    /* Set release flag - secondary harts will see this and proceed */
-    smp_hart_release = 1;
-
-    /* Ensure the store is visible */
-    wmb();
+    /*
+     * Release: all initialization before the flag that secondary harts
+     * poll (startup.S pairs it with an acquire fence). A trailing fence
+     * would not make the store visible any sooner.
+     */
+    atomic_store_u32_explicit(&smp_hart_release, 1, ATOMIC_RELEASE);
 }
 
 uint32_t smp_get_harts_online(void)
 {
-    return atomic_load_u32(&smp_harts_online);
+    /* Each secondary sets only its own flag; merge them here */
+    uint32_t online = 0;
+
+    for (uint32_t h = 1; h < MAX_HARTS; h++) {
+        online += atomic_load_u32_explicit(&smp_hart_local[h].online, ATOMIC_RELAXED);
+    }
+    /* One acquire for all flags (pairs with each hart's release store) */
+    atomic_thread_fence(ATOMIC_ACQUIRE);
+    return online;
 }
 
 uint32_t smp_get_num_harts(void)
@@ -139,80 +286,82 @@ uint32_t smp_get_num_harts(void)
 }
 
 /* =============================================================================
- * Secondary Hart Entry Point
+ * Per-Hart Counters
  * ============================================================================= */
 
-/**
- * @brief Print hart ID to console (helper)
- */
-static void print_hart_id(uint64_t hartid)
+void smp_counter_reset(smp_counter_t *c)
 {
-    char buf[4];
-    if (hartid < 10) {
-        buf[0] = '0' + (char) hartid;
-        buf[1] = '\0';
-    } else {
-        buf[0] = '0' + (char) (hartid / 10);
-        buf[1] = '0' + (char) (hartid % 10);
-        buf[2] = '\0';
+    for (uint32_t h = 0; h < MAX_HARTS; h++) {
+        c->slot[h].value = 0;
+    }
+}
+
+uint64_t smp_counter_read(const smp_counter_t *c)
+{
+    uint64_t sum = 0;
+
+    for (uint32_t h = 0; h < MAX_HARTS; h++) {
+        sum += c->slot[h].value;
     }
-    console_puts(buf);
+    return sum;
 }
 
+/* =============================================================================
+ * Fork-Join Work Dispatch
+ * ============================================================================= */
+
+void smp_parallel_run(smp_job_fn_t fn, void *arg, uint32_t nharts)
+{
+    if (nharts > NUM_HARTS) {
+        nharts = NUM_HARTS;
+    }
+    if (nharts <= 1) {
+        fn(0, 1, arg);
+        return;
+    }
+
+    sched_broadcast(fn, arg, nharts);
+}
+
+/* =============================================================================
+ * Secondary Hart Entry Point
+ * ============================================================================= */
+
 /**
  * @brief Entry point for secondary harts
  *
- * Called from startup.S after secondary harts are released.
- * Participates in SMP tests coordinated by hart 0 via barriers.
- *
- * Test coordination protocol (synchronized with main.c):
- *   Barrier 1: Boot complete (all harts online)
- *   Barrier 2: Spinlock test start
- *   Barrier 3: Spinlock test end
- *   Barrier 4: Atomic test start
- *   Barrier 5: Atomic test end
- *   Barrier 6: Final barrier (barrier test)
+ * Called from startup.S after secondary harts are released. The hart
+ * announces itself, bumps the online counter, and then hands control to
+ * the scheduler: from here on it only runs what hart 0 dispatches
+ * (sched_spawn() tasks and smp_parallel_run() jobs), parking in wfi
+ * between them.
  */
 void smp_secondary_entry(uint64_t hartid)
 {
+    /* satp and mstatus are per hart: share hart 0's page tables */
+    mmu_enable_hart();
+
+#if defined(ENABLE_RVV)
+    /* mstatus is per hart: enable FP (vfmacc.vf etc.) and the vector unit */
+    set_csr(mstatus, 1UL << 13); /* FS = Initial */
+    rvv_enable();
+#endif
+
     /* Announce this hart is online (with print lock for clean output) */
+#if !defined(CONSOLE_LOCKFREE)
     spin_lock(&smp_print_lock);
-    console_puts("[SMP] Hart ");
-    print_hart_id(hartid);
-    console_puts(" online\n");
+#endif
+    console_printf("[SMP] Hart %lu online\n", hartid);
+#if !defined(CONSOLE_LOCKFREE)
     spin_unlock(&smp_print_lock);
+#endif
 
-    /* Increment online counter atomically */
-    atomic_add_u32(&smp_harts_online, 1);
-
-    /* === Barrier 1: Boot complete === */
-    barrier_wait(&smp_test_barrier);
-
-    /* === Barrier 2: Spinlock test start === */
-    barrier_wait(&smp_test_barrier);
+    /* Announce online on our own line (merged by smp_get_harts_online()) */
+    atomic_store_u32(&smp_hart_local[hartid].online, 1);
 
-    /* Spinlock test: increment shared counter under lock */
-    spin_lock(&smp_test_lock);
-    smp_lock_counter++;
-    spin_unlock(&smp_test_lock);
+    /* Sample this hart too (no-op without ENABLE_PROFILER) */
+    prof_start();
 
-    /* === Barrier 3: Spinlock test end === */
-    barrier_wait(&smp_test_barrier);
-
-    /* === Barrier 4: Atomic test start === */
-    barrier_wait(&smp_test_barrier);
-
-    /* Atomic test: increment shared counter atomically */
-    atomic_add_u32(&smp_atomic_counter, 1);
-
-    /* === Barrier 5: Atomic test end === */
-    barrier_wait(&smp_test_barrier);
-
-    /* === Barrier 6: Final barrier (barrier test) === */
-    barrier_wait(&smp_test_barrier);
-
-    /* All tests complete - enter low-power wait loop */
-    while (1) {
-        __asm__ __volatile__("wfi");
-    }
+    /* Serve tasks and jobs from hart 0 until the system exits */
+    sched_worker_loop((uint32_t) hartid);
 }
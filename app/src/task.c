@@ -0,0 +1,424 @@
+/**
+ * @file task.c
+ * @brief Preemptive round-robin tasks with lazy FP/vector context switch
+ *
+ * See task.h. The switch runs in the timer handler with mstatus.MIE
+ * clear. Built with -fno-tree-vectorize: the handler must not touch the
+ * FP or vector registers except in the save/restore sequences below.
+ */
+
+#include "task.h"
+
+#include "csr.h"
+#include "platform.h"
+#include "trap.h"
+
+#if defined(ENABLE_RVV)
+#include "rvv/rvv_detect.h"
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ENABLE_PREEMPT)
+
+#if defined(ENABLE_PROFILER)
+#error "ENABLE_PREEMPT and ENABLE_PROFILER both need the machine timer interrupt"
+#endif
+
+/* =============================================================================
+ * Contexts
+ * ============================================================================= */
+
+/** mtime ticks per slice */
+#define TASK_SLICE_TICKS ((uint64_t) TASK_SLICE_US * CLINT_TIMEBASE_HZ / 1000000UL)
+
+#define TASK_MTIMECMP(hart) (*(volatile uint64_t *) (CLINT_MTIMECMP + 8UL * (hart)))
+
+/** Context slot of task_run()'s caller */
+#define TASK_IDLE TASK_MAX
+
+/** Owner of a register file that holds nobody's saved state */
+#define TASK_NONE (TASK_MAX + 1)
+
+/** FP state: f0-f31 and fcsr */
+typedef struct {
+    uint64_t f[32];
+    uint64_t fcsr;
+} task_fctx_t;
+
+#if defined(ENABLE_RVV)
+/** Vector state: v0-v31 (32 * vlenb bytes) and the vector CSRs */
+typedef struct {
+    uint8_t v[32 * TASK_VLEN_MAX / 8] __attribute__((aligned(16)));
+    uint64_t vl;
+    uint64_t vtype;
+    uint64_t vstart;
+    uint64_t vcsr;
+} task_vctx_t;
+#endif
+
+typedef struct {
+    trap_frame_t *frame; /* Integer context, at the top of the task's stack */
+    task_fn_t fn;
+    void *arg;
+    bool live;    /* Created and not yet returned */
+    bool f_saved; /* fctx holds the task's FP state */
+    task_fctx_t fctx;
+#if defined(ENABLE_RVV)
+    bool v_saved; /* vctx holds the task's vector state */
+    task_vctx_t vctx;
+#endif
+} task_ctx_t;
+
+static uint8_t task_stacks[TASK_MAX][TASK_STACK_SIZE] __attribute__((aligned(16)));
+
+/** Tasks 0 .. TASK_MAX-1, then the caller of task_run() (TASK_IDLE) */
+static task_ctx_t task_ctx[TASK_MAX + 1];
+
+static uint32_t task_count;         /* Tasks created for the next task_run() */
+static volatile uint32_t task_live; /* Tasks not yet returned */
+static uint32_t task_current;       /* Running context */
+static uint32_t task_rr;            /* Last task picked (round-robin cursor) */
+static uint32_t task_f_owner;       /* Context whose saved FP state the registers hold */
+static task_save_mode_t task_mode;
+static task_stats_t task_stats;
+
+#if defined(ENABLE_RVV)
+static uint32_t task_v_owner; /* Context whose saved vector state the registers hold */
+static uint64_t task_vlenb;   /* 0 without a vector unit */
+#endif
+
+/* =============================================================================
+ * Register File Save / Restore
+ * ============================================================================= */
+
+static void task_save_f(task_fctx_t *c)
+{
+    __asm__ __volatile__(".irp n, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,"
+                         "24,25,26,27,28,29,30,31\n\t"
+                         "fsd f\\n, 8*\\n(%0)\n\t"
+                         ".endr"
+                         :
+                         : "r"(c->f)
+                         : "memory");
+    c->fcsr = read_csr(fcsr);
+}
+
+static void task_restore_f(const task_fctx_t *c)
+{
+    __asm__ __volatile__(".irp n, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,"
+                         "24,25,26,27,28,29,30,31\n\t"
+                         "fld f\\n, 8*\\n(%0)\n\t"
+                         ".endr"
+                         :
+                         : "r"(c->f)
+                         : "memory");
+    write_csr(fcsr, c->fcsr);
+}
+
+#if defined(ENABLE_RVV)
+
+static void task_save_v(task_vctx_t *c)
+{
+    uint8_t *p = c->v;
+    uint64_t group = task_vlenb * 8; /* Bytes per 8-register group */
+
+    c->vl = read_csr(vl);
+    c->vtype = read_csr(vtype);
+    c->vstart = read_csr(vstart);
+    c->vcsr = read_csr(vcsr);
+
+    /* Whole-register stores honour vstart: store every element */
+    __asm__ __volatile__("csrw    vstart, zero\n\t"
+                         "vs8r.v  v0, (%0)\n\t"
+                         "add     %0, %0, %1\n\t"
+                         "vs8r.v  v8, (%0)\n\t"
+                         "add     %0, %0, %1\n\t"
+                         "vs8r.v  v16, (%0)\n\t"
+                         "add     %0, %0, %1\n\t"
+                         "vs8r.v  v24, (%0)"
+                         : "+r"(p)
+                         : "r"(group)
+                         : "memory");
+}
+
+static void task_restore_v(const task_vctx_t *c)
+{
+    const uint8_t *p = c->v;
+    uint64_t group = task_vlenb * 8;
+
+    __asm__ __volatile__("csrw    vstart, zero\n\t"
+                         "vl8re8.v v0, (%0)\n\t"
+                         "add     %0, %0, %1\n\t"
+                         "vl8re8.v v8, (%0)\n\t"
+                         "add     %0, %0, %1\n\t"
+                         "vl8re8.v v16, (%0)\n\t"
+                         "add     %0, %0, %1\n\t"
+                         "vl8re8.v v24, (%0)"
+                         : "+r"(p)
+                         : "r"(group)
+                         : "memory");
+
+    /* vl <= VLMAX of its vtype, so vsetvl gives it back exactly; vstart
+     * last, since every vector instruction clears it */
+    __asm__ __volatile__("vsetvl  zero, %0, %1\n\t"
+                         "csrw    vcsr, %2\n\t"
+                         "csrw    vstart, %3"
+                         :
+                         : "r"(c->vl), "r"(c->vtype), "r"(c->vcsr), "r"(c->vstart)
+                         : "memory");
+}
+
+#endif /* ENABLE_RVV */
+
+/**
+ * Hand the FP registers from prev to next. The registers hold the saved
+ * state of task_f_owner (or nobody's); Dirty means prev wrote them since.
+ */
+static void task_switch_f(uint32_t prev, uint32_t next, uint64_t mstatus)
+{
+    uint64_t fs = mstatus & MSTATUS_FS;
+
+    if (fs == MSTATUS_FS_OFF) {
+        return;
+    }
+
+    bool save = task_mode == TASK_SAVE_EAGER || fs == MSTATUS_FS_DIRTY;
+    if (save && task_ctx[prev].live) {
+        task_save_f(&task_ctx[prev].fctx);
+        task_ctx[prev].f_saved = true;
+        task_f_owner = prev;
+        task_stats.f_saves++;
+        task_stats.bytes += sizeof(task_fctx_t);
+    } else if (save) {
+        task_f_owner = TASK_NONE; /* prev returned: its registers are garbage */
+    }
+
+    bool restore = task_mode == TASK_SAVE_EAGER || task_f_owner != next;
+    if (restore && task_ctx[next].f_saved) {
+        task_restore_f(&task_ctx[next].fctx);
+        task_f_owner = next;
+        task_stats.f_restores++;
+        task_stats.bytes += sizeof(task_fctx_t);
+    }
+
+    /* Registers match the owner's saved copy until the next FP write */
+    clear_csr(mstatus, MSTATUS_FS);
+    set_csr(mstatus, MSTATUS_FS_CLEAN);
+}
+
+#if defined(ENABLE_RVV)
+
+/** As task_switch_f(), for the vector registers and mstatus.VS */
+static void task_switch_v(uint32_t prev, uint32_t next, uint64_t mstatus)
+{
+    uint64_t vs = mstatus & MSTATUS_VS_MASK;
+    uint64_t bytes = 32 * task_vlenb + 4 * sizeof(uint64_t);
+
+    if (vs == MSTATUS_VS_OFF || task_vlenb == 0) {
+        return;
+    }
+
+    bool save = task_mode == TASK_SAVE_EAGER || vs == MSTATUS_VS_DIRTY;
+    if (save && task_ctx[prev].live) {
+        task_save_v(&task_ctx[prev].vctx);
+        task_ctx[prev].v_saved = true;
+        task_v_owner = prev;
+        task_stats.v_saves++;
+        task_stats.bytes += bytes;
+    } else if (save) {
+        task_v_owner = TASK_NONE;
+    }
+
+    bool restore = task_mode == TASK_SAVE_EAGER || task_v_owner != next;
+    if (restore && task_ctx[next].v_saved) {
+        task_restore_v(&task_ctx[next].vctx);
+        task_v_owner = next;
+        task_stats.v_restores++;
+        task_stats.bytes += bytes;
+    }
+
+    clear_csr(mstatus, MSTATUS_VS_MASK);
+    set_csr(mstatus, MSTATUS_VS_CLEAN);
+}
+
+#endif /* ENABLE_RVV */
+
+/* =============================================================================
+ * Timer Tick
+ * ============================================================================= */
+
+static inline void task_arm(uint32_t hart)
+{
+    TASK_MTIMECMP(hart) = *(volatile uint64_t *) CLINT_MTIME + TASK_SLICE_TICKS;
+}
+
+/** Next live task after the last one picked, or TASK_IDLE when all have returned */
+static uint32_t task_pick(void)
+{
+    for (uint32_t i = 1; i <= task_count; i++) {
+        uint32_t t = (task_rr + i) % task_count;
+
+        if (task_ctx[t].live) {
+            task_rr = t;
+            return t;
+        }
+    }
+    return TASK_IDLE;
+}
+
+static void task_tick(trap_frame_t *frame)
+{
+    uint64_t start = csr_read_cycle();
+    uint32_t hart = (uint32_t) csr_read_hartid();
+    uint32_t prev = task_current;
+    uint32_t next = task_pick();
+
+    if (next == TASK_IDLE) {
+        TASK_MTIMECMP(hart) = UINT64_MAX; /* Back to task_run() for good */
+    } else {
+        task_arm(hart);
+    }
+    if (next == prev) {
+        return;
+    }
+
+    uint64_t mstatus = read_csr(mstatus);
+    task_switch_f(prev, next, mstatus);
+#if defined(ENABLE_RVV)
+    task_switch_v(prev, next, mstatus);
+#endif
+
+    task_ctx[prev].frame = frame;
+    task_current = next;
+    trap_switch_frame(task_ctx[next].frame);
+
+    task_stats.switches++;
+    task_stats.switch_cycles += csr_read_cycle() - start;
+}
+
+/** Retire the running task and switch away at once; never returns */
+static void task_exit(void)
+{
+    clear_csr(mstatus, MSTATUS_MIE);
+    task_ctx[task_current].live = false;
+    task_live--;
+    TASK_MTIMECMP(csr_read_hartid()) = 0;
+    set_csr(mstatus, MSTATUS_MIE);
+
+    while (1) {
+        wfi();
+    }
+}
+
+/** First code of every task (mepc of its initial frame) */
+static void task_start(task_fn_t fn, void *arg)
+{
+    fn(arg);
+    task_exit();
+}
+
+/* =============================================================================
+ * Public API
+ * ============================================================================= */
+
+int task_create(task_fn_t fn, void *arg)
+{
+    if (task_count >= TASK_MAX) {
+        return -1;
+    }
+
+    uint32_t t = task_count++;
+    task_ctx_t *c = &task_ctx[t];
+    uintptr_t top = (uintptr_t) &task_stacks[t][TASK_STACK_SIZE];
+    trap_frame_t *f = (trap_frame_t *) top - 1;
+    uint64_t gp;
+    uint64_t tp;
+
+    __asm__ __volatile__("mv %0, gp\n\tmv %1, tp" : "=r"(gp), "=r"(tp));
+    for (uint32_t r = 0; r < 32; r++) {
+        f->regs[r] = 0;
+    }
+    f->regs[2] = top;
+    f->regs[3] = gp;
+    f->regs[4] = tp; /* Same hart: same hart-local block */
+    f->regs[10] = (uint64_t) (uintptr_t) fn;
+    f->regs[11] = (uint64_t) (uintptr_t) arg;
+    f->mepc = (uint64_t) (uintptr_t) task_start;
+    f->mcause = 0;
+    f->mtval = 0;
+
+    c->frame = f;
+    c->fn = fn;
+    c->arg = arg;
+    c->live = true;
+    c->f_saved = false;
+#if defined(ENABLE_RVV)
+    c->v_saved = false;
+#endif
+    return (int) t;
+}
+
+int task_run(task_save_mode_t mode, task_stats_t *stats)
+{
+    uint32_t hart = (uint32_t) csr_read_hartid();
+
+    if (task_count == 0) {
+        return -1;
+    }
+#if defined(ENABLE_RVV)
+    task_vlenb = rvv_available() ? rvv_get_vlenb() : 0;
+    if (task_vlenb * 8 > TASK_VLEN_MAX) {
+        task_count = 0; /* Drop the tasks: they cannot run on this hart */
+        return -1;
+    }
+    task_v_owner = TASK_IDLE;
+    task_ctx[TASK_IDLE].v_saved = false;
+#endif
+
+    task_mode = mode;
+    task_stats = (task_stats_t) {0};
+    task_current = TASK_IDLE;
+    task_rr = task_count - 1;
+    task_f_owner = TASK_IDLE;
+    task_ctx[TASK_IDLE].live = true;
+    task_ctx[TASK_IDLE].f_saved = false;
+    task_live = task_count;
+
+    /* Our FP/vector registers may be live: have the first switch save them */
+    uint64_t mstatus = read_csr(mstatus);
+    if ((mstatus & MSTATUS_FS) != MSTATUS_FS_OFF) {
+        set_csr(mstatus, MSTATUS_FS_DIRTY);
+    }
+#if defined(ENABLE_RVV)
+    if ((mstatus & MSTATUS_VS_MASK) != MSTATUS_VS_OFF) {
+        set_csr(mstatus, MSTATUS_VS_DIRTY);
+    }
+#endif
+
+    trap_set_handler(IRQ_M_TIMER, task_tick);
+    task_arm(hart);
+    set_csr(mie, MIE_MTIE);
+    set_csr(mstatus, MSTATUS_MIE);
+
+    /* The last task's exit switches back here with our registers restored */
+    while (task_live != 0) {
+        wfi();
+    }
+
+    clear_csr(mie, MIE_MTIE);
+    if (!(mstatus & MSTATUS_MIE)) {
+        clear_csr(mstatus, MSTATUS_MIE);
+    }
+    trap_set_handler(IRQ_M_TIMER, NULL);
+    task_count = 0;
+
+    if (stats) {
+        *stats = task_stats;
+    }
+    return 0;
+}
+
+#endif /* ENABLE_PREEMPT */
@@ -0,0 +1,102 @@
+/**
+ * @file trap.c
+ * @brief Machine-mode trap dispatch (C side of the startup.S vector table)
+ *
+ * See trap.h. Runs with mstatus.MIE clear (the hart cleared it on entry),
+ * so handlers never nest. Built with -fno-tree-vectorize: the entry code
+ * saves only the integer registers.
+ */
+
+#include "trap.h"
+
+#include "console.h"
+#include "csr.h"
+#include "platform.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* gem5 SE runs in user mode: no mtvec, nothing to dispatch */
+#if !(defined(PLATFORM_GEM5) && defined(GEM5_MODE_SE))
+
+/* =============================================================================
+ * Handler Table
+ * ============================================================================= */
+
+static volatile trap_handler_fn_t trap_handlers[TRAP_MAX_IRQ];
+
+/** Frame each hart's current interrupt resumes instead (NULL = its own) */
+static trap_frame_t *trap_next_frame[NUM_HARTS];
+
+void trap_set_handler(uint32_t irq, trap_handler_fn_t fn)
+{
+    if (irq < TRAP_MAX_IRQ) {
+        trap_handlers[irq] = fn;
+        mb(); /* Handler visible before the caller enables the source */
+    }
+}
+
+/* =============================================================================
+ * Dispatch
+ * ============================================================================= */
+
+/** Silence an interrupt nobody handles, so it does not fire again at once */
+static void trap_quiet_irq(uint32_t irq)
+{
+    uint64_t hart = csr_read_hartid();
+
+    switch (irq) {
+    case IRQ_M_SOFT:
+        /* An IPI only has to wake wfi (smp_send_ipi()): acknowledge it */
+        *(volatile uint32_t *) (CLINT_MSIP + 4UL * hart) = 0;
+        break;
+    case IRQ_M_TIMER:
+        *(volatile uint64_t *) (CLINT_MTIMECMP + 8UL * hart) = UINT64_MAX;
+        break;
+    default:
+        clear_csr(mie, 1UL << irq);
+        break;
+    }
+}
+
+void trap_switch_frame(trap_frame_t *next)
+{
+    uint64_t hart = csr_read_hartid();
+
+    if (hart < NUM_HARTS) {
+        trap_next_frame[hart] = next;
+    }
+}
+
+trap_frame_t *trap_handle_interrupt(trap_frame_t *frame)
+{
+    uint32_t irq = (uint32_t) (frame->mcause & ~CAUSE_INTERRUPT);
+    trap_handler_fn_t fn = irq < TRAP_MAX_IRQ ? trap_handlers[irq] : NULL;
+
+    if (fn) {
+        fn(frame);
+    } else {
+        trap_quiet_irq(irq);
+    }
+
+    uint64_t hart = csr_read_hartid();
+    if (hart < NUM_HARTS && trap_next_frame[hart]) {
+        frame = trap_next_frame[hart];
+        trap_next_frame[hart] = NULL;
+    }
+    return frame;
+}
+
+void trap_handle_exception(trap_frame_t *frame)
+{
+    /* Start on a fresh line: the hart may have trapped mid-printf */
+    console_printf("\n[TRAP] hart %lu exception mcause=%lu mepc=0x%lx mtval=0x%lx\n",
+                   csr_read_hartid(), frame->mcause, frame->mepc, frame->mtval);
+    console_flush();
+
+    while (1) {
+        wfi();
+    }
+}
+
+#endif /* !(PLATFORM_GEM5 && GEM5_MODE_SE) */
@@ -2,8 +2,10 @@
  * @file uart.c
  * @brief UART driver implementation for NS16550A
  *
- * Simple polled UART driver for QEMU virt machine, gem5, and Renode.
- * The NS16550A is a standard UART controller.
+ * Polled UART driver for QEMU virt machine, gem5, and Renode.
+ * The NS16550A is a standard UART controller. Transmit writes up to 16
+ * bytes (the TX FIFO depth) per THRE poll; with UART_TX_RING, output is
+ * staged in per-hart lock-free rings and drained in batches.
  *
  * Note: This file is only compiled for platforms with MMIO UART.
  * Spike uses HTIF instead (will be implemented in Phase 3).
@@ -11,6 +13,8 @@
 
 #include "uart.h"
 
+#include "atomic.h"
+#include "csr.h"
 #include "platform.h"
 
 #include <stdbool.h>
@@ -60,6 +64,147 @@
 
 #define UART_REG(offset) (*(volatile uint8_t *) (UART_BASE + (offset)))
 
+/** TX FIFO depth: after THRE, this many bytes can be written without polling */
+#define UART_TX_FIFO_DEPTH 16
+
+/* =============================================================================
+ * Transmit Path
+ * ============================================================================= */
+
+/**
+ * Burst writer state: bytes that may still be written before LSR must be
+ * polled again. THRE set means the whole 16-byte TX FIFO is empty.
+ */
+static uint32_t uart_tx_room;
+
+static inline void uart_tx_byte(uint8_t b)
+{
+    if (uart_tx_room == 0) {
+        while ((UART_REG(UART_LSR_OFFSET) & UART_LSR_THRE) == 0) {
+            /* Busy wait */
+        }
+        uart_tx_room = UART_TX_FIFO_DEPTH;
+    }
+    UART_REG(UART_THR_OFFSET) = b;
+    uart_tx_room--;
+}
+
+#if defined(UART_TX_RING)
+
+/*
+ * Per-hart SPSC transmit rings
+ *
+ * Each hart appends only to its own ring (single producer) and never
+ * takes a lock. One drainer at a time (single consumer, guarded by
+ * uart_drain_busy) copies rings to the UART in 16-byte FIFO bursts.
+ * Opportunistic drains emit only complete lines, so lines from
+ * different harts never interleave; uart_flush() emits everything.
+ *
+ * Drain points:
+ *   - hart 0 writes a newline and no other drain is running
+ *   - a producer finds its ring full (waits for the drainer, then drains)
+ *   - uart_flush() (platform_exit() calls it)
+ * Secondary harts therefore never poll the UART unless their ring fills,
+ * so output from timed sections does not perturb mcycle measurements.
+ */
+
+#ifndef UART_RING_SIZE
+#define UART_RING_SIZE 1024
+#endif
+
+#if (UART_RING_SIZE & (UART_RING_SIZE - 1)) != 0
+#error "UART_RING_SIZE must be a power of two"
+#endif
+
+typedef struct {
+    volatile uint32_t head __attribute__((aligned(64))); /* Producer only */
+    volatile uint32_t tail __attribute__((aligned(64))); /* Drainer only */
+    char buf[UART_RING_SIZE];
+} uart_ring_t;
+
+static uart_ring_t uart_rings[NUM_HARTS];
+
+/** 1 while a hart is draining (single-consumer guard) */
+static volatile uint32_t uart_drain_busy;
+
+static inline bool uart_drain_trylock(void)
+{
+    return atomic_swap_u32(&uart_drain_busy, 1) == 0;
+}
+
+static inline void uart_drain_unlock(void)
+{
+    atomic_store_u32(&uart_drain_busy, 0);
+}
+
+/** Drain one ring; whole_lines stops after the last complete line */
+static void uart_drain_ring(uart_ring_t *r, bool whole_lines)
+{
+    uint32_t tail = r->tail;
+    uint32_t head = r->head;
+    rmb(); /* Published head before the bytes behind it */
+
+    if (whole_lines) {
+        uint32_t end = head;
+        while (end != tail && r->buf[(end - 1) & (UART_RING_SIZE - 1)] != '\n') {
+            end--;
+        }
+        head = end;
+    }
+
+    for (; tail != head; tail++) {
+        char c = r->buf[tail & (UART_RING_SIZE - 1)];
+        if (c == '\n') {
+            uart_tx_byte('\r');
+        }
+        uart_tx_byte((uint8_t) c);
+    }
+
+    atomic_store_u32(&r->tail, tail); /* Release the slots to the producer */
+}
+
+static void uart_drain_all(bool whole_lines)
+{
+    for (uint32_t h = 0; h < NUM_HARTS; h++) {
+        uart_drain_ring(&uart_rings[h], whole_lines);
+    }
+}
+
+/** Append len bytes to the calling hart's ring; drains if it fills */
+static void uart_ring_write(const char *buf, size_t len)
+{
+    uint32_t hart = (uint32_t) csr_read_hartid();
+    uart_ring_t *r = &uart_rings[hart];
+    uint32_t head = r->head;
+    bool newline = false;
+
+    for (size_t i = 0; i < len; i++) {
+        if (head - r->tail >= UART_RING_SIZE) {
+            /* Full: publish what we have and drain it ourselves */
+            wmb();
+            r->head = head;
+            while (!uart_drain_trylock()) {
+                /* Another hart is draining */
+            }
+            uart_drain_ring(r, false);
+            uart_drain_unlock();
+        }
+        r->buf[head & (UART_RING_SIZE - 1)] = buf[i];
+        newline |= (buf[i] == '\n');
+        head++;
+    }
+
+    wmb(); /* Bytes before the new head */
+    r->head = head;
+
+    if (newline && hart == 0 && uart_drain_trylock()) {
+        uart_drain_all(true);
+        uart_drain_unlock();
+    }
+}
+
+#endif /* UART_TX_RING */
+
 /* =============================================================================
  * UART Implementation
  * ============================================================================= */
@@ -89,6 +234,9 @@ void uart_init(void)
 
 void uart_putc(char c)
 {
+#if defined(UART_TX_RING)
+    uart_ring_write(&c, 1);
+#else
     /* Wait until THR is empty (ready to transmit) */
     while ((UART_REG(UART_LSR_OFFSET) & UART_LSR_THRE) == 0) {
         /* Busy wait */
@@ -96,6 +244,7 @@ void uart_putc(char c)
 
     /* Write character to THR */
     UART_REG(UART_THR_OFFSET) = (uint8_t) c;
+#endif
 }
 
 void uart_puts(const char *s)
@@ -104,13 +253,23 @@ void uart_puts(const char *s)
         return;
     }
 
+#if defined(UART_TX_RING)
+    /* Ring drain converts \n to \r\n */
+    size_t len = 0;
+    while (s[len]) {
+        len++;
+    }
+    uart_ring_write(s, len);
+#else
+    /* Convert \n to \r\n; burst up to 16 bytes per THRE poll */
+    uart_tx_room = 0;
     while (*s) {
-        /* Convert \n to \r\n for proper line endings */
         if (*s == '\n') {
-            uart_putc('\r');
+            uart_tx_byte('\r');
         }
-        uart_putc(*s++);
+        uart_tx_byte((uint8_t) *s++);
     }
+#endif
 }
 
 void uart_write(const char *buf, size_t len)
@@ -119,9 +278,28 @@ void uart_write(const char *buf, size_t len)
         return;
     }
 
+#if defined(UART_TX_RING)
+    uart_ring_write(buf, len);
+#else
+    uart_tx_room = 0;
     for (size_t i = 0; i < len; i++) {
-        uart_putc(buf[i]);
+        if (buf[i] == '\n') {
+            uart_tx_byte('\r');
+        }
+        uart_tx_byte((uint8_t) buf[i]);
     }
+#endif
+}
+
+void uart_flush(void)
+{
+#if defined(UART_TX_RING)
+    while (!uart_drain_trylock()) {
+        /* Another hart is draining */
+    }
+    uart_drain_all(false);
+    uart_drain_unlock();
+#endif
 }
 
 char uart_getc(void)
@@ -167,6 +345,11 @@ void uart_write(const char *buf, size_t len)
     /* UART not available - use platform-specific I/O (HTIF for Spike) */
 }
 
+void uart_flush(void)
+{
+    /* UART not available */
+}
+
 char uart_getc(void)
 {
     /* UART not available */
@@ -102,7 +102,7 @@ function(add_qemu_run_target TARGET_NAME ELF_TARGET)
     
     # Add RVV configuration
     if(ENABLE_RVV)
-        list(APPEND QEMU_ARGS -cpu rv64,v=true,vlen=${VLEN})
+        list(APPEND QEMU_ARGS -cpu ${RVV_QEMU_CPU})
     endif()
     
     # Add kernel
@@ -124,7 +124,7 @@ function(add_spike_run_target TARGET_NAME ELF_TARGET)
 
     set(ISA_STRING "rv64gc")
     if(ENABLE_RVV)
-        set(ISA_STRING "rv64gcv")
+        set(ISA_STRING "${RVV_SPIKE_ISA}")
     endif()
     
     set(SPIKE_ARGS --isa=${ISA_STRING})
@@ -0,0 +1,134 @@
+"""
+gem5 Fast-Forward, Checkpoint and CPU Switch Support
+=====================================================
+
+Shared by se_config.py and fs_config.py. A detailed run (MinorCPU,
+DerivO3CPU, TimingSimpleCPU) spends most of its host time in boot, BSS
+clearing and console output ahead of the kernels. The app marks the end
+of that phase: its first roi_begin() issues an m5 switchcpu (default) or
+checkpoint op (CMake GEM5_ROI_MARK), which ends m5.simulate() with exit
+cause "switchcpu" or "checkpoint". Either cause is the ROI mark here.
+
+  --fast-forward        Start on AtomicSimpleCPU, already connected to the
+                        cache hierarchy of --cpu-type so the caches warm
+                        up, and switch to --cpu-type at the ROI mark.
+  --checkpoint-dir DIR  Run on AtomicSimpleCPU to the ROI mark, write a
+                        checkpoint to DIR and stop.
+  --restore-from DIR    Restore a checkpoint written by --checkpoint-dir
+                        (same config, --num-cpus and --mem-size) and run
+                        the rest on --cpu-type. Checkpoints hold
+                        architectural and memory state only, so the
+                        caches start cold.
+
+Without these options the ROI mark is ignored and the run continues on
+--cpu-type, as before.
+"""
+
+import m5
+from m5.objects import AtomicSimpleCPU
+
+# Exit causes of the app's ROI mark (m5 switchcpu / m5 checkpoint)
+ROI_MARK_CAUSES = ("switchcpu", "checkpoint")
+
+
+def add_arguments(parser):
+    """Add --fast-forward, --checkpoint-dir and --restore-from to parser."""
+    group = parser.add_mutually_exclusive_group()
+    group.add_argument(
+        "--fast-forward",
+        action="store_true",
+        help="Run on AtomicSimpleCPU up to the app's ROI mark, then switch to --cpu-type",
+    )
+    group.add_argument(
+        "--checkpoint-dir",
+        help="Write a checkpoint at the app's ROI mark to this directory and stop",
+    )
+    group.add_argument(
+        "--restore-from",
+        help="Restore a checkpoint written with --checkpoint-dir and run on --cpu-type",
+    )
+
+
+def validate(parser, args):
+    """Reject option combinations that have nothing to switch to."""
+    if (args.fast_forward or args.restore_from) and "Atomic" in args.cpu_type:
+        parser.error("--fast-forward/--restore-from need a detailed --cpu-type")
+
+
+def start_cpu_class(args):
+    """CPU class the simulation starts on."""
+    if args.fast_forward or args.checkpoint_dir or args.restore_from:
+        return AtomicSimpleCPU
+    return getattr(m5.objects, args.cpu_type)
+
+
+def add_switch_cpus(system, args, setup=None):
+    """
+    Create switched-out --cpu-type CPUs for system.cpu and return the
+    (old, new) pairs for m5.switchCpus(), or [] when no switch is due.
+    setup(cpu) applies config-specific settings (e.g. the FS PMA checker).
+    """
+    if not (args.fast_forward or args.restore_from):
+        return []
+
+    cpu_class = getattr(m5.objects, args.cpu_type)
+    switch_cpus = [cpu_class(switched_out=True, cpu_id=i) for i in range(len(system.cpu))]
+    for old, new in zip(system.cpu, switch_cpus):
+        new.system = system
+        new.workload = old.workload
+        new.clk_domain = old.clk_domain
+        new.isa = old.isa
+        new.createThreads()
+        if setup:
+            setup(new)
+    system.switch_cpus = switch_cpus
+    return list(zip(system.cpu, switch_cpus))
+
+
+def print_options(args):
+    """Print the fast-forward settings next to the config's banner."""
+    if args.fast_forward:
+        print(f"[gem5]   Fast-Fwd:  AtomicSimpleCPU -> {args.cpu_type} at ROI mark")
+    elif args.checkpoint_dir:
+        print(f"[gem5]   Checkpoint: {args.checkpoint_dir} at ROI mark")
+    elif args.restore_from:
+        print(f"[gem5]   Restore:   {args.restore_from} -> {args.cpu_type}")
+
+
+def _switch(system, switch_cpu_list, args):
+    m5.switchCpus(system, switch_cpu_list)
+    print(f"[gem5] Switched to {args.cpu_type} at tick {m5.curTick()}")
+
+
+def instantiate(system, args, switch_cpu_list):
+    """m5.instantiate(), restoring --restore-from and switching to --cpu-type right after."""
+    if args.restore_from:
+        m5.instantiate(args.restore_from)
+        print(f"[gem5] Restored checkpoint {args.restore_from} at tick {m5.curTick()}")
+        _switch(system, switch_cpu_list, args)
+    else:
+        m5.instantiate()
+
+
+def simulate(system, args, switch_cpu_list):
+    """
+    Run for at most --max-ticks, handling the ROI mark; returns the exit
+    event that ended the run (or the checkpoint's).
+    """
+    deadline = m5.curTick() + args.max_ticks
+    pending = bool(args.fast_forward)
+
+    while True:
+        exit_event = m5.simulate(max(deadline - m5.curTick(), 1))
+        cause = exit_event.getCause()
+        if cause not in ROI_MARK_CAUSES:
+            return exit_event
+
+        print(f"[gem5] ROI mark ({cause}) at tick {m5.curTick()}")
+        if args.checkpoint_dir:
+            m5.checkpoint(args.checkpoint_dir)
+            print(f"[gem5] Checkpoint written: {args.checkpoint_dir}")
+            return exit_event
+        if pending:
+            _switch(system, switch_cpu_list, args)
+            pending = False
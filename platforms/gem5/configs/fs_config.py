@@ -23,8 +23,16 @@ Options:
   --l1d-size    L1 data cache size (default: 32kB)
   --l1i-size    L1 instruction cache size (default: 32kB)
   --l2-size     L2 cache size (default: 256kB)
+  --vlen        RVV VLEN in bits (default: gem5's, 256)
   --max-ticks   Maximum simulation ticks (default: 10000000000)
   --cmd         Path to the bare-metal ELF binary (required)
+
+Fast-forward (fastforward.py; the app marks its first roi_begin()):
+  --fast-forward    Run up to the mark on AtomicSimpleCPU through the
+                    caches, then switch to --cpu-type
+  --checkpoint-dir  Run up to the mark on AtomicSimpleCPU, write a
+                    checkpoint there and stop
+  --restore-from    Resume such a checkpoint on --cpu-type
 """
 
 import argparse
@@ -35,6 +43,9 @@ import m5
 from m5.objects import *
 from m5.util import addToPath
 
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import fastforward
+
 # =============================================================================
 # Parse Command-Line Arguments
 # =============================================================================
@@ -63,6 +74,10 @@ parser.add_argument(
 parser.add_argument(
     "--l2-size", default="256kB", help="L2 cache size (default: 256kB)"
 )
+parser.add_argument(
+    "--vlen", type=int, default=None,
+    help="Vector register length in bits (default: gem5's RiscvISA default)",
+)
 parser.add_argument(
     "--max-ticks",
     type=int,
@@ -73,7 +88,10 @@ parser.add_argument(
     "--cmd", "--kernel", required=True, help="Path to bare-metal ELF binary"
 )
 
+fastforward.add_arguments(parser)
+
 args = parser.parse_args()
+fastforward.validate(parser, args)
 
 # Validate kernel/binary exists
 if not os.path.exists(args.cmd):
@@ -95,8 +113,9 @@ system.clk_domain = SrcClockDomain()
 system.clk_domain.clock = "1GHz"
 system.clk_domain.voltage_domain = VoltageDomain()
 
-# Memory mode depends on CPU type
-if "Atomic" in args.cpu_type:
+# Memory mode depends on the CPU type the run starts on
+start_cpu_class = fastforward.start_cpu_class(args)
+if start_cpu_class is AtomicSimpleCPU:
     system.mem_mode = "atomic"
 else:
     system.mem_mode = "timing"
@@ -150,14 +169,16 @@ system.platform.setNumCores(args.num_cpus)
 # CPU Configuration
 # =============================================================================
 
-cpu_class = getattr(m5.objects, args.cpu_type)
-system.cpu = [cpu_class() for _ in range(args.num_cpus)]
+system.cpu = [start_cpu_class() for _ in range(args.num_cpus)]
 
 # Configure each CPU
 for i, cpu in enumerate(system.cpu):
     cpu.cpu_id = i
     cpu.createInterruptController()
     cpu.createThreads()
+    if args.vlen:
+        for isa in cpu.isa:
+            isa.vlen = args.vlen
 
 # PMA checker for uncacheable device regions
 uncacheable_range = [
@@ -238,12 +259,23 @@ system.iobridge.mem_side_port = system.membus.cpu_side_ports
 system.workload = RiscvBareMetal()
 system.workload.bootloader = args.cmd
 
+# =============================================================================
+# Fast-Forward CPUs
+# =============================================================================
+
+
+def setup_switch_cpu(cpu):
+    cpu.mmu.pma_checker = PMAChecker(uncacheable=uncacheable_range)
+
+
+switch_cpu_list = fastforward.add_switch_cpus(system, args, setup_switch_cpu)
+
 # =============================================================================
 # Root and Instantiation
 # =============================================================================
 
 root = Root(full_system=True, system=system)
-m5.instantiate()
+fastforward.instantiate(system, args, switch_cpu_list)
 
 # =============================================================================
 # Simulation
@@ -255,13 +287,16 @@ print(f"[gem5]   CPU Type:  {args.cpu_type}")
 print(f"[gem5]   Num CPUs:  {args.num_cpus}")
 print(f"[gem5]   Mem Size:  {args.mem_size}")
 print(f"[gem5]   Max Ticks: {args.max_ticks}")
+if args.vlen:
+    print(f"[gem5]   VLEN:      {args.vlen}")
+fastforward.print_options(args)
 if "Atomic" not in args.cpu_type:
     print(f"[gem5]   L1d Size:  {args.l1d_size}")
     print(f"[gem5]   L1i Size:  {args.l1i_size}")
     print(f"[gem5]   L2 Size:   {args.l2_size}")
 print()
 
-exit_event = m5.simulate(args.max_ticks)
+exit_event = fastforward.simulate(system, args, switch_cpu_list)
 
 print()
 print(f"[gem5] Simulation finished at tick {m5.curTick()}")
@@ -21,9 +21,17 @@ Options:
   --l1d-size    L1 data cache size (default: 32kB)
   --l1i-size    L1 instruction cache size (default: 32kB)
   --l2-size     L2 cache size (default: 256kB)
+  --vlen        RVV VLEN in bits (default: gem5's, 256)
   --max-ticks   Maximum simulation ticks (default: 10000000000)
   --cmd         Path to the binary (required)
 
+Fast-forward (fastforward.py; the app marks its first roi_begin()):
+  --fast-forward    Run up to the mark on AtomicSimpleCPU through the
+                    caches, then switch to --cpu-type
+  --checkpoint-dir  Run up to the mark on AtomicSimpleCPU, write a
+                    checkpoint there and stop
+  --restore-from    Resume such a checkpoint on --cpu-type
+
 Note:
   The binary must be compiled for gem5 SE mode (GEM5_MODE_SE defined).
   It uses Linux syscalls (write/exit_group) via ecall for I/O.
@@ -37,6 +45,9 @@ import m5
 from m5.objects import *
 from m5.util import addToPath
 
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import fastforward
+
 # =============================================================================
 # Parse Command-Line Arguments
 # =============================================================================
@@ -65,6 +76,10 @@ parser.add_argument(
 parser.add_argument(
     "--l2-size", default="256kB", help="L2 cache size (default: 256kB)"
 )
+parser.add_argument(
+    "--vlen", type=int, default=None,
+    help="Vector register length in bits (default: gem5's RiscvISA default)",
+)
 parser.add_argument(
     "--max-ticks",
     type=int,
@@ -78,7 +93,10 @@ parser.add_argument(
     "--options", default="", help="Arguments to pass to the binary"
 )
 
+fastforward.add_arguments(parser)
+
 args = parser.parse_args()
+fastforward.validate(parser, args)
 
 # Validate binary exists
 if not os.path.exists(args.cmd):
@@ -96,8 +114,9 @@ system.clk_domain = SrcClockDomain()
 system.clk_domain.clock = "1GHz"
 system.clk_domain.voltage_domain = VoltageDomain()
 
-# Memory mode depends on CPU type
-if "Atomic" in args.cpu_type:
+# Memory mode depends on the CPU type the run starts on
+start_cpu_class = fastforward.start_cpu_class(args)
+if start_cpu_class is AtomicSimpleCPU:
     system.mem_mode = "atomic"
 else:
     system.mem_mode = "timing"
@@ -109,13 +128,15 @@ system.mem_ranges = [AddrRange(start=0x80000000, size=args.mem_size)]
 # CPU Configuration
 # =============================================================================
 
-cpu_class = getattr(m5.objects, args.cpu_type)
-system.cpu = [cpu_class() for _ in range(args.num_cpus)]
+system.cpu = [start_cpu_class() for _ in range(args.num_cpus)]
 
 for i, cpu in enumerate(system.cpu):
     cpu.cpu_id = i
     cpu.createInterruptController()
     cpu.createThreads()
+    if args.vlen:
+        for isa in cpu.isa:
+            isa.vlen = args.vlen
 
 # =============================================================================
 # Memory Hierarchy
@@ -200,12 +221,18 @@ if args.options:
 for cpu in system.cpu:
     cpu.workload = process
 
+# =============================================================================
+# Fast-Forward CPUs
+# =============================================================================
+
+switch_cpu_list = fastforward.add_switch_cpus(system, args)
+
 # =============================================================================
 # Root and Instantiation
 # =============================================================================
 
 root = Root(full_system=False, system=system)
-m5.instantiate()
+fastforward.instantiate(system, args, switch_cpu_list)
 
 # =============================================================================
 # Simulation
@@ -217,9 +244,12 @@ print(f"[gem5]   CPU Type:  {args.cpu_type}")
 print(f"[gem5]   Num CPUs:  {args.num_cpus}")
 print(f"[gem5]   Mem Size:  {args.mem_size}")
 print(f"[gem5]   Max Ticks: {args.max_ticks}")
+if args.vlen:
+    print(f"[gem5]   VLEN:      {args.vlen}")
+fastforward.print_options(args)
 print()
 
-exit_event = m5.simulate(args.max_ticks)
+exit_event = fastforward.simulate(system, args, switch_cpu_list)
 
 print()
 print(f"[gem5] Simulation finished at tick {m5.curTick()}")
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""
+RVV Backend Comparison
+======================
+
+Compares the benchmark runner output of two builds of the app, typically
+the inline-asm and the intrinsics kernel backends (CMake
+-DRVV_BACKEND=asm|intrinsics) run on the same simulator and CPU model:
+
+  cmake -B build-asm  -DENABLE_RVV=ON -DRVV_BACKEND=asm ...
+  cmake -B build-intr -DENABLE_RVV=ON -DRVV_BACKEND=intrinsics ...
+  (run both binaries, saving the console output)
+  python3 compare-backends.py asm.log intrinsics.log
+
+Both logs are parsed with perf-regress.py's [BENCH-CSV]/[BENCH-JSON]
+reader. For every RVV kernel and size present in both, the median cycles
+(or instret) are printed side by side with the ratio test/base; a ratio
+below 1.00 means the second build is faster. The last line is the
+geometric mean of the ratios.
+
+Usage:
+  python3 compare-backends.py [--metric cycles|instret] [--impl rvv] BASE.log TEST.log
+
+Exit status is 1 when the logs share no benchmark results.
+"""
+
+import argparse
+import importlib.util
+import math
+import os
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def load_perf_regress():
+    """Import perf-regress.py (hyphenated name) as a module."""
+    path = os.path.join(SCRIPT_DIR, "perf-regress.py")
+    spec = importlib.util.spec_from_file_location("perf_regress", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two RVV benchmark runner logs")
+    parser.add_argument("base", help="Baseline log (e.g. the asm backend)")
+    parser.add_argument("test", help="Log to compare (e.g. the intrinsics backend)")
+    parser.add_argument("--metric", default="cycles", choices=["cycles", "instret"],
+                        help="Metric to compare (default: cycles)")
+    parser.add_argument("--impl", default="rvv",
+                        help="Implementation column to compare (default: rvv)")
+    args = parser.parse_args()
+
+    perf = load_perf_regress()
+    for path in (args.base, args.test):
+        if not os.path.exists(path):
+            print(f"Error: log not found: {path}", file=sys.stderr)
+            return 2
+
+    base, base_platform, base_vlen, base_backend = perf.parse_bench_log(args.base)
+    test, test_platform, test_vlen, test_backend = perf.parse_bench_log(args.test)
+
+    base_name = base_backend or "base"
+    test_name = test_backend or "test"
+    if base_name == test_name:
+        base_name, test_name = "base", "test"
+
+    if (base_platform, base_vlen) != (test_platform, test_vlen):
+        print(f"Warning: comparing {base_platform}/vlen{base_vlen} with "
+              f"{test_platform}/vlen{test_vlen}")
+
+    rows = []
+    for key in sorted(base):
+        parts = key.split("/")
+        if parts[0] != "bench" or parts[2] != args.impl or key not in test:
+            continue
+        b = base[key].get(args.metric)
+        t = test[key].get(args.metric)
+        if not b or t is None:
+            continue
+        rows.append((parts[1], int(parts[3]), b, t, t / b))
+
+    if not rows:
+        print("Error: no common benchmark results", file=sys.stderr)
+        return 1
+
+    rows.sort(key=lambda r: (r[0], r[1]))
+    print(f"=== {args.impl} {args.metric}: {base_name} vs {test_name} "
+          f"({base_platform}, VLEN={base_vlen}) ===")
+    print(f"{'kernel':<18} {'n':>7} {base_name:>12} {test_name:>12} {'ratio':>7}")
+    for kernel, n, b, t, ratio in rows:
+        print(f"{kernel:<18} {n:>7} {b:>12} {t:>12} {ratio:>7.2f}")
+
+    geomean = math.exp(sum(math.log(r[4]) for r in rows if r[4] > 0) / len(rows))
+    faster = sum(1 for r in rows if r[4] < 1.0)
+    print(f"geomean ratio {geomean:.3f} ({test_name} faster on {faster}/{len(rows)})")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,78 @@
+#!/usr/bin/env bash
+# =============================================================================
+# Compare Spike console cost: batched HTIF syscall writes vs per-byte HTIF
+# =============================================================================
+# Builds the single-hart Spike app twice (HTIF_BATCHED_WRITE=ON and OFF),
+# runs the phase3_spike_* CTest tests against each build, and reports the
+# wall-clock time of each run and the speedup.
+#
+# Prerequisites:
+#   - RISC-V toolchain (riscv64-unknown-elf-gcc)
+#   - Spike on PATH
+#
+# Usage:
+#   ./scripts/compare-htif-console.sh [--runs N] [--work-dir DIR]
+#
+# =============================================================================
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(cd "${SCRIPT_DIR}/.." && pwd)"
+
+RUNS=5
+WORK_DIR="${PROJECT_ROOT}/build-htif-compare"
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --runs)
+            RUNS="$2"
+            shift 2
+            ;;
+        --work-dir)
+            WORK_DIR="$2"
+            shift 2
+            ;;
+        *)
+            echo "Usage: $0 [--runs N] [--work-dir DIR]"
+            exit 1
+            ;;
+    esac
+done
+
+# Build one variant: $1 = ON|OFF
+build_variant() {
+    local dir="${WORK_DIR}/batched-$1"
+    cmake -S "${PROJECT_ROOT}" -B "${dir}" \
+        -DPLATFORM=spike -DCONFIG=single -DNUM_HARTS=1 \
+        -DCMAKE_BUILD_TYPE=Release -DHTIF_BATCHED_WRITE="$1" > /dev/null
+    cmake --build "${dir}" -j"$(nproc)" > /dev/null
+}
+
+# Best-of-N wall-clock seconds for the phase3_spike tests: $1 = ON|OFF
+time_variant() {
+    local dir="${WORK_DIR}/batched-$1"
+    local best=""
+    for ((i = 0; i < RUNS; i++)); do
+        local t0 t1 dt
+        t0=$(date +%s.%N)
+        ctest --test-dir "${dir}" -R '^phase3_spike_' --output-on-failure > /dev/null
+        t1=$(date +%s.%N)
+        dt=$(awk -v a="${t0}" -v b="${t1}" 'BEGIN { printf "%.3f", b - a }')
+        if [[ -z "${best}" ]] || awk -v d="${dt}" -v b="${best}" 'BEGIN { exit !(d < b) }'; then
+            best="${dt}"
+        fi
+    done
+    echo "${best}"
+}
+
+echo "=== HTIF console comparison (phase3_spike_*, best of ${RUNS}) ==="
+build_variant OFF
+build_variant ON
+
+T_OFF=$(time_variant OFF)
+T_ON=$(time_variant ON)
+
+printf "  per-byte console (HTIF_BATCHED_WRITE=OFF): %8.3f s\n" "${T_OFF}"
+printf "  batched syscall  (HTIF_BATCHED_WRITE=ON):  %8.3f s\n" "${T_ON}"
+printf "  speedup:                                   %8.2fx\n" "$(awk -v a="${T_OFF}" -v b="${T_ON}" 'BEGIN { print a / b }')"
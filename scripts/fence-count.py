@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+Memory-Ordering Instruction Counter
+===================================
+
+Counts the ordering instructions of selected functions in app.dump
+(objdump -d output, generated by every build), so a change to the
+orderings in atomic.h callers can be checked without a simulator:
+
+  full      fence / fence rw,rw / fence iorw,iorw
+  acq       fence r,rw             (acquire)
+  rel       fence rw,w             (release)
+  tso       fence.tso              (acq_rel)
+  other     any other fence        (e.g. wmb()'s fence w,w)
+  amo       AMO and LR/SC instructions, split by suffix:
+            plain / .aq / .rl / .aqrl
+
+Counts are static (per instruction in the function body, not per
+execution). Inlined helpers count toward their caller.
+
+Usage:
+  python3 fence-count.py --dump build/app/app.dump [FUNC ...] [--max-full N]
+
+FUNC defaults to the SMP synchronization entry points (barrier_wait,
+smp_release_harts, smp_get_harts_online). --max-full makes the exit
+status 1 when the listed functions hold more than N full fences; a
+function missing from the dump is an error (exit 2).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+DUMP_LABEL_RE = re.compile(r"^[0-9a-fA-F]+ <([^>]+)>:$")
+DUMP_INSN_RE = re.compile(r"^\s+[0-9a-fA-F]+:\t[0-9a-fA-F ]+\t(\S+)\s*(\S*)")
+
+DEFAULT_FUNCS = ["barrier_wait", "smp_release_harts", "smp_get_harts_online"]
+COLUMNS = ["full", "acq", "rel", "tso", "other", "amo", "amo.aq", "amo.rl", "amo.aqrl"]
+
+
+def classify(mnemonic, operands):
+    """Column of one instruction, or None for non-ordering instructions."""
+    if mnemonic == "fence.tso":
+        return "tso"
+    if mnemonic == "fence":
+        pred, _, succ = operands.partition(",")
+        if not operands or ("r" in pred and "w" in pred and "r" in succ and "w" in succ):
+            return "full"
+        if pred == "r" and succ == "rw":
+            return "acq"
+        if pred == "rw" and succ == "w":
+            return "rel"
+        return "other"
+    if mnemonic.startswith(("amo", "lr.", "sc.")):
+        for suffix in (".aqrl", ".aq", ".rl"):
+            if mnemonic.endswith(suffix):
+                return "amo" + suffix
+        return "amo"
+    return None
+
+
+def parse_dump(path, funcs):
+    """Return {func: {column: count}} for the functions in funcs found in the dump."""
+    counts = {}
+    current = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = DUMP_LABEL_RE.match(line.strip())
+            if m:
+                current = m.group(1) if m.group(1) in funcs else None
+                if current:
+                    counts.setdefault(current, dict.fromkeys(COLUMNS, 0))
+                continue
+            if current is None:
+                continue
+            m = DUMP_INSN_RE.match(line)
+            if m:
+                col = classify(m.group(1), m.group(2))
+                if col:
+                    counts[current][col] += 1
+    return counts
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Count fences and AMO orderings per function")
+    parser.add_argument("--dump", required=True, help="Disassembly (build/app/app.dump)")
+    parser.add_argument("funcs", nargs="*", default=DEFAULT_FUNCS,
+                        help="Functions to count (default: %(default)s)")
+    parser.add_argument("--max-full", type=int,
+                        help="Fail when the functions hold more than this many full fences")
+    args = parser.parse_args()
+
+    if not os.path.exists(args.dump):
+        print(f"Error: file not found: {args.dump}", file=sys.stderr)
+        return 2
+
+    counts = parse_dump(args.dump, set(args.funcs))
+    missing = [f for f in args.funcs if f not in counts]
+    if missing:
+        print(f"Error: not in {args.dump}: {', '.join(missing)}", file=sys.stderr)
+        return 2
+
+    print(f"{'function':<28}" + "".join(f"{c:>9}" for c in COLUMNS))
+    for func in args.funcs:
+        print(f"{func:<28}" + "".join(f"{counts[func][c]:>9}" for c in COLUMNS))
+
+    full = sum(counts[f]["full"] for f in args.funcs)
+    fences = sum(counts[f][c] for f in args.funcs for c in ("full", "acq", "rel", "tso", "other"))
+    print(f"Full fences: {full} of {fences} fences")
+
+    if args.max_full is not None and full > args.max_full:
+        print(f"Error: {full} full fences, at most {args.max_full} expected")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
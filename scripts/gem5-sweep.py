@@ -0,0 +1,361 @@
+#!/usr/bin/env python3
+"""
+gem5 Design-Space Sweep
+=======================
+
+Runs the app on gem5 over a matrix of CPU model x L1D/L1I/L2 size x hart
+count x VLEN, as many runs at a time as there are host cores, and
+gathers the per-ROI stats of every run (one dump per roi_begin()/roi_end()
+region, see app/include/roi.h) into one table:
+
+  sweep.csv / sweep.json   one row per run and region: configuration,
+                           cycles, instructions, CPI, cache and TLB misses,
+                           DRAM bytes, vector instruction share and the speedup over
+                           the baseline run for the same region
+
+Every run gets its own directory, <out>/runs/<run-id>/, holding gem5.log
+(the console) and m5out/ (stats.txt, config.ini), so runs never share
+output. Hart count is fixed at build time (NUM_HARTS), so each count
+needs its own ELF: pass --elf <harts>=<path> once per build. Other
+build-time variants get a name: --elf <harts>:<build>=<path>, e.g. one
+ELF per Sv39 page size (MMU_PAGE_SIZE). VLEN is a gem5 RiscvISA
+parameter (--vlen of the configs) and needs no rebuild.
+
+Usage:
+  python3 gem5-sweep.py --elf build/gem5-fs-rvv/app/app.elf \\
+      --cpu-types MinorCPU,DerivO3CPU --l1d-sizes 16kB,32kB,64kB \\
+      --l2-sizes 256kB,1MB --vlens 128,256,512 --out sweep-out
+
+  python3 gem5-sweep.py --elf 1=build/h1/app/app.elf --elf 4=build/h4/app/app.elf \\
+      --cpu-types MinorCPU --fast-forward --jobs 16
+
+  python3 gem5-sweep.py --elf 1:4K=build/mmu-4k/app/app.elf \
+      --elf 1:2M=build/mmu-2m/app/app.elf --elf 1:1G=build/mmu-1g/app/app.elf \
+      --cpu-types TimingSimpleCPU
+
+Options:
+  --gem5 PATH         gem5.opt (default: $GEM5_OPT, gem5-build/ or /opt/gem5)
+  --config PATH       gem5 config (default: platforms/gem5/configs/fs_config.py)
+  --elf [HARTS[:BUILD]=]PATH
+                      App ELF built with NUM_HARTS=HARTS (default HARTS 1),
+                      optionally named BUILD; repeat for each build
+  --cpu-types LIST    CPU models (default: MinorCPU)
+  --l1d-sizes LIST    L1 data cache sizes (default: 32kB)
+  --l1i-sizes LIST    L1 instruction cache sizes (default: 32kB)
+  --l2-sizes LIST     L2 sizes (default: 256kB)
+  --vlens LIST        VLENs in bits (default: gem5's default only)
+  --baseline RUN-ID   Run the speedups are relative to (default: the first)
+  --fast-forward      Pass --fast-forward: boot on AtomicSimpleCPU
+  --max-ticks N       Per-run tick limit (default: 10000000000)
+  --timeout SEC       Per-run host time limit (default: none)
+  --jobs N            Parallel runs (default: host cores)
+  --out DIR           Output directory (default: gem5-sweep)
+  --skip-existing     Reuse runs whose stats.txt already exists
+  --dry-run           Print the gem5 command lines only
+
+AtomicSimpleCPU has no caches in the configs, so its runs ignore the
+cache-size axes. Exit status is 1 when any run failed or produced no
+ROI stats.
+"""
+
+import argparse
+import concurrent.futures
+import csv
+import importlib.util
+import itertools
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import time
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.dirname(SCRIPT_DIR)
+DEFAULT_CONFIG = os.path.join(REPO_DIR, "platforms", "gem5", "configs", "fs_config.py")
+
+# Per-region columns copied from parse-gem5-stats.py extract_roi_metrics()
+ROI_FIELDS = [
+    "num_cycles", "num_insts", "cpi", "l1d_misses", "l1d_miss_rate",
+    "l1i_misses", "l2_misses", "dtlb_misses", "dtlb_miss_rate", "itlb_misses",
+    "dram_read_bytes", "dram_write_bytes", "vector_insts", "vector_frac",
+]
+RUN_FIELDS = ["run", "cpu_type", "l1d_size", "l1i_size", "l2_size", "harts", "build", "vlen"]
+CSV_FIELDS = RUN_FIELDS + ["index", "region", "app_cycles"] + ROI_FIELDS + ["speedup"]
+
+
+def load_gem5_parser():
+    """Import parse-gem5-stats.py (hyphenated name) as a module."""
+    path = os.path.join(SCRIPT_DIR, "parse-gem5-stats.py")
+    spec = importlib.util.spec_from_file_location("parse_gem5_stats", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def default_gem5():
+    """gem5.opt from $GEM5_OPT, the workspace build or /opt/gem5."""
+    if os.environ.get("GEM5_OPT"):
+        return os.environ["GEM5_OPT"]
+    local = os.path.join(REPO_DIR, "gem5-build", "build", "RISCV", "gem5.opt")
+    return local if os.path.exists(local) else "/opt/gem5/build/RISCV/gem5.opt"
+
+
+def split_list(value):
+    return [v.strip() for v in value.split(",") if v.strip()]
+
+
+# =============================================================================
+# Run Matrix
+# =============================================================================
+
+def parse_elfs(specs):
+    """{(harts, build): path} from "[HARTS[:BUILD]=]PATH" arguments ("-": unnamed build)."""
+    elfs = {}
+    for spec in specs:
+        key, sep, path = spec.partition("=")
+        if not sep:
+            key, path = "1", spec
+        harts, _, build = key.partition(":")
+        if not harts.isdigit() or int(harts) < 1:
+            raise ValueError(f"bad hart count in --elf {spec}")
+        if not re.fullmatch(r"[-\w.]*", build):
+            raise ValueError(f"bad build name in --elf {spec}")
+        elfs[(int(harts), build or "-")] = path
+    return elfs
+
+
+def build_matrix(args, elfs):
+    """List of run dicts, one per distinct configuration, in a stable order."""
+    runs = []
+    seen = set()
+    vlens = [int(v) for v in split_list(args.vlens)] if args.vlens else [None]
+
+    for cpu, l1d, l1i, l2, (harts, build), vlen in itertools.product(
+        split_list(args.cpu_types), split_list(args.l1d_sizes), split_list(args.l1i_sizes),
+        split_list(args.l2_sizes), sorted(elfs, key=lambda e: e[0]), vlens,
+    ):
+        named = f"-{build}" if build != "-" else ""
+        suffix = f"h{harts}{named}-v{vlen or 'default'}"
+        if "Atomic" in cpu:
+            l1d = l1i = l2 = "-"
+            run_id = f"{cpu}-{suffix}"
+        else:
+            run_id = f"{cpu}-l1d{l1d}-l1i{l1i}-l2{l2}-{suffix}"
+        if run_id in seen:
+            continue
+        seen.add(run_id)
+        runs.append({
+            "run": run_id, "cpu_type": cpu, "l1d_size": l1d, "l1i_size": l1i,
+            "l2_size": l2, "harts": harts, "build": build, "vlen": vlen or "default",
+            "elf": elfs[(harts, build)],
+        })
+    return runs
+
+
+def gem5_command(args, run, outdir):
+    cmd = [
+        args.gem5, f"--outdir={os.path.join(outdir, 'm5out')}", args.config,
+        f"--cpu-type={run['cpu_type']}",
+        f"--num-cpus={run['harts']}",
+        f"--cmd={run['elf']}",
+        f"--max-ticks={args.max_ticks}",
+    ]
+    if run["l1d_size"] != "-":
+        cmd += [f"--l1d-size={run['l1d_size']}", f"--l1i-size={run['l1i_size']}",
+                f"--l2-size={run['l2_size']}"]
+    if run["vlen"] != "default":
+        cmd.append(f"--vlen={run['vlen']}")
+    if args.fast_forward and "Atomic" not in run["cpu_type"]:
+        cmd.append("--fast-forward")
+    return cmd
+
+
+# =============================================================================
+# Execution
+# =============================================================================
+
+def execute(args, run):
+    """Run one configuration; returns (run, status, host seconds)."""
+    outdir = os.path.join(args.out, "runs", run["run"])
+    stats = os.path.join(outdir, "m5out", "stats.txt")
+    log = os.path.join(outdir, "gem5.log")
+
+    if args.skip_existing and os.path.exists(stats) and os.path.exists(log):
+        return run, "reused", 0.0
+
+    os.makedirs(outdir, exist_ok=True)
+    cmd = gem5_command(args, run, outdir)
+    start = time.time()
+    try:
+        with open(log, "w") as f:
+            proc = subprocess.run(cmd, stdout=f, stderr=subprocess.STDOUT,
+                                  timeout=args.timeout, check=False)
+        status = "ok" if proc.returncode == 0 else f"exit {proc.returncode}"
+    except subprocess.TimeoutExpired:
+        status = "timeout"
+    except OSError as e:
+        status = f"error: {e.strerror}"
+    return run, status, time.time() - start
+
+
+def collect(gem5, args, run):
+    """Per-region rows of one finished run (without the speedup column)."""
+    outdir = os.path.join(args.out, "runs", run["run"])
+    stats = os.path.join(outdir, "m5out", "stats.txt")
+    log = os.path.join(outdir, "gem5.log")
+    if not os.path.exists(stats) or not os.path.exists(log):
+        return []
+
+    dumps = gem5.parse_stats_dumps(stats)
+    regions = gem5.parse_roi_log(log)
+    rows = []
+    for roi in gem5.extract_roi_metrics(dumps, regions):
+        if roi["region"] == "(exit)":
+            continue
+        row = {k: run[k] for k in RUN_FIELDS}
+        row["index"] = roi["index"]
+        row["region"] = roi["region"]
+        row["app_cycles"] = roi["app_cycles"]
+        for k in ROI_FIELDS:
+            row[k] = roi[k]
+        rows.append(row)
+    return rows
+
+
+def add_speedups(rows, baseline):
+    """speedup = baseline cycles / cycles of the same region (None if either is missing)."""
+    base = {r["region"]: r["num_cycles"] for r in rows if r["run"] == baseline}
+    for r in rows:
+        ref = base.get(r["region"])
+        r["speedup"] = round(ref / r["num_cycles"], 4) if ref and r["num_cycles"] else None
+
+
+# =============================================================================
+# Output
+# =============================================================================
+
+def write_csv(path, rows):
+    with open(path, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=CSV_FIELDS)
+        writer.writeheader()
+        for r in rows:
+            writer.writerow({k: "" if r.get(k) is None else r[k] for k in CSV_FIELDS})
+
+
+def write_json(path, runs, rows, baseline):
+    data = {
+        "baseline": baseline,
+        "runs": [{k: v for k, v in run.items()} for run in runs],
+        "rows": [{k: v for k, v in r.items() if v is not None} for r in rows],
+    }
+    with open(path, "w") as f:
+        json.dump(data, f, indent=2)
+        f.write("\n")
+
+
+def print_summary(runs, rows, baseline):
+    """One line per run: status, host time, ROI cycles summed over regions, speedup."""
+    total = {}
+    for r in rows:
+        if r["num_cycles"] is not None:
+            total[r["run"]] = total.get(r["run"], 0) + r["num_cycles"]
+    base = total.get(baseline)
+    width = max(len("Run"), *(len(run["run"]) for run in runs))
+
+    print(f"\n  {'Run':<{width}} {'Status':>8} {'Host s':>8} {'ROI Cycles':>16} {'Speedup':>8}")
+    for run in runs:
+        cycles = total.get(run["run"])
+        speedup = f"{base / cycles:.2f}x" if base and cycles else "N/A"
+        print(f"  {run['run']:<{width}} {run['status']:>8} {run['host_seconds']:>8.1f} "
+              f"{cycles if cycles is not None else 'N/A':>16} {speedup:>8}")
+
+
+# =============================================================================
+# Main
+# =============================================================================
+
+def main():
+    parser = argparse.ArgumentParser(description="Parallel gem5 design-space sweep")
+    parser.add_argument("--gem5", default=default_gem5(), help="gem5.opt binary")
+    parser.add_argument("--config", default=DEFAULT_CONFIG, help="gem5 config script")
+    parser.add_argument("--elf", action="append", required=True,
+                        help="[HARTS[:BUILD]=]PATH of an app ELF built with NUM_HARTS=HARTS")
+    parser.add_argument("--cpu-types", default="MinorCPU", help="Comma-separated CPU models")
+    parser.add_argument("--l1d-sizes", default="32kB", help="Comma-separated L1D sizes")
+    parser.add_argument("--l1i-sizes", default="32kB", help="Comma-separated L1I sizes")
+    parser.add_argument("--l2-sizes", default="256kB", help="Comma-separated L2 sizes")
+    parser.add_argument("--vlens", default=None, help="Comma-separated VLENs in bits")
+    parser.add_argument("--baseline", default=None, help="Run ID the speedups refer to")
+    parser.add_argument("--fast-forward", action="store_true",
+                        help="Boot on AtomicSimpleCPU, switch at the first ROI")
+    parser.add_argument("--max-ticks", type=int, default=10000000000, help="Per-run tick limit")
+    parser.add_argument("--timeout", type=float, default=None, help="Per-run host seconds")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="Parallel runs")
+    parser.add_argument("--out", default="gem5-sweep", help="Output directory")
+    parser.add_argument("--skip-existing", action="store_true",
+                        help="Reuse runs whose stats.txt exists")
+    parser.add_argument("--dry-run", action="store_true", help="Print the commands only")
+    args = parser.parse_args()
+
+    try:
+        elfs = parse_elfs(args.elf)
+    except ValueError as e:
+        parser.error(str(e))
+    runs = build_matrix(args, elfs)
+    if not runs:
+        parser.error("empty sweep matrix")
+    baseline = args.baseline or runs[0]["run"]
+    if baseline not in (run["run"] for run in runs):
+        parser.error(f"--baseline {baseline} is not in the matrix")
+
+    args.out = os.path.abspath(args.out)
+    if args.dry_run:
+        for run in runs:
+            outdir = os.path.join(args.out, "runs", run["run"])
+            print(" ".join(shlex.quote(c) for c in gem5_command(args, run, outdir)))
+        return 0
+
+    for path in [args.gem5, args.config] + list(elfs.values()):
+        if not os.path.exists(path):
+            print(f"Error: file not found: {path}", file=sys.stderr)
+            return 2
+
+    jobs = max(1, min(args.jobs, len(runs)))
+    print(f"=== gem5 sweep: {len(runs)} runs, {jobs} at a time, output in {args.out} ===")
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as pool:
+        futures = [pool.submit(execute, args, run) for run in runs]
+        for done, future in enumerate(concurrent.futures.as_completed(futures), 1):
+            run, status, seconds = future.result()
+            run["status"] = status
+            run["host_seconds"] = round(seconds, 1)
+            print(f"[{done}/{len(runs)}] {run['run']}: {status} ({seconds:.0f}s)", flush=True)
+
+    gem5 = load_gem5_parser()
+    rows = []
+    failed = 0
+    for run in runs:
+        run_rows = collect(gem5, args, run)
+        if run["status"] not in ("ok", "reused") or not run_rows:
+            failed += 1
+        rows.extend(run_rows)
+    add_speedups(rows, baseline)
+
+    write_csv(os.path.join(args.out, "sweep.csv"), rows)
+    write_json(os.path.join(args.out, "sweep.json"), runs, rows, baseline)
+    print_summary(runs, rows, baseline)
+    print(f"\nBaseline: {baseline}")
+    print(f"Table: {os.path.join(args.out, 'sweep.csv')} ({len(rows)} rows), "
+          f"{os.path.join(args.out, 'sweep.json')}")
+
+    if failed:
+        print(f"=== gem5 sweep: {failed} of {len(runs)} runs failed or gave no ROI stats ===")
+        return 1
+    print("=== gem5 sweep PASSED ===")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
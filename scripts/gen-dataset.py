@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""
+Dataset Generator
+=================
+
+Writes float32 matrices and vectors in the app's RVDS dataset format
+(app/include/dataset.h) for the gem5 SE dataset benchmarks. The app maps
+the files in place (mmap), so inputs can be many megabytes without
+touching the ELF or rebuilding:
+
+  gem5.opt se_config.py --cmd=app.elf --options="a.rvds b.rvds"
+
+Layout (little endian):
+  0   magic "RVDS", version, dtype (1 = f32), elem_size
+  16  rows, cols, data_offset, data_bytes (u64), 16 reserved bytes
+  64  rows * cols float32 elements, row-major
+
+Usage:
+  python3 gen-dataset.py --rows 256 --cols 1024 --seed 1 a.rvds
+  python3 gen-dataset.py --rows 1 --cols 1048576 vec.rvds
+  python3 gen-dataset.py --info a.rvds
+
+Options:
+  --rows N      Rows (1 for a vector; default 1)
+  --cols N      Columns (required)
+  --seed N      Random seed (default 1); values are uniform in [-1, 1)
+  --info        Print the header of an existing dataset instead
+"""
+
+import argparse
+import array
+import random
+import struct
+import sys
+
+MAGIC = 0x53445652  # "RVDS"
+VERSION = 1
+DTYPE_F32 = 1
+HEADER = struct.Struct("<IIIIQQQQ16x")
+DATA_OFFSET = 64
+
+
+def write_dataset(path, rows, cols, seed):
+    """Write a rows x cols float32 dataset of seeded uniform values."""
+    rng = random.Random(seed)
+    data = array.array("f", (rng.uniform(-1.0, 1.0) for _ in range(rows * cols)))
+    if sys.byteorder != "little":
+        data.byteswap()
+
+    data_bytes = rows * cols * 4
+    with open(path, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, DTYPE_F32, 4, rows, cols, DATA_OFFSET, data_bytes))
+        f.write(data.tobytes())
+    return data_bytes
+
+
+def print_info(path):
+    """Print a dataset's header; returns False when it is not an RVDS file."""
+    with open(path, "rb") as f:
+        raw = f.read(HEADER.size)
+    if len(raw) < HEADER.size:
+        print(f"Error: {path}: shorter than the header", file=sys.stderr)
+        return False
+    magic, version, dtype, elem, rows, cols, offset, nbytes = HEADER.unpack(raw)
+    if magic != MAGIC:
+        print(f"Error: {path}: not an RVDS dataset", file=sys.stderr)
+        return False
+    print(f"{path}: v{version} dtype={dtype} elem={elem} {rows}x{cols} "
+          f"data@{offset} ({nbytes} bytes)")
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Write RVDS float32 datasets")
+    parser.add_argument("path", help="Output file (or input with --info)")
+    parser.add_argument("--rows", type=int, default=1, help="Rows (default 1)")
+    parser.add_argument("--cols", type=int, help="Columns")
+    parser.add_argument("--seed", type=int, default=1, help="Random seed (default 1)")
+    parser.add_argument("--info", action="store_true", help="Print the header of PATH")
+    args = parser.parse_args()
+
+    if args.info:
+        sys.exit(0 if print_info(args.path) else 1)
+
+    if args.cols is None or args.rows < 1 or args.cols < 1:
+        parser.error("--cols (and --rows) must be positive")
+
+    nbytes = write_dataset(args.path, args.rows, args.cols, args.seed)
+    print(f"[gen-dataset] {args.path}: {args.rows}x{args.cols} float32 ({nbytes} bytes)")
+
+
+if __name__ == "__main__":
+    main()
@@ -8,7 +8,8 @@ Parses gem5's stats.txt output and extracts key performance metrics:
   - CPI (Cycles Per Instruction)
   - Instructions executed
   - Cache hit/miss rates (L1I, L1D, L2)
-  - Memory accesses
+  - TLB misses (data and instruction; Sv39 builds, -DENABLE_MMU=ON)
+  - Memory accesses and DRAM bytes read/written
   - Pipeline statistics (for MinorCPU/O3CPU)
 
 Usage:
@@ -16,13 +17,29 @@ Usage:
   python3 parse-gem5-stats.py m5out/stats.txt
   python3 parse-gem5-stats.py --json m5out/stats.txt
   python3 parse-gem5-stats.py --compare m5out/atomic/stats.txt m5out/timing/stats.txt
+  python3 parse-gem5-stats.py --roi --roi-log gem5.log m5out/stats.txt
 
 Options:
-  --json        Output in JSON format
-  --csv         Output in CSV format
-  --compare     Compare two stats files side by side
-  --verbose     Show all parsed stats
-  --filter KEY  Only show stats matching KEY pattern
+  --json          Output in JSON format
+  --csv           Output in CSV format
+  --compare       Compare two stats files side by side
+  --verbose       Show all parsed stats
+  --filter KEY    Only show stats matching KEY pattern
+  --roi           Split a multi-dump stats.txt into per-region tables
+                  (CPI, cache and TLB misses, DRAM traffic, vector
+                  instructions)
+  --roi-log FILE  Simulator output with the app's "[ROI] <index> <name>
+                  cycles=<n>" report, used to name the regions
+  --expect-region NAME
+                  (--roi) Fail unless region NAME was dumped; repeatable
+  --expect-dram-read-below REGION:BASE
+                  (--roi) Fail unless REGION read fewer DRAM bytes than
+                  BASE (both must be present); repeatable
+
+ROI mode: the app's roi_begin()/roi_end() (app/include/roi.h) reset
+stats before and dump them after each kernel run, so dump k of stats.txt
+covers exactly region k. Dumps beyond the reported regions (the final
+dump at exit) are labelled "(exit)".
 """
 
 import argparse
@@ -68,6 +85,58 @@ def parse_stats_file(filepath):
     return stats
 
 
+def parse_stats_dumps(filepath):
+    """Parse a multi-dump gem5 stats.txt into one dictionary per dump."""
+    dumps = []
+    current = None
+
+    if not os.path.exists(filepath):
+        print(f"Error: Stats file not found: {filepath}", file=sys.stderr)
+        return dumps
+
+    with open(filepath, "r") as f:
+        for line in f:
+            line = line.strip()
+
+            if "Begin Simulation Statistics" in line:
+                current = {}
+                continue
+            if "End Simulation Statistics" in line:
+                if current is not None:
+                    dumps.append(current)
+                current = None
+                continue
+            if current is None or not line:
+                continue
+
+            match = re.match(r"^(\S+)\s+([\d.eE+-]+(?:%?)?)\s*(?:#.*)?$", line)
+            if match:
+                value_str = match.group(2)
+                try:
+                    if "." in value_str or "e" in value_str.lower():
+                        value = float(value_str.rstrip("%"))
+                    else:
+                        value = int(value_str)
+                except ValueError:
+                    value = value_str
+                current[match.group(1)] = value
+
+    return dumps
+
+
+def parse_roi_log(filepath):
+    """Read "[ROI] <index> <name> cycles=<n>" lines; return {index: (name, cycles)}."""
+    regions = {}
+
+    with open(filepath, "r", errors="replace") as f:
+        for line in f:
+            match = re.search(r"\[ROI\] (\d+) (\S+) cycles=(\d+)", line)
+            if match:
+                regions[int(match.group(1))] = (match.group(2), int(match.group(3)))
+
+    return regions
+
+
 def extract_key_metrics(stats, cpu_id=0):
     """Extract key performance metrics from parsed stats."""
     prefix = f"system.cpu" if cpu_id == 0 else f"system.cpu{cpu_id}"
@@ -77,10 +146,11 @@ def extract_key_metrics(stats, cpu_id=0):
         # Try exact name first
         if name in stats:
             return stats[name]
-        # Try with cpu prefix
-        full_name = f"{prefix}.{name}"
-        if full_name in stats:
-            return stats[full_name]
+        # Try with cpu prefix (system.cpu0 when the system has several CPUs)
+        for cpu_prefix in (prefix, f"system.cpu{cpu_id}"):
+            full_name = f"{cpu_prefix}.{name}"
+            if full_name in stats:
+                return stats[full_name]
         # Try system-level
         sys_name = f"system.{name}"
         if sys_name in stats:
@@ -137,13 +207,187 @@ def extract_key_metrics(stats, cpu_id=0):
     else:
         metrics["l2_hit_rate"] = None
 
+    # TLBs (system.cpu.mmu.{dtb,itb}; misses start page walks)
+    metrics["dtlb_misses"] = get_stat("mmu.dtb.misses")
+    metrics["dtlb_accesses"] = get_stat("mmu.dtb.accesses")
+    metrics["itlb_misses"] = get_stat("mmu.itb.misses")
+    if metrics["dtlb_accesses"] and metrics["dtlb_misses"] is not None:
+        metrics["dtlb_miss_rate"] = metrics["dtlb_misses"] / metrics["dtlb_accesses"] * 100.0
+    else:
+        metrics["dtlb_miss_rate"] = None
+
     # Memory controller
     metrics["mem_reads"] = stats.get("system.mem_ctrl.readReqs")
     metrics["mem_writes"] = stats.get("system.mem_ctrl.writeReqs")
 
+    # DRAM bytes (per-requestor totals of the DRAM interface, else the controller's)
+    def first_stat(*names):
+        for name in names:
+            if name in stats:
+                return stats[name]
+        return None
+
+    metrics["dram_read_bytes"] = first_stat(
+        "system.mem_ctrl.dram.bytesRead::total", "system.mem_ctrl.bytesReadSys")
+    metrics["dram_write_bytes"] = first_stat(
+        "system.mem_ctrl.dram.bytesWritten::total", "system.mem_ctrl.bytesWrittenSys")
+
     return metrics
 
 
+def count_vector_insts(stats, cpu_id=0):
+    """Sum committed vector/SIMD instruction classes for one CPU (None if absent)."""
+    prefix = "system.cpu" if cpu_id == 0 else f"system.cpu{cpu_id}"
+    pattern = re.compile(
+        rf"^{re.escape(prefix)}(?:0)?\.\S*committedInstType(?:_0)?::(?:Vector|Simd)\w*$"
+    )
+    total = None
+    for name, value in stats.items():
+        if pattern.match(name) and isinstance(value, (int, float)):
+            total = (total or 0) + value
+    return total
+
+
+def extract_roi_metrics(dumps, regions, cpu_id=0):
+    """One row of metrics per stats dump, named from the ROI report."""
+    rows = []
+    seen = {}
+
+    for index, stats in enumerate(dumps):
+        metrics = extract_key_metrics(stats, cpu_id)
+
+        if index in regions:
+            name, cycles = regions[index]
+        elif regions:
+            name, cycles = "(exit)", None
+        else:
+            name, cycles = f"roi{index}", None
+
+        # Sweeps reuse region names: number repeats as name#2, name#3, ...
+        seen[name] = seen.get(name, 0) + 1
+        if seen[name] > 1:
+            name = f"{name}#{seen[name]}"
+
+        insts = metrics.get("num_insts") or metrics.get("sim_insts")
+        cpi = metrics.get("cpi")
+        if cpi is None and metrics.get("num_cycles") and insts:
+            cpi = metrics["num_cycles"] / insts
+        vec = count_vector_insts(stats, cpu_id)
+        l1d_acc = metrics.get("l1d_accesses")
+        l1d_miss = metrics.get("l1d_misses")
+
+        rows.append({
+            "index": index,
+            "region": name,
+            "app_cycles": cycles,
+            "num_cycles": metrics.get("num_cycles"),
+            "num_insts": insts,
+            "cpi": cpi,
+            "l1d_misses": l1d_miss,
+            "l1d_miss_rate": (
+                l1d_miss / l1d_acc * 100.0 if l1d_acc and l1d_miss is not None else None
+            ),
+            "l1i_misses": metrics.get("l1i_misses"),
+            "l2_misses": metrics.get("l2_misses"),
+            "dtlb_misses": metrics.get("dtlb_misses"),
+            "dtlb_miss_rate": metrics.get("dtlb_miss_rate"),
+            "itlb_misses": metrics.get("itlb_misses"),
+            "dram_read_bytes": metrics.get("dram_read_bytes"),
+            "dram_write_bytes": metrics.get("dram_write_bytes"),
+            "vector_insts": vec,
+            "vector_frac": (vec / insts * 100.0) if vec is not None and insts else None,
+        })
+
+    return rows
+
+
+def print_roi_tables(rows):
+    """Print per-region CPI, cache and vector-instruction tables."""
+
+    def fmt(val, spec=","):
+        if val is None:
+            return "N/A"
+        return format(val, spec)
+
+    width = max([len("Region")] + [len(r["region"]) for r in rows])
+
+    print(f"\n{'=' * (width + 52)}")
+    print("  Per-Region Performance (one gem5 stats dump per ROI)")
+    print(f"{'=' * (width + 52)}")
+
+    print(f"\n  CPI:")
+    print(f"  {'#':>3} {'Region':<{width}} {'Cycles':>14} {'Insts':>14} {'CPI':>8}")
+    for r in rows:
+        print(f"  {r['index']:>3} {r['region']:<{width}} {fmt(r['num_cycles']):>14} "
+              f"{fmt(r['num_insts']):>14} {fmt(r['cpi'], '.4f'):>8}")
+
+    print(f"\n  Cache Misses:")
+    print(f"  {'#':>3} {'Region':<{width}} {'L1D Miss':>12} {'L1D Miss %':>10} "
+          f"{'L1I Miss':>10} {'L2 Miss':>10}")
+    for r in rows:
+        print(f"  {r['index']:>3} {r['region']:<{width}} {fmt(r['l1d_misses']):>12} "
+              f"{fmt(r['l1d_miss_rate'], '.2f'):>10} {fmt(r['l1i_misses']):>10} "
+              f"{fmt(r['l2_misses']):>10}")
+
+    if any(r["dtlb_misses"] is not None for r in rows):
+        print(f"\n  TLB Misses:")
+        print(f"  {'#':>3} {'Region':<{width}} {'DTLB Miss':>12} {'DTLB Miss %':>11} "
+              f"{'ITLB Miss':>10}")
+        for r in rows:
+            print(f"  {r['index']:>3} {r['region']:<{width}} {fmt(r['dtlb_misses']):>12} "
+                  f"{fmt(r['dtlb_miss_rate'], '.3f'):>11} {fmt(r['itlb_misses']):>10}")
+
+    if any(r["dram_read_bytes"] is not None for r in rows):
+        print(f"\n  DRAM Traffic:")
+        print(f"  {'#':>3} {'Region':<{width}} {'Read B':>14} {'Write B':>14} "
+              f"{'Bytes/Cycle':>11}")
+        for r in rows:
+            per_cycle = None
+            if r["num_cycles"] and r["dram_read_bytes"] is not None:
+                total = r["dram_read_bytes"] + (r["dram_write_bytes"] or 0)
+                per_cycle = total / r["num_cycles"]
+            print(f"  {r['index']:>3} {r['region']:<{width}} {fmt(r['dram_read_bytes']):>14} "
+                  f"{fmt(r['dram_write_bytes']):>14} {fmt(per_cycle, '.3f'):>11}")
+
+    print(f"\n  Vector Instructions:")
+    print(f"  {'#':>3} {'Region':<{width}} {'Vector':>14} {'Vector %':>9}")
+    for r in rows:
+        print(f"  {r['index']:>3} {r['region']:<{width}} {fmt(r['vector_insts']):>14} "
+              f"{fmt(r['vector_frac'], '.2f'):>9}")
+
+    print(f"\n{'=' * (width + 52)}\n")
+
+
+def check_roi_expectations(rows, regions, below):
+    """Check required regions and DRAM-read orderings; return True if all hold."""
+    by_name = {r["region"]: r for r in rows}
+    ok = True
+
+    for name in regions:
+        if name not in by_name:
+            print(f"Error: region {name} not in the stats dumps")
+            ok = False
+
+    for pair in below:
+        region, sep, base = pair.partition(":")
+        if not sep or region not in by_name or base not in by_name:
+            print(f"Error: DRAM read check {pair}: region missing from the stats dumps")
+            ok = False
+            continue
+        got = by_name[region]["dram_read_bytes"]
+        ref = by_name[base]["dram_read_bytes"]
+        if got is None or ref is None:
+            print(f"Error: DRAM read check {pair}: no DRAM read bytes in the stats")
+            ok = False
+        elif got >= ref:
+            print(f"Error: DRAM read check {region} {got:,} B >= {base} {ref:,} B")
+            ok = False
+        else:
+            print(f"DRAM read check: {region} {got:,} B < {base} {ref:,} B")
+
+    return ok
+
+
 def print_metrics(metrics, title="gem5 Performance Metrics"):
     """Print metrics in a human-readable table format."""
     print(f"\n{'=' * 60}")
@@ -199,12 +443,25 @@ def print_metrics(metrics, title="gem5 Performance Metrics"):
         if metrics.get("l2_hit_rate"):
             print(f"    Hit Rate:      {metrics['l2_hit_rate']:>14.2f}%")
 
+    if metrics.get("dtlb_accesses"):
+        print(f"\n  TLBs:")
+        print(f"    DTLB Accesses: {metrics['dtlb_accesses']:>15,}")
+        print(f"    DTLB Misses:   {metrics['dtlb_misses']:>15,}")
+        if metrics.get("dtlb_miss_rate") is not None:
+            print(f"    DTLB Miss %:   {metrics['dtlb_miss_rate']:>14.3f}%")
+        if metrics.get("itlb_misses") is not None:
+            print(f"    ITLB Misses:   {metrics['itlb_misses']:>15,}")
+
     if metrics.get("mem_reads") or metrics.get("mem_writes"):
         print(f"\n  Memory Controller:")
         if metrics.get("mem_reads"):
             print(f"    Read Reqs:     {metrics['mem_reads']:>15,}")
         if metrics.get("mem_writes"):
             print(f"    Write Reqs:    {metrics['mem_writes']:>15,}")
+        if metrics.get("dram_read_bytes") is not None:
+            print(f"    DRAM Read B:   {metrics['dram_read_bytes']:>15,}")
+        if metrics.get("dram_write_bytes") is not None:
+            print(f"    DRAM Write B:  {metrics['dram_write_bytes']:>15,}")
 
     print(f"\n{'=' * 60}\n")
 
@@ -242,6 +499,7 @@ def print_comparison(metrics1, metrics2, title1="Config 1", title2="Config 2"):
         ("L1D Hit Rate %", "l1d_hit_rate", True),
         ("L1I Hit Rate %", "l1i_hit_rate", True),
         ("L2 Hit Rate %", "l2_hit_rate", True),
+        ("DTLB Misses", "dtlb_misses", False),
     ]
 
     for label, key, is_float in comparisons:
@@ -270,9 +528,54 @@ def main():
     parser.add_argument(
         "--cpu-id", type=int, default=0, help="CPU ID to extract stats for"
     )
+    parser.add_argument(
+        "--roi", action="store_true", help="Per-region tables from a multi-dump stats.txt"
+    )
+    parser.add_argument(
+        "--roi-log", default=None, help="Simulator output containing the [ROI] report"
+    )
+    parser.add_argument(
+        "--expect-region", action="append", default=[], metavar="NAME",
+        help="With --roi: fail unless region NAME was dumped (repeatable)"
+    )
+    parser.add_argument(
+        "--expect-dram-read-below", action="append", default=[], metavar="REGION:BASE",
+        help="With --roi: fail unless REGION read fewer DRAM bytes than BASE (repeatable)"
+    )
 
     args = parser.parse_args()
 
+    if args.roi:
+        if len(args.stats_files) != 1:
+            print("Error: --roi requires exactly 1 stats file", file=sys.stderr)
+            sys.exit(1)
+        dumps = parse_stats_dumps(args.stats_files[0])
+        if not dumps:
+            print(f"Error: No stats dumps found in {args.stats_files[0]}", file=sys.stderr)
+            sys.exit(1)
+        regions = parse_roi_log(args.roi_log) if args.roi_log else {}
+        rows = extract_roi_metrics(dumps, regions, args.cpu_id)
+
+        if args.json:
+            print(json.dumps(
+                [{k: v for k, v in r.items() if v is not None} for r in rows], indent=2
+            ))
+        elif args.csv:
+            keys = list(rows[0].keys())
+            print(",".join(keys))
+            for r in rows:
+                print(",".join("" if r[k] is None else str(r[k]) for k in keys))
+        else:
+            print_roi_tables(rows)
+
+        if args.expect_region or args.expect_dram_read_below:
+            if not check_roi_expectations(
+                rows, args.expect_region, args.expect_dram_read_below
+            ):
+                sys.exit(1)
+            print("ROI expectations PASSED")
+        return
+
     if args.compare and len(args.stats_files) != 2:
         print("Error: --compare requires exactly 2 stats files", file=sys.stderr)
         sys.exit(1)
@@ -301,7 +604,7 @@ def main():
         # CSV header
         keys = [
             "file", "sim_ticks", "sim_insts", "num_cycles", "cpi", "ipc",
-            "l1d_hit_rate", "l1i_hit_rate", "l2_hit_rate",
+            "l1d_hit_rate", "l1i_hit_rate", "l2_hit_rate", "dtlb_misses",
         ]
         print(",".join(keys))
         for filepath, _, metrics in results:
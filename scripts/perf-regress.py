@@ -0,0 +1,341 @@
+#!/usr/bin/env python3
+"""
+Performance Regression Checker
+==============================
+
+Collects the app's structured benchmark output from a simulator log and
+compares it against stored per-configuration baselines:
+  - [BENCH-CSV] / [BENCH-JSON] lines from the benchmark runner
+    (app/src/rvv/rvv_bench.c): median cycles and instret per kernel,
+    implementation and size
+  - [ROI] <index> <name> cycles=<n> lines from roi_report()
+  - optionally gem5 per-ROI stats (CPI) via parse-gem5-stats.py
+
+Baselines live in a versioned JSON file (tests/perf/baselines.json),
+keyed by "<platform>/<cpu>/vlen<VLEN>/<backend>", so QEMU, Spike, each
+gem5 CPU model, each VLEN and each RVV kernel backend (asm, intrinsics)
+are tracked separately.
+
+Usage:
+  python3 perf-regress.py --log run.log --cpu spike
+  python3 perf-regress.py --log gem5.log --cpu TimingSimpleCPU \\
+      --gem5-stats m5out/stats.txt
+  python3 perf-regress.py --log run.log --cpu spike --update
+
+Options:
+  --log FILE          Simulator console output
+  --baseline FILE     Baseline file (default: tests/perf/baselines.json)
+  --platform NAME     Platform tag (default: taken from the bench lines)
+  --cpu NAME          CPU model tag ("-" when the platform has only one)
+  --vlen N            VLEN tag (default: taken from the bench lines)
+  --backend NAME      RVV backend tag (default: taken from the bench lines,
+                      else "asm")
+  --metrics LIST      Metrics to check: cycles, instret, cpi (default:
+                      cycles,cpi)
+  --threshold PCT     Allowed slowdown in percent (default: the file's
+                      threshold_pct, else 10)
+  --min-delta N       Ignore cycle/instret regressions smaller than N in
+                      absolute terms (default 200; guards tiny kernels)
+  --gem5-stats FILE   gem5 stats.txt with one dump per ROI
+  --require-baseline  Fail when the configuration has no baseline
+  --update            Record the current results as the baseline
+
+Exit status is 1 when any metric regressed past the threshold, or when
+--require-baseline is given and no baseline exists.
+"""
+
+import argparse
+import datetime
+import importlib.util
+import json
+import os
+import re
+import subprocess
+import sys
+
+SCHEMA_VERSION = 1
+DEFAULT_THRESHOLD_PCT = 10.0
+DEFAULT_MIN_DELTA = 200
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.dirname(SCRIPT_DIR)
+DEFAULT_BASELINE = os.path.join(REPO_DIR, "tests", "perf", "baselines.json")
+
+CSV_FIELDS = [
+    "platform", "vlen", "kernel", "impl", "n", "reps",
+    "min", "median", "max", "mean", "stddev", "instret", "passed", "backend",
+]
+
+CSV_RE = re.compile(r"^\[BENCH-CSV\] (.*)$")
+JSON_RE = re.compile(r"^\[BENCH-JSON\] (\{.*\})\s*$")
+ROI_RE = re.compile(r"^\[ROI\] (\d+) (\S+) cycles=(\d+)")
+
+
+# =============================================================================
+# Result Collection
+# =============================================================================
+
+def parse_bench_log(filepath):
+    """Return ({metric_key: {metric: value}}, platform, vlen, backend) from a log."""
+    results = {}
+    platform = None
+    vlen = None
+    backend = None
+
+    with open(filepath, "r", errors="replace") as f:
+        for raw in f:
+            line = raw.rstrip("\r\n")
+            row = None
+
+            m = JSON_RE.match(line)
+            if m:
+                try:
+                    row = json.loads(m.group(1))
+                except json.JSONDecodeError:
+                    continue
+            else:
+                m = CSV_RE.match(line)
+                if m and not m.group(1).startswith("platform,"):
+                    values = m.group(1).split(",")
+                    if len(values) == len(CSV_FIELDS) - 1:
+                        values.append("asm")  # logs from before the backend column
+                    if len(values) == len(CSV_FIELDS):
+                        row = dict(zip(CSV_FIELDS, values))
+
+            if row is not None:
+                platform = platform or row["platform"]
+                vlen = vlen or int(row["vlen"])
+                backend = backend or row.get("backend", "asm")
+                key = f"bench/{row['kernel']}/{row['impl']}/{row['n']}"
+                cycles = int(row["median"])
+                instret = int(row["instret"])
+                results[key] = {
+                    "cycles": cycles,
+                    "instret": instret,
+                    "cpi": round(cycles / instret, 4) if instret else None,
+                }
+                continue
+
+            m = ROI_RE.match(line)
+            if m:
+                name = m.group(2)
+                key = f"roi/{name}"
+                suffix = 2
+                while key in results:
+                    key = f"roi/{name}#{suffix}"
+                    suffix += 1
+                results[key] = {"cycles": int(m.group(3))}
+
+    return results, platform, vlen, backend
+
+
+def load_gem5_parser():
+    """Import parse-gem5-stats.py (hyphenated name) as a module."""
+    path = os.path.join(SCRIPT_DIR, "parse-gem5-stats.py")
+    spec = importlib.util.spec_from_file_location("parse_gem5_stats", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def merge_gem5_roi(results, stats_file, log_file):
+    """Add gem5 per-ROI CPI and cycle counts to the ROI entries."""
+    gem5 = load_gem5_parser()
+    dumps = gem5.parse_stats_dumps(stats_file)
+    regions = gem5.parse_roi_log(log_file)
+
+    for row in gem5.extract_roi_metrics(dumps, regions):
+        if row["region"] == "(exit)":
+            continue
+        entry = results.setdefault(f"roi/{row['region']}", {})
+        if row["num_cycles"] is not None:
+            entry["cycles"] = int(row["num_cycles"])
+        if row["num_insts"] is not None:
+            entry["instret"] = int(row["num_insts"])
+        if row["cpi"] is not None:
+            entry["cpi"] = round(row["cpi"], 4)
+
+
+# =============================================================================
+# Baseline File
+# =============================================================================
+
+def load_baselines(filepath):
+    if not os.path.exists(filepath):
+        return {"schema": SCHEMA_VERSION, "threshold_pct": DEFAULT_THRESHOLD_PCT,
+                "configs": {}}
+
+    with open(filepath, "r") as f:
+        data = json.load(f)
+
+    if data.get("schema") != SCHEMA_VERSION:
+        print(f"Error: {filepath}: unsupported schema {data.get('schema')} "
+              f"(expected {SCHEMA_VERSION})", file=sys.stderr)
+        sys.exit(2)
+
+    data.setdefault("configs", {})
+    return data
+
+
+def save_baselines(filepath, data):
+    os.makedirs(os.path.dirname(os.path.abspath(filepath)), exist_ok=True)
+    with open(filepath, "w") as f:
+        json.dump(data, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+
+def git_revision():
+    try:
+        out = subprocess.run(["git", "-C", REPO_DIR, "rev-parse", "--short", "HEAD"],
+                             capture_output=True, text=True, check=True)
+        return out.stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+# =============================================================================
+# Comparison
+# =============================================================================
+
+def compare(baseline, results, metrics, threshold_pct, min_delta):
+    """Return (regressions, improvements, checked) lists of message strings.
+
+    A baseline kernel missing from the run (crashed or truncated output)
+    counts as a regression.
+    """
+    regressions = []
+    improvements = []
+    checked = 0
+
+    for key in sorted(baseline):
+        if key not in results:
+            regressions.append(f"{key}: missing from this run")
+            continue
+
+        for metric in metrics:
+            base = baseline[key].get(metric)
+            cur = results[key].get(metric)
+            if base is None or cur is None or base <= 0:
+                continue
+
+            checked += 1
+            change = (cur - base) / base * 100.0
+            delta = cur - base
+            small = metric != "cpi" and abs(delta) < min_delta
+            msg = f"{key} {metric}: {base} -> {cur} ({change:+.1f}%)"
+
+            if change > threshold_pct and not small:
+                regressions.append(msg)
+            elif change < -threshold_pct and not small:
+                improvements.append(msg)
+
+    return regressions, improvements, checked
+
+
+# =============================================================================
+# Main
+# =============================================================================
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Check benchmark results against per-configuration baselines"
+    )
+    parser.add_argument("--log", required=True, help="Simulator console output")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="Baseline JSON file")
+    parser.add_argument("--platform", help="Platform tag (default: from bench lines)")
+    parser.add_argument("--cpu", default="-", help="CPU model tag")
+    parser.add_argument("--vlen", type=int, help="VLEN tag (default: from bench lines)")
+    parser.add_argument("--backend", help="RVV backend tag (default: from bench lines)")
+    parser.add_argument("--metrics", default="cycles,cpi",
+                        help="Comma-separated metrics: cycles, instret, cpi")
+    parser.add_argument("--threshold", type=float, help="Allowed slowdown in percent")
+    parser.add_argument("--min-delta", type=int, default=DEFAULT_MIN_DELTA,
+                        help="Ignore absolute cycle/instret changes below this")
+    parser.add_argument("--gem5-stats", help="gem5 stats.txt with per-ROI dumps")
+    parser.add_argument("--require-baseline", action="store_true",
+                        help="Fail when no baseline exists for this configuration")
+    parser.add_argument("--update", action="store_true",
+                        help="Store this run as the baseline")
+
+    args = parser.parse_args()
+
+    metrics = [m.strip() for m in args.metrics.split(",") if m.strip()]
+    for metric in metrics:
+        if metric not in ("cycles", "instret", "cpi"):
+            parser.error(f"unknown metric: {metric}")
+
+    if not os.path.exists(args.log):
+        print(f"Error: log not found: {args.log}", file=sys.stderr)
+        return 2
+
+    results, log_platform, log_vlen, log_backend = parse_bench_log(args.log)
+    if args.gem5_stats:
+        merge_gem5_roi(results, args.gem5_stats, args.log)
+
+    if not results:
+        print("Error: no [BENCH-CSV]/[BENCH-JSON]/[ROI] results in the log", file=sys.stderr)
+        return 1
+
+    platform = args.platform or log_platform or "unknown"
+    vlen = args.vlen or log_vlen or 0
+    backend = args.backend or log_backend or "asm"
+    config = f"{platform}/{args.cpu}/vlen{vlen}/{backend}"
+
+    data = load_baselines(args.baseline)
+    threshold = args.threshold
+    if threshold is None:
+        threshold = float(data.get("threshold_pct", DEFAULT_THRESHOLD_PCT))
+
+    print(f"=== Performance check: {config} ({len(results)} results) ===")
+
+    if args.update:
+        data["configs"][config] = {
+            "recorded": {
+                "date": datetime.date.today().isoformat(),
+                "git": git_revision(),
+            },
+            "results": results,
+        }
+        save_baselines(args.baseline, data)
+        print(f"Baseline updated: {args.baseline} [{config}]")
+        print("=== perf check PASSED (baseline updated) ===")
+        return 0
+
+    entry = data["configs"].get(config)
+    if entry is None:
+        print(f"No baseline for {config} in {args.baseline}")
+        print("Record one with: perf-regress.py --update "
+              f"--log <log> --cpu {args.cpu}")
+        if args.require_baseline:
+            print("=== perf check FAILED (no baseline) ===")
+            return 1
+        print("=== perf check PASSED (no baseline) ===")
+        return 0
+
+    recorded = entry.get("recorded", {})
+    print(f"Baseline: git {recorded.get('git', '?')} ({recorded.get('date', '?')}), "
+          f"threshold {threshold:g}%, metrics {','.join(metrics)}")
+
+    regressions, improvements, checked = compare(entry.get("results", {}), results, metrics,
+                                                 threshold, args.min_delta)
+
+    for msg in improvements:
+        print(f"  [improved] {msg}")
+    for msg in regressions:
+        print(f"  [REGRESSION] {msg}")
+
+    print(f"Checked {checked} metrics: {len(regressions)} regressed, "
+          f"{len(improvements)} improved")
+
+    if regressions:
+        print("=== perf check FAILED ===")
+        return 1
+
+    if improvements:
+        print("Consider refreshing the baseline with --update")
+    print("=== perf check PASSED ===")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
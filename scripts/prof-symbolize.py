@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""
+PC-Sample Profile Symbolizer
+============================
+
+Turns the "[PROF]" lines of a profiler build (CMake -DENABLE_PROFILER=ON,
+see app/include/prof.h) into a flat profile per function:
+
+  [PROF] hart=<h> pc=0x<addr> samples=<n>
+
+Every sampled PC is attributed to the function whose label in app.dump
+(objdump -d output, "<addr> <name>:") is the closest one at or below it,
+and to the object file that contributed its section in app.map (the
+linker map). Samples from all harts are merged unless --hart is given.
+
+Usage:
+  python3 prof-symbolize.py --log run.log --dump build/app/app.dump \\
+      [--map build/app/app.map] [--hart N] [--top N] [--pcs]
+
+--pcs adds the hottest individual PCs (with their function offsets) after
+the function table. Exit status is 1 when the log holds no samples.
+"""
+
+import argparse
+import bisect
+import os
+import re
+import sys
+from collections import defaultdict
+
+PROF_RE = re.compile(r"\[PROF\] hart=(\d+) pc=0x([0-9a-fA-F]+) samples=(\d+)")
+PROF_SUMMARY_RE = re.compile(r"\[PROF\] hart=(\d+) samples=(\d+) pcs=(\d+) dropped=(\d+)")
+DUMP_LABEL_RE = re.compile(r"^([0-9a-fA-F]+) <([^>]+)>:$")
+DUMP_INSN_RE = re.compile(r"^\s+([0-9a-fA-F]+):\t")
+# " .text.name  0xaddr  0xsize  object" (the section name may sit alone on
+# the previous line when it is long)
+MAP_SECTION_RE = re.compile(r"^ (\.text\S*)\s*$")
+MAP_ENTRY_RE = re.compile(r"^ (?:(\.text\S*))?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def parse_log(path, hart):
+    """Return ({pc: samples}, [(hart, samples, pcs, dropped)]) from a console log."""
+    samples = defaultdict(int)
+    summaries = []
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = PROF_RE.search(line)
+            if m:
+                if hart is None or int(m.group(1)) == hart:
+                    samples[int(m.group(2), 16)] += int(m.group(3))
+                continue
+            m = PROF_SUMMARY_RE.search(line)
+            if m and (hart is None or int(m.group(1)) == hart):
+                summaries.append(tuple(int(g) for g in m.groups()))
+    return samples, summaries
+
+
+def parse_dump(path):
+    """Return sorted function start addresses, their names and the last
+    instruction address from objdump -d output."""
+    symbols = {}
+    last = 0
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = DUMP_INSN_RE.match(line)
+            if m:
+                last = max(last, int(m.group(1), 16))
+                continue
+            m = DUMP_LABEL_RE.match(line.strip())
+            if m:
+                symbols.setdefault(int(m.group(1), 16), m.group(2))
+    addrs = sorted(symbols)
+    return addrs, [symbols[a] for a in addrs], last
+
+
+def parse_map(path):
+    """Return sorted (start, end, object) ranges of the .text input sections in a linker map."""
+    ranges = []
+    pending = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            m = MAP_SECTION_RE.match(line)
+            if m:
+                pending = m.group(1)
+                continue
+            m = MAP_ENTRY_RE.match(line)
+            if m and (m.group(1) or pending):
+                start = int(m.group(2), 16)
+                size = int(m.group(3), 16)
+                if size:
+                    ranges.append((start, start + size, os.path.basename(m.group(4).strip())))
+            pending = None
+    ranges.sort()
+    return ranges
+
+
+def lookup_function(addrs, names, last, pc):
+    """(name, offset) of the function containing pc, or ("??", 0) outside the code."""
+    i = bisect.bisect_right(addrs, pc) - 1
+    if i < 0 or pc > last:
+        return "??", 0
+    return names[i], pc - addrs[i]
+
+
+def lookup_object(ranges, starts, pc):
+    """Object file whose .text section holds pc, or "?"."""
+    i = bisect.bisect_right(starts, pc) - 1
+    if i >= 0 and pc < ranges[i][1]:
+        return ranges[i][2]
+    return "?"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolize [PROF] PC samples into a flat profile")
+    parser.add_argument("--log", required=True, help="Console log of a profiler build")
+    parser.add_argument("--dump", required=True, help="Disassembly (build/app/app.dump)")
+    parser.add_argument("--map", help="Linker map (build/app/app.map) for object file names")
+    parser.add_argument("--hart", type=int, help="Only this hart's samples (default: all)")
+    parser.add_argument("--top", type=int, default=30,
+                        help="Functions (and PCs) to list (default: 30, 0 = all)")
+    parser.add_argument("--pcs", action="store_true", help="Also list the hottest PCs")
+    args = parser.parse_args()
+
+    for path in (args.log, args.dump, args.map):
+        if path and not os.path.exists(path):
+            print(f"Error: file not found: {path}", file=sys.stderr)
+            return 2
+
+    samples, summaries = parse_log(args.log, args.hart)
+    total = sum(samples.values())
+    if total == 0:
+        print("No [PROF] samples in the log (build with -DENABLE_PROFILER=ON)")
+        return 1
+
+    addrs, names, last = parse_dump(args.dump)
+    ranges = parse_map(args.map) if args.map else []
+    starts = [r[0] for r in ranges]
+
+    per_func = defaultdict(int)
+    func_obj = {}
+    for pc, n in samples.items():
+        name, _ = lookup_function(addrs, names, last, pc)
+        per_func[name] += n
+        if name not in func_obj:
+            func_obj[name] = lookup_object(ranges, starts, pc) if ranges and name != "??" else ""
+
+    harts = "all harts" if args.hart is None else f"hart {args.hart}"
+    dropped = sum(s[3] for s in summaries)
+    print(f"Flat profile: {total} samples ({harts}, {len(samples)} PCs, {dropped} dropped)")
+    print(f"{'samples':>9} {'%':>7} {'cum %':>7}  {'function':<40} object")
+
+    rows = sorted(per_func.items(), key=lambda kv: (-kv[1], kv[0]))
+    if args.top > 0:
+        rows = rows[:args.top]
+    cum = 0
+    for name, n in rows:
+        cum += n
+        print(f"{n:>9} {100.0 * n / total:>6.2f}% {100.0 * cum / total:>6.2f}%  "
+              f"{name:<40} {func_obj[name]}")
+
+    if args.pcs:
+        print()
+        print(f"{'samples':>9} {'%':>7}  pc")
+        hot = sorted(samples.items(), key=lambda kv: (-kv[1], kv[0]))
+        if args.top > 0:
+            hot = hot[:args.top]
+        for pc, n in hot:
+            name, off = lookup_function(addrs, names, last, pc)
+            print(f"{n:>9} {100.0 * n / total:>6.2f}%  0x{pc:x} <{name}+0x{off:x}>")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+# =============================================================================
+# Run gem5 SE dataset test
+# =============================================================================
+# Generates two float32 matrices with gen-dataset.py, A (M x K) and
+# B (K x N), and runs the app in gem5 SE mode with their paths on the
+# command line. The app maps both files in place and checks rvv_matmul_f32
+# and rvv_dot_product_f32 on them against the scalar references.
+# Used by Phase 6 CTest.
+#
+# Usage: run-gem5-dataset-test.sh <GEM5_OPT> <GEM5_CONFIG> <APP_ELF> <WORK_DIR> <GEN_DATASET> [M K N]
+# =============================================================================
+
+set -e
+
+if [ $# -lt 5 ]; then
+    echo "Usage: $0 <GEM5_OPT> <GEM5_CONFIG> <APP_ELF> <WORK_DIR> <GEN_DATASET> [M K N]"
+    exit 1
+fi
+
+GEM5_OPT="$1"
+GEM5_CONFIG="$2"
+APP_ELF="$3"
+WORK_DIR="$4"
+GEN_DATASET="$5"
+M="${6:-64}"
+K="${7:-1024}"
+N="${8:-64}"
+
+MAX_TICKS=50000000000
+
+mkdir -p "$WORK_DIR"
+cd "$WORK_DIR"
+
+echo "=== gem5 SE Dataset Test (A ${M}x${K}, B ${K}x${N}) ==="
+"$GEN_DATASET" --rows "$M" --cols "$K" --seed 1 a.rvds
+"$GEN_DATASET" --rows "$K" --cols "$N" --seed 2 b.rvds
+
+# Relative paths resolve against gem5's working directory (WORK_DIR)
+"$GEM5_OPT" --outdir=m5out "$GEM5_CONFIG" \
+    --cmd="$APP_ELF" \
+    --max-ticks=$MAX_TICKS \
+    --options="a.rvds b.rvds" > gem5.log 2>&1 || true
+
+grep "^\[DATA\]" gem5.log || true
+
+if ! grep -q "^\[TEST\] Dataset kernels: PASS" gem5.log; then
+    echo "Error: dataset kernels did not pass (see $WORK_DIR/gem5.log)"
+    tail -n 20 gem5.log
+    exit 1
+fi
+
+echo ""
+echo "=== gem5 dataset test PASSED ==="
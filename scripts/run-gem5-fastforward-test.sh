@@ -0,0 +1,86 @@
+#!/usr/bin/env bash
+# =============================================================================
+# Run gem5 fast-forward / checkpoint test
+# =============================================================================
+# Runs the app three ways on the detailed CPU model and checks each reaches
+# the kernels and reports its regions:
+#   1. --fast-forward:     AtomicSimpleCPU up to the first roi_begin(),
+#                          then a switch to the detailed CPU
+#   2. --checkpoint-dir:   AtomicSimpleCPU up to the first roi_begin(),
+#                          checkpoint written there
+#   3. --restore-from:     the checkpoint resumed on the detailed CPU
+# Prints the tick of the ROI mark against the end of the run, i.e. how
+# much of the simulated time no longer needs the detailed model.
+# Used by Phase 6 CTest.
+#
+# Usage: run-gem5-fastforward-test.sh <GEM5_OPT> <GEM5_CONFIG> <APP_ELF> <WORK_DIR> <CPU_TYPE>
+# =============================================================================
+
+set -e
+
+if [ $# -lt 5 ]; then
+    echo "Usage: $0 <GEM5_OPT> <GEM5_CONFIG> <APP_ELF> <WORK_DIR> <CPU_TYPE>"
+    exit 1
+fi
+
+GEM5_OPT="$1"
+GEM5_CONFIG="$2"
+APP_ELF="$3"
+WORK_DIR="$4"
+CPU_TYPE="$5"
+
+MAX_TICKS=5000000000
+
+mkdir -p "$WORK_DIR"
+cd "$WORK_DIR"
+rm -rf ff cpt restore
+
+# run <outdir> <log> <config args...>
+run() {
+    local outdir="$1" log="$2"
+    shift 2
+    local start end
+    start=$(date +%s)
+    "$GEM5_OPT" --outdir="$outdir" "$GEM5_CONFIG" \
+        --cpu-type="$CPU_TYPE" \
+        --cmd="$APP_ELF" \
+        --max-ticks=$MAX_TICKS \
+        "$@" > "$log" 2>&1 || true
+    end=$(date +%s)
+    echo "  host time: $((end - start))s"
+}
+
+# expect <log> <regex> <what>
+expect() {
+    if ! grep -Eq "$2" "$1"; then
+        echo "Error: $3 missing from $1"
+        tail -n 20 "$1"
+        exit 1
+    fi
+}
+
+echo "=== gem5 Fast-Forward Test ($CPU_TYPE) ==="
+
+echo "Running --fast-forward..."
+run ff ff.log --fast-forward
+expect ff.log "^\[gem5\] Switched to $CPU_TYPE at tick" "CPU switch at the ROI mark"
+expect ff.log "^\[ROI\] 0 " "region report"
+MARK=$(sed -n 's/^\[gem5\] ROI mark ([a-z]*) at tick \([0-9]*\)$/\1/p' ff.log | head -n 1)
+END=$(sed -n 's/^\[gem5\] Simulation finished at tick \([0-9]*\)$/\1/p' ff.log | head -n 1)
+echo "  ROI mark at tick $MARK of $END"
+
+echo "Running --checkpoint-dir..."
+run cpt cpt.log --checkpoint-dir="$WORK_DIR/cpt/roi"
+expect cpt.log "^\[gem5\] Checkpoint written:" "checkpoint"
+if [ ! -f cpt/roi/m5.cpt ]; then
+    echo "Error: checkpoint not found at $WORK_DIR/cpt/roi/m5.cpt"
+    exit 1
+fi
+
+echo "Running --restore-from..."
+run restore restore.log --restore-from="$WORK_DIR/cpt/roi"
+expect restore.log "^\[gem5\] Switched to $CPU_TYPE at tick" "CPU switch after restore"
+expect restore.log "^\[ROI\] 0 " "region report after restore"
+
+echo ""
+echo "=== gem5 fast-forward test PASSED ==="
@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+# =============================================================================
+# Run gem5 per-region (ROI) stats test
+# =============================================================================
+# Runs the app on gem5 with caches (TimingSimpleCPU), then splits the
+# multi-dump stats.txt into per-kernel tables with parse-gem5-stats.py
+# --roi, naming each dump from the app's "[ROI] <index> <name>" report.
+# Used by Phase 6 CTest.
+#
+# Usage: run-gem5-roi-test.sh <GEM5_OPT> <GEM5_FS_CONFIG> <APP_ELF> <PARSE_SCRIPT> <WORK_DIR>
+#                             [MAX_TICKS [PARSE_ARGS...]]
+#
+# MAX_TICKS defaults to 5e9 (enough for the first tests); PARSE_ARGS go to
+# parse-gem5-stats.py, e.g. --expect-region / --expect-dram-read-below.
+# =============================================================================
+
+set -e
+
+if [ $# -lt 5 ]; then
+    echo "Usage: $0 <GEM5_OPT> <GEM5_FS_CONFIG> <APP_ELF> <PARSE_SCRIPT> <WORK_DIR>"
+    exit 1
+fi
+
+GEM5_OPT="$1"
+GEM5_FS_CONFIG="$2"
+APP_ELF="$3"
+PARSE_SCRIPT="$4"
+WORK_DIR="$5"
+MAX_TICKS="${6:-5000000000}"
+shift $(( $# < 6 ? $# : 6 ))
+
+mkdir -p "$WORK_DIR"
+cd "$WORK_DIR"
+
+echo "=== gem5 ROI Stats Test ==="
+echo "Running TimingSimpleCPU..."
+"$GEM5_OPT" "$GEM5_FS_CONFIG" \
+    --cpu-type=TimingSimpleCPU \
+    --cmd="$APP_ELF" \
+    --max-ticks=$MAX_TICKS \
+    > gem5_roi.log 2>&1
+
+STATS="m5out/stats.txt"
+
+if [ ! -f "$STATS" ]; then
+    echo "Error: stats not found at $WORK_DIR/$STATS"
+    cat gem5_roi.log 2>/dev/null || true
+    exit 1
+fi
+
+REGIONS=$(grep -c '^\[ROI\] [0-9]' gem5_roi.log || true)
+DUMPS=$(grep -c 'Begin Simulation Statistics' "$STATS" || true)
+echo "Regions reported: $REGIONS, stats dumps: $DUMPS"
+
+if [ "$REGIONS" -eq 0 ] || [ "$DUMPS" -lt "$REGIONS" ]; then
+    echo "Error: expected one stats dump per reported region"
+    exit 1
+fi
+
+"$PARSE_SCRIPT" --roi --roi-log gem5_roi.log "$@" "$STATS"
+
+echo ""
+echo "=== gem5 ROI stats test PASSED ==="
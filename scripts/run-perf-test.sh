@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+# =============================================================================
+# Run a simulator and check its benchmark output against the baselines
+# =============================================================================
+# Runs <command...> in WORK_DIR with its console output saved to run.log,
+# then hands the log to perf-regress.py. If the run left a gem5
+# m5out/stats.txt, its per-ROI dumps are checked too. Used by the perf_*
+# CTests.
+#
+# Usage: run-perf-test.sh <WORK_DIR> <BASELINE> <CPU> <METRICS> <THRESHOLD> <command...>
+#   CPU:       CPU model tag ("-" for QEMU/Spike)
+#   METRICS:   comma-separated list for perf-regress.py --metrics
+#   THRESHOLD: allowed slowdown in percent, or "default" for the file's
+#
+# Set PERF_UPDATE=1 to record this run as the new baseline instead. A
+# nonzero simulator exit status fails the test and records nothing.
+# =============================================================================
+
+set -e
+
+if [ $# -lt 6 ]; then
+    echo "Usage: $0 <WORK_DIR> <BASELINE> <CPU> <METRICS> <THRESHOLD> <command...>"
+    exit 1
+fi
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+WORK_DIR="$1"
+BASELINE="$2"
+CPU="$3"
+METRICS="$4"
+THRESHOLD="$5"
+shift 5
+
+mkdir -p "$WORK_DIR"
+cd "$WORK_DIR"
+rm -rf m5out
+
+echo "=== Performance Test: $CPU ==="
+STATUS=0
+"$@" > run.log 2>&1 || STATUS=$?
+echo "Simulator exit status: $STATUS"
+
+# A crashed or timed-out run has truncated results: never compare or record it
+if [ "$STATUS" -ne 0 ]; then
+    tail -n 20 run.log
+    echo "Error: simulator exited with status $STATUS"
+    echo "=== perf check FAILED (simulator exit status $STATUS) ==="
+    exit 1
+fi
+
+ARGS=(--log run.log --baseline "$BASELINE" --cpu "$CPU" --metrics "$METRICS")
+if [ "$THRESHOLD" != "default" ]; then
+    ARGS+=(--threshold "$THRESHOLD")
+fi
+if [ -f m5out/stats.txt ]; then
+    ARGS+=(--gem5-stats m5out/stats.txt)
+fi
+if [ "${PERF_UPDATE:-0}" = "1" ]; then
+    ARGS+=(--update)
+fi
+
+python3 "$SCRIPT_DIR/perf-regress.py" "${ARGS[@]}"
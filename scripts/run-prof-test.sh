@@ -0,0 +1,33 @@
+#!/usr/bin/env bash
+# =============================================================================
+# Run a profiler build and symbolize its PC samples
+# =============================================================================
+# Runs <command...> in WORK_DIR with its console output saved to run.log,
+# then hands the log to prof-symbolize.py with the build's disassembly and
+# linker map. Used by the prof_* CTests (builds with -DENABLE_PROFILER=ON).
+#
+# Usage: run-prof-test.sh <WORK_DIR> <APP_DUMP> <APP_MAP> <command...>
+# =============================================================================
+
+set -e
+
+if [ $# -lt 4 ]; then
+    echo "Usage: $0 <WORK_DIR> <APP_DUMP> <APP_MAP> <command...>"
+    exit 1
+fi
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+WORK_DIR="$1"
+APP_DUMP="$2"
+APP_MAP="$3"
+shift 3
+
+mkdir -p "$WORK_DIR"
+cd "$WORK_DIR"
+
+echo "=== Profile: $(basename "$1") ==="
+STATUS=0
+"$@" > run.log 2>&1 || STATUS=$?
+echo "Simulator exit status: $STATUS"
+
+python3 "$SCRIPT_DIR/prof-symbolize.py" --log run.log --dump "$APP_DUMP" --map "$APP_MAP" --top 20